@@ -0,0 +1,165 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "AssetServerLogging.h"
+
+// address space rather than memory, the pages of a mapped file are only loaded while they are being read
+static const qint64 MAX_RETAINED_SIZE = 1024LL * 1024 * 1024;
+static const int NUM_HOTTEST_ASSETS_IN_STATS = 5;
+
+MappedAssetFile::MappedAssetFile(const QString& filePath) :
+    _file(filePath)
+{
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    _size = _file.size();
+    if (_size == 0) {
+        // there is nothing to map in an empty file
+        _isValid = true;
+        return;
+    }
+
+    _data = _file.map(0, _size);
+    if (!_data) {
+        qCWarning(asset_server) << "Could not map asset file" << filePath << _file.errorString();
+        return;
+    }
+    _isValid = true;
+}
+
+MappedAssetFile::~MappedAssetFile() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+AssetFileCache::AssetFileCache(const QDir& filesDirectory) :
+    _filesDirectory(filesDirectory)
+{
+}
+
+MappedAssetFilePointer AssetFileCache::get(const AssetUtils::AssetHash& hash) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_numRequests;
+
+        auto it = _entries.find(hash);
+        if (it != _entries.end()) {
+            if (auto file = it->second.file.lock()) {
+                ++_numHits;
+                ++it->second.numRequests;
+                retain(it->second, hash, file);
+                return file;
+            }
+        }
+    }
+
+    // mapped without holding the lock, so that requests for mapped files don't wait on the disk
+    auto file = std::make_shared<const MappedAssetFile>(_filesDirectory.filePath(hash));
+    if (!file->isValid()) {
+        return MappedAssetFilePointer();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& entry = _entries[hash];
+    ++entry.numRequests;
+    if (auto mappedFile = entry.file.lock()) {
+        // another request mapped it in the meantime, share theirs
+        file = mappedFile;
+    } else {
+        entry.file = file;
+    }
+    retain(entry, hash, file);
+    return file;
+}
+
+void AssetFileCache::recordBytesSent(const AssetUtils::AssetHash& hash, qint64 bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        it->second.bytesSent += bytes;
+    }
+}
+
+void AssetFileCache::evict(const AssetUtils::AssetHash& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        release(it->second);
+        _entries.erase(it);
+    }
+}
+
+void AssetFileCache::retain(Entry& entry, const AssetUtils::AssetHash& hash, const MappedAssetFilePointer& file) {
+    release(entry);
+
+    _retained.emplace_front(hash, file);
+    _retainedSize += file->getSize();
+    entry.isRetained = true;
+    entry.retainedPosition = _retained.begin();
+
+    // always keep the file just requested, even if it is bigger than the limit on its own
+    while (_retainedSize > MAX_RETAINED_SIZE && _retained.size() > 1) {
+        release(_entries[_retained.back().first]);
+    }
+}
+
+void AssetFileCache::release(Entry& entry) {
+    if (entry.isRetained) {
+        _retainedSize -= entry.retainedPosition->second->getSize();
+        _retained.erase(entry.retainedPosition);
+        entry.isRetained = false;
+    }
+}
+
+QJsonObject AssetFileCache::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<std::pair<AssetUtils::AssetHash, const Entry*>> hottest;
+    int numMapped = 0;
+    qint64 mappedSize = 0;
+    for (const auto& entry : _entries) {
+        if (auto file = entry.second.file.lock()) {
+            ++numMapped;
+            mappedSize += file->getSize();
+        }
+        hottest.emplace_back(entry.first, &entry.second);
+    }
+
+    auto numHottest = std::min((int)hottest.size(), NUM_HOTTEST_ASSETS_IN_STATS);
+    std::partial_sort(hottest.begin(), hottest.begin() + numHottest, hottest.end(), [](const auto& a, const auto& b) {
+        return a.second->numRequests > b.second->numRequests;
+    });
+
+    static const float BYTES_PER_MEGABYTE = 1024.0f * 1024.0f;
+
+    QJsonObject hottestStats;
+    for (int i = 0; i < numHottest; ++i) {
+        QJsonObject assetStats;
+        assetStats["1. Requests"] = (double)hottest[i].second->numRequests;
+        assetStats["2. Sent (MB)"] = hottest[i].second->bytesSent / BYTES_PER_MEGABYTE;
+        hottestStats[QString::number(i + 1) + ". " + hottest[i].first] = assetStats;
+    }
+
+    QJsonObject stats;
+    stats["1. Mapped Files"] = numMapped;
+    stats["2. Mapped (MB)"] = mappedSize / BYTES_PER_MEGABYTE;
+    stats["3. Requests"] = (double)_numRequests;
+    stats["4. Already Mapped"] = (double)_numHits;
+    stats["5. Hottest Assets"] = hottestStats;
+    return stats;
+}
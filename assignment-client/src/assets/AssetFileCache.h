@@ -0,0 +1,93 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
+
+#include "AssetUtils.h"
+
+// An asset file mapped into memory. The mapping lasts as long as the file is referenced.
+class MappedAssetFile {
+public:
+    MappedAssetFile(const QString& filePath);
+    ~MappedAssetFile();
+
+    bool isValid() const { return _isValid; }
+    const char* getData() const { return reinterpret_cast<const char*>(_data); }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+    bool _isValid { false };
+};
+
+using MappedAssetFilePointer = std::shared_ptr<const MappedAssetFile>;
+
+// Shares the mapped asset files between the requests for them, so that each file is mapped once and its pages are
+// read from disk once, however many clients download it at the same time.
+//
+// Files stay mapped while a request is sending them, and the most recently requested ones are kept mapped after that,
+// up to a total size. Asset files never change once written, so a mapping only has to be dropped before its file is
+// deleted. Requests are counted per asset, for the stats of the hottest assets.
+class AssetFileCache {
+public:
+    AssetFileCache(const QDir& filesDirectory);
+
+    // the mapped file, or nullptr if it doesn't exist or can't be mapped; counts a request for the asset
+    MappedAssetFilePointer get(const AssetUtils::AssetHash& hash);
+
+    // counts bytes of the asset as sent
+    void recordBytesSent(const AssetUtils::AssetHash& hash, qint64 bytes);
+
+    // stops keeping the file mapped, must be called before deleting it
+    void evict(const AssetUtils::AssetHash& hash);
+
+    QJsonObject getStats() const;
+
+private:
+    using RetainedFiles = std::list<std::pair<AssetUtils::AssetHash, MappedAssetFilePointer>>;
+
+    struct Entry {
+        std::weak_ptr<const MappedAssetFile> file;
+        bool isRetained { false };
+        RetainedFiles::iterator retainedPosition;
+
+        quint64 numRequests { 0 };
+        quint64 bytesSent { 0 };
+    };
+
+    void retain(Entry& entry, const AssetUtils::AssetHash& hash, const MappedAssetFilePointer& file);
+    void release(Entry& entry);
+
+    const QDir _filesDirectory;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<AssetUtils::AssetHash, Entry> _entries;
+
+    // the most recently requested files first, kept mapped once no request is using them anymore
+    RetainedFiles _retained;
+    qint64 _retainedSize { 0 };
+
+    quint64 _numRequests { 0 };
+    quint64 _numHits { 0 };
+};
+
+#endif // hifi_AssetFileCache_h
@@ -35,6 +35,7 @@
 #include <PathUtils.h>
 #include <image/TextureProcessing.h>
 
+#include "AssetFileCache.h"
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
 #include "SendAssetTask.h"
@@ -424,6 +425,8 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    _fileCache = std::make_shared<AssetFileCache>(_filesDirectory);
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -536,6 +539,7 @@ void AssetServer::cleanupUnmappedFiles() {
             }
             if (!matched) {
                 // remove the unmapped file
+                _fileCache->evict(filename);
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -867,7 +871,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _fileCache);
     _transferTaskPool.start(task);
 }
 
@@ -957,6 +961,10 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    if (_fileCache) {
+        serverStats["Asset File Cache"] = _fileCache->getStats();
+    }
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1170,6 +1178,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
+            _fileCache->evict(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
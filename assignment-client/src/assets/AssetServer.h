@@ -68,6 +68,7 @@ struct AssetMeta {
     QString redirectTarget;
 };
 
+class AssetFileCache;
 class BakeAssetTask;
 
 class AssetServer : public ThreadedAssignment {
@@ -153,6 +154,9 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Asset files mapped for the transfer tasks, shared between them
+    std::shared_ptr<AssetFileCache> _fileCache;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
@@ -282,6 +282,10 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["threads"] = _workerPool.numThreads();
 
+    QJsonObject utilizationStats;
+    _workerPool.utilizationStats(utilizationStats);
+    statsObject["thread_utilization"] = utilizationStats;
+
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
@@ -306,6 +310,7 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_sleepTiming, "sleep");
     addTiming(_frameTiming, "frame");
     addTiming(_packetsTiming, "packets");
+    addTiming(_prepareTiming, "prepare");
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
@@ -326,6 +331,9 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_hrtf_bucket_renders"] = (int)(_stats.hrtfBucketRenders / (float)_numStatFrames);
+    mixStats["1_bucketed_streams"] = (int)(_stats.bucketedStreams / (float)_numStatFrames);
+    mixStats["1_source_buckets"] = (int)(_stats.sumSourceBuckets / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
@@ -453,6 +461,17 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        // index stream positions and pre-mix distant sources into the buckets shared by every listener
+        {
+            auto prepareTimer = _prepareTiming.timer();
+
+            nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                _workerSharedData.spatialIndex.build(cbegin, cend);
+                _workerSharedData.sourceBuckets.prepare(cbegin, cend);
+            });
+            _stats.sumSourceBuckets += _workerSharedData.sourceBuckets.numBuckets();
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
@@ -553,6 +572,8 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _workerSharedData.sourceBuckets.setEnabled(false);
+    _workerSharedData.spatialIndex.setRadius(0.0f);
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -588,6 +609,27 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        const QString SHARED_HRTF_BUCKETS_KEY = "shared_hrtf_buckets";
+        const QString SHARED_HRTF_DISTANCE_KEY = "shared_hrtf_distance";
+        const QString SHARED_HRTF_CELL_SIZE_KEY = "shared_hrtf_cell_size";
+
+        auto& sourceBuckets = _workerSharedData.sourceBuckets;
+        sourceBuckets.setEnabled(audioThreadingGroupObject[SHARED_HRTF_BUCKETS_KEY].toBool());
+
+        float settingsBucketDistance = audioThreadingGroupObject[SHARED_HRTF_DISTANCE_KEY].toDouble(sourceBuckets.getMinDistance());
+        float settingsBucketCellSize = audioThreadingGroupObject[SHARED_HRTF_CELL_SIZE_KEY].toDouble(sourceBuckets.getCellSize());
+
+        if (settingsBucketCellSize <= 0.0f || settingsBucketDistance < settingsBucketCellSize) {
+            qCWarning(audio) << "Shared HRTF cell size must be greater than 0.0"
+                << "and lesser than or equal to the shared HRTF distance. Using default values.";
+        } else {
+            sourceBuckets.setMinDistance(settingsBucketDistance);
+            sourceBuckets.setCellSize(settingsBucketCellSize);
+        }
+
+        qCDebug(audio) << "Shared HRTF buckets:" << (sourceBuckets.isEnabled() ? "enabled" : "disabled")
+            << "Distance:" << sourceBuckets.getMinDistance() << "Cell Size:" << sourceBuckets.getCellSize();
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -674,6 +716,24 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString MAX_AUDIBLE_DISTANCE = "max_audible_distance";
+        if (audioEnvGroupObject[MAX_AUDIBLE_DISTANCE].isString()) {
+            bool ok = false;
+            float maxAudibleDistance = audioEnvGroupObject[MAX_AUDIBLE_DISTANCE].toString().toFloat(&ok);
+            if (ok && maxAudibleDistance >= 0.0f && maxAudibleDistance != _workerSharedData.spatialIndex.getRadius()) {
+                _workerSharedData.spatialIndex.setRadius(maxAudibleDistance);
+                qCDebug(audio) << "Max audible distance changed to" << maxAudibleDistance;
+
+                // the listeners hold the streams that were picked with the old distance, or without one
+                DependencyManager::get<NodeList>()->eachNode([](const SharedNodePointer& node) {
+                    auto clientData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+                    if (clientData) {
+                        clientData->resetStreams();
+                    }
+                });
+            }
+        }
+
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
             bool ok = false;
@@ -357,13 +357,18 @@ void AudioMixerClientData::removeAgentAvatarAudioStream() {
 
         // Clear mixing structures so that they get recreated with up to date
         // data if the stream comes back
-        setHasReceivedFirstMix(false);
-        _streams.skipped.clear();
-        _streams.inactive.clear();
-        _streams.active.clear();
+        resetStreams();
     }
 }
 
+void AudioMixerClientData::resetStreams() {
+    setHasReceivedFirstMix(false);
+    _streams.skipped.clear();
+    _streams.inactive.clear();
+    _streams.active.clear();
+    _nearbyStreams.clear();
+}
+
 int AudioMixerClientData::parseData(ReceivedMessage& message) {
     PacketType packetType = message.getType();
 
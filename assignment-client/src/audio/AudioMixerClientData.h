@@ -13,6 +13,7 @@
 #define hifi_AudioMixerClientData_h
 
 #include <queue>
+#include <unordered_map>
 
 #if !defined(Q_MOC_RUN)
 #include <tbb/concurrent_vector.h>
@@ -30,6 +31,7 @@
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
+#include "AudioMixerSpatialIndex.h"
 
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
@@ -59,6 +61,9 @@ public:
 
     void removeAgentAvatarAudioStream();
 
+    // drops the streams picked for this listener, so that its next mix picks them all again
+    void resetStreams();
+
     // packet parsers
     int parseData(ReceivedMessage& message) override;
     void processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams);
@@ -138,6 +143,18 @@ public:
 
     Streams& getStreams() { return _streams; }
 
+    // per-listener HRTF state for the shared source buckets this listener renders
+    struct BucketHRTF {
+        std::unique_ptr<AudioHRTF> hrtf { new AudioHRTF };
+        unsigned int lastFrame { 0 };
+    };
+    using BucketHRTFs = std::unordered_map<uint64_t, BucketHRTF>;
+
+    BucketHRTFs& getBucketHRTFs() { return _bucketHRTFs; }
+
+    // streams that were within the audible radius of this listener on the last mix
+    AudioMixerSpatialIndex::Entries& getNearbyStreams() { return _nearbyStreams; }
+
     // thread-safe, called from AudioMixerWorker(s) while processing ignore packets for other nodes
     void ignoredByNode(QUuid nodeID);
     void unignoredByNode(QUuid nodeID);
@@ -185,6 +202,8 @@ private:
     bool containsValidPosition(ReceivedMessage& message) const;
 
     Streams _streams;
+    BucketHRTFs _bucketHRTFs;
+    AudioMixerSpatialIndex::Entries _nearbyStreams;
 
     quint16 _outgoingMixedAudioSequenceNumber;
 
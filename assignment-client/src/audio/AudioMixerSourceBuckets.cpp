@@ -0,0 +1,156 @@
+//
+//  AudioMixerSourceBuckets.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerSourceBuckets.h"
+
+#include <algorithm>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+#include "AudioMixerClientData.h"
+#include "InjectedAudioStream.h"
+
+static const int CELL_COORDINATE_BITS = 20;
+static const int32_t CELL_COORDINATE_OFFSET = 1 << (CELL_COORDINATE_BITS - 1);
+static const uint64_t CELL_COORDINATE_MASK = (1 << CELL_COORDINATE_BITS) - 1;
+static const int FACING_SECTOR_SHIFT = 3 * CELL_COORDINATE_BITS;
+static const int TYPE_SHIFT = FACING_SECTOR_SHIFT + 2;
+
+static const float SECTOR_ANGLE = TWO_PI / AudioMixerSourceBuckets::NUM_FACING_SECTORS;
+
+static int computeFacingSector(const glm::quat& orientation) {
+    // yaw of the forward (UNIT_NEG_Z) direction, projected onto the XZ plane
+    glm::vec3 forward = orientation * Vectors::UNIT_NEG_Z;
+    float yaw = atan2f(-forward.x, -forward.z);
+    int sector = (int)((yaw + PI) / SECTOR_ANGLE);
+    return glm::clamp(sector, 0, AudioMixerSourceBuckets::NUM_FACING_SECTORS - 1);
+}
+
+bool AudioMixerSourceBuckets::isBucketable(const PositionalAudioStream& stream) const {
+    // stereo sources bypass the HRTF, and sources repeating with fade need per-listener handling
+    return _isEnabled && !stream.isStereo() && stream.lastPopSucceeded() && !stream.getLastPopOutput().isNull();
+}
+
+AudioMixerSourceBuckets::BucketKey AudioMixerSourceBuckets::computeKey(const PositionalAudioStream& stream) const {
+    glm::ivec3 cell = glm::ivec3(glm::floor(stream.getPosition() / _cellSize));
+
+    BucketKey key = 0;
+    for (int i = 0; i < 3; ++i) {
+        key |= ((uint64_t)(cell[i] + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << (i * CELL_COORDINATE_BITS);
+    }
+
+    // injectors are omni-directional, only avatars are split by facing
+    if (stream.getType() == PositionalAudioStream::Microphone) {
+        key |= (uint64_t)computeFacingSector(stream.getOrientation()) << FACING_SECTOR_SHIFT;
+    }
+    key |= (uint64_t)stream.getType() << TYPE_SHIFT;
+
+    return key;
+}
+
+const AudioMixerSourceBuckets::Bucket* AudioMixerSourceBuckets::find(BucketKey key) const {
+    auto it = _keys.find(key);
+    return it != _keys.end() ? &_buckets[it->second] : nullptr;
+}
+
+void AudioMixerSourceBuckets::prepare(ConstIter begin, ConstIter end) {
+    _keys.clear();
+    _numBuckets = 0;
+
+    if (!_isEnabled) {
+        return;
+    }
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (nodeData) {
+            for (auto& stream : nodeData->getAudioStreams()) {
+                if (isBucketable(*stream)) {
+                    addStream(*stream);
+                }
+            }
+        }
+    });
+
+    finalize();
+}
+
+void AudioMixerSourceBuckets::addStream(const PositionalAudioStream& stream) {
+    BucketKey key = computeKey(stream);
+
+    auto it = _keys.find(key);
+    int index;
+    if (it == _keys.end()) {
+        index = _numBuckets++;
+        _keys[key] = index;
+
+        if (index >= (int)_buckets.size()) {
+            _buckets.emplace_back();
+            _accumulators.emplace_back();
+            _positionSums.emplace_back();
+        }
+
+        Bucket& bucket = _buckets[index];
+        bucket.type = stream.getType();
+        bucket.numStreams = 0;
+        if (bucket.type == PositionalAudioStream::Microphone) {
+            float yaw = -PI + (computeFacingSector(stream.getOrientation()) + 0.5f) * SECTOR_ANGLE;
+            bucket.orientation = glm::angleAxis(yaw, Vectors::UNIT_Y);
+        } else {
+            bucket.orientation = glm::quat();
+        }
+        _accumulators[index].fill(0.0f);
+        _positionSums[index] = glm::vec3(0.0f);
+    } else {
+        index = it->second;
+    }
+
+    // injector attenuation does not depend on the listener, so it is applied once here
+    float gain = 1.0f;
+    if (stream.getType() == PositionalAudioStream::Injector) {
+        gain = static_cast<const InjectedAudioStream&>(stream).getAttenuationRatio();
+    }
+
+    int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    AudioRingBuffer::ConstIterator streamPopOutput = stream.getLastPopOutput();
+    streamPopOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    Accumulator& accumulator = _accumulators[index];
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+        accumulator[i] += gain * samples[i];
+    }
+
+    _positionSums[index] += stream.getPosition();
+    ++_buckets[index].numStreams;
+}
+
+void AudioMixerSourceBuckets::finalize() {
+    const float MAX_SAMPLE = (float)AudioConstants::MAX_SAMPLE_VALUE;
+
+    for (int index = 0; index < _numBuckets; ++index) {
+        Bucket& bucket = _buckets[index];
+        const Accumulator& accumulator = _accumulators[index];
+
+        bucket.position = _positionSums[index] / (float)bucket.numStreams;
+
+        // the HRTF takes 16-bit input, so scale down loud pre-mixes and compensate in the render gain
+        float peak = 0.0f;
+        for (float sample : accumulator) {
+            peak = std::max(peak, fabsf(sample));
+        }
+        float scale = (peak > MAX_SAMPLE) ? MAX_SAMPLE / peak : 1.0f;
+        bucket.gainCompensation = 1.0f / scale;
+
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+            bucket.samples[i] = (int16_t)lrintf(accumulator[i] * scale);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+//
+//  AudioMixerSourceBuckets.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerSourceBuckets_h
+#define hifi_AudioMixerSourceBuckets_h
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <NodeList.h>
+#include <PositionalAudioStream.h>
+
+// Shared, per-frame pre-mix of mono sources into quantized world-space buckets.
+//
+// Every bucketable source is summed once per frame into the bucket for its grid cell, its type and
+// (for avatars) its quantized facing. Listeners far enough away from a bucket then run a single HRTF render
+// for the whole bucket instead of one per source, so the cost of distant crowds no longer scales with
+// listeners x sources.
+//
+// prepare() is called from the mixer thread before mixing; the buckets are read-only while workers mix.
+class AudioMixerSourceBuckets {
+public:
+    using ConstIter = NodeList::const_iterator;
+    using BucketKey = uint64_t;
+
+    static const int NUM_FACING_SECTORS = 4;
+
+    struct Bucket {
+        glm::vec3 position;         // mean position of the sources in this bucket
+        glm::quat orientation;      // center of the facing sector (avatars only)
+        PositionalAudioStream::Type type;
+        int numStreams { 0 };
+        float gainCompensation { 1.0f }; // undoes the scale applied to fit the pre-mix in 16 bits
+        int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    };
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    void setCellSize(float cellSize) { _cellSize = cellSize; }
+    float getCellSize() const { return _cellSize; }
+
+    // sources closer than this to a listener are always rendered exactly for that listener
+    void setMinDistance(float minDistance) { _minDistance = minDistance; }
+    float getMinDistance() const { return _minDistance; }
+
+    // build this frame's buckets from every stream of every node in [begin, end)
+    void prepare(ConstIter begin, ConstIter end);
+
+    // true if the stream has been summed into a bucket this frame
+    bool isBucketable(const PositionalAudioStream& stream) const;
+    BucketKey computeKey(const PositionalAudioStream& stream) const;
+
+    const Bucket* find(BucketKey key) const;
+    int numBuckets() const { return _numBuckets; }
+
+private:
+    using Accumulator = std::array<float, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL>;
+
+    void addStream(const PositionalAudioStream& stream);
+    void finalize();
+
+    bool _isEnabled { false };
+    float _cellSize { 4.0f };
+    float _minDistance { 20.0f };
+
+    // bucket storage is retained between frames to avoid reallocating it every frame
+    std::unordered_map<BucketKey, int> _keys;
+    std::vector<Bucket> _buckets;
+    std::vector<Accumulator> _accumulators;
+    std::vector<glm::vec3> _positionSums;
+    int _numBuckets { 0 };
+};
+
+#endif // hifi_AudioMixerSourceBuckets_h
@@ -0,0 +1,95 @@
+//
+//  AudioMixerSpatialIndex.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerSpatialIndex.h"
+
+#include <algorithm>
+
+#include <glm/gtx/norm.hpp>
+
+#include "AudioMixerClientData.h"
+
+static const int CELL_COORDINATE_BITS = 21;
+static const int32_t CELL_COORDINATE_OFFSET = 1 << (CELL_COORDINATE_BITS - 1);
+static const uint64_t CELL_COORDINATE_MASK = (1 << CELL_COORDINATE_BITS) - 1;
+
+AudioMixerSpatialIndex::CellKey AudioMixerSpatialIndex::computeKey(const glm::ivec3& cell) const {
+    CellKey key = 0;
+    for (int i = 0; i < 3; ++i) {
+        key |= ((uint64_t)(cell[i] + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << (i * CELL_COORDINATE_BITS);
+    }
+    return key;
+}
+
+glm::ivec3 AudioMixerSpatialIndex::computeCell(const glm::vec3& position) const {
+    // cells are as large as the radius, so a query never needs more than the 27 neighbouring cells
+    return glm::ivec3(glm::floor(position / _radius));
+}
+
+void AudioMixerSpatialIndex::build(ConstIter begin, ConstIter end) {
+    _entries.clear();
+    _cells.clear();
+
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (nodeData) {
+            for (auto& stream : nodeData->getAudioStreams()) {
+                NodeIDStreamID nodeStreamID(node->getUUID(), node->getLocalID(), stream->getStreamIdentifier());
+                _entries.emplace_back(computeKey(computeCell(stream->getPosition())), Entry(nodeStreamID, stream.get()));
+            }
+        }
+    });
+
+    std::sort(_entries.begin(), _entries.end(), [](const std::pair<CellKey, Entry>& a, const std::pair<CellKey, Entry>& b) {
+        return a.first < b.first;
+    });
+
+    int first = 0;
+    int numEntries = (int)_entries.size();
+    while (first < numEntries) {
+        int last = first + 1;
+        while (last < numEntries && _entries[last].first == _entries[first].first) {
+            ++last;
+        }
+        _cells[_entries[first].first] = { first, last };
+        first = last;
+    }
+}
+
+void AudioMixerSpatialIndex::query(const glm::vec3& position, Entries& results) const {
+    results.clear();
+
+    float radius2 = _radius * _radius;
+    glm::ivec3 center = computeCell(position);
+    glm::ivec3 cell;
+    for (cell.x = center.x - 1; cell.x <= center.x + 1; ++cell.x) {
+        for (cell.y = center.y - 1; cell.y <= center.y + 1; ++cell.y) {
+            for (cell.z = center.z - 1; cell.z <= center.z + 1; ++cell.z) {
+                auto it = _cells.find(computeKey(cell));
+                if (it == _cells.end()) {
+                    continue;
+                }
+
+                for (int i = it->second.first; i < it->second.second; ++i) {
+                    const Entry& entry = _entries[i].second;
+                    if (glm::distance2(entry.positionalStream->getPosition(), position) <= radius2) {
+                        results.push_back(entry);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(results.begin(), results.end());
+}
@@ -0,0 +1,70 @@
+//
+//  AudioMixerSpatialIndex.h
+//  assignment-client/src/audio
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerSpatialIndex_h
+#define hifi_AudioMixerSpatialIndex_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+#include <PositionalAudioStream.h>
+
+// Per-frame uniform grid of every audio stream position in the domain.
+//
+// When an audible radius is configured, the grid is rebuilt once per frame before mixing, and each listener
+// only considers the streams returned by query() instead of every stream in the domain.
+// build() is called from the mixer thread; query() is thread-safe while workers mix.
+class AudioMixerSpatialIndex {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Entry {
+        NodeIDStreamID nodeStreamID;
+        PositionalAudioStream* positionalStream;
+
+        Entry(const NodeIDStreamID& nodeStreamID, PositionalAudioStream* positionalStream) :
+            nodeStreamID(nodeStreamID), positionalStream(positionalStream) {};
+
+        // entries are ordered by node then stream so that consecutive frames can be diffed
+        bool operator<(const Entry& other) const {
+            return nodeStreamID.nodeID < other.nodeStreamID.nodeID ||
+                (nodeStreamID.nodeID == other.nodeStreamID.nodeID && nodeStreamID.streamID < other.nodeStreamID.streamID);
+        }
+    };
+    using Entries = std::vector<Entry>;
+
+    // a radius of 0 disables the index
+    void setRadius(float radius) { _radius = radius; }
+    float getRadius() const { return _radius; }
+    bool isEnabled() const { return _radius > 0.0f; }
+
+    // rebuild the grid from every stream of every node in [begin, end)
+    void build(ConstIter begin, ConstIter end);
+
+    // replace results with the streams within the radius of position, sorted by node and stream
+    void query(const glm::vec3& position, Entries& results) const;
+
+    int numEntries() const { return (int)_entries.size(); }
+
+private:
+    using CellKey = uint64_t;
+    CellKey computeKey(const glm::ivec3& cell) const;
+    glm::ivec3 computeCell(const glm::vec3& position) const;
+
+    float _radius { 0.0f };
+
+    std::vector<std::pair<CellKey, Entry>> _entries; // sorted by cell
+    std::unordered_map<CellKey, std::pair<int, int>> _cells; // [first, last) ranges into _entries
+};
+
+#endif // hifi_AudioMixerSpatialIndex_h
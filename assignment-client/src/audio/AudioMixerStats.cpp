@@ -21,6 +21,9 @@ void AudioMixerStats::reset() {
     hrtfRenders = 0;
     hrtfResets = 0;
     hrtfUpdates = 0;
+    hrtfBucketRenders = 0;
+    bucketedStreams = 0;
+    sumSourceBuckets = 0;
 
     manualStereoMixes = 0;
     manualEchoMixes = 0;
@@ -51,6 +54,9 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfRenders += otherStats.hrtfRenders;
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
+    hrtfBucketRenders += otherStats.hrtfBucketRenders;
+    bucketedStreams += otherStats.bucketedStreams;
+    sumSourceBuckets += otherStats.sumSourceBuckets;
 
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
@@ -26,6 +26,9 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
+    int hrtfBucketRenders { 0 };
+    int bucketedStreams { 0 };
+    int sumSourceBuckets { 0 };
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
@@ -52,9 +52,14 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
 inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
+inline float computeSourceGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
+        PositionalAudioStream::Type sourceType, const glm::vec3& sourcePosition, const glm::quat& sourceOrientation,
+        const glm::vec3& relativePosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
 
+static const int HRTF_DATASET_INDEX = 1;
+
 void AudioMixerWorker::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
@@ -178,6 +183,53 @@ private:
 };
 
 
+void AudioMixerWorker::addNearbyStreams(Node& listener, AudioMixerClientData& listenerData,
+                                        const AvatarAudioStream& listenerAudioStream) {
+    auto& ignoredNodeIDs = listener.getIgnoredNodeIDs();
+    auto& ignoringNodeIDs = listenerData.getIgnoringNodeIDs();
+
+    auto& streams = listenerData.getStreams();
+    auto& previousNearbyStreams = listenerData.getNearbyStreams();
+
+    _sharedData.spatialIndex.query(listenerAudioStream.getPosition(), _nearbyStreams);
+
+    // both lists are sorted, so a single walk finds the streams that just came within range
+    auto previous = previousNearbyStreams.cbegin();
+    for (const auto& nearbyStream : _nearbyStreams) {
+        while (previous != previousNearbyStreams.cend() && *previous < nearbyStream) {
+            ++previous;
+        }
+
+        bool wasNearby = previous != previousNearbyStreams.cend() && !(nearbyStream < *previous) &&
+            !shouldBeRemoved(nearbyStream.nodeStreamID, _sharedData);
+        if (wasNearby) {
+            continue;
+        }
+
+        const auto& nodeID = nearbyStream.nodeStreamID.nodeID;
+        bool ignoredByListener = contains(ignoredNodeIDs, nodeID);
+        bool ignoringListener = contains(ignoringNodeIDs, nodeID);
+
+        if (ignoredByListener || ignoringListener) {
+            streams.skipped.emplace_back(nearbyStream.nodeStreamID, nearbyStream.positionalStream);
+
+            // pre-populate ignored and ignoring flags for this stream
+            streams.skipped.back().ignoredByListener = ignoredByListener;
+            streams.skipped.back().ignoringListener = ignoringListener;
+        } else {
+            streams.active.emplace_back(nearbyStream.nodeStreamID, nearbyStream.positionalStream);
+        }
+    }
+
+    previousNearbyStreams = _nearbyStreams;
+    listenerData.setHasReceivedFirstMix(true);
+}
+
+bool AudioMixerWorker::isNearby(const NodeIDStreamID& nodeStreamID) const {
+    return std::binary_search(_nearbyStreams.cbegin(), _nearbyStreams.cend(),
+                              AudioMixerSpatialIndex::Entry(nodeStreamID, nullptr));
+}
+
 void AudioMixerWorker::addStreams(Node& listener, AudioMixerClientData& listenerData) {
     auto& ignoredNodeIDs = listener.getIgnoredNodeIDs();
     auto& ignoringNodeIDs = listenerData.getIgnoringNodeIDs();
@@ -229,9 +281,13 @@ void AudioMixerWorker::addStreams(Node& listener, AudioMixerClientData& listener
     }
 }
 
+bool shouldBeRemoved(const NodeIDStreamID& nodeStreamID, const AudioMixerWorker::SharedData& sharedData) {
+    return (contains(sharedData.removedNodes, nodeStreamID.nodeLocalID) ||
+            contains(sharedData.removedStreams, nodeStreamID));
+};
+
 bool shouldBeRemoved(const MixableStream& stream, const AudioMixerWorker::SharedData& sharedData) {
-    return (contains(sharedData.removedNodes, stream.nodeStreamID.nodeLocalID) ||
-            contains(sharedData.removedStreams, stream.nodeStreamID));
+    return shouldBeRemoved(stream.nodeStreamID, sharedData);
 };
 
 bool shouldBeInactive(MixableStream& stream) {
@@ -318,11 +374,21 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
 
     auto& streams = listenerData->getStreams();
 
-    addStreams(*listener, *listenerData);
+    // with a spatial index, listeners only hold the streams within the audible radius
+    bool useSpatialIndex = _sharedData.spatialIndex.isEnabled();
+    if (useSpatialIndex) {
+        addNearbyStreams(*listener, *listenerData, *listenerAudioStream);
+    } else {
+        addStreams(*listener, *listenerData);
+    }
+
+    auto shouldBeDropped = [&](const MixableStream& stream) {
+        return shouldBeRemoved(stream, _sharedData) || (useSpatialIndex && !isNearby(stream.nodeStreamID));
+    };
 
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
-        if (shouldBeRemoved(stream, _sharedData)) {
+        if (shouldBeDropped(stream)) {
             return true;
         }
 
@@ -346,7 +412,7 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
 
     // Process inactive streams
     erase_if(streams.inactive, [&](MixableStream& stream) {
-        if (shouldBeRemoved(stream, _sharedData)) {
+        if (shouldBeDropped(stream)) {
             return true;
         }
 
@@ -371,7 +437,7 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
 
     // Process active streams
     erase_if(streams.active, [&](MixableStream& stream) {
-        if (shouldBeRemoved(stream, _sharedData)) {
+        if (shouldBeDropped(stream)) {
             return true;
         }
 
@@ -460,6 +526,9 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
         });
     }
 
+    // render the distant streams that addStream deferred, sharing the pre-mixed buckets where possible
+    renderDeferredStreams(*listenerAudioStream, *listenerData);
+
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
@@ -510,8 +579,6 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
                                                    relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
-    const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
@@ -566,6 +633,16 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
 
         ++stats.manualEchoMixes;
     } else {
+        auto& sourceBuckets = _sharedData.sourceBuckets;
+
+        // distant sources go through the shared buckets, unless this listener treats them specially
+        // silent sources keep their exact render so that their HRTF tail is flushed
+        if (!isSoloing && gain > 0.0f && distance >= sourceBuckets.getMinDistance() &&
+            mixableStream.hrtf->getGainAdjustment() == HRTF_GAIN && sourceBuckets.isBucketable(*streamToAdd)) {
+            _deferredStreams.push_back({ sourceBuckets.computeKey(*streamToAdd), mixableStream.hrtf.get(),
+                                         streamToAdd, azimuth, distance, gain });
+            return;
+        }
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
@@ -601,6 +678,72 @@ void AudioMixerWorker::resetHRTFState(AudioMixerClientData::MixableStream& mixab
     ++stats.hrtfResets;
 }
 
+void AudioMixerWorker::renderDeferredStreams(AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData) {
+    auto& bucketHRTFs = listenerData.getBucketHRTFs();
+
+    std::sort(_deferredStreams.begin(), _deferredStreams.end(), [](const DeferredStream& a, const DeferredStream& b) {
+        return a.key < b.key;
+    });
+
+    auto first = _deferredStreams.begin();
+    while (first != _deferredStreams.end()) {
+        auto key = first->key;
+        auto last = std::find_if(first, _deferredStreams.end(), [key](const DeferredStream& stream) {
+            return stream.key != key;
+        });
+        int numStreams = (int)(last - first);
+
+        // a bucket can only replace the listener's streams if it holds exactly those streams,
+        // i.e. none of its sources are skipped, throttled, or close enough to need an exact render
+        auto bucket = _sharedData.sourceBuckets.find(key);
+        if (bucket && bucket->numStreams == numStreams) {
+            glm::vec3 relativePosition = bucket->position - listeningNodeStream.getPosition();
+            float distance = glm::max(glm::length(relativePosition), EPSILON);
+            float gain = bucket->gainCompensation *
+                computeSourceGain(listenerData.getMasterAvatarGain(), listenerData.getMasterInjectorGain(),
+                                  listeningNodeStream, bucket->type, bucket->position, bucket->orientation,
+                                  relativePosition, distance);
+            float azimuth = computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+
+            auto& bucketHRTF = bucketHRTFs[key];
+            bucketHRTF.lastFrame = _frame;
+
+            memcpy(_bufferSamples, bucket->samples, sizeof(bucket->samples));
+            bucketHRTF.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            ++stats.hrtfBucketRenders;
+            stats.bucketedStreams += numStreams;
+
+            // the per-stream state restarts from silence if the stream returns to an exact render
+            std::for_each(first, last, [](const DeferredStream& stream) {
+                stream.hrtf->reset();
+            });
+        } else {
+            std::for_each(first, last, [&](const DeferredStream& stream) {
+                AudioRingBuffer::ConstIterator streamPopOutput = stream.positionalStream->getLastPopOutput();
+                streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+                stream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, stream.azimuth, stream.distance,
+                                    stream.gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                ++stats.hrtfRenders;
+            });
+        }
+
+        first = last;
+    }
+
+    _deferredStreams.clear();
+
+    // drop the state of buckets that this listener no longer renders
+    for (auto it = bucketHRTFs.begin(); it != bucketHRTFs.end();) {
+        if (it->second.lastFrame != _frame) {
+            it = bucketHRTFs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -737,12 +880,29 @@ float computeGain(float masterAvatarGain,
     // injector: apply attenuation
     if (streamToAdd.getType() == PositionalAudioStream::Injector) {
         gain *= reinterpret_cast<const InjectedAudioStream*>(&streamToAdd)->getAttenuationRatio();
-        // apply master gain
+    }
+
+    return gain * computeSourceGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, streamToAdd.getType(),
+                                    streamToAdd.getPosition(), streamToAdd.getOrientation(), relativePosition, distance);
+}
+
+float computeSourceGain(float masterAvatarGain,
+                        float masterInjectorGain,
+                        const AvatarAudioStream& listeningNodeStream,
+                        PositionalAudioStream::Type sourceType,
+                        const glm::vec3& sourcePosition,
+                        const glm::quat& sourceOrientation,
+                        const glm::vec3& relativePosition,
+                        float distance) {
+    float gain = 1.0f;
+
+    // injector: apply master gain
+    if (sourceType == PositionalAudioStream::Injector) {
         gain *= masterInjectorGain;
 
     // avatar: apply fixed off-axis attenuation to make them quieter as they turn away
-    } else if (streamToAdd.getType() == PositionalAudioStream::Microphone) {
-        glm::vec3 rotatedListenerPosition = glm::inverse(streamToAdd.getOrientation()) * relativePosition;
+    } else if (sourceType == PositionalAudioStream::Microphone) {
+        glm::vec3 rotatedListenerPosition = glm::inverse(sourceOrientation) * relativePosition;
 
         // source directivity is based on angle of emission, in local coordinates
         glm::vec3 direction = glm::normalize(rotatedListenerPosition);
@@ -764,7 +924,7 @@ float computeGain(float masterAvatarGain,
     // find distance attenuation coefficient
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
-        if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
+        if (audioZones[settings.source].area.contains(sourcePosition) &&
             audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
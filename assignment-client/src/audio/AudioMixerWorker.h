@@ -25,6 +25,8 @@
 #include <PositionalAudioStream.h>
 
 #include "AudioMixerClientData.h"
+#include "AudioMixerSourceBuckets.h"
+#include "AudioMixerSpatialIndex.h"
 #include "AudioMixerStats.h"
 
 class AvatarAudioStream;
@@ -38,6 +40,8 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerSourceBuckets sourceBuckets;
+        AudioMixerSpatialIndex spatialIndex;
     };
 
     AudioMixerWorker(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -68,11 +72,26 @@ private:
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
 
+    // distant sources deferred by addStream, rendered through the shared source buckets when possible
+    struct DeferredStream {
+        AudioMixerSourceBuckets::BucketKey key;
+        AudioHRTF* hrtf;
+        const PositionalAudioStream* positionalStream;
+        float azimuth;
+        float distance;
+        float gain;
+    };
+    void renderDeferredStreams(AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData);
+
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
+    void addNearbyStreams(Node& listener, AudioMixerClientData& listenerData, const AvatarAudioStream& listenerAudioStream);
+    bool isNearby(const NodeIDStreamID& nodeStreamID) const;
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    std::vector<DeferredStream> _deferredStreams;
+    AudioMixerSpatialIndex::Entries _nearbyStreams;
 
     // frame state
     ConstIter _begin;
@@ -13,19 +13,27 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <chrono>
+
+#include <PortableHighResolutionClock.h>
 
 void AudioMixerWorkerThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        // iterate over our chunk of nodes, then over whatever we can steal from the other threads
+        uint32_t index;
+        while (_function && _pool._scheduler.next(_index, index)) {
+            auto start = p_high_resolution_clock::now();
+            (this->*_function)(_pool._nodes[index]);
+            auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start);
+
+            _pool._measuredCosts[index] = cost.count();
+            _busyTime += cost.count();
         }
 
         bool stopping = _stop;
-        notify(stopping);
+        notify();
         if (stopping) {
             return;
         }
@@ -33,14 +41,7 @@ void AudioMixerWorkerThread::run() {
 }
 
 void AudioMixerWorkerThread::wait() {
-    {
-        Lock lock(_pool._mutex);
-        _pool._workerCondition.wait(lock, [&] {
-            assert(_pool._numStarted <= _pool._numThreads);
-            return _pool._numStarted != _pool._numThreads;
-        });
-        ++_pool._numStarted;
-    }
+    _frame = _pool._barrier.waitForFrame(_frame);
 
     if (_pool._configure) {
         _pool._configure(*this);
@@ -48,26 +49,14 @@ void AudioMixerWorkerThread::wait() {
     _function = _pool._function;
 }
 
-void AudioMixerWorkerThread::notify(bool stopping) {
-    {
-        Lock lock(_pool._mutex);
-        assert(_pool._numFinished < _pool._numThreads);
-        ++_pool._numFinished;
-        if (stopping) {
-            ++_pool._numStopped;
-        }
-    }
-    _pool._poolCondition.notify_one();
-}
-
-bool AudioMixerWorkerThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+void AudioMixerWorkerThread::notify() {
+    _pool._barrier.finish();
 }
 
 void AudioMixerWorkerPool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerWorker::processPackets;
     _configure = [](AudioMixerWorker& worker) {};
-    run(begin, end);
+    run(begin, end, _packetsCosts);
 }
 
 void AudioMixerWorkerPool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
@@ -76,35 +65,52 @@ void AudioMixerWorkerPool::mix(ConstIter begin, ConstIter end, unsigned int fram
         worker.configureMix(_begin, _end, frame, numToRetain);
     };
 
-    run(begin, end);
+    run(begin, end, _mixCosts);
 }
 
-void AudioMixerWorkerPool::run(ConstIter begin, ConstIter end) {
+void AudioMixerWorkerPool::run(ConstIter begin, ConstIter end, NodeCosts& nodeCosts) {
+    auto start = p_high_resolution_clock::now();
+
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // gather the nodes, estimating their cost from the last frame (new nodes get the average cost)
+    _nodes.assign(_begin, _end);
+    uint64_t averageCost = 1;
+    if (!nodeCosts.empty()) {
+        uint64_t totalCost = 0;
+        for (const auto& nodeCost : nodeCosts) {
+            totalCost += nodeCost.second;
+        }
+        averageCost = std::max(totalCost / nodeCosts.size(), (uint64_t)1);
+    }
 
-    {
-        Lock lock(_mutex);
+    _estimatedCosts.resize(_nodes.size());
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        auto it = nodeCosts.find(_nodes[i]->getUUID());
+        _estimatedCosts[i] = (it != nodeCosts.end()) ? std::max(it->second, (uint64_t)1) : averageCost;
+    }
+    _measuredCosts.assign(_nodes.size(), 0);
 
-        // run
-        _numStarted = _numFinished = 0;
-        _workerCondition.notify_all();
+    // run
+    _scheduler.reset(_numThreads, _estimatedCosts);
+    _barrier.start(_numThreads);
 
-        // wait
-        _poolCondition.wait(lock, [&] {
-            assert(_numFinished <= _numThreads);
-            return _numFinished == _numThreads;
-        });
+    // wait
+    _barrier.wait();
 
-        assert(_numStarted == _numThreads);
+    // keep this frame's costs for the next one
+    nodeCosts.clear();
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        nodeCosts[_nodes[i]->getUUID()] = _measuredCosts[i];
     }
 
-    assert(_queue.empty());
+    // release the nodes until the next frame
+    _nodes.clear();
+
+    _numSteals += _scheduler.getNumSteals();
+    _runTime += std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start).count();
+    ++_numRuns;
 }
 
 void AudioMixerWorkerPool::each(std::function<void(AudioMixerWorker& worker)> functor) {
@@ -126,6 +132,19 @@ void AudioMixerWorkerPool::queueStats(QJsonObject& stats) {
 }
 #endif // DEBUG_EVENT_QUEUE
 
+void AudioMixerWorkerPool::utilizationStats(QJsonObject& stats) {
+    for (auto& worker : _workers) {
+        float utilization = (_runTime > 0) ? (float)worker->_busyTime / (float)_runTime : 0.0f;
+        stats[QString("thread_%1").arg(worker->_index)] = utilization;
+        worker->_busyTime = 0;
+    }
+    stats["steals_per_run"] = (_numRuns > 0) ? (float)_numSteals / (float)_numRuns : 0.0f;
+
+    _runTime = 0;
+    _numRuns = 0;
+    _numSteals = 0;
+}
+
 void AudioMixerWorkerPool::setNumThreads(int numThreads) {
     // clamp to allowed size
     {
@@ -151,12 +170,10 @@ void AudioMixerWorkerPool::resize(int numThreads) {
 
     qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
 
-    Lock lock(_mutex);
-
     if (numThreads > _numThreads) {
-        // start new workers
-        for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto worker = new AudioMixerWorkerThread(*this, _workerSharedData);
+        // start new workers, waiting for the next frame
+        for (int i = _numThreads; i < numThreads; ++i) {
+            auto worker = new AudioMixerWorkerThread(*this, _workerSharedData, i, _barrier.getFrame());
             worker->start();
             _workers.emplace_back(worker);
         }
@@ -170,16 +187,12 @@ void AudioMixerWorkerPool::resize(int numThreads) {
             ++worker;
         }
 
-        // ...cycle them until they do stop...
-        _numStopped = 0;
-        while (_numStopped != (_numThreads - numThreads)) {
-            _numStarted = _numFinished = _numStopped;
-            _workerCondition.notify_all();
-            _poolCondition.wait(lock, [&] {
-                assert(_numFinished <= _numThreads);
-                return _numFinished == _numThreads;
-            });
-        }
+        // ...cycle an empty frame so they stop...
+        _function = nullptr;
+        _configure = nullptr;
+        _scheduler.reset(_numThreads, {});
+        _barrier.start(_numThreads);
+        _barrier.wait();
 
         // ...wait for threads to finish...
         worker = extraBegin;
@@ -194,6 +207,6 @@ void AudioMixerWorkerPool::resize(int numThreads) {
         _workers.erase(extraBegin, _workers.end());
     }
 
-    _numThreads = _numStarted = _numFinished = numThreads;
+    _numThreads = numThreads;
     assert(_numThreads == (int)_workers.size());
 }
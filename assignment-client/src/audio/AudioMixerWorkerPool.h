@@ -12,13 +12,15 @@
 #ifndef hifi_AudioMixerWorkerPool_h
 #define hifi_AudioMixerWorkerPool_h
 
-#include <condition_variable>
-#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <QThread>
+#include <QtCore/QJsonObject>
+#include <shared/FrameBarrier.h>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
+#include <shared/WorkStealingScheduler.h>
+#include <UUIDHasher.h>
 
 #include "AudioMixerWorker.h"
 
@@ -27,12 +29,10 @@ class AudioMixerWorkerPool;
 class AudioMixerWorkerThread : public QThread, public AudioMixerWorker {
     Q_OBJECT
     using ConstIter = NodeList::const_iterator;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
 
 public:
-    AudioMixerWorkerThread(AudioMixerWorkerPool& pool, AudioMixerWorker::SharedData& sharedData)
-        : AudioMixerWorker(sharedData), _pool(pool) {}
+    AudioMixerWorkerThread(AudioMixerWorkerPool& pool, AudioMixerWorker::SharedData& sharedData, int index, uint32_t frame)
+        : AudioMixerWorker(sharedData), _pool(pool), _index(index), _frame(frame) {}
 
     void run() override final;
 
@@ -40,22 +40,22 @@ private:
     friend class AudioMixerWorkerPool;
 
     void wait();
-    void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
+    void notify();
 
     AudioMixerWorkerPool& _pool;
     void (AudioMixerWorker::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
+
+    const int _index;
+    uint32_t _frame;
+    uint64_t _busyTime { 0 }; // nanoseconds spent on nodes, read by the pool between frames
 };
 
 // Worker pool for audio mixers
 //   AudioMixerWorkerPool is not thread-safe! It should be instantiated and used from a single thread.
+//   Nodes are split into per-thread chunks balanced by each node's cost on the last frame,
+//   and threads that run out of work steal from the others.
 class AudioMixerWorkerPool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-    using ConditionVariable = std::condition_variable;
-
 public:
     using ConstIter = NodeList::const_iterator;
 
@@ -76,35 +76,45 @@ public:
     void queueStats(QJsonObject& stats);
 #endif
 
+    // per-thread utilization since the last call
+    void utilizationStats(QJsonObject& stats);
+
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    using NodeCosts = std::unordered_map<QUuid, uint64_t, UUIDHasher>;
+
+    void run(ConstIter begin, ConstIter end, NodeCosts& nodeCosts);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerWorkerThread>> _workers;
 
-    friend void AudioMixerWorkerThread::wait();
-    friend void AudioMixerWorkerThread::notify(bool stopping);
-    friend bool AudioMixerWorkerThread::try_pop(SharedNodePointer& node);
+    friend class AudioMixerWorkerThread;
 
     // synchronization state
-    Mutex _mutex;
-    ConditionVariable _workerCondition;
-    ConditionVariable _poolCondition;
+    FrameBarrier _barrier;
+    WorkStealingScheduler _scheduler;
     void (AudioMixerWorker::*_function)(const SharedNodePointer& node);
     std::function<void(AudioMixerWorker&)> _configure;
     int _numThreads { 0 };
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    std::vector<SharedNodePointer> _nodes;
+    std::vector<uint64_t> _estimatedCosts;
+    std::vector<uint64_t> _measuredCosts; // written by the thread that processed each node
     ConstIter _begin;
     ConstIter _end;
 
+    // nanoseconds spent on each node during the last frame of each job, for balancing the next one
+    NodeCosts _packetsCosts;
+    NodeCosts _mixCosts;
+
+    // utilization stats
+    uint64_t _runTime { 0 };
+    int _numRuns { 0 };
+    int _numSteals { 0 };
+
     AudioMixerWorker::SharedData& _workerSharedData;
 };
 
@@ -0,0 +1,76 @@
+//
+//  AvatarEncodingCache.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEncodingCache.h"
+
+#include <atomic>
+
+#include <GLMHelpers.h>
+#include <SharedUtil.h>
+
+// generations are unique across all caches, so a listener never mistakes a delta of a reconnected avatar for its own
+static std::atomic<uint32_t> nextGeneration { 1 };
+
+// a distance well within each level, only the distance of the viewer from the avatar matters to the encoding
+static const float LEVEL_VIEWER_DISTANCES[NUM_AVATAR_DISTANCE_LEVELS] = {
+    0.0f,
+    (AVATAR_DISTANCE_LEVEL_1 + AVATAR_DISTANCE_LEVEL_2) / 2.0f,
+    (AVATAR_DISTANCE_LEVEL_2 + AVATAR_DISTANCE_LEVEL_3) / 2.0f,
+    (AVATAR_DISTANCE_LEVEL_3 + AVATAR_DISTANCE_LEVEL_4) / 2.0f,
+    (AVATAR_DISTANCE_LEVEL_4 + AVATAR_DISTANCE_LEVEL_5) / 2.0f,
+    AVATAR_DISTANCE_LEVEL_5 * 2.0f
+};
+
+QByteArray AvatarEncodingCache::getKeyframe(const AvatarData& avatar, uint16_t sequenceNumber) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_hasKeyframe || _keyframeSequenceNumber != sequenceNumber) {
+        // sending all data neither reads the last sent time nor the last sent joints
+        QVector<JointData> sentJoints;
+        AvatarDataPacket::SendStatus sendStatus;
+        sendStatus.sendUUID = true;
+        _keyframe = avatar.toByteArray(AvatarData::SendAllData, 0, sentJoints, sendStatus,
+            false, false, glm::vec3(0.0f), &sentJoints);
+
+        _keyframeSequenceNumber = sequenceNumber;
+        _hasKeyframe = true;
+    }
+
+    return _keyframe;
+}
+
+AvatarEncodingCache::Delta AvatarEncodingCache::getDelta(const AvatarData& avatar, uint16_t sequenceNumber,
+                                                         int distanceLevel) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Level& level = _levels[distanceLevel];
+    if (!level.isValid || level.sequenceNumber != sequenceNumber) {
+        Delta& delta = level.delta;
+        delta.baseTime = level.lastEncodeTime;
+        delta.baseJoints = level.sentJoints;
+        delta.baseGeneration = level.isValid ? delta.generation : 0;
+        delta.generation = nextGeneration++;
+
+        // taken before encoding, so that changes made while encoding go out with the next delta
+        quint64 encodeTime = usecTimestampNow();
+
+        glm::vec3 viewerPosition = avatar.getClientGlobalPosition() + LEVEL_VIEWER_DISTANCES[distanceLevel] * Vectors::UNIT_X;
+        AvatarDataPacket::SendStatus sendStatus;
+        sendStatus.sendUUID = true;
+        delta.bytes = avatar.toByteArray(AvatarData::CullSmallData, level.lastEncodeTime, level.sentJoints, sendStatus,
+            false, true, viewerPosition, &level.sentJoints);
+
+        level.lastEncodeTime = encodeTime;
+        level.sequenceNumber = sequenceNumber;
+        level.isValid = true;
+    }
+
+    return level.delta;
+}
@@ -0,0 +1,68 @@
+//
+//  AvatarEncodingCache.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarEncodingCache_h
+#define hifi_AvatarEncodingCache_h
+
+#include <array>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QVector>
+
+#include <AvatarData.h>
+
+// Avatar data of one source avatar, encoded once per received frame and shared by every listener.
+//
+// Instead of a delta against each listener's own last sent joints, every distance level has a single chain of
+// deltas, one per received frame, each numbered by a generation. A listener that holds the previous generation of
+// its distance level is sent the shared delta; any other listener (new, skipped a frame, or changed level) is sent
+// the shared keyframe, which includes all data and does not depend on what the listener already has.
+//
+// Encodings are made lazily by the first listener that needs them in a broadcast, and are thread-safe.
+class AvatarEncodingCache {
+public:
+    struct Delta {
+        QByteArray bytes;
+
+        // a listener can only apply this delta if it holds baseGeneration, and holds generation after applying it
+        uint32_t baseGeneration { 0 };
+        uint32_t generation { 0 };
+
+        // what the delta was encoded against, to encode it again when it has to be split over several packets
+        quint64 baseTime { 0 };
+        QVector<JointData> baseJoints;
+    };
+
+    // the avatar data at this frame that depends on nothing the listener holds
+    QByteArray getKeyframe(const AvatarData& avatar, uint16_t sequenceNumber);
+
+    // the avatar data at this frame that changed for listeners at this distance level since the previous frame
+    Delta getDelta(const AvatarData& avatar, uint16_t sequenceNumber, int distanceLevel);
+
+private:
+    struct Level {
+        bool isValid { false };
+        uint16_t sequenceNumber { 0 };
+        quint64 lastEncodeTime { 0 };
+        QVector<JointData> sentJoints;
+        Delta delta;
+    };
+
+    std::mutex _mutex;
+
+    bool _hasKeyframe { false };
+    uint16_t _keyframeSequenceNumber { 0 };
+    QByteArray _keyframe;
+
+    std::array<Level, NUM_AVATAR_DISTANCE_LEVELS> _levels;
+};
+
+#endif // hifi_AvatarEncodingCache_h
@@ -322,6 +322,9 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
+                if (_workerSharedData.avatarGrid) {
+                    _workerSharedData.avatarGrid->prepare(cbegin, cend);
+                }
                 _workerPool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
@@ -786,6 +789,10 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["broadcast_loop_rate"] = _loopRate.rate();
     statsObject["threads"] = _workerPool.numThreads();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
+
+    QJsonObject utilizationStats;
+    _workerPool.utilizationStats(utilizationStats);
+    statsObject["thread_utilization"] = utilizationStats;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
 #ifdef DEBUG_EVENT_QUEUE
@@ -870,6 +877,10 @@ void AvatarMixer::sendStatsPacket() {
     workersAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     workersAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     workersAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    workersAggregatObject["sent_8_averageSharedDeltas"] = TIGHT_LOOP_STAT(aggregateStats.numSharedDeltasSent);
+    workersAggregatObject["sent_9_averageKeyframes"] = TIGHT_LOOP_STAT(aggregateStats.numKeyframesSent);
+    float averageOthersSorted = averageNodes ? aggregateStats.numOthersSorted / averageNodes : 0.0f;
+    workersAggregatObject["sent_10_averageOthersSorted"] = TIGHT_LOOP_STAT(averageOthersSorted);
 
     workersAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     workersAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -1061,6 +1072,20 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {
+        static const QString SHARED_ENCODING_KEY = "shared_avatar_encoding";
+        _workerSharedData.sharedAvatarEncoding = avatarMixerGroupObject[SHARED_ENCODING_KEY].toBool(false);
+        qCDebug(avatars) << "Avatar mixer shared encoding of avatar data is"
+                         << (_workerSharedData.sharedAvatarEncoding ? "enabled" : "disabled");
+    }
+
+    {
+        static const QString SPATIAL_SORTING_KEY = "spatial_avatar_sorting";
+        bool spatialSorting = avatarMixerGroupObject[SPATIAL_SORTING_KEY].toBool(false);
+        _workerSharedData.avatarGrid = spatialSorting ? &_avatarGrid : nullptr;
+        qCDebug(avatars) << "Avatar mixer spatial sorting of avatars is" << (spatialSorting ? "enabled" : "disabled");
+    }
+
     const QString AVATARS_SETTINGS_KEY = "avatars";
 
     static const QString MIN_HEIGHT_OPTION = "min_avatar_height";
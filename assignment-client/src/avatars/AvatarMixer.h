@@ -157,6 +157,7 @@ private:
 
     AvatarMixerWorkerPool _workerPool;
     WorkerSharedData _workerSharedData;
+    AvatarMixerSpatialGrid _avatarGrid;
 };
 
 #endif // hifi_AvatarMixer_h
@@ -146,6 +146,14 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message, const WorkerShare
     _avatar->setHasPriorityWithoutTimestampReset(oldHasPriority);
 
     auto newPosition = _avatar->getClientGlobalPosition();
+    if (workerSharedData.avatarGrid) {
+        auto gridCell = workerSharedData.avatarGrid->computeKey(newPosition);
+        if (gridCell != _gridCell) {
+            workerSharedData.avatarGrid->move(getNodeID(), _gridCell, gridCell);
+            _gridCell = gridCell;
+        }
+    }
+
     if (newPosition != oldPosition || _avatar->getNeedsHeroCheck()) {
         EntityTree& entityTree = *workerSharedData.entityTree;
         FindContainingZone findContainingZone{ newPosition };
@@ -436,6 +444,7 @@ void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLo
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
+    _sharedEncodingStates.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
     for (auto&& pendingTraitVersions : _perNodePendingTraitVersions) {
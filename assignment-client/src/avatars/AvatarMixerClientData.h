@@ -21,6 +21,8 @@
 #include <QtCore/QJsonObject>
 #include <QtCore/QUrl>
 
+#include "AvatarEncodingCache.h"
+#include "AvatarMixerSpatialGrid.h"
 #include "MixerAvatar.h"
 #include <AssociatedTraitValues.h>
 #include <NodeData.h>
@@ -104,6 +106,8 @@ public:
     void loadJSONStats(QJsonObject& jsonObject) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getClientGlobalPosition() : glm::vec3(0); }
+    AvatarMixerSpatialGrid::CellKey getGridCell() const { return _gridCell; }
+    uint32_t nextFarCellVisit() { return _farCellVisit++; }
     bool isRadiusIgnoring(const QUuid& other) const;
     void addToRadiusIgnoringSet(const QUuid& other);
     void removeFromRadiusIgnoringSet(const QUuid& other);
@@ -131,6 +135,16 @@ public:
 
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
+    // the shared encoding of an "other" avatar that "this" node holds, see AvatarEncodingCache
+    struct SharedEncodingState {
+        int distanceLevel { -1 };
+        uint32_t generation { 0 };
+    };
+    SharedEncodingState& getSharedEncodingState(NLPacket::LocalID otherAvatar) { return _sharedEncodingStates[otherAvatar]; }
+
+    // encodings of this avatar shared by all listening nodes, thread-safe
+    AvatarEncodingCache& getEncodingCache() const { return _encodingCache; }
+
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(const WorkerSharedData& workerSharedData); // returns number of packets processed
 
@@ -170,6 +184,8 @@ private:
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
+    AvatarMixerSpatialGrid::CellKey _gridCell { AvatarMixerSpatialGrid::INVALID_CELL };
+    uint32_t _farCellVisit { 0 };
     std::unordered_map<NLPacket::LocalID, uint16_t> _lastBroadcastSequenceNumbers;
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastBroadcastTimes;
 
@@ -177,6 +193,9 @@ private:
     // sending to "this" node
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<NLPacket::LocalID, SharedEncodingState> _sharedEncodingStates;
+
+    mutable AvatarEncodingCache _encodingCache;
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
@@ -0,0 +1,97 @@
+//
+//  AvatarMixerSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarMixerSpatialGrid.h"
+
+#include <algorithm>
+
+#include "AvatarMixerClientData.h"
+
+const float AvatarMixerSpatialGrid::CELL_SIZE = 10.0f;
+
+// avatars are binned by position only, so cells are widened by about the half-size of a large avatar
+static const float CELL_LOOSENESS = 2.0f;
+
+static const int CELL_COORDINATE_BITS = 21;
+static const int32_t CELL_COORDINATE_OFFSET = 1 << (CELL_COORDINATE_BITS - 1);
+static const uint64_t CELL_COORDINATE_MASK = (1 << CELL_COORDINATE_BITS) - 1;
+
+AvatarMixerSpatialGrid::CellKey AvatarMixerSpatialGrid::computeKey(const glm::vec3& position) const {
+    glm::ivec3 cell = glm::ivec3(glm::floor(position / CELL_SIZE));
+
+    CellKey key = 0;
+    for (int i = 0; i < 3; ++i) {
+        key |= ((uint64_t)(cell[i] + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << (i * CELL_COORDINATE_BITS);
+    }
+    return key;
+}
+
+void AvatarMixerSpatialGrid::move(const QUuid& nodeID, CellKey from, CellKey to) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (from != INVALID_CELL) {
+        auto it = _cells.find(from);
+        if (it != _cells.end()) {
+            auto& nodeIDs = it->second.nodeIDs;
+            nodeIDs.erase(std::remove(nodeIDs.begin(), nodeIDs.end(), nodeID), nodeIDs.end());
+        }
+    }
+
+    if (to != INVALID_CELL) {
+        auto it = _cells.find(to);
+        if (it == _cells.end()) {
+            GridCell cell;
+            for (int i = 0; i < 3; ++i) {
+                cell.coordinates[i] = (int32_t)((to >> (i * CELL_COORDINATE_BITS)) & CELL_COORDINATE_MASK) - CELL_COORDINATE_OFFSET;
+            }
+            it = _cells.emplace(to, std::move(cell)).first;
+        }
+        it->second.nodeIDs.push_back(nodeID);
+    }
+}
+
+void AvatarMixerSpatialGrid::prepare(ConstIter begin, ConstIter end) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _nodesByID.clear();
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        if (node->getType() == NodeType::Agent && node->getLinkedData()) {
+            _nodesByID[node->getUUID()] = node.data();
+        }
+    });
+
+    _preparedCells.clear();
+    for (auto it = _cells.begin(); it != _cells.end();) {
+        CellKey key = it->first;
+        auto& nodeIDs = it->second.nodeIDs;
+
+        // killed avatars are never moved out of their cell, and a reconnected one may be listed in its old cell
+        nodeIDs.erase(std::remove_if(nodeIDs.begin(), nodeIDs.end(), [&](const QUuid& nodeID) {
+            auto node = _nodesByID.find(nodeID);
+            return node == _nodesByID.end() ||
+                static_cast<AvatarMixerClientData*>(node->second->getLinkedData())->getGridCell() != key;
+        }), nodeIDs.end());
+
+        if (nodeIDs.empty()) {
+            it = _cells.erase(it);
+            continue;
+        }
+
+        Cell cell;
+        glm::vec3 corner = glm::vec3(it->second.coordinates) * CELL_SIZE - CELL_LOOSENESS;
+        cell.bounds = AABox(corner, glm::vec3(CELL_SIZE + 2.0f * CELL_LOOSENESS));
+        cell.nodes.reserve(nodeIDs.size());
+        for (auto& nodeID : nodeIDs) {
+            cell.nodes.push_back(_nodesByID[nodeID]);
+        }
+        _preparedCells.push_back(std::move(cell));
+        ++it;
+    }
+}
@@ -0,0 +1,67 @@
+//
+//  AvatarMixerSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarMixerSpatialGrid_h
+#define hifi_AvatarMixerSpatialGrid_h
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <NodeList.h>
+#include <UUIDHasher.h>
+
+// Loose uniform grid of the avatars in the domain, used to seed the per-listener avatar sort with nearby avatars
+// before far ones.
+//
+// Avatars are moved between cells as their data packets are parsed, which only takes a lock when an avatar
+// crosses into another cell. Once per frame, before the broadcast, prepare() drops killed avatars and resolves the
+// remaining ones to their nodes; the broadcast then reads the prepared cells from any number of workers.
+class AvatarMixerSpatialGrid {
+public:
+    using ConstIter = NodeList::const_iterator;
+    using CellKey = uint64_t;
+    static const CellKey INVALID_CELL = UINT64_MAX;
+
+    static const float CELL_SIZE; // meters
+
+    struct Cell {
+        AABox bounds; // loose, includes the extent of the avatars positioned near the cell's faces
+        std::vector<Node*> nodes;
+    };
+
+    CellKey computeKey(const glm::vec3& position) const;
+
+    // move an avatar from its previous cell to a new one, INVALID_CELL when it had none; thread-safe
+    void move(const QUuid& nodeID, CellKey from, CellKey to);
+
+    // resolve the avatars of every cell to the nodes in [begin, end), dropping those no longer in it
+    void prepare(ConstIter begin, ConstIter end);
+
+    // the cells resolved by the last prepare(), valid until the next one
+    const std::vector<Cell>& getCells() const { return _preparedCells; }
+
+private:
+    struct GridCell {
+        glm::ivec3 coordinates;
+        std::vector<QUuid> nodeIDs;
+    };
+
+    std::mutex _mutex;
+    std::unordered_map<CellKey, GridCell> _cells;
+
+    std::unordered_map<QUuid, Node*> _nodesByID;
+    std::vector<Cell> _preparedCells;
+};
+
+#endif // hifi_AvatarMixerSpatialGrid_h
@@ -33,6 +33,7 @@
 
 #include "AvatarMixer.h"
 #include "AvatarMixerClientData.h"
+#include "AvatarMixerSpatialGrid.h"
 
 namespace chrono = std::chrono;
 
@@ -275,6 +276,10 @@ void AvatarMixerWorker::broadcastAvatarData(const SharedNodePointer& node) {
     _stats.jobElapsedTime += (end - start);
 }
 
+static float distanceToBox(const glm::vec3& position, const AABox& box) {
+    return glm::distance(position, glm::clamp(position, box.getMinimumPoint(), box.getMaximumPoint()));
+}
+
 AABox computeBubbleBox(const AvatarData& avatar, float bubbleExpansionFactor) {
     AABox box = avatar.getGlobalBoundingBox();
     glm::vec3 scale = box.getScale();
@@ -384,14 +389,12 @@ void AvatarMixerWorker::broadcastAvatarDataToAgent(const SharedNodePointer& node
             AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
     };
 
-    avatarPriorityQueues[kNonhero].reserve(_end - _begin);
-
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
+    // consider another avatar for sending, and queue it to be sorted if it should be sent
+    auto considerAvatar = [&](Node* otherNodeRaw) {
         if (otherNodeRaw->getType() != NodeType::Agent
             || !otherNodeRaw->getLinkedData()
             || otherNodeRaw == destinationNode) {
-            continue;
+            return;
         }
 
         auto sourceAvatarNode = otherNodeRaw;
@@ -489,13 +492,63 @@ void AvatarMixerWorker::broadcastAvatarDataToAgent(const SharedNodePointer& node
             nodeList->sendPacket(std::move(packet), *destinationNode);
             destinationNodeData->cleanupKilledNode(sourceAvatarNode->getUUID(), sourceAvatarNode->getLocalID());
         }
+    };
+
+    const AvatarMixerSpatialGrid* avatarGrid = _sharedData->avatarGrid;
+    if (avatarGrid && !PALIsOpen && !PALWasOpen) {
+        // seed the sort with the cells nearest to the destination and its views, and only go on to farther cells
+        // while more avatars could still be sent this frame
+        const auto& cells = avatarGrid->getCells();
+        _sortedCells.clear();
+        for (int i = 0; i < (int)cells.size(); ++i) {
+            const AABox& bounds = cells[i].bounds;
+            float distance = distanceToBox(destinationPosition, bounds);
+            if (distance <= AvatarMixerSpatialGrid::CELL_SIZE) {
+                // cells around the destination are always considered, for its space bubble
+                distance = 0.0f;
+            }
+            for (const auto& view : cameraViews) {
+                const float IN_VIEW_DISTANCE_SCALE = 0.5f;
+                float viewDistance = distanceToBox(view.getPosition(), bounds);
+                distance = std::min(distance, view.intersects(bounds) ? viewDistance * IN_VIEW_DISTANCE_SCALE : viewDistance);
+            }
+            _sortedCells.emplace_back(distance, i);
+        }
+        std::sort(_sortedCells.begin(), _sortedCells.end());
+
+        size_t cellIndex = 0;
+        for (; cellIndex < _sortedCells.size(); ++cellIndex) {
+            int numQueued = (int)(avatarPriorityQueues[kHero].size() + avatarPriorityQueues[kNonhero].size());
+            if (numQueued >= numToSendEst && _sortedCells[cellIndex].first > 0.0f) {
+                break;
+            }
+            for (Node* node : cells[_sortedCells[cellIndex].second].nodes) {
+                considerAvatar(node);
+            }
+        }
 
-        destinationNodeData->setPrevRequestsDomainListData(PALIsOpen);
+        if (cellIndex < _sortedCells.size()) {
+            // also visit one of the remaining cells in turn, so that far avatars age until they are sent
+            size_t numFarCells = _sortedCells.size() - cellIndex;
+            size_t farCellIndex = cellIndex + destinationNodeData->nextFarCellVisit() % numFarCells;
+            for (Node* node : cells[_sortedCells[farCellIndex].second].nodes) {
+                considerAvatar(node);
+            }
+        }
+    } else {
+        // the PAL, and the kill packets sent when it closes, need every avatar
+        avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+        for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
+            considerAvatar((*listedNode).data());
+        }
     }
 
+    destinationNodeData->setPrevRequestsDomainListData(PALIsOpen);
+
     // loop through our sorted avatars and allocate our bandwidth to them accordingly
 
     int remainingAvatars = (int)avatarPriorityQueues[kHero].size() + (int)avatarPriorityQueues[kNonhero].size();
+    _stats.numOthersSorted += remainingAvatars;
     auto traitsPacketList = NLPacketList::create(PacketType::BulkAvatarTraits, QByteArray(), true, true);
 
     auto avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
@@ -562,33 +615,95 @@ void AvatarMixerWorker::broadcastAvatarDataToAgent(const SharedNodePointer& node
                 }
             }
 
-            QVector<JointData>& lastSentJointsForOther = destinationNodeData->getLastOtherAvatarSentJoints(sourceNode->getLocalID());
-
             const bool distanceAdjust = true;
             const bool dropFaceTracking = false;
-            AvatarDataPacket::SendStatus sendStatus;
-            sendStatus.sendUUID = true;
 
-            do {
+            // what is encoded for this destination, and what it is a delta against
+            AvatarData::AvatarDataDetail encodeDetail = detail;
+            quint64 encodeLastSentTime = lastEncodeForOther;
+            QVector<JointData>* lastSentJointsForOther = &destinationNodeData->getLastOtherAvatarSentJoints(sourceNode->getLocalID());
+            QVector<JointData> sharedBaseJoints;
+            QByteArray sharedBytes;
+
+            auto& sharedEncodingState = destinationNodeData->getSharedEncodingState(sourceNode->getLocalID());
+            bool useSharedEncoding = _sharedData->sharedAvatarEncoding &&
+                (detail == AvatarData::SendAllData || detail == AvatarData::CullSmallData);
+            if (useSharedEncoding) {
                 auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
+
+                AvatarEncodingCache& encodingCache = sourceNodeData->getEncodingCache();
+                uint16_t sequenceNumber = sourceNodeData->getLastReceivedSequenceNumber();
+                float distance = glm::distance(sourceAvatar->getClientGlobalPosition(), destinationPosition);
+                int distanceLevel = AvatarData::getDistanceLevel(distance);
+                auto delta = encodingCache.getDelta(*sourceAvatar, sequenceNumber, distanceLevel);
+
+                if (detail == AvatarData::CullSmallData && sharedEncodingState.distanceLevel == distanceLevel
+                    && sharedEncodingState.generation == delta.baseGeneration) {
+                    sharedBytes = delta.bytes;
+                    sharedBaseJoints = delta.baseJoints;
+                    encodeLastSentTime = delta.baseTime;
+                    _stats.numSharedDeltasSent++;
+                } else {
+                    // the keyframe leaves the destination within the culling tolerance of this frame's delta,
+                    // so from here on it can follow the deltas of its distance level
+                    sharedBytes = encodingCache.getKeyframe(*sourceAvatar, sequenceNumber);
+                    encodeDetail = AvatarData::SendAllData;
+                    _stats.numKeyframesSent++;
+                }
+                lastSentJointsForOther = &sharedBaseJoints;
+                sharedEncodingState.distanceLevel = distanceLevel;
+                sharedEncodingState.generation = delta.generation;
+
                 auto endSerialize = chrono::high_resolution_clock::now();
                 _stats.toByteArrayElapsedTime +=
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+            } else if (sharedEncodingState.generation != 0) {
+                // the per-destination joints were not kept up to date while shared encodings were sent
+                lastSentJointsForOther->clear();
+                sharedEncodingState = AvatarMixerClientData::SharedEncodingState();
+            }
+
+            auto sendAvatarPacket = [&] {
+                nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                ++numPacketsSent;
+                avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                avatarSpaceAvailable = avatarPacketCapacity;
+            };
+
+            if (useSharedEncoding && sharedBytes.size() <= avatarPacketCapacity) {
+                if (sharedBytes.size() > avatarSpaceAvailable) {
+                    sendAvatarPacket();
+                }
 
-                avatarPacket->write(bytes);
-                avatarSpaceAvailable -= bytes.size();
-                numAvatarDataBytes += bytes.size();
-                if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
-                    // Weren't able to fit everything.
-                    nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
-                    ++numPacketsSent;
-                    avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
-                    avatarSpaceAvailable = avatarPacketCapacity;
+                avatarPacket->write(sharedBytes);
+                avatarSpaceAvailable -= sharedBytes.size();
+                numAvatarDataBytes += sharedBytes.size();
+                if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                    sendAvatarPacket();
                 }
-            } while (!sendStatus);
+            } else {
+                // this also splits a shared encoding that does not fit in a packet, by encoding it again against the same base
+                AvatarDataPacket::SendStatus sendStatus;
+                sendStatus.sendUUID = true;
+
+                do {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    QByteArray bytes = sourceAvatar->toByteArray(encodeDetail, encodeLastSentTime, *lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        lastSentJointsForOther, avatarSpaceAvailable);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        // Weren't able to fit everything.
+                        sendAvatarPacket();
+                    }
+                } while (!sendStatus);
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
@@ -33,6 +33,9 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numSharedDeltasSent { 0 };
+    int numKeyframesSent { 0 };
+    int numOthersSorted { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +62,9 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numSharedDeltasSent = 0;
+        numKeyframesSent = 0;
+        numOthersSorted = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +89,9 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numSharedDeltasSent += rhs.numSharedDeltasSent;
+        numKeyframesSent += rhs.numKeyframesSent;
+        numOthersSorted += rhs.numOthersSorted;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -95,9 +104,12 @@ public:
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
+class AvatarMixerSpatialGrid;
 
 struct WorkerSharedData {
     EntityTreePointer entityTree;
+    AvatarMixerSpatialGrid* avatarGrid { nullptr };
+    bool sharedAvatarEncoding { false };
 };
 
 class AvatarMixerWorker {
@@ -143,6 +155,8 @@ private:
 
     AvatarMixerWorkerStats _stats;
     WorkerSharedData* _sharedData;
+
+    std::vector<std::pair<float, int>> _sortedCells; // (distance, index) of the avatar grid cells, per destination
 };
 
 #endif // hifi_AvatarMixerWorker_h
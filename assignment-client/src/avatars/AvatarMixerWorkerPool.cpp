@@ -13,19 +13,27 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <chrono>
+
+#include <PortableHighResolutionClock.h>
 
 void AvatarMixerWorkerThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        // iterate over our chunk of nodes, then over whatever we can steal from the other threads
+        uint32_t index;
+        while (_function && _pool._scheduler.next(_index, index)) {
+            auto start = p_high_resolution_clock::now();
+            (this->*_function)(_pool._nodes[index]);
+            auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start);
+
+            _pool._measuredCosts[index] = cost.count();
+            _busyTime += cost.count();
         }
 
         bool stopping = _stop;
-        notify(stopping);
+        notify();
         if (stopping) {
             return;
         }
@@ -33,34 +41,16 @@ void AvatarMixerWorkerThread::run() {
 }
 
 void AvatarMixerWorkerThread::wait() {
-    {
-        Lock lock(_pool._mutex);
-        _pool._workerCondition.wait(lock, [&] {
-            assert(_pool._numStarted <= _pool._numThreads);
-            return _pool._numStarted != _pool._numThreads;
-        });
-        ++_pool._numStarted;
-    }
+    _frame = _pool._barrier.waitForFrame(_frame);
+
     if (_pool._configure) {
         _pool._configure(*this);
     }
     _function = _pool._function;
 }
 
-void AvatarMixerWorkerThread::notify(bool stopping) {
-    {
-        Lock lock(_pool._mutex);
-        assert(_pool._numFinished < _pool._numThreads);
-        ++_pool._numFinished;
-        if (stopping) {
-            ++_pool._numStopped;
-        }
-    }
-    _pool._poolCondition.notify_one();
-}
-
-bool AvatarMixerWorkerThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+void AvatarMixerWorkerThread::notify() {
+    _pool._barrier.finish();
 }
 
 void AvatarMixerWorkerPool::processIncomingPackets(ConstIter begin, ConstIter end) {
@@ -68,7 +58,7 @@ void AvatarMixerWorkerPool::processIncomingPackets(ConstIter begin, ConstIter en
     _configure = [=](AvatarMixerWorker& worker) { 
         worker.configure(begin, end);
     };
-    run(begin, end);
+    run(begin, end, _packetsCosts);
 }
 
 void AvatarMixerWorkerPool::broadcastAvatarData(ConstIter begin, ConstIter end, 
@@ -79,35 +69,52 @@ void AvatarMixerWorkerPool::broadcastAvatarData(ConstIter begin, ConstIter end,
         worker.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
             _priorityReservedFraction);
    };
-    run(begin, end);
+    run(begin, end, _broadcastCosts);
 }
 
-void AvatarMixerWorkerPool::run(ConstIter begin, ConstIter end) {
+void AvatarMixerWorkerPool::run(ConstIter begin, ConstIter end, NodeCosts& nodeCosts) {
+    auto start = p_high_resolution_clock::now();
+
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // gather the nodes, estimating their cost from the last frame (new nodes get the average cost)
+    _nodes.assign(_begin, _end);
+    uint64_t averageCost = 1;
+    if (!nodeCosts.empty()) {
+        uint64_t totalCost = 0;
+        for (const auto& nodeCost : nodeCosts) {
+            totalCost += nodeCost.second;
+        }
+        averageCost = std::max(totalCost / nodeCosts.size(), (uint64_t)1);
+    }
 
-    {
-        Lock lock(_mutex);
+    _estimatedCosts.resize(_nodes.size());
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        auto it = nodeCosts.find(_nodes[i]->getUUID());
+        _estimatedCosts[i] = (it != nodeCosts.end()) ? std::max(it->second, (uint64_t)1) : averageCost;
+    }
+    _measuredCosts.assign(_nodes.size(), 0);
 
-        // run
-        _numStarted = _numFinished = 0;
-        _workerCondition.notify_all();
+    // run
+    _scheduler.reset(_numThreads, _estimatedCosts);
+    _barrier.start(_numThreads);
 
-        // wait
-        _poolCondition.wait(lock, [&] {
-            assert(_numFinished <= _numThreads);
-            return _numFinished == _numThreads;
-        });
+    // wait
+    _barrier.wait();
 
-        assert(_numStarted == _numThreads);
+    // keep this frame's costs for the next one
+    nodeCosts.clear();
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        nodeCosts[_nodes[i]->getUUID()] = _measuredCosts[i];
     }
 
-    assert(_queue.empty());
+    // release the nodes until the next frame
+    _nodes.clear();
+
+    _numSteals += _scheduler.getNumSteals();
+    _runTime += std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start).count();
+    ++_numRuns;
 }
 
 
@@ -130,6 +137,19 @@ void AvatarMixerWorkerPool::queueStats(QJsonObject& stats) {
 }
 #endif // DEBUG_EVENT_QUEUE
 
+void AvatarMixerWorkerPool::utilizationStats(QJsonObject& stats) {
+    for (auto& worker : _workers) {
+        float utilization = (_runTime > 0) ? (float)worker->_busyTime / (float)_runTime : 0.0f;
+        stats[QString("thread_%1").arg(worker->_index)] = utilization;
+        worker->_busyTime = 0;
+    }
+    stats["steals_per_run"] = (_numRuns > 0) ? (float)_numSteals / (float)_numRuns : 0.0f;
+
+    _runTime = 0;
+    _numRuns = 0;
+    _numSteals = 0;
+}
+
 void AvatarMixerWorkerPool::setNumThreads(int numThreads) {
     // clamp to allowed size
     {
@@ -155,12 +175,10 @@ void AvatarMixerWorkerPool::resize(int numThreads) {
 
     qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
 
-    Lock lock(_mutex);
-
     if (numThreads > _numThreads) {
-        // start new workers
-        for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto worker = new AvatarMixerWorkerThread(*this, _workerSharedData);
+        // start new workers, waiting for the next frame
+        for (int i = _numThreads; i < numThreads; ++i) {
+            auto worker = new AvatarMixerWorkerThread(*this, _workerSharedData, i, _barrier.getFrame());
             worker->start();
             _workers.emplace_back(worker);
         }
@@ -174,16 +192,12 @@ void AvatarMixerWorkerPool::resize(int numThreads) {
             ++worker;
         }
 
-        // ...cycle them until they do stop...
-        _numStopped = 0;
-        while (_numStopped != (_numThreads - numThreads)) {
-            _numStarted = _numFinished = _numStopped;
-            _workerCondition.notify_all();
-            _poolCondition.wait(lock, [&] {
-                assert(_numFinished <= _numThreads);
-                return _numFinished == _numThreads;
-            });
-        }
+        // ...cycle an empty frame so they stop...
+        _function = nullptr;
+        _configure = nullptr;
+        _scheduler.reset(_numThreads, {});
+        _barrier.start(_numThreads);
+        _barrier.wait();
 
         // ...wait for threads to finish...
         worker = extraBegin;
@@ -198,6 +212,6 @@ void AvatarMixerWorkerPool::resize(int numThreads) {
         _workers.erase(extraBegin, _workers.end());
     }
 
-    _numThreads = _numStarted = _numFinished = numThreads;
+    _numThreads = numThreads;
     assert(_numThreads == (int)_workers.size());
 }
@@ -12,15 +12,17 @@
 #ifndef hifi_AvatarMixerWorkerPool_h
 #define hifi_AvatarMixerWorkerPool_h
 
-#include <condition_variable>
-#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <QThread>
+#include <QtCore/QJsonObject>
 
-#include <TBBHelpers.h>
 #include <NodeList.h>
+#include <UUIDHasher.h>
+#include <shared/FrameBarrier.h>
 #include <shared/QtHelpers.h>
+#include <shared/WorkStealingScheduler.h>
 
 #include "AvatarMixerWorker.h"
 
@@ -30,12 +32,10 @@ class AvatarMixerWorkerPool;
 class AvatarMixerWorkerThread : public QThread, public AvatarMixerWorker {
     Q_OBJECT
     using ConstIter = NodeList::const_iterator;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
 
 public:
-    AvatarMixerWorkerThread(AvatarMixerWorkerPool& pool, WorkerSharedData* workerSharedData) :
-        AvatarMixerWorker(workerSharedData), _pool(pool) {};
+    AvatarMixerWorkerThread(AvatarMixerWorkerPool& pool, WorkerSharedData* workerSharedData, int index, uint32_t frame) :
+        AvatarMixerWorker(workerSharedData), _pool(pool), _index(index), _frame(frame) {};
 
     void run() override final;
 
@@ -43,22 +43,22 @@ private:
     friend class AvatarMixerWorkerPool;
 
     void wait();
-    void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
+    void notify();
 
     AvatarMixerWorkerPool& _pool;
     void (AvatarMixerWorker::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
+
+    const int _index;
+    uint32_t _frame;
+    uint64_t _busyTime { 0 }; // nanoseconds spent on nodes, read by the pool between frames
 };
 
 // Worker pool for avatar mixers
 //   AvatarMixerWorkerPool is not thread-safe! It should be instantiated and used from a single thread.
+//   Nodes are split into per-thread chunks balanced by each node's cost on the last frame,
+//   and threads that run out of work steal from the others.
 class AvatarMixerWorkerPool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-    using ConditionVariable = std::condition_variable;
-
 public:
     using ConstIter = NodeList::const_iterator;
 
@@ -78,6 +78,9 @@ public:
     void queueStats(QJsonObject& stats);
 #endif
 
+    // per-thread utilization since the last call
+    void utilizationStats(QJsonObject& stats);
+
     void setNumThreads(int numThreads);
     int numThreads() const { return _numThreads; }
 
@@ -85,19 +88,18 @@ public:
     float getPriorityReservedFraction() const { return  _priorityReservedFraction; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    using NodeCosts = std::unordered_map<QUuid, uint64_t, UUIDHasher>;
+
+    void run(ConstIter begin, ConstIter end, NodeCosts& nodeCosts);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AvatarMixerWorkerThread>> _workers;
 
-    friend void AvatarMixerWorkerThread::wait();
-    friend void AvatarMixerWorkerThread::notify(bool stopping);
-    friend bool AvatarMixerWorkerThread::try_pop(SharedNodePointer& node);
+    friend class AvatarMixerWorkerThread;
 
     // synchronization state
-    Mutex _mutex;
-    ConditionVariable _workerCondition;
-    ConditionVariable _poolCondition;
+    FrameBarrier _barrier;
+    WorkStealingScheduler _scheduler;
     void (AvatarMixerWorker::*_function)(const SharedNodePointer& node);
     std::function<void(AvatarMixerWorker&)> _configure;
 
@@ -105,15 +107,22 @@ private:
     float _priorityReservedFraction { 0.4f };
     int _numThreads { 0 };
 
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
-
     // frame state
-    Queue _queue;
+    std::vector<SharedNodePointer> _nodes;
+    std::vector<uint64_t> _estimatedCosts;
+    std::vector<uint64_t> _measuredCosts; // written by the thread that processed each node
     ConstIter _begin;
     ConstIter _end;
 
+    // nanoseconds spent on each node during the last frame of each job, for balancing the next one
+    NodeCosts _packetsCosts;
+    NodeCosts _broadcastCosts;
+
+    // utilization stats
+    uint64_t _runTime { 0 };
+    int _numRuns { 0 };
+    int _numSteals { 0 };
+
     WorkerSharedData* _workerSharedData;
 };
 
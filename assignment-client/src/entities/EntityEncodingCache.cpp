@@ -0,0 +1,79 @@
+//
+//  EntityEncodingCache.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodingCache.h"
+
+#include <EntityTreeElement.h>
+
+bool EntityEncodingCache::Stamps::operator==(const Stamps& other) const {
+    return lastEdited == other.lastEdited && lastUpdated == other.lastUpdated && lastSimulated == other.lastSimulated &&
+        lastChangedOnServer == other.lastChangedOnServer && queryAACube == other.queryAACube;
+}
+
+EntityEncodingCache::Stamps EntityEncodingCache::getStamps(const EntityItem& entity) {
+    Stamps stamps;
+    stamps.lastEdited = entity.getLastEdited();
+    stamps.lastUpdated = entity.getLastUpdated();
+    stamps.lastSimulated = entity.getLastSimulated();
+    stamps.lastChangedOnServer = entity.getLastChangedOnServer();
+    stamps.queryAACube = entity.getQueryAACube();
+    return stamps;
+}
+
+QByteArray EntityEncodingCache::getEncoding(const EntityItem& entity, const EncodeBitstreamParams& params,
+                                            bool canGetAndSetPrivateUserData, OctreePacketData& scratchPacketData) {
+    const EntityItemID& entityID = entity.getEntityItemID();
+    const int variant = canGetAndSetPrivateUserData ? 1 : 0;
+    Stamps stamps = getStamps(entity);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(entityID);
+        if (it != _entries.end() && it->second.stamps == stamps && it->second.isEncoded[variant]) {
+            ++_numHits;
+            return it->second.encodings[variant];
+        }
+    }
+
+    ++_numMisses;
+
+    // encoded outside of the lock, two send threads may encode the same entity but will produce the same bytes
+    EncodeBitstreamParams encodeParams(params.includeExistsBits, params.nodeData);
+    EntityTreeElementExtraEncodeDataPointer extraEncodeData { new EntityTreeElementExtraEncodeData() };
+    scratchPacketData.reset();
+    OctreeElement::AppendState appendState = entity.appendEntityData(&scratchPacketData, encodeParams, extraEncodeData,
+                                                                     canGetAndSetPrivateUserData);
+
+    QByteArray encoding;
+    if (appendState == OctreeElement::COMPLETED) {
+        encoding = QByteArray((const char*)scratchPacketData.getUncompressedData(), scratchPacketData.getUncompressedSize());
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry& entry = _entries[entityID];
+    if (!(entry.stamps == stamps)) {
+        entry = Entry();
+        entry.stamps = stamps;
+    }
+    entry.isEncoded[variant] = true;
+    entry.encodings[variant] = encoding;
+
+    return encoding;
+}
+
+void EntityEncodingCache::invalidate(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.erase(entityID);
+}
+
+size_t EntityEncodingCache::getNumEntries() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
@@ -0,0 +1,74 @@
+//
+//  EntityEncodingCache.h
+//  assignment-client/src/entities
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodingCache_h
+#define hifi_EntityEncodingCache_h
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+
+#include <AACube.h>
+#include <EntityItem.h>
+#include <EntityItemID.h>
+#include <OctreePacketData.h>
+
+// Encoded properties of the entities sent by the entity server, shared by all of its send threads.
+//
+// An entity is encoded in full by the first send thread that sends it, and the same bytes are then appended to the
+// packets of every other client until the entity changes. Apart from partial sends, which are never cached, the
+// encoding only depends on the client through whether it can see private user data, so an entity has two variants.
+//
+// Entries are dropped when the tree edits or deletes their entity. Server side simulation does not go through edits,
+// so entries are also checked against the entity's change timestamps when read.
+//
+// Encodings are made while the caller holds the tree's read lock, and are thread-safe.
+class EntityEncodingCache {
+public:
+    // the full encoding of the entity, encoded into scratchPacketData on a miss; empty if it doesn't fit in a packet
+    QByteArray getEncoding(const EntityItem& entity, const EncodeBitstreamParams& params,
+                           bool canGetAndSetPrivateUserData, OctreePacketData& scratchPacketData);
+
+    // called with the tree's write lock held, so never while an encoding of the entity is being made
+    void invalidate(const EntityItemID& entityID);
+
+    uint64_t getNumHits() const { return _numHits; }
+    uint64_t getNumMisses() const { return _numMisses; }
+    size_t getNumEntries();
+
+private:
+    struct Stamps {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 lastChangedOnServer { 0 };
+        AACube queryAACube; // follows the entity's parent, which changes none of its timestamps
+
+        bool operator==(const Stamps& other) const;
+    };
+
+    struct Entry {
+        Stamps stamps;
+        bool isEncoded[2] { false, false };
+        QByteArray encodings[2];
+    };
+
+    static Stamps getStamps(const EntityItem& entity);
+
+    std::mutex _mutex;
+    std::unordered_map<EntityItemID, Entry> _entries;
+
+    std::atomic<uint64_t> _numHits { 0 };
+    std::atomic<uint64_t> _numMisses { 0 };
+};
+
+#endif // hifi_EntityEncodingCache_h
@@ -347,6 +347,25 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
         tree->setEntityScriptSourceWhitelist("");
     }
     
+    bool sharedEntityEncoding;
+    if (!readOptionBool(QString("sharedEntityEncoding"), settingsSectionObject, sharedEntityEncoding)) {
+        sharedEntityEncoding = false;
+    }
+    qDebug("sharedEntityEncoding=%s", debug::valueOf(sharedEntityEncoding));
+
+    if (sharedEntityEncoding && !_encodingCache) {
+        _encodingCache.reset(new EntityEncodingCache());
+
+        // direct, since the tree emits these with its write lock held, before any send thread can see the change
+        EntityEncodingCache* encodingCache = _encodingCache.get();
+        connect(tree.get(), &EntityTree::editingEntityPointer, this, [encodingCache](const EntityItemPointer& entity) {
+            encodingCache->invalidate(entity->getEntityItemID());
+        }, Qt::DirectConnection);
+        connect(tree.get(), &EntityTree::deletingEntityPointer, this, [encodingCache](EntityItem* entity) {
+            encodingCache->invalidate(entity->getEntityItemID());
+        }, Qt::DirectConnection);
+    }
+
     auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
     
     QString filterURL;
@@ -417,6 +436,17 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().asprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    if (_encodingCache) {
+        statsString += "<b>Entity Server Shared Encoding Statistics</b>\r\n";
+        statsString += QString("                 Cached entities: %1\r\n")
+            .arg(locale.toString((uint)_encodingCache->getNumEntries()).rightJustified(16, ' '));
+        statsString += QString("                       Encodings: %1\r\n")
+            .arg(locale.toString((qulonglong)_encodingCache->getNumMisses()).rightJustified(16, ' '));
+        statsString += QString("          Encodings shared again: %1\r\n")
+            .arg(locale.toString((qulonglong)_encodingCache->getNumHits()).rightJustified(16, ' '));
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
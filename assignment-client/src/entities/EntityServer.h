@@ -20,6 +20,7 @@
 #include <EntityTree.h>
 #include <SimpleEntitySimulation.h>
 
+#include "EntityEncodingCache.h"
 #include "EntityServerConsts.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
@@ -59,6 +60,9 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // the encodings shared by the send threads, null if they encode every entity for each client
+    EntityEncodingCache* getEncodingCache() const { return _encodingCache.get(); }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -85,6 +89,8 @@ private:
     int _MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 45m
     int _MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 1h
     QTimer _dynamicDomainVerificationTimer;
+
+    std::unique_ptr<EntityEncodingCache> _encodingCache;
     void startDynamicDomainVerification();
 };
 
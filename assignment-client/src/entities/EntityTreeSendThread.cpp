@@ -29,6 +29,7 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
 }
 
 void EntityTreeSendThread::resetState() {
+    QMutexLocker locker(&_mutex);
     qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
 
     _knownState.clear();
@@ -377,7 +378,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
-                OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
+                OctreeElement::AppendState appendEntityState = appendEntity(*entity, params, entityNode->getCanGetAndSetPrivateUserData());
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -418,7 +419,26 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     return true;
 }
 
+OctreeElement::AppendState EntityTreeSendThread::appendEntity(const EntityItem& entity, EncodeBitstreamParams& params,
+                                                              bool canGetAndSetPrivateUserData) {
+    EntityEncodingCache* encodingCache = static_cast<EntityServer*>(_myServer)->getEncodingCache();
+
+    // the rest of a partially sent entity is only ever needed by this client, so it is encoded for it alone
+    if (encodingCache && !_extraEncodeData->entities.contains(entity.getEntityItemID())) {
+        QByteArray encoding = encodingCache->getEncoding(entity, params, canGetAndSetPrivateUserData, _encodingPacketData);
+
+        // if it doesn't fit, the entity is split over several packets below as it would be without the cache
+        if (!encoding.isEmpty() && _packetData.appendRawData(encoding)) {
+            params.trackSend(entity.getID(), entity.getLastEdited());
+            return OctreeElement::COMPLETED;
+        }
+    }
+
+    return entity.appendEntityData(&_packetData, params, _extraEncodeData, canGetAndSetPrivateUserData);
+}
+
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
+    QMutexLocker locker(&_mutex);
     if (entity) {
         if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
             const auto& view = _traversal.getCurrentView();
@@ -435,5 +455,6 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
 }
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
+    QMutexLocker locker(&_mutex);
     _knownState.erase(entity);
 }
@@ -44,6 +44,8 @@ private:
 
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
+    OctreeElement::AppendState appendEntity(const EntityItem& entity, EncodeBitstreamParams& params,
+                                            bool canGetAndSetPrivateUserData);
 
     void preDistributionProcessing() override;
     bool hasSomethingToSend(OctreeQueryNode* nodeData) override { return !_sendQueue.empty(); }
@@ -57,6 +59,7 @@ private:
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
     int32_t _numEntitiesOffset { 0 };
     uint16_t _numEntities { 0 };
+    OctreePacketData _encodingPacketData; // scratch space for the entity server's shared encodings
 
 private slots:
     void editingEntityPointer(const EntityItemPointer& entity);
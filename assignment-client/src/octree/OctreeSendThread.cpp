@@ -80,6 +80,9 @@ bool OctreeSendThread::process() {
 
     // don't do any send processing until the initial load of the octree is complete...
     if (_myServer->isInitialLoadComplete()) {
+        // when run by a pool we are processed off the thread our slots run on, see OctreeSendThreadPool
+        QMutexLocker locker(&_mutex);
+
         if (auto node = _node.lock()) {
             OctreeQueryNode* nodeData = static_cast<OctreeQueryNode*>(node->getLinkedData());
 
@@ -102,7 +105,8 @@ bool OctreeSendThread::process() {
     }
 
     // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
+    // (a pool schedules the send threads it runs itself)
+    if (isStillRunning() && isThreaded()) {
         // dynamically sleep until we need to fire off the next set of octree elements
         int elapsed = (usecTimestampNow() - start);
         int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
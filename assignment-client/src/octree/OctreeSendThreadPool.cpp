@@ -0,0 +1,103 @@
+//
+//  OctreeSendThreadPool.cpp
+//  assignment-client/src/octree
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <SharedUtil.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+OctreeSendThreadPool::OctreeSendThreadPool(int numThreads) {
+    _threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { run(); });
+    }
+}
+
+OctreeSendThreadPool::~OctreeSendThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _scheduleChanged.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void OctreeSendThreadPool::add(OctreeSendThread* sendThread) {
+    assert(!sendThread->isThreaded());
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        schedule(sendThread, usecTimestampNow());
+    }
+    _scheduleChanged.notify_one();
+}
+
+void OctreeSendThreadPool::remove(OctreeSendThread* sendThread) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _processingDone.wait(lock, [&] { return _processing.find(sendThread) == _processing.end(); });
+
+    _scheduled.erase(std::remove_if(_scheduled.begin(), _scheduled.end(), [&](const Scheduled& scheduled) {
+        return scheduled.sendThread == sendThread;
+    }), _scheduled.end());
+}
+
+void OctreeSendThreadPool::schedule(OctreeSendThread* sendThread, quint64 dueTime) {
+    // almost always goes at the back, as every send thread is due one interval after it last started processing
+    auto it = _scheduled.end();
+    while (it != _scheduled.begin() && std::prev(it)->dueTime > dueTime) {
+        --it;
+    }
+    _scheduled.insert(it, { sendThread, dueTime });
+}
+
+void OctreeSendThreadPool::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_isStopping) {
+        if (_scheduled.empty()) {
+            _scheduleChanged.wait(lock);
+            continue;
+        }
+
+        quint64 now = usecTimestampNow();
+        if (_scheduled.front().dueTime > now) {
+            _scheduleChanged.wait_for(lock, std::chrono::microseconds(_scheduled.front().dueTime - now));
+            continue;
+        }
+
+        OctreeSendThread* sendThread = _scheduled.front().sendThread;
+        _scheduled.pop_front();
+        _processing.insert(sendThread);
+        lock.unlock();
+
+        // process() is protected in send threads, which are only meant to be driven through their GenericThread
+        bool keepRunning = static_cast<GenericThread*>(sendThread)->process();
+        if (!keepRunning) {
+            // still marked as processing, so the server can't destroy it before it has been told
+            emit sendThread->finished();
+        }
+
+        lock.lock();
+        _processing.erase(sendThread);
+        _processingDone.notify_all();
+        if (keepRunning) {
+            schedule(sendThread, now + OCTREE_SEND_INTERVAL_USECS);
+
+            // so that idle workers wait for the new due time rather than for the next added send thread
+            _scheduleChanged.notify_one();
+        }
+    }
+}
@@ -0,0 +1,63 @@
+//
+//  OctreeSendThreadPool.h
+//  assignment-client/src/octree
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendThreadPool_h
+#define hifi_OctreeSendThreadPool_h
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+class OctreeSendThread;
+
+// Runs the send threads of an octree server on a fixed set of workers, instead of one thread per client.
+//
+// Send threads given to the pool must be initialized non-threaded. Each one is processed once per send interval by
+// whichever worker is free first, and never by two workers at once. A send thread whose processing returns false is
+// dropped from the pool and emits finished(), as a threaded one does when its thread exits.
+class OctreeSendThreadPool {
+public:
+    OctreeSendThreadPool(int numThreads);
+    ~OctreeSendThreadPool();
+
+    int getNumThreads() const { return (int)_threads.size(); }
+
+    void add(OctreeSendThread* sendThread);
+
+    // blocks while the send thread is being processed, it is never processed again once this returns
+    void remove(OctreeSendThread* sendThread);
+
+private:
+    void run();
+    void schedule(OctreeSendThread* sendThread, quint64 dueTime);
+
+    struct Scheduled {
+        OctreeSendThread* sendThread;
+        quint64 dueTime;
+    };
+
+    std::mutex _mutex;
+    std::condition_variable _scheduleChanged;
+    std::condition_variable _processingDone;
+
+    // ordered by due time
+    std::deque<Scheduled> _scheduled;
+    std::unordered_set<OctreeSendThread*> _processing;
+    bool _isStopping { false };
+
+    std::vector<std::thread> _threads;
+};
+
+#endif // hifi_OctreeSendThreadPool_h
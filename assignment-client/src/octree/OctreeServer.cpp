@@ -878,7 +878,13 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+
+    if (_sendThreadPool) {
+        sendThread->initialize(false);
+        _sendThreadPool->add(sendThread.get());
+    } else {
+        sendThread->initialize(true);
+    }
 
     return sendThread;
 }
@@ -886,6 +892,10 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
+        if (_sendThreadPool) {
+            _sendThreadPool->remove(sendThread);
+        }
+
         // This deletes the unique_ptr, so sendThread is destructed after that line
         _sendThreads.erase(sendThread->getNodeUuid());
     }
@@ -902,6 +912,9 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
+            if (_sendThreadPool) {
+                _sendThreadPool->remove(it->second.get());
+            }
             _sendThreads.erase(it); // Remove right away and wait on thread to be
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
@@ -1058,6 +1071,12 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistInterval=" << _persistInterval.count();
 
+        readOptionBool(QString("persistJournal"), settingsSectionObject, _persistJournal);
+        qDebug() << "persistJournal=" << _persistJournal;
+
+        readOptionBool(QString("persistSnapshot"), settingsSectionObject, _persistSnapshot);
+        qDebug() << "persistSnapshot=" << _persistSnapshot;
+
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
@@ -1097,6 +1116,14 @@ void OctreeServer::readConfiguration() {
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
 
+    // Check to see if the send threads should be run by a pool of workers, instead of a thread per client
+    int sendThreadPoolSize = 0;
+    if (readOptionInt(QString("sendThreadPoolSize"), settingsSectionObject, sendThreadPoolSize)
+        && sendThreadPoolSize > 0 && !_sendThreadPool) {
+        _sendThreadPool.reset(new OctreeSendThreadPool(sendThreadPoolSize));
+    }
+    qDebug("sendThreadPoolSize=%d", sendThreadPoolSize);
+
     readAdditionalConfiguration(settingsSectionObject);
 }
 
@@ -1186,7 +1213,7 @@ void OctreeServer::domainSettingsRequestComplete() {
 
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
-                                                 _persistAsFileType);
+                                                 _persistAsFileType, _persistJournal, _persistSnapshot);
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, &OctreePersistThread::start);
@@ -1295,6 +1322,9 @@ void OctreeServer::aboutToFinish() {
         sendThread.terminate();
     }
 
+    // Stops the pool's workers, so that none of them is left processing a send thread when it is destructed
+    _sendThreadPool.reset();
+
     // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
     // which waits on the thread to be done before returning
     _sendThreads.clear(); // Cleans up all the send threads.
@@ -24,6 +24,7 @@
 
 #include "OctreePersistThread.h"
 #include "OctreeSendThread.h"
+#include "OctreeSendThreadPool.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
 
@@ -195,6 +196,8 @@ protected:
 
     std::chrono::milliseconds _persistInterval;
     bool _persistFileDownload;
+    bool _persistJournal { false };
+    bool _persistSnapshot { false };
     int _maxBackupVersions;
 
     time_t _started;
@@ -202,6 +205,7 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    std::unique_ptr<OctreeSendThreadPool> _sendThreadPool; // null when each send thread has a thread of its own
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
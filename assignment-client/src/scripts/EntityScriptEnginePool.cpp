@@ -0,0 +1,266 @@
+//
+//  EntityScriptEnginePool.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePool.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonArray>
+
+#include <NumericalConstants.h>
+#include <UUID.h>
+
+// the weight of the latest interval in the scripts' average loads
+static const float LOAD_SMOOTHING = 0.25f;
+// engines closer than this, as a fraction of a thread, are left as they are
+static const float MIN_REBALANCE_LOAD = 0.1f;
+static const int MAX_REPORTED_SCRIPTS = 20;
+
+void EntityScriptEnginePool::setEngines(const std::vector<ScriptEnginePointer>& engines) {
+    QWriteLocker locker(&_lock);
+    _engines = engines;
+    _scripts.clear();
+}
+
+std::vector<ScriptEnginePointer> EntityScriptEnginePool::getEngines() const {
+    QReadLocker locker(&_lock);
+    return _engines;
+}
+
+int EntityScriptEnginePool::getNumEngines() const {
+    QReadLocker locker(&_lock);
+    return (int)_engines.size();
+}
+
+ScriptEnginePointer EntityScriptEnginePool::getEngine(const EntityItemID& entityID) const {
+    QReadLocker locker(&_lock);
+    auto it = _scripts.constFind(entityID);
+    if (it == _scripts.constEnd()) {
+        return ScriptEnginePointer();
+    }
+    return _engines[it->engineIndex];
+}
+
+int EntityScriptEnginePool::getEngineIndex(const EntityItemID& entityID) const {
+    QReadLocker locker(&_lock);
+    auto it = _scripts.constFind(entityID);
+    return it != _scripts.constEnd() ? it->engineIndex : -1;
+}
+
+ScriptEnginePointer EntityScriptEnginePool::assignEngine(const EntityItemID& entityID) {
+    QWriteLocker locker(&_lock);
+    if (_engines.empty()) {
+        return ScriptEnginePointer();
+    }
+    auto it = _scripts.find(entityID);
+    if (it == _scripts.end()) {
+        ScriptStats stats;
+        stats.engineIndex = pickEngine(entityID);
+        it = _scripts.insert(entityID, stats);
+    }
+    return _engines[it->engineIndex];
+}
+
+void EntityScriptEnginePool::unassignEngine(const EntityItemID& entityID) {
+    QWriteLocker locker(&_lock);
+    _scripts.remove(entityID);
+}
+
+QList<EntityItemID> EntityScriptEnginePool::getAssignedEntities() const {
+    QReadLocker locker(&_lock);
+    return _scripts.keys();
+}
+
+int EntityScriptEnginePool::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& engine : getEngines()) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+int EntityScriptEnginePool::pickEngine(const EntityItemID& entityID) const {
+    int numEngines = (int)_engines.size();
+    if (_placement == Placement::Hash || numEngines == 1) {
+        return (int)(qHash(entityID) % (uint)numEngines);
+    }
+
+    // the least busy engine, or the one with the fewest scripts while none of them have run long enough to tell
+    std::vector<float> loads(numEngines, 0.0f);
+    std::vector<int> numScripts(numEngines, 0);
+    for (const auto& stats : _scripts) {
+        loads[stats.engineIndex] += stats.load;
+        numScripts[stats.engineIndex]++;
+    }
+    int bestIndex = 0;
+    for (int i = 1; i < numEngines; i++) {
+        if (loads[i] < loads[bestIndex] || (loads[i] == loads[bestIndex] && numScripts[i] < numScripts[bestIndex])) {
+            bestIndex = i;
+        }
+    }
+    return bestIndex;
+}
+
+float EntityScriptEnginePool::getEngineLoad(int engineIndex) const {
+    float load = 0.0f;
+    for (const auto& stats : _scripts) {
+        if (stats.engineIndex == engineIndex) {
+            load += stats.load;
+        }
+    }
+    return load;
+}
+
+void EntityScriptEnginePool::updateRunTimes(quint64 interval) {
+    auto engines = getEngines();
+    std::vector<QHash<EntityItemID, quint64>> runTimes;
+    runTimes.reserve(engines.size());
+    for (const auto& engine : engines) {
+        runTimes.push_back(engine->takeEntityScriptRunTimes());
+    }
+
+    QWriteLocker locker(&_lock);
+    if (engines != _engines) {
+        return;
+    }
+    applyRunTimes(runTimes, interval);
+}
+
+void EntityScriptEnginePool::addRunTimes(const std::vector<QHash<EntityItemID, quint64>>& engineRunTimes, quint64 interval) {
+    QWriteLocker locker(&_lock);
+    if (engineRunTimes.size() != _engines.size()) {
+        return;
+    }
+    applyRunTimes(engineRunTimes, interval);
+}
+
+std::vector<float> EntityScriptEnginePool::getEngineLoads() const {
+    QReadLocker locker(&_lock);
+    std::vector<float> loads;
+    loads.reserve(_engines.size());
+    for (int i = 0; i < (int)_engines.size(); i++) {
+        loads.push_back(getEngineLoad(i));
+    }
+    return loads;
+}
+
+void EntityScriptEnginePool::applyRunTimes(const std::vector<QHash<EntityItemID, quint64>>& engineRunTimes, quint64 interval) {
+    for (auto it = _scripts.begin(); it != _scripts.end(); ++it) {
+        quint64 runTime = engineRunTimes[it->engineIndex].value(it.key(), 0);
+        it->totalRunTime += runTime;
+        float load = interval > 0 ? (float)runTime / (float)interval : 0.0f;
+        it->load += LOAD_SMOOTHING * (load - it->load);
+    }
+}
+
+bool EntityScriptEnginePool::rebalance(EntityItemID& entityID, ScriptEnginePointer& fromEngine) {
+    QWriteLocker locker(&_lock);
+    int numEngines = (int)_engines.size();
+    if (_placement != Placement::Load || numEngines < 2) {
+        return false;
+    }
+
+    std::vector<float> loads(numEngines, 0.0f);
+    for (const auto& stats : _scripts) {
+        loads[stats.engineIndex] += stats.load;
+    }
+    int busiestIndex = (int)(std::max_element(loads.begin(), loads.end()) - loads.begin());
+    int idlestIndex = (int)(std::min_element(loads.begin(), loads.end()) - loads.begin());
+    float loadGap = loads[busiestIndex] - loads[idlestIndex];
+    if (loadGap < MIN_REBALANCE_LOAD) {
+        return false;
+    }
+
+    // the busiest script that closes the gap without opening it the other way
+    auto bestIt = _scripts.end();
+    for (auto it = _scripts.begin(); it != _scripts.end(); ++it) {
+        if (it->engineIndex == busiestIndex && it->load > 0.0f && it->load <= 0.5f * loadGap &&
+            (bestIt == _scripts.end() || it->load > bestIt->load)) {
+            bestIt = it;
+        }
+    }
+    if (bestIt == _scripts.end()) {
+        return false;
+    }
+
+    fromEngine = _engines[busiestIndex];
+    bestIt->engineIndex = idlestIndex;
+    entityID = bestIt.key();
+    return true;
+}
+
+QJsonObject EntityScriptEnginePool::getStats() const {
+    QReadLocker locker(&_lock);
+    int numEngines = (int)_engines.size();
+
+    QJsonObject stats;
+    stats["placement"] = _placement == Placement::Load ? QString("load") : QString("hash");
+
+    QJsonArray engineStats;
+    for (int i = 0; i < numEngines; i++) {
+        int numScripts = 0;
+        for (const auto& script : _scripts) {
+            if (script.engineIndex == i) {
+                numScripts++;
+            }
+        }
+        QJsonObject engineObject;
+        engineObject["number_scripts"] = numScripts;
+        engineObject["number_running_scripts"] = _engines[i]->getNumRunningEntityScripts();
+        engineObject["load"] = getEngineLoad(i);
+        engineStats.append(engineObject);
+    }
+    stats["engines"] = engineStats;
+
+    std::vector<QHash<EntityItemID, ScriptStats>::const_iterator> scripts;
+    scripts.reserve(_scripts.size());
+    for (auto it = _scripts.constBegin(); it != _scripts.constEnd(); ++it) {
+        scripts.push_back(it);
+    }
+    int numReportedScripts = std::min((int)scripts.size(), MAX_REPORTED_SCRIPTS);
+    std::partial_sort(scripts.begin(), scripts.begin() + numReportedScripts, scripts.end(),
+                      [](const QHash<EntityItemID, ScriptStats>::const_iterator& a,
+                         const QHash<EntityItemID, ScriptStats>::const_iterator& b) {
+        return a->load > b->load;
+    });
+
+    QJsonObject scriptStats;
+    for (int i = 0; i < numReportedScripts; i++) {
+        QJsonObject scriptObject;
+        scriptObject["engine"] = scripts[i]->engineIndex;
+        scriptObject["load"] = scripts[i]->load;
+        scriptObject["total_run_time_ms"] = (double)scripts[i]->totalRunTime / USECS_PER_MSEC;
+        scriptStats[uuidStringWithoutCurlyBraces(scripts[i].key())] = scriptObject;
+    }
+    stats["busiest_scripts"] = scriptStats;
+
+    return stats;
+}
+
+void EntityScriptEnginePool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                    const QStringList& params, const QUuid& remoteCallerID) {
+    auto engine = getEngine(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptEnginePool::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEngine(entityID);
+    if (!engine) {
+        // an engine that doesn't run the script gives the same answer as no engine would
+        auto engines = getEngines();
+        if (engines.empty()) {
+            return QFuture<QVariant>();
+        }
+        engine = engines.front();
+    }
+    return engine->getLocalEntityScriptDetails(entityID);
+}
@@ -0,0 +1,87 @@
+//
+//  EntityScriptEnginePool.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePool_h
+#define hifi_EntityScriptEnginePool_h
+
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QReadWriteLock>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// Shards the entity scripts of the entity script server across several script engines, each running on its own
+// thread, so that a slow script only holds up the scripts that share its engine.
+//
+// An entity's script is placed on an engine by a hash of the entity ID, or on the engine that has been the least busy.
+// With the latter, rebalance() moves a script from the busiest engine to the least busy one when they drift apart.
+class EntityScriptEnginePool : public EntitiesScriptEngineProvider {
+public:
+    enum class Placement {
+        Hash = 0,
+        Load
+    };
+
+    void setEngines(const std::vector<ScriptEnginePointer>& engines);
+    std::vector<ScriptEnginePointer> getEngines() const;
+    int getNumEngines() const;
+
+    void setPlacement(Placement placement) { _placement = placement; }
+    Placement getPlacement() const { return _placement; }
+
+    // the engine the entity's script runs on, or null if it hasn't been given one
+    ScriptEnginePointer getEngine(const EntityItemID& entityID) const;
+    // the index of that engine, or -1
+    int getEngineIndex(const EntityItemID& entityID) const;
+    // the engine the entity's script runs on, which is picked for it if it hasn't been given one
+    ScriptEnginePointer assignEngine(const EntityItemID& entityID);
+    void unassignEngine(const EntityItemID& entityID);
+    QList<EntityItemID> getAssignedEntities() const;
+
+    int getNumRunningEntityScripts() const;
+
+    // collects the time the scripts have spent running since the last update, which was interval usecs ago
+    void updateRunTimes(quint64 interval);
+    // the same with the run times already taken from each of the engines, in order
+    void addRunTimes(const std::vector<QHash<EntityItemID, quint64>>& engineRunTimes, quint64 interval);
+    // the fraction of a thread each engine's scripts have taken, on average
+    std::vector<float> getEngineLoads() const;
+
+    // picks a script to move from the busiest engine to the least busy one, returns false if the engines are balanced
+    // enough.  the script is then to be unloaded from fromEngine and loaded on getEngine(entityID).
+    bool rebalance(EntityItemID& entityID, ScriptEnginePointer& fromEngine);
+
+    QJsonObject getStats() const;
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    struct ScriptStats {
+        int engineIndex { -1 };
+        float load { 0.0f };  // the fraction of a thread the script has taken, on average
+        quint64 totalRunTime { 0 };  // usecs
+    };
+
+    int pickEngine(const EntityItemID& entityID) const;
+    float getEngineLoad(int engineIndex) const;
+    void applyRunTimes(const std::vector<QHash<EntityItemID, quint64>>& engineRunTimes, quint64 interval);
+
+    mutable QReadWriteLock _lock;
+    std::vector<ScriptEnginePointer> _engines;
+    QHash<EntityItemID, ScriptStats> _scripts;
+    Placement _placement { Placement::Hash };
+};
+
+#endif // hifi_EntityScriptEnginePool_h
@@ -96,6 +96,12 @@ EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssig
     timer->setInterval(LOG_INTERVAL);
     connect(timer, &QTimer::timeout, this, &EntityScriptServer::pushLogs);
     timer->start();
+
+    static const int REBALANCE_INTERVAL = MSECS_PER_SECOND;
+    auto rebalanceTimer = new QTimer(this);
+    rebalanceTimer->setInterval(REBALANCE_INTERVAL);
+    connect(rebalanceTimer, &QTimer::timeout, this, &EntityScriptServer::rebalanceEntityScripts);
+    rebalanceTimer->start();
 }
 
 EntityScriptServer::~EntityScriptServer() {
@@ -125,7 +131,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = _entitiesScriptEngines->getEngine(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -154,6 +161,26 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString SCRIPT_ENGINES_OPTION = "script_engines";
+    static const QString SCRIPT_PLACEMENT_OPTION = "script_placement";
+    static const int MAX_SCRIPT_ENGINES = 16;
+
+    if (entityScriptServerSettings.contains(SCRIPT_PLACEMENT_OPTION)) {
+        bool isLoadPlacement = entityScriptServerSettings[SCRIPT_PLACEMENT_OPTION].toString() == "load";
+        _entitiesScriptEngines->setPlacement(isLoadPlacement ? EntityScriptEnginePool::Placement::Load
+                                                             : EntityScriptEnginePool::Placement::Hash);
+    }
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINES_OPTION)) {
+        int numEngines = std::min(std::max(1, entityScriptServerSettings[SCRIPT_ENGINES_OPTION].toInt()), MAX_SCRIPT_ENGINES);
+        if (numEngines != _numEntitiesScriptEngines) {
+            _numEntitiesScriptEngines = numEngines;
+            qCDebug(entity_script_server) << "Running the entity scripts on" << _numEntitiesScriptEngines << "script engines";
+            if (_entitiesScriptEngines->getNumEngines() > 0 && !_shuttingDown) {
+                restartEntitiesScriptEngines();
+            }
+        }
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -170,7 +197,7 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entitiesScriptEngines->getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -231,7 +258,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -245,7 +272,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -276,8 +303,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -439,65 +466,103 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
-    auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
-
-    auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
-    newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+                   this, &EntityScriptServer::updateEntityPPS);
+    }
 
-    newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
-    newEngine->registerGlobalObject("AvatarList", DependencyManager::get<AvatarHashMap>().data());
+    std::vector<ScriptEnginePointer> newEngines;
+    for (int i = 0; i < _numEntitiesScriptEngines; i++) {
+        auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+        auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
+
+        auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
+        newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+
+        newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
+        newEngine->registerGlobalObject("AvatarList", DependencyManager::get<AvatarHashMap>().data());
+
+        // connect this script engines printedMessage signal to the global ScriptEngines these various messages
+        auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
+        connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
+        connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
+        connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
+        connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+
+        // the entity tree is updated along with the first engine only
+        if (i == 0) {
+            connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+                _entityViewer.queryOctree();
+                _entityViewer.getTree()->preUpdate();
+                _entityViewer.getTree()->update();
+            });
+        }
 
-    // connect this script engines printedMessage signal to the global ScriptEngines these various messages
-    auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
-    connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
-    connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
-    connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
-    connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+        scriptEngines->runScriptInitializers(newEngine);
+        newEngine->runInThread();
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+        connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+                this, &EntityScriptServer::updateEntityPPS);
+        newEngines.push_back(newEngine);
+    }
 
-    scriptEngines->runScriptInitializers(newEngine);
-    newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
+    _entitiesScriptEngines->setEngines(newEngines);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(_entitiesScriptEngines);
+    _lastRebalanceTime = usecTimestampNow();
+}
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    auto engines = _entitiesScriptEngines->getEngines();
+    for (const auto& engine : engines) {
+        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
+        engine->unloadAllEntityScripts();
+        engine->stop();
     }
+    for (const auto& engine : engines) {
+        engine->waitTillDoneRunning();
+    }
+}
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+void EntityScriptServer::restartEntitiesScriptEngines() {
+    // the scripts are loaded again, spread over the new engines
+    auto entityIDs = _entitiesScriptEngines->getAssignedEntities();
+    stopEntitiesScriptEngines();
+    resetEntitiesScriptEngines();
+    for (const auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
+    }
 }
 
+void EntityScriptServer::rebalanceEntityScripts() {
+    quint64 now = usecTimestampNow();
+    _entitiesScriptEngines->updateRunTimes(now - _lastRebalanceTime);
+    _lastRebalanceTime = now;
+
+    EntityItemID entityID;
+    ScriptEnginePointer fromEngine;
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines->rebalance(entityID, fromEngine)) {
+        qCDebug(entity_script_server) << "Moving the script of" << entityID << "to a less busy script engine";
+        fromEngine->unloadEntityScript(entityID, true);
+        checkAndCallPreload(entityID);
+    }
+}
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
-        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
-    }
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (const auto& engine : _entitiesScriptEngines->getEngines()) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -506,7 +571,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines->setEngines(std::vector<ScriptEnginePointer>());
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -524,8 +589,12 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        auto engine = _entitiesScriptEngines->getEngine(entityID);
+        if (engine) {
+            engine->unloadEntityScript(entityID, true);
+        }
+        _entitiesScriptEngines->unassignEngine(entityID);
     }
 }
 
@@ -536,20 +605,23 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines->getNumEngines() > 0) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        auto engine = _entitiesScriptEngines->getEngine(entityID);
+        bool isRunning = engine && engine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                engine->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                _entitiesScriptEngines->assignEngine(entityID)->loadEntityScript(entityID, scriptUrl, forceRedownload);
+            } else {
+                _entitiesScriptEngines->unassignEngine(entityID);
             }
         }
     }
@@ -564,13 +636,8 @@ void EntityScriptServer::sendStatsPacket() {
     octreeStats["leafElementCount"] = (double)OctreeElement::getLeafNodeCount();
     statsObject["octree_stats"] = octreeStats;
 
-    QJsonObject scriptEngineStats;
-    int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
-    }
-    scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+    QJsonObject scriptEngineStats = _entitiesScriptEngines->getStats();
+    scriptEngineStats["number_running_scripts"] = _entitiesScriptEngines->getNumRunningEntityScripts();
     statsObject["script_engine_stats"] = scriptEngineStats;
     
 
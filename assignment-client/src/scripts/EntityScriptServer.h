@@ -24,6 +24,7 @@
 #include <SimpleEntitySimulation.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptEnginePool.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -53,6 +54,7 @@ private slots:
     void handleEntityServerScriptLogPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void pushLogs();
+    void rebalanceEntityScripts();
 
     void handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
@@ -61,7 +63,9 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    void restartEntitiesScriptEngines();
+    void stopEntitiesScriptEngines();
     void clear();
     void shutdownScriptEngine();
 
@@ -75,7 +79,9 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    QSharedPointer<EntityScriptEnginePool> _entitiesScriptEngines { QSharedPointer<EntityScriptEnginePool>::create() };
+    int _numEntitiesScriptEngines { 1 };
+    quint64 _lastRebalanceTime { 0 };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
@@ -25,6 +25,11 @@ macro(TARGET_BULLET)
       target_include_directories(${TARGET_NAME} SYSTEM PRIVATE ${BULLET_INCLUDE_DIRS})
     endif()
     target_link_libraries(${TARGET_NAME} ${BULLET_LIBRARIES})
+    if (NOT ANDROID)
+      # our Bullet port is built with BULLET2_MULTITHREADING, so its headers must see the same BT_THREADSAFE it was built with.
+      # like the include directories, this stays private: every target that includes Bullet headers calls target_bullet()
+      target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
+    endif()
 endmacro()
 
 
@@ -11,15 +11,13 @@
 
 #include "DomainGatekeeper.h"
 
-#include <openssl/err.h>
-#include <openssl/rsa.h>
-#include <openssl/x509.h>
 #include <random>
 
 #include <QDataStream>
 
 #include <AccountManager.h>
 #include <Assignment.h>
+#include <ThreadHelpers.h>
 
 #include "DomainServer.h"
 #include "DomainServerNodeData.h"
@@ -30,6 +28,16 @@ DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
     initLocalIDManagement();
+
+    // the results are handled back on our thread, all of those ready by then together
+    _signatureVerifier.reset(new UserSignatureVerifier(getWorkerPoolThreadCount(), [this] {
+        QMetaObject::invokeMethod(this, "processVerifiedSignatures", Qt::QueuedConnection);
+    }));
+}
+
+DomainGatekeeper::~DomainGatekeeper() {
+    // stop the verifier threads while we can still be called back
+    _signatureVerifier.reset();
 }
 
 void DomainGatekeeper::addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
@@ -104,40 +112,12 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             }
         }
 
-        node = processAgentConnectRequest(nodeConnection, username, usernameSignature);
+        node = processAgentConnectRequest(nodeConnection, username, usernameSignature, message->getFirstPacketReceiveTime());
     }
 
     if (node) {
-        // set the sending sock addr and node interest set on this node
-        DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-        nodeData->setSendingSockAddr(message->getSenderSockAddr());
-
-        // guard against patched agents asking to hear about other agents
-        auto safeInterestSet = QSet<NodeType_t>(
-            nodeConnection.interestList.begin(),
-            nodeConnection.interestList.end()
-        );
-        if (nodeConnection.nodeType == NodeType::Agent) {
-            safeInterestSet.remove(NodeType::Agent);
-        }
-
-        nodeData->setNodeInterestSet(safeInterestSet);
-        nodeData->setPlaceName(nodeConnection.placeName);
-
-        QMetaEnum metaEnum = QMetaEnum::fromType<LimitedNodeList::ConnectReason>();
-        qDebug() << "Allowed connection from node" << uuidStringWithoutCurlyBraces(node->getUUID()) 
-            << "on" << message->getSenderSockAddr() 
-            << "with MAC" << nodeConnection.hardwareAddress 
-            << "and machine fingerprint" << nodeConnection.machineFingerprint 
-            << "user" << username 
-            << "reason" << QString(metaEnum.valueToKey(nodeConnection.connectReason))
-            << "previous connection uptime" << nodeConnection.previousConnectionUpTime/USECS_PER_MSEC << "msec"
-            << "sysinfo" << nodeConnection.SystemInfo;
-
-        // signal that we just connected a node so the DomainServer can get it a list
-        // and broadcast its presence right away
-        emit connectedNode(node, message->getFirstPacketReceiveTime());
-    } else {
+        finishConnectRequest(node, nodeConnection, username, message->getFirstPacketReceiveTime());
+    } else if (!_usernamesBeingVerified.contains(username.toLower())) {
         qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
             << "with hardware address" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint
@@ -145,6 +125,39 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
     }
 }
 
+void DomainGatekeeper::finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection,
+                                            const QString& username, quint64 requestReceiveTime) {
+    // set the sending sock addr and node interest set on this node
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    nodeData->setSendingSockAddr(nodeConnection.senderSockAddr);
+
+    // guard against patched agents asking to hear about other agents
+    auto safeInterestSet = QSet<NodeType_t>(
+        nodeConnection.interestList.begin(),
+        nodeConnection.interestList.end()
+    );
+    if (nodeConnection.nodeType == NodeType::Agent) {
+        safeInterestSet.remove(NodeType::Agent);
+    }
+
+    nodeData->setNodeInterestSet(safeInterestSet);
+    nodeData->setPlaceName(nodeConnection.placeName);
+
+    QMetaEnum metaEnum = QMetaEnum::fromType<LimitedNodeList::ConnectReason>();
+    qDebug() << "Allowed connection from node" << uuidStringWithoutCurlyBraces(node->getUUID()) 
+        << "on" << nodeConnection.senderSockAddr 
+        << "with MAC" << nodeConnection.hardwareAddress 
+        << "and machine fingerprint" << nodeConnection.machineFingerprint 
+        << "user" << username 
+        << "reason" << QString(metaEnum.valueToKey(nodeConnection.connectReason))
+        << "previous connection uptime" << nodeConnection.previousConnectionUpTime/USECS_PER_MSEC << "msec"
+        << "sysinfo" << nodeConnection.SystemInfo;
+
+    // signal that we just connected a node so the DomainServer can get it a list
+    // and broadcast its presence right away
+    emit connectedNode(node, requestReceiveTime);
+}
+
 NodePermissions DomainGatekeeper::setPermissionsForUser(bool isLocalUser, QString verifiedUsername, const QHostAddress& senderAddress,
                                                         const QString& hardwareAddress, const QUuid& machineFingerprint) {
     NodePermissions userPerms;
@@ -210,71 +223,94 @@ NodePermissions DomainGatekeeper::setPermissionsForUser(bool isLocalUser, QStrin
 #endif
         } else {
             // they are logged into metaverse, but we don't have specific permissions for them.
-            userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameLoggedIn);
+            const auto& groupPermissions = getUserGroupPermissions(verifiedUsername);
+            userPerms.permissions |= groupPermissions.granted;
+            userPerms.permissions &= ~groupPermissions.forbidden;
+        }
+
+        userPerms.setID(verifiedUsername);
+        userPerms.setVerifiedUserName(verifiedUsername);
+    }
+
 #ifdef WANT_DEBUG
-            qDebug() << "|  user-permissions: user is logged-into metaverse, so:" << userPerms;
+    qDebug() << "|  user-permissions: final:" << userPerms;
 #endif
+    return userPerms;
+}
 
-            // if this user is a friend of the domain-owner, give them friend's permissions
-            if (_domainOwnerFriends.contains(verifiedUsername)) {
-                userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameFriends);
+const DomainGatekeeper::UserGroupPermissions& DomainGatekeeper::getUserGroupPermissions(const QString& verifiedUsername) {
+    // everything cached was worked out from permissions settings that have changed since
+    auto permissionsVersion = _server->_settingsManager.getPermissionsVersion();
+    if (permissionsVersion != _userGroupPermissionsVersion) {
+        _userGroupPermissions.clear();
+        _userGroupPermissionsVersion = permissionsVersion;
+    }
+
+    auto it = _userGroupPermissions.find(verifiedUsername);
+    if (it != _userGroupPermissions.end()) {
+        return it.value();
+    }
+
+    NodePermissions userPerms;
+    userPerms.setAll(false);
+    NodePermissions forbiddenPerms;
+    forbiddenPerms.setAll(false);
+
+    userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameLoggedIn);
 #ifdef WANT_DEBUG
-                qDebug() << "|  user-permissions: user is friends with domain-owner, so:" << userPerms;
+    qDebug() << "|  user-permissions: user is logged-into metaverse, so:" << userPerms;
 #endif
-            }
-
-            // if this user is a known member of a group, give them the implied permissions
-            foreach (QUuid groupID, _server->_settingsManager.getGroupIDs()) {
-                QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
-                if (rankID != QUuid()) {
-                    userPerms |= _server->_settingsManager.getPermissionsForGroup(groupID, rankID);
 
-                    GroupRank rank = _server->_settingsManager.getGroupRank(groupID, rankID);
+    // if this user is a friend of the domain-owner, give them friend's permissions
+    if (_domainOwnerFriends.contains(verifiedUsername)) {
+        userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameFriends);
 #ifdef WANT_DEBUG
-                    qDebug() << "|  user-permissions: user " << verifiedUsername << "is in group:" << groupID << " rank:"
-                             << rank.name << "so:" << userPerms;
+        qDebug() << "|  user-permissions: user is friends with domain-owner, so:" << userPerms;
 #endif
-                }
-            }
+    }
 
-            // if this user is a known member of a blacklist group, remove the implied permissions
-            foreach (QUuid groupID, _server->_settingsManager.getBlacklistGroupIDs()) {
-                QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
-                if (rankID != QUuid()) {
-                    QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
-                    if (rankID != QUuid()) {
-                        userPerms &= ~_server->_settingsManager.getForbiddensForGroup(groupID, rankID);
+    // if this user is a known member of a group, give them the implied permissions
+    foreach (QUuid groupID, _server->_settingsManager.getGroupIDs()) {
+        QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
+        if (rankID != QUuid()) {
+            userPerms |= _server->_settingsManager.getPermissionsForGroup(groupID, rankID);
 
-                        GroupRank rank = _server->_settingsManager.getGroupRank(groupID, rankID);
+            GroupRank rank = _server->_settingsManager.getGroupRank(groupID, rankID);
 #ifdef WANT_DEBUG
-                        qDebug() << "|  user-permissions: user is in blacklist group:" << groupID << " rank:" << rank.name
-                                 << "so:" << userPerms;
+            qDebug() << "|  user-permissions: user " << verifiedUsername << "is in group:" << groupID << " rank:"
+                     << rank.name << "so:" << userPerms;
 #endif
-                    }
-                }
-            }
         }
-
-        userPerms.setID(verifiedUsername);
-        userPerms.setVerifiedUserName(verifiedUsername);
     }
 
+    // if this user is a known member of a blacklist group, remove the implied permissions
+    foreach (QUuid groupID, _server->_settingsManager.getBlacklistGroupIDs()) {
+        QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
+        if (rankID != QUuid()) {
+            forbiddenPerms |= _server->_settingsManager.getForbiddensForGroup(groupID, rankID);
+
+            GroupRank rank = _server->_settingsManager.getGroupRank(groupID, rankID);
 #ifdef WANT_DEBUG
-    qDebug() << "|  user-permissions: final:" << userPerms;
+            qDebug() << "|  user-permissions: user is in blacklist group:" << groupID << " rank:" << rank.name
+                     << "so forbidden:" << forbiddenPerms;
 #endif
-    return userPerms;
+        }
+    }
+
+    return _userGroupPermissions.insert(verifiedUsername, { userPerms.permissions, forbiddenPerms.permissions }).value();
 }
 
 void DomainGatekeeper::updateNodePermissions() {
     // If the permissions were changed on the domain-server webpage (and nothing else was), a restart isn't required --
-    // we reprocess the permissions map and update the nodes here.  The node list is frequently sent out to all
-    // the connected nodes, so these changes are propagated to other nodes.
+    // we reprocess the permissions map and update the nodes here.  The nodes whose permissions changed are sent out
+    // to the other connected nodes with the next domain list update.
 
     QList<SharedNodePointer> nodesToKill;
+    QList<SharedNodePointer> changedNodes;
 
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
     QWeakPointer<LimitedNodeList> limitedNodeListWeak = limitedNodeList;
-    limitedNodeList->eachNode([this, limitedNodeListWeak, &nodesToKill](const SharedNodePointer& node){
+    limitedNodeList->eachNode([this, limitedNodeListWeak, &nodesToKill, &changedNodes](const SharedNodePointer& node){
         // the id and the username in NodePermissions will often be the same, but id is set before
         // authentication and verifiedUsername is only set once they user's key has been confirmed.
         QString verifiedUsername = node->getPermissions().getVerifiedUserName();
@@ -315,6 +351,9 @@ void DomainGatekeeper::updateNodePermissions() {
             userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        if (node->getPermissions().permissions != userPerms.permissions) {
+            changedNodes << node;
+        }
         node->setPermissions(userPerms);
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
@@ -324,6 +363,10 @@ void DomainGatekeeper::updateNodePermissions() {
         }
     });
 
+    foreach (auto node, changedNodes) {
+        emit nodePermissionsChanged(node);
+    }
+
     foreach (auto node, nodesToKill) {
         emit killNode(node);
     }
@@ -395,20 +438,8 @@ const QString MAXIMUM_USER_CAPACITY_REDIRECT_LOCATION = "security.maximum_user_c
 
 SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                                const QString& username,
-                                                               const QByteArray& usernameSignature) {
-
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-
-    // start with empty permissions
-    NodePermissions userPerms(NodePermissionsKey(username, 0));
-    userPerms.setAll(false);
-
-    // check if this user is on our local machine - if this is true set permissions to those for a "localhost" connection
-    QHostAddress senderHostAddress = nodeConnection.senderSockAddr.getAddress();
-    bool isLocalUser =
-        (senderHostAddress == limitedNodeList->getLocalSockAddr().getAddress() || senderHostAddress == QHostAddress::LocalHost);
-
-    QString verifiedUsername; // if this remains empty, consider this an anonymous connection attempt
+                                                               const QByteArray& usernameSignature,
+                                                               quint64 requestReceiveTime) {
     if (!username.isEmpty()) {
         const QUuid& connectionToken = _connectionTokenHash.value(username.toLower());
 
@@ -421,23 +452,29 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             getGroupMemberships(username); // optimistically get started on group memberships
 #ifdef WANT_DEBUG
             qDebug() << "stalling login because we have no username-signature:" << username;
-#endif
-            return SharedNodePointer();
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username.toLower();
-        } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
-#ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
 #endif
             return SharedNodePointer();
         }
+
+        // the connection carries on once the signature has been checked
+        startUserSignatureCheck(nodeConnection, username, usernameSignature, requestReceiveTime);
+        return SharedNodePointer();
     }
 
-    userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, nodeConnection.senderSockAddr.getAddress(),
+    // no username, this is an anonymous connection attempt
+    return admitAgent(nodeConnection, username, QString());
+}
+
+SharedNodePointer DomainGatekeeper::admitAgent(const NodeConnectionData& nodeConnection, const QString& username,
+                                               const QString& verifiedUsername) {
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // check if this user is on our local machine - if this is true set permissions to those for a "localhost" connection
+    QHostAddress senderHostAddress = nodeConnection.senderSockAddr.getAddress();
+    bool isLocalUser =
+        (senderHostAddress == limitedNodeList->getLocalSockAddr().getAddress() || senderHostAddress == QHostAddress::LocalHost);
+
+    NodePermissions userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, nodeConnection.senderSockAddr.getAddress(),
                                       nodeConnection.hardwareAddress, nodeConnection.machineFingerprint);
 
     if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
@@ -561,81 +598,82 @@ void DomainGatekeeper::cleanupICEPeerForNode(const QUuid& nodeID) {
     }
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const HifiSockAddr& senderSockAddr) {
-    // it's possible this user can be allowed to connect, but we need to check their username signature
+void DomainGatekeeper::startUserSignatureCheck(const NodeConnectionData& nodeConnection, const QString& username,
+                                               const QByteArray& usernameSignature, quint64 requestReceiveTime) {
     auto lowerUsername = username.toLower();
-    KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
-
-    QByteArray publicKeyArray = publicKeyPair.first;
-    bool isOptimisticKey = publicKeyPair.second;
+    if (_usernamesBeingVerified.contains(lowerUsername)) {
+        // the client sends its connect request a few times while waiting, we're already checking this one
+        return;
+    }
 
+    // it's possible this user can be allowed to connect, but we need to check their username signature
+    KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
     const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
-        // if we do have a public key for the user, check for a signature match
+    if (publicKeyPair.first.isEmpty() || connectionToken.isNull()) {
+        qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
+        requestUserPublicKey(username); // no joy.  maybe next time?
+        return;
+    }
 
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
+    QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
+    QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
+                                                            QCryptographicHash::Sha256);
 
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+    quint64 checkID = ++_lastSignatureCheckID;
+    _pendingSignatureChecks.insert(checkID, { nodeConnection, username, publicKeyPair.second, requestReceiveTime });
+    _usernamesBeingVerified.insert(lowerUsername);
 
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
+    _signatureVerifier->verify({ checkID, publicKeyPair.first, usernameWithToken, usernameSignature });
+}
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+void DomainGatekeeper::processVerifiedSignatures() {
+    for (const auto& check : _signatureVerifier->takeResults()) {
+        PendingSignatureCheck pendingCheck = _pendingSignatureChecks.take(check.id);
+        const QString& username = pendingCheck.username;
+        const HifiSockAddr& senderSockAddr = pendingCheck.nodeConnection.senderSockAddr;
+        auto lowerUsername = username.toLower();
+        _usernamesBeingVerified.remove(lowerUsername);
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+        if (check.result == UserSignatureVerifier::Result::Verified) {
+            qDebug() << "Username signature matches for" << username;
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+            // remove connection token now that it was used
+            _connectionTokenHash.remove(lowerUsername);
 
-                return true;
+            // they sent us a username and the signature verifies it
+            getGroupMemberships(username);
 
+            auto node = admitAgent(pendingCheck.nodeConnection, username, lowerUsername);
+            if (node) {
+                finishConnectRequest(node, pendingCheck.nodeConnection, username, pendingCheck.requestReceiveTime);
             } else {
-                // we only send back a LoginError if this wasn't an "optimistic" key
-                // (a key that we hoped would work but is probably stale)
-
-                if (!senderSockAddr.isNull() && !isOptimisticKey) {
-                    qDebug() << "Error decrypting username signature for" << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginError);
-                } else if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting username signature for" << username << "with optimisitic key -"
-                        << "re-requesting public key and delaying connection";
-                }
-
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
+                qDebug() << "Refusing connection from node at" << senderSockAddr
+                    << "with hardware address" << pendingCheck.nodeConnection.hardwareAddress
+                    << "and machine fingerprint" << pendingCheck.nodeConnection.machineFingerprint;
             }
+            continue;
+        }
 
-        } else {
-
+        if (check.result == UserSignatureVerifier::Result::InvalidKey) {
             // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-            if (!senderSockAddr.isNull()) {
-                qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
-                sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
-                    DomainHandler::ConnectionRefusedReason::LoginError);
-            }
-        }
-    } else {
-        if (!senderSockAddr.isNull()) {
-            qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
+            qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
+            sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginError);
+        } else if (!pendingCheck.isOptimisticKey) {
+            // we only send back a LoginError if this wasn't an "optimistic" key
+            // (a key that we hoped would work but is probably stale)
+            qDebug() << "Error decrypting username signature for" << username << "- denying connection.";
+            sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginError);
+        } else {
+            qDebug() << "Error decrypting username signature for" << username << "with optimisitic key -"
+                << "re-requesting public key and delaying connection";
         }
-    }
 
-    requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+        // they sent us a username, but it didn't check out
+        requestUserPublicKey(username);
+    }
 }
 
 bool DomainGatekeeper::isWithinMaxCapacity() {
@@ -953,6 +991,9 @@ void DomainGatekeeper::getIsGroupMemberJSONCallback(QNetworkReply* requestReply)
             QUuid rankID = QUuid(rank["id"].toString());
             _server->_settingsManager.recordGroupMembership(username, groupID, rankID);
         }
+
+        // their permissions have to be worked out again with their new groups
+        _userGroupPermissions.remove(username.toLower());
     } else {
         qDebug() << "getIsGroupMember api call returned:" << QJsonDocument(jsonObject).toJson(QJsonDocument::Compact);
     }
@@ -1000,6 +1041,7 @@ void DomainGatekeeper::getDomainOwnerFriendsListJSONCallback(QNetworkReply* requ
     QJsonObject jsonObject = QJsonDocument::fromJson(requestReply->readAll()).object();
     if (jsonObject["status"].toString() == "success") {
         _domainOwnerFriends.clear();
+        _userGroupPermissions.clear();
         QJsonArray friends = jsonObject["data"].toObject()["friends"].toArray();
         for (int i = 0; i < friends.size(); i++) {
             _domainOwnerFriends += friends.at(i).toString().toLower();
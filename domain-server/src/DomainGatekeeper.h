@@ -14,6 +14,7 @@
 #ifndef hifi_DomainGatekeeper_h
 #define hifi_DomainGatekeeper_h
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -28,6 +29,7 @@
 
 #include "NodeConnectionData.h"
 #include "PendingAssignedNodeData.h"
+#include "UserSignatureVerifier.h"
 
 class DomainServer;
 
@@ -35,6 +37,7 @@ class DomainGatekeeper : public QObject {
     Q_OBJECT
 public:
     DomainGatekeeper(DomainServer* server);
+    ~DomainGatekeeper();
     
     void addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
                                 const QUuid& walletUUID, const QString& nodeVersion);
@@ -64,6 +67,7 @@ public slots:
 
 signals:
     void killNode(SharedNodePointer node);
+    void nodePermissionsChanged(SharedNodePointer node);
     void connectedNode(SharedNodePointer node, quint64 requestReceiveTime);
 
 public slots:
@@ -71,16 +75,22 @@ public slots:
 
 private slots:
     void handlePeerPingTimeout();
+    void processVerifiedSignatures();
 private:
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
     SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
                                                  const QString& username,
-                                                 const QByteArray& usernameSignature);
+                                                 const QByteArray& usernameSignature,
+                                                 quint64 requestReceiveTime);
+    SharedNodePointer admitAgent(const NodeConnectionData& nodeConnection, const QString& username,
+                                 const QString& verifiedUsername);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection);
+    void finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection,
+                              const QString& username, quint64 requestReceiveTime);
     
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const HifiSockAddr& senderSockAddr);
+    void startUserSignatureCheck(const NodeConnectionData& nodeConnection, const QString& username,
+                                 const QByteArray& usernameSignature, quint64 requestReceiveTime);
     bool isWithinMaxCapacity();
     
     bool shouldAllowConnectionFromNode(const QString& username, const QByteArray& usernameSignature,
@@ -120,9 +130,31 @@ private:
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
 
+    // connect requests waiting for their username signature to be checked
+    struct PendingSignatureCheck {
+        NodeConnectionData nodeConnection;
+        QString username;
+        bool isOptimisticKey;
+        quint64 requestReceiveTime;
+    };
+    std::unique_ptr<UserSignatureVerifier> _signatureVerifier;
+    QHash<quint64, PendingSignatureCheck> _pendingSignatureChecks;
+    QSet<QString> _usernamesBeingVerified;
+    quint64 _lastSignatureCheckID { 0 };
+
     NodePermissions setPermissionsForUser(bool isLocalUser, QString verifiedUsername, const QHostAddress& senderAddress, 
                                           const QString& hardwareAddress, const QUuid& machineFingerprint);
 
+    // the permissions a logged in user without specific permissions gets from being logged in, being a friend of the
+    // domain owner and from their groups, cached until their groups or the permissions settings change
+    struct UserGroupPermissions {
+        NodePermissions::Permissions granted;
+        NodePermissions::Permissions forbidden;
+    };
+    const UserGroupPermissions& getUserGroupPermissions(const QString& verifiedUsername);
+    QHash<QString, UserGroupPermissions> _userGroupPermissions;
+    quint64 _userGroupPermissionsVersion { 0 };
+
     void getGroupMemberships(const QString& username);
     // void getIsGroupMember(const QString& username, const QUuid groupID);
     void getDomainOwnerFriendsList();
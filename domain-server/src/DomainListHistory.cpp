@@ -0,0 +1,72 @@
+//
+//  DomainListHistory.cpp
+//  domain-server/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListHistory.h"
+
+#include <algorithm>
+
+// enough for every node of a busy domain to join and leave again before anyone needs the whole list
+static const size_t MAX_CHANGES = 4096;
+
+void DomainListHistory::nodeChanged(const QUuid& nodeUUID) {
+    _pendingChanges.push_back({ 0, nodeUUID, NodeType::Unassigned, false });
+}
+
+void DomainListHistory::nodeRemoved(const QUuid& nodeUUID, NodeType_t nodeType) {
+    _pendingChanges.push_back({ 0, nodeUUID, nodeType, true });
+}
+
+DomainListHistory::Version DomainListHistory::commitPendingChanges() {
+    if (_pendingChanges.empty()) {
+        return _version;
+    }
+
+    ++_version;
+    for (auto& change : _pendingChanges) {
+        change.version = _version;
+        _changes.push_back(change);
+    }
+    _pendingChanges.clear();
+
+    // drop whole versions, the changes since a version are either all known or not at all
+    while (_changes.size() > MAX_CHANGES) {
+        Version droppedVersion = _changes.front().version;
+        while (!_changes.empty() && _changes.front().version == droppedVersion) {
+            _changes.pop_front();
+        }
+        _oldestVersion = droppedVersion;
+    }
+
+    return _version;
+}
+
+bool DomainListHistory::hasChangesSince(Version version) const {
+    return version != 0 && version >= _oldestVersion && version <= _version;
+}
+
+DomainListHistory::Changes DomainListHistory::getChangesSince(Version version) const {
+    Changes changes;
+
+    auto firstChange = std::upper_bound(_changes.begin(), _changes.end(), version, [](Version version, const Change& change) {
+        return version < change.version;
+    });
+
+    for (auto it = firstChange; it != _changes.end(); ++it) {
+        if (it->isRemoval) {
+            changes.changedNodes.remove(it->nodeUUID);
+            changes.removedNodes.insert(it->nodeUUID, it->nodeType);
+        } else {
+            changes.removedNodes.remove(it->nodeUUID);
+            changes.changedNodes.insert(it->nodeUUID);
+        }
+    }
+
+    return changes;
+}
@@ -0,0 +1,65 @@
+//
+//  DomainListHistory.h
+//  domain-server/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListHistory_h
+#define hifi_DomainListHistory_h
+
+#include <deque>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QUuid>
+
+#include <NodeType.h>
+
+// The recent changes to the domain list, so that nodes can be sent what changed since the version of the list they have
+// instead of the whole list.
+//
+// Changes are collected until they are committed, all the changes committed together make up the next version.
+// Only a limited number of changes are kept, a node with an older version than that is sent the whole list again.
+class DomainListHistory {
+public:
+    // 0 is never a version of the list, nodes that have no list report it
+    using Version = quint32;
+
+    struct Changes {
+        // the nodes that were added or whose entry changed
+        QSet<QUuid> changedNodes;
+        QHash<QUuid, NodeType_t> removedNodes;
+    };
+
+    Version getVersion() const { return _version; }
+
+    void nodeChanged(const QUuid& nodeUUID);
+    void nodeRemoved(const QUuid& nodeUUID, NodeType_t nodeType);
+
+    bool hasPendingChanges() const { return !_pendingChanges.empty(); }
+    Version commitPendingChanges();
+
+    bool hasChangesSince(Version version) const;
+    Changes getChangesSince(Version version) const;
+
+private:
+    struct Change {
+        Version version;
+        QUuid nodeUUID;
+        NodeType_t nodeType;
+        bool isRemoval;
+    };
+
+    Version _version { 1 };
+    Version _oldestVersion { 1 };
+
+    std::vector<Change> _pendingChanges;
+    std::deque<Change> _changes;
+};
+
+#endif // hifi_DomainListHistory_h
@@ -225,6 +225,11 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     // if a connected node loses connection privileges, hang up on it
     connect(&_gatekeeper, &DomainGatekeeper::killNode, this, &DomainServer::handleKillNode);
 
+    // the other nodes are sent the new permissions of a node with the next domain list update
+    connect(&_gatekeeper, &DomainGatekeeper::nodePermissionsChanged, this, [this](SharedNodePointer node) {
+        _domainListHistory.nodeChanged(node->getUUID());
+    });
+
     // if permissions are updated, relay the changes to the Node datastructures
     connect(&_settingsManager, &DomainServerSettingsManager::updateNodePermissions,
             &_gatekeeper, &DomainGatekeeper::updateNodePermissions);
@@ -335,6 +340,12 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     _nodePingMonitorTimer = new QTimer{ this };
     connect(_nodePingMonitorTimer, &QTimer::timeout, this, &DomainServer::nodePingMonitor);
     _nodePingMonitorTimer->start(NODE_PING_MONITOR_INTERVAL_MSECS);
+
+    // the changes to the domain list are sent out together, however many nodes joined or left in the meantime
+    static const int DOMAIN_LIST_UPDATE_INTERVAL_MSECS = 100;
+    _domainListUpdateTimer = new QTimer{ this };
+    connect(_domainListUpdateTimer, &QTimer::timeout, this, &DomainServer::sendDomainListUpdates);
+    _domainListUpdateTimer->start(DOMAIN_LIST_UPDATE_INTERVAL_MSECS);
 }
 
 void DomainServer::parseCommandLine(int argc, char* argv[]) {
@@ -1080,9 +1091,17 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
-    // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    // the version of the domain list the node has, it is only sent what changed since then
+    DomainListHistory::Version knownVersion;
+    packetStream >> knownVersion;
+
+    // update this node's sockets in case they have changed, the other nodes need to know about it
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        _domainListHistory.nodeChanged(sendingNode->getUUID());
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
@@ -1102,8 +1121,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // update the NodeInterestSet in case there have been any changes, the node then needs the whole list again
+    if (nodeData->getNodeInterestSet() != safeInterestSet) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        knownVersion = 0;
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1111,7 +1133,7 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false, knownVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1189,11 +1211,34 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
-    // send out this node to our other connected nodes
-    broadcastNewNode(newNode);
+    // send out this node to our other connected nodes with the next domain list update
+    _domainListHistory.nodeChanged(newNode->getUUID());
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr,
+                                        bool newConnection, DomainListHistory::Version knownVersion) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // send only what changed since the version the node has, or the whole list if it has none or it is too old
+    bool isUpdate = !newConnection && _domainListHistory.hasChangesSince(knownVersion);
+    DomainListHistory::Version baseVersion = isUpdate ? knownVersion : 0;
+    DomainListHistory::Version version = _domainListHistory.getVersion();
+
+    std::vector<SharedNodePointer> changedNodes;
+    std::vector<QUuid> removedNodes;
+
+    // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+    if (nodeData->isAuthenticated() && baseVersion != version) {
+        // if this authenticated node has any interest types, send back those nodes as well
+        if (isUpdate) {
+            auto changes = _domainListHistory.getChangesSince(baseVersion);
+            getDomainListEntries(node, &changes, changedNodes, removedNodes);
+        } else {
+            getDomainListEntries(node, nullptr, changedNodes, removedNodes);
+        }
+    }
+
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
@@ -1201,8 +1246,6 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
@@ -1214,42 +1257,78 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    extendedHeaderStream << baseVersion;
+    extendedHeaderStream << version;
+    extendedHeaderStream << quint32(changedNodes.size() + removedNodes.size());
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
-    // always send the node their own UUID back
-    QDataStream domainListStream(domainListPackets.get());
+    writeDomainListEntries(*domainListPackets, node, changedNodes, removedNodes);
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+    // send an empty list to the node, in case there were no other nodes
+    domainListPackets->closeCurrentPacket(true);
 
-    if (nodeInterestSet.size() > 0) {
+    // write the PacketList to this node
+    limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    nodeData->setDomainListVersion(version);
+}
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+void DomainServer::getDomainListEntries(const SharedNodePointer& node, const DomainListHistory::Changes* changes,
+                                        std::vector<SharedNodePointer>& changedNodes, std::vector<QUuid>& removedNodes) {
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+    if (!changes) {
+        limitedNodeList->eachNode([this, node, &changedNodes](const SharedNodePointer& otherNode) {
+            if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                changedNodes.push_back(otherNode);
+            }
+        });
+        return;
+    }
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
+    for (const auto& otherNodeUUID : changes->changedNodes) {
+        auto otherNode = limitedNodeList->nodeWithUUID(otherNodeUUID);
+        if (otherNode && otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+            changedNodes.push_back(otherNode);
         }
     }
 
-    // send an empty list to the node, in case there were no other nodes
-    domainListPackets->closeCurrentPacket(true);
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    for (auto it = changes->removedNodes.cbegin(); it != changes->removedNodes.cend(); ++it) {
+        if (nodeData->getNodeInterestSet().contains(it.value())) {
+            removedNodes.push_back(it.key());
+        }
+    }
+}
 
-    // write the PacketList to this node
-    limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+void DomainServer::writeDomainListEntries(NLPacketList& packetList, const SharedNodePointer& node,
+                                          const std::vector<SharedNodePointer>& changedNodes,
+                                          const std::vector<QUuid>& removedNodes) {
+    QDataStream packetStream(&packetList);
+
+    // each entry starts with whether it adds (or updates) a node or removes one
+    for (const auto& otherNode : changedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        packetList.startSegment();
+
+        packetStream << false;
+
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        packetStream << *otherNode.data();
+
+        // pack the secret that these two nodes will use to communicate with each other
+        packetStream << connectionSecretForNodes(node, otherNode);
+
+        // we've added the node we wanted so end the segment now
+        packetList.endSegment();
+    }
+
+    for (const auto& otherNodeUUID : removedNodes) {
+        packetList.startSegment();
+        packetStream << true;
+        packetStream << otherNodeUUID;
+        packetList.endSegment();
+    }
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1273,43 +1352,59 @@ QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, con
     return QUuid();
 }
 
-void DomainServer::broadcastNewNode(const SharedNodePointer& addedNode) {
+void DomainServer::sendDomainListUpdates() {
+    if (!_domainListHistory.hasPendingChanges()) {
+        return;
+    }
+
+    auto version = _domainListHistory.commitPendingChanges();
 
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-    QWeakPointer<LimitedNodeList> limitedNodeListWeak = limitedNodeList;
 
-    auto addNodePacket = NLPacket::create(PacketType::DomainServerAddedNode);
+    // only nodes that were sent a list can be sent what changed since, the others will get the whole list
+    std::vector<SharedNodePointer> nodesToUpdate;
+    limitedNodeList->eachNode([this, &nodesToUpdate](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (nodeData && node->getActiveSocket() && nodeData->isAuthenticated()
+            && _domainListHistory.hasChangesSince(nodeData->getDomainListVersion())) {
+            nodesToUpdate.push_back(node);
+        }
+    });
+
+    // most nodes are up to date with the previous version, so the changes are worked out once for each version
+    QHash<DomainListHistory::Version, DomainListHistory::Changes> changesSinceVersion;
 
-    // setup the add packet for this new node
-    QDataStream addNodeStream(addNodePacket.get());
+    for (const auto& node : nodesToUpdate) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        auto baseVersion = nodeData->getDomainListVersion();
+        nodeData->setDomainListVersion(version);
 
-    addNodeStream << *addedNode.data();
+        auto changes = changesSinceVersion.find(baseVersion);
+        if (changes == changesSinceVersion.end()) {
+            changes = changesSinceVersion.insert(baseVersion, _domainListHistory.getChangesSince(baseVersion));
+        }
 
-    int connectionSecretIndex = addNodePacket->pos();
+        std::vector<SharedNodePointer> changedNodes;
+        std::vector<QUuid> removedNodes;
+        getDomainListEntries(node, &changes.value(), changedNodes, removedNodes);
 
-    limitedNodeList->eachMatchingNode(
-        [this, addedNode](const SharedNodePointer& node)->bool {
-            // is the added Node in this node's interest list?
-            return node->getLinkedData()
-                && node->getActiveSocket()
-                && node != addedNode
-                && isInInterestSet(node, addedNode);
-        },
-        [this, &addNodePacket, connectionSecretIndex, addedNode, limitedNodeListWeak](const SharedNodePointer& node) {
-            // send off this packet to the node
-            auto limitedNodeList = limitedNodeListWeak.lock();
-            if (limitedNodeList) {
-                addNodePacket->seek(connectionSecretIndex);
+        if (changedNodes.empty() && removedNodes.empty()) {
+            // nothing this node is interested in, it hears about the new version when it next checks in
+            continue;
+        }
 
-                QByteArray rfcConnectionSecret = connectionSecretForNodes(node, addedNode).toRfc4122();
+        QByteArray extendedHeader;
+        QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
+        extendedHeaderStream << baseVersion;
+        extendedHeaderStream << version;
+        extendedHeaderStream << quint32(changedNodes.size() + removedNodes.size());
+        auto updatePackets = NLPacketList::create(PacketType::DomainServerAddedNode, extendedHeader);
 
-                // replace the bytes at the end of the packet for the connection secret between these nodes
-                addNodePacket->write(rfcConnectionSecret);
+        writeDomainListEntries(*updatePackets, node, changedNodes, removedNodes);
 
-                limitedNodeList->sendUnreliablePacket(*addNodePacket, *node);
-            }
-        }
-    );
+        updatePackets->closeCurrentPacket();
+        limitedNodeList->sendPacketList(std::move(updatePackets), *node);
+    }
 }
 
 void DomainServer::processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> message) {
@@ -3081,7 +3176,10 @@ void DomainServer::updateReplicatedNodes() {
                 qDebug() << "Setting node to replicated:"
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
-            otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                otherNode->setIsReplicated(shouldReplicate);
+                _domainListHistory.nodeChanged(otherNode->getUUID());
+            }
         }
     );
 }
@@ -3146,7 +3244,10 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
         }
     }
 
+    // let the other nodes know it is gone right away, reliably, and with the next domain list update for those that
+    // only catch up from there
     broadcastNodeDisconnect(node);
+    _domainListHistory.nodeRemoved(node->getUUID(), node->getType());
 }
 
 SharedAssignmentPointer DomainServer::dequeueMatchingAssignment(const QUuid& assignmentUUID, NodeType_t nodeType) {
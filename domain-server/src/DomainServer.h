@@ -29,6 +29,7 @@
 
 #include "AssetsBackupHandler.h"
 #include "DomainGatekeeper.h"
+#include "DomainListHistory.h"
 #include "DomainMetadata.h"
 #include "DomainServerSettingsManager.h"
 #include "DomainServerWebSessionData.h"
@@ -112,6 +113,7 @@ private slots:
     void sendHeartbeatToMetaverse() { sendHeartbeatToMetaverse(QString()); }
     void sendHeartbeatToIceServer();
     void nodePingMonitor();
+    void sendDomainListUpdates();
 
     void handleConnectedNode(SharedNodePointer newNode, quint64 requestReceiveTime); 
     void handleTempDomainSuccess(QNetworkReply* requestReply);
@@ -176,12 +178,16 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr,
+                              bool newConnection, DomainListHistory::Version knownVersion = 0);
+    void getDomainListEntries(const SharedNodePointer& node, const DomainListHistory::Changes* changes,
+                              std::vector<SharedNodePointer>& changedNodes, std::vector<QUuid>& removedNodes);
+    void writeDomainListEntries(NLPacketList& packetList, const SharedNodePointer& node,
+                                const std::vector<SharedNodePointer>& changedNodes, const std::vector<QUuid>& removedNodes);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
     QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
-    void broadcastNewNode(const SharedNodePointer& node);
 
     void parseAssignmentConfigs(QSet<Assignment::Type>& excludedTypes);
     void addStaticAssignmentToAssignmentHash(Assignment* newAssignment);
@@ -229,6 +235,7 @@ private:
     std::vector<QString> _replicatedUsernames;
 
     DomainGatekeeper _gatekeeper;
+    DomainListHistory _domainListHistory;
 
     HTTPManager _httpManager;
     std::unique_ptr<HTTPSManager> _httpsManager;
@@ -263,6 +270,7 @@ private:
     QTimer* _metaverseHeartbeatTimer { nullptr };
     QTimer* _metaverseGroupCacheTimer { nullptr };
     QTimer* _nodePingMonitorTimer { nullptr };
+    QTimer* _domainListUpdateTimer { nullptr };
 
     QList<QHostAddress> _iceServerAddresses;
     QSet<QHostAddress> _failedIceServerAddresses;
@@ -22,6 +22,8 @@
 #include <NodeData.h>
 #include <NodeType.h>
 
+#include "DomainListHistory.h"
+
 class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
@@ -75,6 +77,10 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the version of the domain list this node has been sent, 0 until it was sent a list
+    DomainListHistory::Version getDomainListVersion() const { return _domainListVersion; }
+    void setDomainListVersion(DomainListHistory::Version version) { _domainListVersion = version; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -102,6 +108,8 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    DomainListHistory::Version _domainListVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
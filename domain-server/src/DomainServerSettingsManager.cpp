@@ -626,6 +626,7 @@ void DomainServerSettingsManager::packPermissionsForMap(QString mapName,
 
 void DomainServerSettingsManager::packPermissions() {
     // transfer details from _agentPermissions to _configMap
+    ++_permissionsVersion;
 
     // save settings for anonymous / logged-in / localhost
     packPermissionsForMap("standard_permissions", _standardAgentPermissions, AGENT_STANDARD_PERMISSIONS_KEYPATH);
@@ -696,6 +697,7 @@ bool DomainServerSettingsManager::unpackPermissionsForKeypath(const QString& key
 
 void DomainServerSettingsManager::unpackPermissions() {
     // transfer details from _configMap to _agentPermissions
+    ++_permissionsVersion;
 
     // NOTE: Defaults for standard permissions (anonymous, friends, localhost, logged-in) used
     // to be set here and then immediately persisted to the config JSON file.
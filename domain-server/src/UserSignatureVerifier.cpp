@@ -0,0 +1,97 @@
+//
+//  UserSignatureVerifier.cpp
+//  domain-server/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UserSignatureVerifier.h"
+
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+UserSignatureVerifier::UserSignatureVerifier(int numThreads, std::function<void()> resultsReady) :
+    _resultsReady(std::move(resultsReady))
+{
+    _threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { run(); });
+    }
+}
+
+UserSignatureVerifier::~UserSignatureVerifier() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _checksAdded.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void UserSignatureVerifier::verify(Check check) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _checks.push_back(std::move(check));
+    }
+    _checksAdded.notify_one();
+}
+
+std::vector<UserSignatureVerifier::Check> UserSignatureVerifier::takeResults() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<Check> results;
+    results.swap(_results);
+    return results;
+}
+
+UserSignatureVerifier::Result UserSignatureVerifier::verifySignature(const QByteArray& publicKey,
+                                                                     const QByteArray& signedData,
+                                                                     const QByteArray& signature) {
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKey.constData());
+
+    // first load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKey.size());
+    if (!rsaPublicKey) {
+        return Result::InvalidKey;
+    }
+
+    int decryptResult = RSA_verify(NID_sha256,
+                                   reinterpret_cast<const unsigned char*>(signedData.constData()),
+                                   signedData.size(),
+                                   reinterpret_cast<const unsigned char*>(signature.constData()),
+                                   signature.size(),
+                                   rsaPublicKey);
+    RSA_free(rsaPublicKey);
+
+    return decryptResult == 1 ? Result::Verified : Result::Mismatch;
+}
+
+void UserSignatureVerifier::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _checksAdded.wait(lock, [this] { return _isStopping || !_checks.empty(); });
+        if (_isStopping) {
+            return;
+        }
+
+        Check check = std::move(_checks.front());
+        _checks.pop_front();
+        lock.unlock();
+
+        check.result = verifySignature(check.publicKey, check.signedData, check.signature);
+
+        lock.lock();
+        bool wereResultsWaiting = !_results.empty();
+        _results.push_back(std::move(check));
+        if (!wereResultsWaiting) {
+            lock.unlock();
+            _resultsReady();
+            lock.lock();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+//
+//  UserSignatureVerifier.h
+//  domain-server/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UserSignatureVerifier_h
+#define hifi_UserSignatureVerifier_h
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+// Checks the username signatures of connecting users on a few worker threads, so that a burst of connect requests
+// doesn't hold up the domain-server's main thread with RSA verifications.
+//
+// The results are collected until they are taken. The results ready callback is called from a worker whenever a
+// result is added while none were waiting to be taken, so that all of the results available by then are taken at once.
+class UserSignatureVerifier {
+public:
+    enum class Result {
+        Verified,
+        Mismatch,
+        InvalidKey
+    };
+
+    struct Check {
+        quint64 id;
+        QByteArray publicKey;
+        QByteArray signedData;
+        QByteArray signature;
+        Result result { Result::Mismatch };
+    };
+
+    UserSignatureVerifier(int numThreads, std::function<void()> resultsReady);
+    ~UserSignatureVerifier();
+
+    void verify(Check check);
+    std::vector<Check> takeResults();
+
+    // verifies a SHA256 RSA signature, the public key is DER encoded
+    static Result verifySignature(const QByteArray& publicKey, const QByteArray& signedData, const QByteArray& signature);
+
+private:
+    void run();
+
+    std::function<void()> _resultsReady;
+
+    std::mutex _mutex;
+    std::condition_variable _checksAdded;
+    std::deque<Check> _checks;
+    std::vector<Check> _results;
+    bool _isStopping { false };
+
+    std::vector<std::thread> _threads;
+};
+
+#endif // hifi_UserSignatureVerifier_h
@@ -121,6 +121,11 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Animation Full/Reduced/Low: " + root.fullAnimationAvatarCount + "/" +
+                            root.reducedAnimationAvatarCount + "/" + root.lowAnimationAvatarCount
+                    }
                 }
             }
 
@@ -133,6 +133,11 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Animation Full/Reduced/Low: " + root.fullAnimationAvatarCount + "/" +
+                            root.reducedAnimationAvatarCount + "/" + root.lowAnimationAvatarCount
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -353,6 +358,11 @@ Item {
                     StatText {
                         text: "Drawcalls: " + root.drawcalls
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Blendshapes: " + root.blendshapeQueueDepth + " queued, " +
+                              root.blendshapeLatency.toFixed(1) + " ms latency"
+                    }
                     StatText {
                         text: "Triangles: " + root.triangles +
                             " / Material Switches: " + root.materialSwitches
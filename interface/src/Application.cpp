@@ -5654,6 +5654,7 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    _shapeManager.initializeDiskCache();
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
@@ -6796,6 +6797,12 @@ void Application::update(float deltaTime) {
         avatarManager->postUpdate(deltaTime, getMain3DScene());
     }
 
+    {
+        PROFILE_RANGE_EX(app, "ModelBlender", 0xffff0000, (uint64_t)0);
+        PerformanceTimer perfTimer("modelBlender");
+        DependencyManager::get<ModelBlender>()->update(_conicalViews);
+    }
+
     {
         PROFILE_RANGE_EX(app, "PostUpdateLambdas", 0xffff0000, (uint64_t)0);
         PerformanceTimer perfTimer("postUpdateLambdas");
@@ -9242,6 +9249,12 @@ void Application::setShowBulletConstraintLimits(bool value) {
     _physicsEngine->setShowBulletConstraintLimits(value);
 }
 
+void Application::setMultithreadedPhysics(bool value) {
+    // leave the other half of the cores to rendering, audio and networking
+    int numThreads = value ? std::max(QThread::idealThreadCount() / 2, 1) : 1;
+    _physicsEngine->setNumThreads(numThreads);
+}
+
 void Application::createLoginDialog() {
     const glm::vec3 LOGIN_DIMENSIONS { 0.89f, 0.5f, 0.01f };
     const auto OFFSET = glm::vec2(0.7f, -0.1f);
@@ -572,6 +572,7 @@ private slots:
     void setShowBulletContactPoints(bool value);
     void setShowBulletConstraints(bool value);
     void setShowBulletConstraintLimits(bool value);
+    void setMultithreadedPhysics(bool value);
 
     void onDismissedLoginDialog();
 
@@ -35,6 +35,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <ThreadHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -216,6 +217,17 @@ float AvatarManager::getAvatarSimulationRate(const QUuid& sessionID, const QStri
     return avatar ? avatar->getSimulationRate(rateName) : 0.0f;
 }
 
+// the angular radius of a sphere, as seen from the nearest of the views
+static float computeScreenSize(const ConicalViewFrustums& views, const glm::vec3& position, float radius) {
+    const float MIN_DISTANCE = 0.01f;
+    float screenSize = 0.0f;
+    for (const auto& view : views) {
+        float distance = glm::max(glm::distance(view.getPosition(), position), MIN_DISTANCE);
+        screenSize = glm::max(screenSize, radius / distance);
+    }
+    return screenSize;
+}
+
 void AvatarManager::updateOtherAvatars(float deltaTime) {
     {
         // lock the hash for read to check the size
@@ -283,6 +295,31 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     _numHeroAvatars = (int)avatarPriorityQueues[kHero].size();
 
+    // pick the animation LOD of each avatar from its size on screen, then start the rig updates of the avatars in
+    // view on the workers, in priority order, for as many avatars as the workers should get through within the time
+    // budget.  the rest are updated in simulate() if there's time left.
+    std::vector<OtherAvatarPointer> avatarsWithRigUpdates;
+    // the rigs of other avatars are updated on the main thread's worker pool, alongside the main thread
+    QThreadPool* rigUpdatePool = getMainThreadWorkerPool();
+    const uint64_t rigUpdateBudget = MAX_UPDATE_AVATARS_TIME_BUDGET * rigUpdatePool->maxThreadCount();
+    uint64_t rigUpdateTime = 0;
+    int numAvatarsPerAnimationLOD[OtherAvatar::NumAnimationLODs] = { 0 };
+    for (int p = kHero; p < NumVariants; p++) {
+        for (const auto& sortData : avatarPriorityQueues[p].getSortedVector()) {
+            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+            avatar->computeAnimationLOD(computeScreenSize(views, avatar->getWorldPosition(), avatar->getBoundingRadius()));
+            numAvatarsPerAnimationLOD[avatar->getAnimationLOD()]++;
+
+            bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
+            if (inView && rigUpdateTime < rigUpdateBudget && avatar->needsRigUpdate()) {
+                // the worker writes the time of this update, so the budget goes by the last one
+                rigUpdateTime += avatar->getRigUpdateTime();
+                avatar->startRigUpdate(*rigUpdatePool);
+                avatarsWithRigUpdates.push_back(avatar);
+            }
+        }
+    }
+
     // process in sorted order
     uint64_t startTime = usecTimestampNow();
 
@@ -306,6 +343,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
             const SortableAvatar& sortData = *it;
             const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+            avatar->waitForRigUpdate();
             if (!avatar->_isClientAvatar) {
                 avatar->setIsClientAvatar(true);
             }
@@ -346,7 +384,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->setIsNewAvatar(false);
                 }
                 avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
+                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1 &&
+                    avatar->getAnimationLOD() == OtherAvatar::AnimationLOD::Full) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
                 if (_drawOtherAvatarSkeletons) {
@@ -392,6 +431,11 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
     }
 
+    // no rig may still be updating once the render transaction is submitted
+    for (const auto& avatar : avatarsWithRigUpdates) {
+        avatar->finishRigUpdate();
+    }
+
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
     }
@@ -401,6 +445,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    std::copy(std::begin(numAvatarsPerAnimationLOD), std::end(numAvatarsPerAnimationLOD), _numAvatarsPerAnimationLOD);
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
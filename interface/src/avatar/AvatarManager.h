@@ -117,6 +117,7 @@ public:
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
     int getNumHeroAvatars() const { return _numHeroAvatars; }
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
+    int getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLOD lod) const { return _numAvatarsPerAnimationLOD[lod]; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
 
     void updateMyAvatar(float deltaTime);
@@ -313,6 +314,7 @@ private:
     int _numAvatarsNotUpdated { 0 };
     int _numHeroAvatars{ 0 };
     int _numHeroAvatarsUpdated{ 0 };
+    int _numAvatarsPerAnimationLOD[OtherAvatar::NumAnimationLODs] { 0 };
     float _avatarSimulationTime { 0.0f };
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
@@ -8,9 +8,12 @@
 
 #include "OtherAvatar.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+
 #include <glm/gtx/norm.hpp>
 #include <glm/gtx/vector_angle.hpp>
 
+#include <AnimUtil.h>
 #include <AvatarLogging.h>
 
 #include "Application.h"
@@ -21,6 +24,10 @@
 const float DISPLAYNAME_FADE_TIME = 0.5f;
 const float DISPLAYNAME_FADE_FACTOR = pow(0.01f, 1.0f / DISPLAYNAME_FADE_TIME);
 
+// the joints of distant avatars take the joint data only every few frames and ease towards it in between, while their
+// position follows every frame
+static const int RIG_UPDATE_INTERVALS[OtherAvatar::NumAnimationLODs] = { 1, 2, 4 };
+
 static glm::u8vec3 getLoadingOrbColor(Avatar::LoadingStatus loadingStatus) {
 
     const glm::u8vec3 NO_MODEL_COLOR(0xe3, 0xe3, 0xe3);
@@ -282,17 +289,26 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
+            if (_isRigUpdated || needsRigUpdate()) {
+                if (!_isRigUpdated) {
+                    _rigUpdateTakesJointData = needsJointData();
+                    if (_rigUpdateTakesJointData) {
+                        _hasNewJointData = false;
+                    }
+                    updateRig();
+                }
+                _isRigUpdated = false;
+                if (_rigUpdateTakesJointData) {
+                    _framesSinceRigUpdate = 0;
+                    _jointDataSimulationRate.increment();
+                } else {
+                    _framesSinceRigUpdate++;
+                }
 
                 head->simulate(deltaTime);
                 _skeletonModel->simulate(deltaTime, true);
 
                 locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
 
                 glm::vec3 headPosition = getWorldPosition();
                 if (!_skeletonModel->getHeadPosition(headPosition)) {
@@ -300,6 +316,7 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
                 }
                 head->setPosition(headPosition);
             } else {
+                _framesSinceRigUpdate++;
                 head->simulate(deltaTime);
                 _skeletonModel->simulate(deltaTime, false);
             }
@@ -347,6 +364,65 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     }
 }
 
+void OtherAvatar::updateRig() {
+    PROFILE_RANGE(simulation, "updateRig");
+    uint64_t start = usecTimestampNow();
+
+    Rig& rig = _skeletonModel->getRig();
+    if (_rigUpdateTakesJointData) {
+        QReadLocker readLock(&_jointDataLock);
+        rig.copyJointsFromJointData(_jointData, _animationLOD == AnimationLOD::Low, RIG_UPDATE_INTERVALS[_animationLOD]);
+    } else {
+        rig.stepJointInterpolation();
+    }
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    rig.computeExternalPoses(rootTransform);
+
+    _isRigUpdated = true;
+    _rigUpdateTime = usecTimestampNow() - start;
+}
+
+bool OtherAvatar::needsRigUpdate() const {
+    return needsJointData() || _skeletonModel->getRig().isInterpolatingJoints();
+}
+
+bool OtherAvatar::needsJointData() const {
+    return (_hasNewJointData || _transit.isActive()) && _framesSinceRigUpdate + 1 >= RIG_UPDATE_INTERVALS[_animationLOD];
+}
+
+void OtherAvatar::computeAnimationLOD(float screenSize) {
+    static const float MIN_SCREEN_SIZES[AnimationLOD::NumAnimationLODs] = { 0.05f, 0.015f, 0.0f };
+    // an avatar has to shrink a bit past a threshold before it drops a LOD, so that it doesn't flicker between two
+    const float HYSTERESIS = 0.9f;
+
+    _animationLOD = (AnimationLOD)computeLevelOfDetail(screenSize, _animationLOD, MIN_SCREEN_SIZES, AnimationLOD::NumAnimationLODs,
+                                                      HYSTERESIS);
+}
+
+void OtherAvatar::startRigUpdate(QThreadPool& pool) {
+    _isRigUpdated = false;
+    _rigUpdateTakesJointData = needsJointData();
+    if (_rigUpdateTakesJointData) {
+        // cleared as the joint data is taken, so that joint data received while the update runs is taken by the next one
+        _hasNewJointData = false;
+    }
+    _rigUpdate = QtConcurrent::run(&pool, [this] {
+        updateRig();
+    });
+}
+
+void OtherAvatar::waitForRigUpdate() {
+    _rigUpdate.waitForFinished();
+}
+
+void OtherAvatar::finishRigUpdate() {
+    _rigUpdate.waitForFinished();
+    _rigUpdate = QFuture<void>();
+
+    // if simulate() didn't use the update this frame, the joint data may have changed by the next one
+    _isRigUpdated = false;
+}
+
 void OtherAvatar::debugJointData() const {
     // Get a copy of the joint data
     auto jointData = getJointData();
@@ -12,6 +12,9 @@
 #include <memory>
 #include <vector>
 
+#include <QtCore/QFuture>
+#include <QtCore/QThreadPool>
+
 #include <avatars-renderer/Avatar.h>
 #include <workload/Space.h>
 
@@ -32,6 +35,14 @@ public:
         MultiSphereHigh // All joints
     };
 
+    // driven by the avatar's size on screen, see computeAnimationLOD()
+    enum AnimationLOD {
+        Full = 0,   // joints updated every frame, hands fed to MyAvatar's flow
+        Reduced,    // joints take the joint data every other frame and are interpolated in between
+        Low,        // core joints take the joint data every fourth frame and are interpolated in between
+        NumAnimationLODs
+    };
+
     virtual void instantiableAvatar() override { };
     virtual void createOrb() override;
     virtual void indicateLoadingStatus(LoadingStatus loadingStatus) override;
@@ -66,9 +77,25 @@ public:
 
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
+
+    // The rig update of simulate() only touches this avatar's own rig and joint data, so AvatarManager starts it on
+    // a worker thread ahead of simulate(), then waits for it before it touches the avatar on the main thread.
+    bool needsRigUpdate() const;
+    void startRigUpdate(QThreadPool& pool);
+    void waitForRigUpdate();
+    void finishRigUpdate();
+    // the time the last rig update took, which isn't to be read while one is running
+    uint64_t getRigUpdateTime() const { return _rigUpdateTime; }
+
+    // screenSize is the angular radius of the avatar's bounds, in radians, as seen from the nearest view
+    void computeAnimationLOD(float screenSize);
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+
     friend AvatarManager;
 
 protected:
+    bool needsJointData() const;
+    void updateRig();
     void handleChangedAvatarEntityData();
     void updateAttachedAvatarEntities();
     void onAddAttachedAvatarEntity(const QUuid& id);
@@ -92,6 +119,13 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+
+    QFuture<void> _rigUpdate;
+    bool _isRigUpdated { false };
+    bool _rigUpdateTakesJointData { false }; // or steps the rig's joint interpolation
+    uint64_t _rigUpdateTime { 0 }; // usecs
+    AnimationLOD _animationLOD { AnimationLOD::Full };
+    int _framesSinceRigUpdate { 0 };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
@@ -23,6 +23,7 @@
 #include <AudioClient.h>
 #include <GeometryCache.h>
 #include <LODManager.h>
+#include <Model.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
@@ -131,6 +132,9 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(fullAnimationAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLOD::Full));
+    STAT_UPDATE(reducedAnimationAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLOD::Reduced));
+    STAT_UPDATE(lowAnimationAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLOD::Low));
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
@@ -392,6 +396,9 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    auto modelBlender = DependencyManager::get<ModelBlender>();
+    STAT_UPDATE(blendshapeQueueDepth, modelBlender->getQueueDepth());
+    STAT_UPDATE(blendshapeLatency, modelBlender->getAverageLatency());
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
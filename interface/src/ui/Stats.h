@@ -97,6 +97,15 @@ private: \
  * @property {number} notUpdatedAvatarCount - The number of avatars in the domain, other than the client's, that weren't able 
  *     to be updated in the most recent game loop because there wasn't enough time to.
  *     <em>Read-only.</em>
+ * @property {number} fullAnimationAvatarCount - The number of avatars in the domain, other than the client's, that are
+ *     close enough to be animated in full in the most recent game loop.
+ *     <em>Read-only.</em>
+ * @property {number} reducedAnimationAvatarCount - The number of avatars in the domain, other than the client's, that are
+ *     animated at a reduced rate because they're small on screen.
+ *     <em>Read-only.</em>
+ * @property {number} lowAnimationAvatarCount - The number of avatars in the domain, other than the client's, that are
+ *     animated at a low rate and without their fingers and faces because they're tiny on screen.
+ *     <em>Read-only.</em>
  * @property {number} packetInCount - The number of packets being received from the domain server, in packets per second.
  *     <em>Read-only.</em>
  * @property {number} packetOutCount - The number of packets being sent to the domain server, in packets per second.
@@ -338,6 +347,11 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} avatarSimulationTime - The time being spent simulating avatars each frame, in ms.
  *     <em>Read-only.</em>
+ * @property {number} blendshapeQueueDepth - The number of models waiting for their blendshapes to be computed.
+ *     <em>Read-only.</em>
+ * @property {number} blendshapeLatency - The average time from a model's blendshapes changing to them being computed, in
+ *     ms.
+ *     <em>Read-only.</em>
  *
  * @property {number} stylusPicksCount - The number of stylus picks currently in effect.
  *     <em>Read-only.</em>
@@ -490,6 +504,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, fullAnimationAvatarCount, 0)
+    STATS_PROPERTY(int, reducedAnimationAvatarCount, 0)
+    STATS_PROPERTY(int, lowAnimationAvatarCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -583,6 +600,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(int, blendshapeQueueDepth, 0)
+    STATS_PROPERTY(float, blendshapeLatency, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -825,6 +844,27 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>fullAnimationAvatarCount</code> property changes.
+     * @function Stats.fullAnimationAvatarCountChanged
+     * @returns {Signal}
+     */
+    void fullAnimationAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>reducedAnimationAvatarCount</code> property changes.
+     * @function Stats.reducedAnimationAvatarCountChanged
+     * @returns {Signal}
+     */
+    void reducedAnimationAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>lowAnimationAvatarCount</code> property changes.
+     * @function Stats.lowAnimationAvatarCountChanged
+     * @returns {Signal}
+     */
+    void lowAnimationAvatarCountChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
@@ -1457,6 +1497,20 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>blendshapeQueueDepth</code> property changes.
+     * @function Stats.blendshapeQueueDepthChanged
+     * @returns {Signal}
+     */
+    void blendshapeQueueDepthChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>blendshapeLatency</code> property changes.
+     * @function Stats.blendshapeLatencyChanged
+     * @returns {Signal}
+     */
+    void blendshapeLatencyChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>stylusPicksCount</code> property changes.
      * @function Stats.stylusPicksCountChanged
@@ -0,0 +1,580 @@
+//
+//  AnimPoseBuffer.cpp
+//  libraries/animation/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+static const int POSES_PER_BLOCK = AnimPoseBuffer::POSES_PER_BLOCK;
+
+static int roundUpToBlock(int numPoses) {
+    return (numPoses + POSES_PER_BLOCK - 1) / POSES_PER_BLOCK * POSES_PER_BLOCK;
+}
+
+AnimPoseHierarchy::AnimPoseHierarchy(const std::vector<int>& parentIndices) :
+    _numJoints((int)parentIndices.size())
+{
+    std::vector<std::vector<int>> jointsByDepth;
+    for (int i = 0; i < _numJoints; i++) {
+        int depth = 0;
+        for (int parent = parentIndices[i]; parent >= 0 && depth < _numJoints; parent = parentIndices[parent]) {
+            depth++;
+        }
+        if (depth >= (int)jointsByDepth.size()) {
+            jointsByDepth.resize(depth + 1);
+        }
+        jointsByDepth[depth].push_back(i);
+    }
+
+    for (auto& joints : jointsByDepth) {
+        if (joints.empty()) {
+            continue;
+        }
+        // pad each depth to whole blocks, so that a block never holds both a joint and its parent
+        int lastJoint = joints.back();
+        joints.resize(roundUpToBlock((int)joints.size()), lastJoint);
+        for (int joint : joints) {
+            int parent = parentIndices[joint];
+            _jointOrder.push_back(joint);
+            _parentOrder.push_back(parent >= 0 ? parent : _numJoints);
+        }
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+#include "CPUDetect.h"
+
+static inline __m128 select_SSE(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 dot4_SSE(__m128 ax, __m128 ay, __m128 az, __m128 aw, __m128 bx, __m128 by, __m128 bz, __m128 bw) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+}
+
+// like glm::normalize, a zero length quaternion becomes the identity
+static inline void normalize_SSE(__m128& x, __m128& y, __m128& z, __m128& w) {
+    __m128 lengthSquared = dot4_SSE(x, y, z, w, x, y, z, w);
+    __m128 isValid = _mm_cmpgt_ps(lengthSquared, _mm_setzero_ps());
+    __m128 oneOverLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+    x = _mm_and_ps(isValid, _mm_mul_ps(x, oneOverLength));
+    y = _mm_and_ps(isValid, _mm_mul_ps(y, oneOverLength));
+    z = _mm_and_ps(isValid, _mm_mul_ps(z, oneOverLength));
+    w = select_SSE(isValid, _mm_mul_ps(w, oneOverLength), _mm_set1_ps(1.0f));
+}
+
+// like glm::quat_cast, gives the largest component a positive sign
+static inline void canonicalize_SSE(__m128& x, __m128& y, __m128& z, __m128& w) {
+    __m128 largest = w;
+    __m128 largestSquared = _mm_mul_ps(w, w);
+    __m128 squared = _mm_mul_ps(x, x);
+    __m128 isLarger = _mm_cmpgt_ps(squared, largestSquared);
+    largest = select_SSE(isLarger, x, largest);
+    largestSquared = select_SSE(isLarger, squared, largestSquared);
+    squared = _mm_mul_ps(y, y);
+    isLarger = _mm_cmpgt_ps(squared, largestSquared);
+    largest = select_SSE(isLarger, y, largest);
+    largestSquared = select_SSE(isLarger, squared, largestSquared);
+    squared = _mm_mul_ps(z, z);
+    isLarger = _mm_cmpgt_ps(squared, largestSquared);
+    largest = select_SSE(isLarger, z, largest);
+
+    __m128 sign = _mm_and_ps(largest, _mm_set1_ps(-0.0f));
+    x = _mm_xor_ps(x, sign);
+    y = _mm_xor_ps(y, sign);
+    z = _mm_xor_ps(z, sign);
+    w = _mm_xor_ps(w, sign);
+}
+
+// (x, y, z, w) = a * b
+static inline void multiply_SSE(__m128 ax, __m128 ay, __m128 az, __m128 aw, __m128 bx, __m128 by, __m128 bz, __m128 bw,
+                                __m128& x, __m128& y, __m128& z, __m128& w) {
+    x = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by));
+    y = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx)), _mm_mul_ps(ax, bz));
+    z = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(az, bw)), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx));
+    w = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+static inline __m128 gather_SSE(const float* data, const int* indices) {
+    return _mm_setr_ps(data[indices[0]], data[indices[1]], data[indices[2]], data[indices[3]]);
+}
+
+static inline void scatter_SSE(float* data, const int* indices, __m128 value) {
+    float values[4];
+    _mm_storeu_ps(values, value);
+    data[indices[0]] = values[0];
+    data[indices[1]] = values[1];
+    data[indices[2]] = values[2];
+    data[indices[3]] = values[3];
+}
+
+// linear combination of 2 to 4 sets of poses, the rotations are flipped to the side of the first before they are combined
+static void blendPoses_SSE(const float* const* inputs, const float* alphas, int numInputs, float* result, int numPoses, int stride) {
+
+    static const int LINEAR_COMPONENTS[] = {
+        AnimPoseBuffer::ScaleX, AnimPoseBuffer::ScaleY, AnimPoseBuffer::ScaleZ,
+        AnimPoseBuffer::TransX, AnimPoseBuffer::TransY, AnimPoseBuffer::TransZ
+    };
+    const int rx = AnimPoseBuffer::RotX * stride;
+    const int ry = AnimPoseBuffer::RotY * stride;
+    const int rz = AnimPoseBuffer::RotZ * stride;
+    const int rw = AnimPoseBuffer::RotW * stride;
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    assert(numPoses % 4 == 0);
+
+    for (int i = 0; i < numPoses; i += 4) {
+
+        for (int component : LINEAR_COMPONENTS) {
+            int offset = component * stride + i;
+            __m128 sum = _mm_mul_ps(_mm_set1_ps(alphas[0]), _mm_loadu_ps(&inputs[0][offset]));
+            for (int k = 1; k < numInputs; k++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(alphas[k]), _mm_loadu_ps(&inputs[k][offset])));
+            }
+            _mm_storeu_ps(&result[offset], sum);
+        }
+
+        __m128 ax = _mm_loadu_ps(&inputs[0][rx + i]);
+        __m128 ay = _mm_loadu_ps(&inputs[0][ry + i]);
+        __m128 az = _mm_loadu_ps(&inputs[0][rz + i]);
+        __m128 aw = _mm_loadu_ps(&inputs[0][rw + i]);
+
+        __m128 alpha = _mm_set1_ps(alphas[0]);
+        __m128 x = _mm_mul_ps(alpha, ax);
+        __m128 y = _mm_mul_ps(alpha, ay);
+        __m128 z = _mm_mul_ps(alpha, az);
+        __m128 w = _mm_mul_ps(alpha, aw);
+
+        for (int k = 1; k < numInputs; k++) {
+            __m128 bx = _mm_loadu_ps(&inputs[k][rx + i]);
+            __m128 by = _mm_loadu_ps(&inputs[k][ry + i]);
+            __m128 bz = _mm_loadu_ps(&inputs[k][rz + i]);
+            __m128 bw = _mm_loadu_ps(&inputs[k][rw + i]);
+
+            // negating the alpha negates the rotation
+            __m128 isOpposite = _mm_cmplt_ps(dot4_SSE(ax, ay, az, aw, bx, by, bz, bw), _mm_setzero_ps());
+            alpha = _mm_xor_ps(_mm_set1_ps(alphas[k]), _mm_and_ps(isOpposite, signMask));
+
+            x = _mm_add_ps(x, _mm_mul_ps(alpha, bx));
+            y = _mm_add_ps(y, _mm_mul_ps(alpha, by));
+            z = _mm_add_ps(z, _mm_mul_ps(alpha, bz));
+            w = _mm_add_ps(w, _mm_mul_ps(alpha, bw));
+        }
+
+        normalize_SSE(x, y, z, w);
+        _mm_storeu_ps(&result[rx + i], x);
+        _mm_storeu_ps(&result[ry + i], y);
+        _mm_storeu_ps(&result[rz + i], z);
+        _mm_storeu_ps(&result[rw + i], w);
+    }
+}
+
+static void blendAddPoses_SSE(const float* a, const float* b, float alpha, float* result, int numPoses, int stride) {
+
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 alpha4 = _mm_set1_ps(alpha);
+    const __m128 oneMinusAlpha = _mm_set1_ps(1.0f - alpha);
+    const int rx = AnimPoseBuffer::RotX * stride;
+    const int ry = AnimPoseBuffer::RotY * stride;
+    const int rz = AnimPoseBuffer::RotZ * stride;
+    const int rw = AnimPoseBuffer::RotW * stride;
+
+    assert(numPoses % 4 == 0);
+
+    for (int i = 0; i < numPoses; i += 4) {
+
+        for (int component = AnimPoseBuffer::ScaleX; component <= AnimPoseBuffer::ScaleZ; component++) {
+            int offset = component * stride + i;
+            __m128 scale = _mm_add_ps(oneMinusAlpha, _mm_mul_ps(_mm_loadu_ps(&b[offset]), alpha4));
+            _mm_storeu_ps(&result[offset], _mm_mul_ps(_mm_loadu_ps(&a[offset]), scale));
+        }
+
+        // the delta is flipped to the side of the identity, then lerped from it
+        __m128 bx = _mm_loadu_ps(&b[rx + i]);
+        __m128 by = _mm_loadu_ps(&b[ry + i]);
+        __m128 bz = _mm_loadu_ps(&b[rz + i]);
+        __m128 bw = _mm_loadu_ps(&b[rw + i]);
+        __m128 sign = _mm_and_ps(_mm_cmplt_ps(bw, _mm_setzero_ps()), signMask);
+        __m128 signedAlpha = _mm_xor_ps(alpha4, sign);
+        __m128 dx = _mm_mul_ps(bx, signedAlpha);
+        __m128 dy = _mm_mul_ps(by, signedAlpha);
+        __m128 dz = _mm_mul_ps(bz, signedAlpha);
+        __m128 dw = _mm_add_ps(oneMinusAlpha, _mm_mul_ps(bw, signedAlpha));
+
+        __m128 x, y, z, w;
+        multiply_SSE(_mm_loadu_ps(&a[rx + i]), _mm_loadu_ps(&a[ry + i]), _mm_loadu_ps(&a[rz + i]), _mm_loadu_ps(&a[rw + i]),
+                     dx, dy, dz, dw, x, y, z, w);
+        normalize_SSE(x, y, z, w);
+        _mm_storeu_ps(&result[rx + i], x);
+        _mm_storeu_ps(&result[ry + i], y);
+        _mm_storeu_ps(&result[rz + i], z);
+        _mm_storeu_ps(&result[rw + i], w);
+
+        for (int component = AnimPoseBuffer::TransX; component <= AnimPoseBuffer::TransZ; component++) {
+            int offset = component * stride + i;
+            __m128 trans = _mm_add_ps(_mm_loadu_ps(&a[offset]), _mm_mul_ps(alpha4, _mm_loadu_ps(&b[offset])));
+            _mm_storeu_ps(&result[offset], trans);
+        }
+    }
+}
+
+static void normalizeRotations_SSE(float* poses, int numPoses, int stride) {
+
+    float* rx = poses + AnimPoseBuffer::RotX * stride;
+    float* ry = poses + AnimPoseBuffer::RotY * stride;
+    float* rz = poses + AnimPoseBuffer::RotZ * stride;
+    float* rw = poses + AnimPoseBuffer::RotW * stride;
+
+    assert(numPoses % 4 == 0);
+
+    for (int i = 0; i < numPoses; i += 4) {
+        __m128 x = _mm_loadu_ps(&rx[i]);
+        __m128 y = _mm_loadu_ps(&ry[i]);
+        __m128 z = _mm_loadu_ps(&rz[i]);
+        __m128 w = _mm_loadu_ps(&rw[i]);
+        normalize_SSE(x, y, z, w);
+        _mm_storeu_ps(&rx[i], x);
+        _mm_storeu_ps(&ry[i], y);
+        _mm_storeu_ps(&rz[i], z);
+        _mm_storeu_ps(&rw[i], w);
+    }
+}
+
+// result[childIndices[i]] = parents[parentIndices[i]] * children[childIndices[i]], composed by scale, rotation and translation
+static void composePoses_SSE(const float* parents, const float* children, float* result,
+                             const int* parentIndices, const int* childIndices, int numPoses, int stride) {
+
+    assert(numPoses % 4 == 0);
+
+    for (int i = 0; i < numPoses; i += 4) {
+        const int* parentIndex = &parentIndices[i];
+        const int* childIndex = &childIndices[i];
+
+        __m128 psx = gather_SSE(parents + AnimPoseBuffer::ScaleX * stride, parentIndex);
+        __m128 psy = gather_SSE(parents + AnimPoseBuffer::ScaleY * stride, parentIndex);
+        __m128 psz = gather_SSE(parents + AnimPoseBuffer::ScaleZ * stride, parentIndex);
+        __m128 prx = gather_SSE(parents + AnimPoseBuffer::RotX * stride, parentIndex);
+        __m128 pry = gather_SSE(parents + AnimPoseBuffer::RotY * stride, parentIndex);
+        __m128 prz = gather_SSE(parents + AnimPoseBuffer::RotZ * stride, parentIndex);
+        __m128 prw = gather_SSE(parents + AnimPoseBuffer::RotW * stride, parentIndex);
+
+        __m128 csx = gather_SSE(children + AnimPoseBuffer::ScaleX * stride, childIndex);
+        __m128 csy = gather_SSE(children + AnimPoseBuffer::ScaleY * stride, childIndex);
+        __m128 csz = gather_SSE(children + AnimPoseBuffer::ScaleZ * stride, childIndex);
+        __m128 crx = gather_SSE(children + AnimPoseBuffer::RotX * stride, childIndex);
+        __m128 cry = gather_SSE(children + AnimPoseBuffer::RotY * stride, childIndex);
+        __m128 crz = gather_SSE(children + AnimPoseBuffer::RotZ * stride, childIndex);
+        __m128 crw = gather_SSE(children + AnimPoseBuffer::RotW * stride, childIndex);
+
+        // v = parent.scale * child.trans, rotated by the parent: v + 2w(q x v) + 2q x (q x v)
+        __m128 vx = _mm_mul_ps(psx, gather_SSE(children + AnimPoseBuffer::TransX * stride, childIndex));
+        __m128 vy = _mm_mul_ps(psy, gather_SSE(children + AnimPoseBuffer::TransY * stride, childIndex));
+        __m128 vz = _mm_mul_ps(psz, gather_SSE(children + AnimPoseBuffer::TransZ * stride, childIndex));
+        __m128 two = _mm_set1_ps(2.0f);
+        __m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(pry, vz), _mm_mul_ps(prz, vy)));
+        __m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(prz, vx), _mm_mul_ps(prx, vz)));
+        __m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(prx, vy), _mm_mul_ps(pry, vx)));
+        vx = _mm_add_ps(_mm_add_ps(vx, _mm_mul_ps(prw, tx)), _mm_sub_ps(_mm_mul_ps(pry, tz), _mm_mul_ps(prz, ty)));
+        vy = _mm_add_ps(_mm_add_ps(vy, _mm_mul_ps(prw, ty)), _mm_sub_ps(_mm_mul_ps(prz, tx), _mm_mul_ps(prx, tz)));
+        vz = _mm_add_ps(_mm_add_ps(vz, _mm_mul_ps(prw, tz)), _mm_sub_ps(_mm_mul_ps(prx, ty), _mm_mul_ps(pry, tx)));
+        vx = _mm_add_ps(vx, gather_SSE(parents + AnimPoseBuffer::TransX * stride, parentIndex));
+        vy = _mm_add_ps(vy, gather_SSE(parents + AnimPoseBuffer::TransY * stride, parentIndex));
+        vz = _mm_add_ps(vz, gather_SSE(parents + AnimPoseBuffer::TransZ * stride, parentIndex));
+
+        __m128 x, y, z, w;
+        multiply_SSE(prx, pry, prz, prw, crx, cry, crz, crw, x, y, z, w);
+        normalize_SSE(x, y, z, w);
+        canonicalize_SSE(x, y, z, w);
+
+        scatter_SSE(result + AnimPoseBuffer::ScaleX * stride, childIndex, _mm_mul_ps(psx, csx));
+        scatter_SSE(result + AnimPoseBuffer::ScaleY * stride, childIndex, _mm_mul_ps(psy, csy));
+        scatter_SSE(result + AnimPoseBuffer::ScaleZ * stride, childIndex, _mm_mul_ps(psz, csz));
+        scatter_SSE(result + AnimPoseBuffer::RotX * stride, childIndex, x);
+        scatter_SSE(result + AnimPoseBuffer::RotY * stride, childIndex, y);
+        scatter_SSE(result + AnimPoseBuffer::RotZ * stride, childIndex, z);
+        scatter_SSE(result + AnimPoseBuffer::RotW * stride, childIndex, w);
+        scatter_SSE(result + AnimPoseBuffer::TransX * stride, childIndex, vx);
+        scatter_SSE(result + AnimPoseBuffer::TransY * stride, childIndex, vy);
+        scatter_SSE(result + AnimPoseBuffer::TransZ * stride, childIndex, vz);
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+void blendPoses_AVX2(const float* const* inputs, const float* alphas, int numInputs, float* result, int numPoses, int stride);
+void blendAddPoses_AVX2(const float* a, const float* b, float alpha, float* result, int numPoses, int stride);
+void normalizeRotations_AVX2(float* poses, int numPoses, int stride);
+void composePoses_AVX2(const float* parents, const float* children, float* result,
+                       const int* parentIndices, const int* childIndices, int numPoses, int stride);
+
+static void blendPoses(const float* const* inputs, const float* alphas, int numInputs, float* result, int numPoses, int stride) {
+    static auto f = cpuSupportsAVX2() ? blendPoses_AVX2 : blendPoses_SSE;
+    (*f)(inputs, alphas, numInputs, result, numPoses, stride); // dispatch
+}
+
+static void blendAddPoses(const float* a, const float* b, float alpha, float* result, int numPoses, int stride) {
+    static auto f = cpuSupportsAVX2() ? blendAddPoses_AVX2 : blendAddPoses_SSE;
+    (*f)(a, b, alpha, result, numPoses, stride); // dispatch
+}
+
+static void normalizeRotations(float* poses, int numPoses, int stride) {
+    static auto f = cpuSupportsAVX2() ? normalizeRotations_AVX2 : normalizeRotations_SSE;
+    (*f)(poses, numPoses, stride); // dispatch
+}
+
+static void composePoses(const float* parents, const float* children, float* result,
+                         const int* parentIndices, const int* childIndices, int numPoses, int stride) {
+    static auto f = cpuSupportsAVX2() ? composePoses_AVX2 : composePoses_SSE;
+    (*f)(parents, children, result, parentIndices, childIndices, numPoses, stride); // dispatch
+}
+
+#else   // portable reference code
+
+#include <GLMHelpers.h>
+
+static glm::quat readRotation(const float* poses, int index, int stride) {
+    return glm::quat(poses[AnimPoseBuffer::RotW * stride + index], poses[AnimPoseBuffer::RotX * stride + index],
+                     poses[AnimPoseBuffer::RotY * stride + index], poses[AnimPoseBuffer::RotZ * stride + index]);
+}
+
+static void writeRotation(float* poses, int index, int stride, const glm::quat& rotation) {
+    poses[AnimPoseBuffer::RotX * stride + index] = rotation.x;
+    poses[AnimPoseBuffer::RotY * stride + index] = rotation.y;
+    poses[AnimPoseBuffer::RotZ * stride + index] = rotation.z;
+    poses[AnimPoseBuffer::RotW * stride + index] = rotation.w;
+}
+
+static glm::vec3 readVector(const float* poses, int firstComponent, int index, int stride) {
+    const float* data = poses + firstComponent * stride + index;
+    return glm::vec3(data[0], data[stride], data[2 * stride]);
+}
+
+static void writeVector(float* poses, int firstComponent, int index, int stride, const glm::vec3& vector) {
+    float* data = poses + firstComponent * stride + index;
+    data[0] = vector.x;
+    data[stride] = vector.y;
+    data[2 * stride] = vector.z;
+}
+
+// linear combination of 2 to 4 sets of poses, the rotations are flipped to the side of the first before they are combined
+static void blendPoses(const float* const* inputs, const float* alphas, int numInputs, float* result, int numPoses, int stride) {
+    for (int i = 0; i < numPoses; i++) {
+        glm::vec3 scale = alphas[0] * readVector(inputs[0], AnimPoseBuffer::ScaleX, i, stride);
+        glm::quat firstRotation = readRotation(inputs[0], i, stride);
+        glm::quat rotation = alphas[0] * firstRotation;
+        glm::vec3 trans = alphas[0] * readVector(inputs[0], AnimPoseBuffer::TransX, i, stride);
+        for (int k = 1; k < numInputs; k++) {
+            scale += alphas[k] * readVector(inputs[k], AnimPoseBuffer::ScaleX, i, stride);
+            glm::quat otherRotation = readRotation(inputs[k], i, stride);
+            if (glm::dot(firstRotation, otherRotation) < 0.0f) {
+                otherRotation = -otherRotation;
+            }
+            rotation += alphas[k] * otherRotation;
+            trans += alphas[k] * readVector(inputs[k], AnimPoseBuffer::TransX, i, stride);
+        }
+        writeVector(result, AnimPoseBuffer::ScaleX, i, stride, scale);
+        writeRotation(result, i, stride, glm::normalize(rotation));
+        writeVector(result, AnimPoseBuffer::TransX, i, stride, trans);
+    }
+}
+
+static void blendAddPoses(const float* a, const float* b, float alpha, float* result, int numPoses, int stride) {
+    for (int i = 0; i < numPoses; i++) {
+        glm::vec3 scale = readVector(a, AnimPoseBuffer::ScaleX, i, stride) *
+            lerp(glm::vec3(1.0f), readVector(b, AnimPoseBuffer::ScaleX, i, stride), alpha);
+        glm::quat delta = readRotation(b, i, stride);
+        if (delta.w < 0.0f) {
+            delta = -delta;
+        }
+        delta = glm::lerp(glm::quat(), delta, alpha);
+        glm::quat rotation = glm::normalize(readRotation(a, i, stride) * delta);
+        glm::vec3 trans = readVector(a, AnimPoseBuffer::TransX, i, stride) + alpha * readVector(b, AnimPoseBuffer::TransX, i, stride);
+
+        writeVector(result, AnimPoseBuffer::ScaleX, i, stride, scale);
+        writeRotation(result, i, stride, rotation);
+        writeVector(result, AnimPoseBuffer::TransX, i, stride, trans);
+    }
+}
+
+static void normalizeRotations(float* poses, int numPoses, int stride) {
+    for (int i = 0; i < numPoses; i++) {
+        writeRotation(poses, i, stride, glm::normalize(readRotation(poses, i, stride)));
+    }
+}
+
+// result[childIndices[i]] = parents[parentIndices[i]] * children[childIndices[i]], composed by scale, rotation and translation
+static void composePoses(const float* parents, const float* children, float* result,
+                         const int* parentIndices, const int* childIndices, int numPoses, int stride) {
+    for (int i = 0; i < numPoses; i++) {
+        int parent = parentIndices[i];
+        int child = childIndices[i];
+        glm::vec3 parentScale = readVector(parents, AnimPoseBuffer::ScaleX, parent, stride);
+        glm::quat parentRotation = readRotation(parents, parent, stride);
+
+        glm::vec3 scale = parentScale * readVector(children, AnimPoseBuffer::ScaleX, child, stride);
+        glm::quat rotation = glm::normalize(parentRotation * readRotation(children, child, stride));
+        glm::vec3 trans = readVector(parents, AnimPoseBuffer::TransX, parent, stride) +
+            parentRotation * (parentScale * readVector(children, AnimPoseBuffer::TransX, child, stride));
+
+        // like glm::quat_cast, give the largest component a positive sign
+        float largest = rotation.w;
+        if (rotation.x * rotation.x > largest * largest) {
+            largest = rotation.x;
+        }
+        if (rotation.y * rotation.y > largest * largest) {
+            largest = rotation.y;
+        }
+        if (rotation.z * rotation.z > largest * largest) {
+            largest = rotation.z;
+        }
+        if (largest < 0.0f) {
+            rotation = -rotation;
+        }
+
+        writeVector(result, AnimPoseBuffer::ScaleX, child, stride, scale);
+        writeRotation(result, child, stride, rotation);
+        writeVector(result, AnimPoseBuffer::TransX, child, stride, trans);
+    }
+}
+
+#endif
+
+void AnimPoseBuffer::resize(int numPoses) {
+    if (numPoses == _size && !_data.empty()) {
+        return;
+    }
+    _size = numPoses;
+    _stride = roundUpToBlock(numPoses + 1);
+    _data.resize(NUM_COMPONENTS * _stride);
+
+    // the padding holds identity poses, so that the kernels never see a zero length rotation
+    std::fill(_data.begin(), _data.end(), 0.0f);
+    std::fill(data(ScaleX), data(ScaleZ) + _stride, 1.0f);
+    std::fill(data(RotW), data(RotW) + _stride, 1.0f);
+}
+
+void AnimPoseBuffer::load(const AnimPose* poses, int numPoses) {
+    resize(numPoses);
+    for (int i = 0; i < numPoses; i++) {
+        setPose(i, poses[i]);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPose* poses) const {
+    for (int i = 0; i < _size; i++) {
+        poses[i] = getPose(i);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPoseVec& poses) const {
+    poses.resize(_size);
+    store(poses.data());
+}
+
+AnimPose AnimPoseBuffer::getPose(int index) const {
+    const float* pose = _data.data() + index;
+    return AnimPose(glm::vec3(pose[ScaleX * _stride], pose[ScaleY * _stride], pose[ScaleZ * _stride]),
+                    glm::quat(pose[RotW * _stride], pose[RotX * _stride], pose[RotY * _stride], pose[RotZ * _stride]),
+                    glm::vec3(pose[TransX * _stride], pose[TransY * _stride], pose[TransZ * _stride]));
+}
+
+void AnimPoseBuffer::setPose(int index, const AnimPose& pose) {
+    float* data = _data.data() + index;
+    data[ScaleX * _stride] = pose.scale().x;
+    data[ScaleY * _stride] = pose.scale().y;
+    data[ScaleZ * _stride] = pose.scale().z;
+    data[RotX * _stride] = pose.rot().x;
+    data[RotY * _stride] = pose.rot().y;
+    data[RotZ * _stride] = pose.rot().z;
+    data[RotW * _stride] = pose.rot().w;
+    data[TransX * _stride] = pose.trans().x;
+    data[TransY * _stride] = pose.trans().y;
+    data[TransZ * _stride] = pose.trans().z;
+}
+
+static const float UNIFORM_SCALE_TOLERANCE = 0.0001f;
+
+static bool isUniformScale(float x, float y, float z) {
+    float tolerance = UNIFORM_SCALE_TOLERANCE * x;
+    return x > 0.0f && fabsf(y - x) <= tolerance && fabsf(z - x) <= tolerance;
+}
+
+bool AnimPoseBuffer::isUniformScale(const glm::vec3& scale) {
+    return ::isUniformScale(scale.x, scale.y, scale.z);
+}
+
+bool AnimPoseBuffer::hasUniformScales() const {
+    const float* scaleX = data(ScaleX);
+    const float* scaleY = data(ScaleY);
+    const float* scaleZ = data(ScaleZ);
+    for (int i = 0; i < _size; i++) {
+        if (!::isUniformScale(scaleX[i], scaleY[i], scaleZ[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AnimPoseBuffer::normalizeRotations() {
+    ::normalizeRotations(data(), roundUpToBlock(_size), _stride);
+}
+
+void AnimPoseBuffer::blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    const float* inputs[] = { a.data(), b.data() };
+    const float alphas[] = { 1.0f - alpha, alpha };
+    blendPoses(inputs, alphas, 2, result.data(), roundUpToBlock(a.size()), a.getStride());
+}
+
+void AnimPoseBuffer::blend3(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const AnimPoseBuffer& c, const float* alphas,
+                            AnimPoseBuffer& result) {
+    assert(a.size() == b.size() && a.size() == c.size());
+    result.resize(a.size());
+    const float* inputs[] = { a.data(), b.data(), c.data() };
+    blendPoses(inputs, alphas, 3, result.data(), roundUpToBlock(a.size()), a.getStride());
+}
+
+void AnimPoseBuffer::blend4(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const AnimPoseBuffer& c, const AnimPoseBuffer& d,
+                            const float* alphas, AnimPoseBuffer& result) {
+    assert(a.size() == b.size() && a.size() == c.size() && a.size() == d.size());
+    result.resize(a.size());
+    const float* inputs[] = { a.data(), b.data(), c.data(), d.data() };
+    blendPoses(inputs, alphas, 4, result.data(), roundUpToBlock(a.size()), a.getStride());
+}
+
+void AnimPoseBuffer::blendAdd(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    blendAddPoses(a.data(), b.data(), alpha, result.data(), roundUpToBlock(a.size()), a.getStride());
+}
+
+void AnimPoseBuffer::buildAbsolutePoses(const AnimPoseBuffer& relative, const AnimPoseHierarchy& hierarchy,
+                                        const AnimPose& rootPose, AnimPoseBuffer& absolute) {
+    assert(relative.size() == hierarchy.getNumJoints());
+    absolute.resize(relative.size());
+
+    // the spare pose after the last joint is the parent of the roots
+    absolute.setPose(relative.size(), rootPose);
+
+    const auto& jointOrder = hierarchy.getJointOrder();
+    composePoses(absolute.data(), relative.data(), absolute.data(), hierarchy.getParentOrder().data(), jointOrder.data(),
+                 (int)jointOrder.size(), relative.getStride());
+}
@@ -0,0 +1,105 @@
+//
+//  AnimPoseBuffer.h
+//  libraries/animation/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer_h
+#define hifi_AnimPoseBuffer_h
+
+#include <vector>
+
+#include "AnimPose.h"
+
+// The joints of a skeleton grouped by their depth, so that the absolute poses of a whole group can be computed at once:
+// the parents of the joints in a group are all in earlier groups.
+class AnimPoseHierarchy {
+public:
+    AnimPoseHierarchy() {}
+    explicit AnimPoseHierarchy(const std::vector<int>& parentIndices);
+
+    int getNumJoints() const { return _numJoints; }
+
+    // the joint indices ordered by depth, each depth is padded to a multiple of AnimPoseBuffer::POSES_PER_BLOCK
+    // by repeating its last joint
+    const std::vector<int>& getJointOrder() const { return _jointOrder; }
+
+    // the parents of the joints in getJointOrder(), roots have getNumJoints() as their parent
+    const std::vector<int>& getParentOrder() const { return _parentOrder; }
+
+private:
+    int _numJoints { 0 };
+    std::vector<int> _jointOrder;
+    std::vector<int> _parentOrder;
+};
+
+// Poses stored as a structure of arrays: each component of the scales, rotations and translations is kept in its own
+// array, so that the kernels below work on 4 (SSE) or 8 (AVX2) joints at once.
+//
+// The arrays are padded with identity poses to a multiple of POSES_PER_BLOCK, with at least one spare pose that
+// buildAbsolutePoses() uses as the parent of the roots.
+class AnimPoseBuffer {
+public:
+    enum Component {
+        ScaleX, ScaleY, ScaleZ,
+        RotX, RotY, RotZ, RotW,
+        TransX, TransY, TransZ,
+        NUM_COMPONENTS
+    };
+
+    static const int POSES_PER_BLOCK = 8;
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(int numPoses) { resize(numPoses); }
+
+    void resize(int numPoses);
+    int size() const { return _size; }
+
+    // the distance between the arrays of two consecutive components
+    int getStride() const { return _stride; }
+
+    float* data() { return _data.data(); }
+    const float* data() const { return _data.data(); }
+    float* data(Component component) { return _data.data() + component * _stride; }
+    const float* data(Component component) const { return _data.data() + component * _stride; }
+
+    void load(const AnimPose* poses, int numPoses);
+    void load(const AnimPoseVec& poses) { load(poses.data(), (int)poses.size()); }
+    void store(AnimPose* poses) const;
+    void store(AnimPoseVec& poses) const;
+
+    AnimPose getPose(int index) const;
+    void setPose(int index, const AnimPose& pose);
+
+    // true when all of the scales are positive and uniform, composing such poses by their scale, rotation and
+    // translation gives the same result as multiplying their matrices
+    bool hasUniformScales() const;
+    static bool isUniformScale(const glm::vec3& scale);
+
+    void normalizeRotations();
+
+    // the buffers passed to these must all be the same size
+    static void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+    static void blend3(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const AnimPoseBuffer& c, const float* alphas,
+                       AnimPoseBuffer& result);
+    static void blend4(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const AnimPoseBuffer& c, const AnimPoseBuffer& d,
+                       const float* alphas, AnimPoseBuffer& result);
+    static void blendAdd(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
+    // converts the relative poses of a skeleton to absolute poses, the roots are transformed by rootPose.
+    // the rotations are given the sign glm::quat_cast would give them, so that the result matches AnimPose::operator*
+    // when relative.hasUniformScales() and rootPose has a uniform scale.
+    static void buildAbsolutePoses(const AnimPoseBuffer& relative, const AnimPoseHierarchy& hierarchy,
+                                   const AnimPose& rootPose, AnimPoseBuffer& absolute);
+
+private:
+    std::vector<float> _data;
+    int _size { 0 };
+    int _stride { 0 };
+};
+
+#endif // hifi_AnimPoseBuffer_h
@@ -206,6 +206,7 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
     for (auto& joint : _joints) {
         _parentIndices.push_back(joint.parentIndex);
     }
+    _poseHierarchy = AnimPoseHierarchy(_parentIndices);
 
     _jointsSize = (int)joints.size();
     // build a cache of bind poses
@@ -260,6 +261,20 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
         }
     }
 
+    // build core joints
+    int leftHandIndex = nameToJointIndex("LeftHand");
+    int rightHandIndex = nameToJointIndex("RightHand");
+    int headIndex = nameToJointIndex("Head");
+    _isCoreJoint.assign(_jointsSize, true);
+    for (int i = 0; i < _jointsSize; i++) {
+        for (int parentIndex = _parentIndices[i]; parentIndex != -1; parentIndex = _parentIndices[parentIndex]) {
+            if (parentIndex == leftHandIndex || parentIndex == rightHandIndex || parentIndex == headIndex) {
+                _isCoreJoint[i] = false;
+                break;
+            }
+        }
+    }
+
     // build mirror map.
     _nonMirroredIndices.clear();
     _mirrorMap.reserve(_jointsSize);
@@ -17,6 +17,7 @@
 
 #include <FBXSerializer.h>
 #include "AnimPose.h"
+#include "AnimPoseBuffer.h"
 
 class AnimSkeleton {
 public:
@@ -48,6 +49,12 @@ public:
         return _parentIndices[jointIndex];
     }
 
+    // the joints grouped by depth, for AnimPoseBuffer::buildAbsolutePoses
+    const AnimPoseHierarchy& getPoseHierarchy() const { return _poseHierarchy; }
+
+    // all but the joints below the hands and the head, the fingers and face that a distant avatar can do without
+    bool isCoreJoint(int jointIndex) const { return _isCoreJoint[jointIndex]; }
+
     std::vector<int> getChildrenOfJoint(int jointIndex) const;
 
     AnimPose getAbsolutePose(int jointIndex, const AnimPoseVec& relativePoses) const;
@@ -75,6 +82,8 @@ protected:
 
     std::vector<HFMJoint> _joints;
     std::vector<int> _parentIndices;
+    AnimPoseHierarchy _poseHierarchy;
+    std::vector<bool> _isCoreJoint;
     int _jointsSize { 0 };
     AnimPoseVec _relativeDefaultPoses;
     AnimPoseVec _absoluteDefaultPoses;
@@ -13,9 +13,10 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
+#include "AnimPoseBuffer.h"
+
 // TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
-void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+static void blendPoses(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -26,7 +27,7 @@ void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, A
     }
 }
 
-void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result) {
+static void blendPoses3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -38,7 +39,7 @@ void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPos
     }
 }
 
-void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+static void blendPoses4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -51,8 +52,7 @@ void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPos
     }
 }
 
-// additive blend
-void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+static void blendAddPoses(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
 
     const glm::vec3 IDENTITY_SCALE = glm::vec3(1.0f);
     const glm::quat IDENTITY_ROT = glm::quat();
@@ -75,6 +75,68 @@ void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha
     }
 }
 
+// a few poses are blended one at a time, whole skeletons are copied into AnimPoseBuffers and blended by their SIMD
+// kernels.  the buffers are kept per thread, as the rigs of other avatars are updated on worker threads.
+static const size_t MIN_BUFFERED_POSES = AnimPoseBuffer::POSES_PER_BLOCK;
+static const int MAX_BLEND_INPUTS = 4;
+
+static AnimPoseBuffer* getBlendBuffers() {
+    static thread_local AnimPoseBuffer buffers[MAX_BLEND_INPUTS + 1];
+    return buffers;
+}
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    if (numPoses < MIN_BUFFERED_POSES) {
+        blendPoses(numPoses, a, b, alpha, result);
+        return;
+    }
+    AnimPoseBuffer* buffers = getBlendBuffers();
+    buffers[0].load(a, (int)numPoses);
+    buffers[1].load(b, (int)numPoses);
+    AnimPoseBuffer::blend(buffers[0], buffers[1], alpha, buffers[MAX_BLEND_INPUTS]);
+    buffers[MAX_BLEND_INPUTS].store(result);
+}
+
+void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result) {
+    if (numPoses < MIN_BUFFERED_POSES) {
+        blendPoses3(numPoses, a, b, c, alphas, result);
+        return;
+    }
+    AnimPoseBuffer* buffers = getBlendBuffers();
+    buffers[0].load(a, (int)numPoses);
+    buffers[1].load(b, (int)numPoses);
+    buffers[2].load(c, (int)numPoses);
+    AnimPoseBuffer::blend3(buffers[0], buffers[1], buffers[2], alphas, buffers[MAX_BLEND_INPUTS]);
+    buffers[MAX_BLEND_INPUTS].store(result);
+}
+
+void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+    if (numPoses < MIN_BUFFERED_POSES) {
+        blendPoses4(numPoses, a, b, c, d, alphas, result);
+        return;
+    }
+    AnimPoseBuffer* buffers = getBlendBuffers();
+    buffers[0].load(a, (int)numPoses);
+    buffers[1].load(b, (int)numPoses);
+    buffers[2].load(c, (int)numPoses);
+    buffers[3].load(d, (int)numPoses);
+    AnimPoseBuffer::blend4(buffers[0], buffers[1], buffers[2], buffers[3], alphas, buffers[MAX_BLEND_INPUTS]);
+    buffers[MAX_BLEND_INPUTS].store(result);
+}
+
+// additive blend
+void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    if (numPoses < MIN_BUFFERED_POSES) {
+        blendAddPoses(numPoses, a, b, alpha, result);
+        return;
+    }
+    AnimPoseBuffer* buffers = getBlendBuffers();
+    buffers[0].load(a, (int)numPoses);
+    buffers[1].load(b, (int)numPoses);
+    AnimPoseBuffer::blendAdd(buffers[0], buffers[1], alpha, buffers[MAX_BLEND_INPUTS]);
+    buffers[MAX_BLEND_INPUTS].store(result);
+}
+
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats) {
     if (numQuats == 0) {
         return glm::quat();
@@ -138,6 +200,21 @@ float accumulateTime(float startFrame, float endFrame, float timeScale, float cu
     return frame;
 }
 
+int computeLevelOfDetail(float screenSize, int currentLOD, const float* minScreenSizes, int numLODs, float hysteresis) {
+    int lod = 0;
+    while (lod < numLODs - 1) {
+        float minScreenSize = minScreenSizes[lod];
+        if (lod >= currentLOD) {
+            minScreenSize *= hysteresis;
+        }
+        if (screenSize >= minScreenSize) {
+            break;
+        }
+        lod++;
+    }
+    return lod;
+}
+
 // rotate bone's y-axis with target.
 AnimPose boneLookAt(const glm::vec3& target, const AnimPose& bone) {
     glm::vec3 u, v, w;
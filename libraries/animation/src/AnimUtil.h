@@ -75,6 +75,10 @@ inline glm::quat safeLinearCombine4(const glm::quat& a, const glm::quat& b, cons
     return glm::normalize(alphas[0] * a + alphas[1] * bTemp + alphas[2] * cTemp + alphas[3] * dTemp);
 }
 
+// the first of numLODs levels of detail, finest first, whose minimum screen size screenSize reaches.  the current level
+// and the coarser ones only need hysteresis times their minimum, so that a size near a threshold doesn't flicker between two.
+int computeLevelOfDetail(float screenSize, int currentLOD, const float* minScreenSizes, int numLODs, float hysteresis);
+
 AnimPose boneLookAt(const glm::vec3& target, const AnimPose& bone);
 
 // This will attempt to determine the proper body facing of a characters body
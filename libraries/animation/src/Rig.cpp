@@ -28,6 +28,7 @@
 #include "AnimClip.h"
 #include "AnimInverseKinematics.h"
 #include "AnimOverlay.h"
+#include "AnimPoseBuffer.h"
 #include "AnimSkeleton.h"
 #include "AnimStateMachine.h"
 #include "AnimUtil.h"
@@ -629,6 +630,7 @@ void Rig::initJointStates(const HFMModel& hfmModel, const glm::mat4& modelOffset
 
     _internalPoseSet._relativePoses.clear();
     _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
+    _numJointInterpolationFrames = 0;
     _networkPoseSet._relativePoses.clear();
     _networkPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
 
@@ -673,6 +675,7 @@ void Rig::reset(const HFMModel& hfmModel) {
 
     _internalPoseSet._relativePoses.clear();
     _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
+    _numJointInterpolationFrames = 0;
 
     buildAbsoluteRigPoses(_internalPoseSet._relativePoses, _internalPoseSet._absolutePoses);
 
@@ -2547,6 +2550,19 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
 
     absolutePosesOut.resize(relativePoses.size());
     AnimPose geometryToRigTransform(_geometryToRigTransform);
+
+    // composing poses by their scale, rotation and translation is only the same as multiplying their matrices
+    // when the scales are uniform, which they nearly always are, otherwise use the matrices.
+    static thread_local AnimPoseBuffer relativeBuffer;
+    static thread_local AnimPoseBuffer absoluteBuffer;
+    relativeBuffer.load(relativePoses);
+    if (AnimPoseBuffer::isUniformScale(geometryToRigTransform.scale()) && relativeBuffer.hasUniformScales()) {
+        AnimPoseBuffer::buildAbsolutePoses(relativeBuffer, _animSkeleton->getPoseHierarchy(), geometryToRigTransform,
+                                           absoluteBuffer);
+        absoluteBuffer.store(absolutePosesOut.data());
+        return;
+    }
+
     for (int i = 0; i < (int)relativePoses.size(); i++) {
         int parentIndex = _animSkeleton->getParentIndex(i);
         if (parentIndex == -1) {
@@ -2619,7 +2635,7 @@ void Rig::copyJointsIntoJointData(QVector<JointData>& jointDataVec) const {
     }
 }
 
-void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
+void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec, bool coreJointsOnly, int numInterpolationFrames) {
     DETAILED_PROFILE_RANGE(simulation_animation_detail, "copyJoints");
     DETAILED_PERFORMANCE_TIMER("copyJoints");
 
@@ -2649,23 +2665,68 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     }
 
     // convert rotations from absolute to parent relative.
-    _animSkeleton->convertAbsoluteRotationsToRelative(rotations);
+    if (coreJointsOnly) {
+        for (int i = numJoints - 1; i >= 0; --i) {
+            int parentIndex = _animSkeleton->getParentIndex(i);
+            if (parentIndex != -1 && _animSkeleton->isCoreJoint(i)) {
+                rotations[i] = glm::inverse(rotations[parentIndex]) * rotations[i];
+            }
+        }
+    } else {
+        _animSkeleton->convertAbsoluteRotationsToRelative(rotations);
+    }
 
     // store new relative poses
     if (numJoints != (int)_internalPoseSet._relativePoses.size()) {
         _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
     }
+    bool interpolate = numInterpolationFrames > 1;
+    if (interpolate) {
+        _jointInterpolationStartPoses = _internalPoseSet._relativePoses;
+        _jointInterpolationEndPoses = _internalPoseSet._relativePoses;
+    }
+    AnimPoseVec& relativePoses = interpolate ? _jointInterpolationEndPoses : _internalPoseSet._relativePoses;
     const AnimPoseVec& relativeDefaultPoses = _animSkeleton->getRelativeDefaultPoses();
     for (int i = 0; i < numJoints; i++) {
+        if (coreJointsOnly && !_animSkeleton->isCoreJoint(i)) {
+            continue;
+        }
         const JointData& data = jointDataVec.at(i);
-        _internalPoseSet._relativePoses[i].rot() = rotations[i];
+        relativePoses[i].rot() = rotations[i];
         if (data.translationIsDefaultPose) {
-            _internalPoseSet._relativePoses[i].trans() = relativeDefaultPoses[i].trans();
+            relativePoses[i].trans() = relativeDefaultPoses[i].trans();
         } else {
             // JointData translations are in relative-frame
-            _internalPoseSet._relativePoses[i].trans() = data.translation;
+            relativePoses[i].trans() = data.translation;
         }
     }
+
+    _jointInterpolationFrame = 0;
+    _numJointInterpolationFrames = interpolate ? numInterpolationFrames : 0;
+    if (interpolate) {
+        stepJointInterpolation();
+    }
+}
+
+void Rig::stepJointInterpolation() {
+    if (!isInterpolatingJoints()) {
+        return;
+    }
+    size_t numPoses = _jointInterpolationEndPoses.size();
+    if (numPoses != _internalPoseSet._relativePoses.size() || numPoses != _jointInterpolationStartPoses.size()) {
+        // the skeleton changed since the interpolation started
+        _numJointInterpolationFrames = 0;
+        return;
+    }
+
+    _jointInterpolationFrame++;
+    if (_jointInterpolationFrame < _numJointInterpolationFrames) {
+        float alpha = (float)_jointInterpolationFrame / (float)_numJointInterpolationFrames;
+        ::blend(numPoses, _jointInterpolationStartPoses.data(), _jointInterpolationEndPoses.data(), alpha,
+                _internalPoseSet._relativePoses.data());
+    } else {
+        _internalPoseSet._relativePoses = _jointInterpolationEndPoses;
+    }
 }
 
 void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
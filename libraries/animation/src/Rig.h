@@ -223,7 +223,13 @@ public:
     bool getRelativeDefaultJointTranslation(int index, glm::vec3& translationOut) const;
 
     void copyJointsIntoJointData(QVector<JointData>& jointDataVec) const;
-    void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
+    // with coreJointsOnly the joints that aren't AnimSkeleton::isCoreJoint() keep their current poses.
+    // with numInterpolationFrames > 1 the joints move from the poses they have towards the new ones over that many
+    // frames, the first step now and one more per call to stepJointInterpolation().
+    void copyJointsFromJointData(const QVector<JointData>& jointDataVec, bool coreJointsOnly = false,
+                                 int numInterpolationFrames = 1);
+    bool isInterpolatingJoints() const { return _jointInterpolationFrame < _numJointInterpolationFrames; }
+    void stepJointInterpolation();
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
 
     void computeAvatarBoundingCapsule(const HFMModel& hfmModel, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
@@ -303,6 +309,12 @@ protected:
     PoseSet _internalPoseSet;
     PoseSet _networkPoseSet;
 
+    // the relative poses the joint interpolation of copyJointsFromJointData() moves between
+    AnimPoseVec _jointInterpolationStartPoses;
+    AnimPoseVec _jointInterpolationEndPoses;
+    int _jointInterpolationFrame { 0 };
+    int _numJointInterpolationFrames { 0 };
+
     // Copy of the _poseSet for external threads.
     PoseSet _externalPoseSet;
     mutable QReadWriteLock _externalPoseSetLock;
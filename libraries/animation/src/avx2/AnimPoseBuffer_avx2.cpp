@@ -0,0 +1,265 @@
+//
+//  AnimPoseBuffer_avx2.cpp
+//  libraries/animation/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AnimPoseBuffer.h"
+
+static inline __m256 dot4_AVX2(__m256 ax, __m256 ay, __m256 az, __m256 aw, __m256 bx, __m256 by, __m256 bz, __m256 bw) {
+    return _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+}
+
+// like glm::normalize, a zero length quaternion becomes the identity
+static inline void normalize_AVX2(__m256& x, __m256& y, __m256& z, __m256& w) {
+    __m256 lengthSquared = dot4_AVX2(x, y, z, w, x, y, z, w);
+    __m256 isValid = _mm256_cmp_ps(lengthSquared, _mm256_setzero_ps(), _CMP_GT_OQ);
+    __m256 oneOverLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+    x = _mm256_and_ps(isValid, _mm256_mul_ps(x, oneOverLength));
+    y = _mm256_and_ps(isValid, _mm256_mul_ps(y, oneOverLength));
+    z = _mm256_and_ps(isValid, _mm256_mul_ps(z, oneOverLength));
+    w = _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(w, oneOverLength), isValid);
+}
+
+// like glm::quat_cast, gives the largest component a positive sign
+static inline void canonicalize_AVX2(__m256& x, __m256& y, __m256& z, __m256& w) {
+    __m256 largest = w;
+    __m256 largestSquared = _mm256_mul_ps(w, w);
+    __m256 squared = _mm256_mul_ps(x, x);
+    __m256 isLarger = _mm256_cmp_ps(squared, largestSquared, _CMP_GT_OQ);
+    largest = _mm256_blendv_ps(largest, x, isLarger);
+    largestSquared = _mm256_blendv_ps(largestSquared, squared, isLarger);
+    squared = _mm256_mul_ps(y, y);
+    isLarger = _mm256_cmp_ps(squared, largestSquared, _CMP_GT_OQ);
+    largest = _mm256_blendv_ps(largest, y, isLarger);
+    largestSquared = _mm256_blendv_ps(largestSquared, squared, isLarger);
+    squared = _mm256_mul_ps(z, z);
+    isLarger = _mm256_cmp_ps(squared, largestSquared, _CMP_GT_OQ);
+    largest = _mm256_blendv_ps(largest, z, isLarger);
+
+    __m256 sign = _mm256_and_ps(largest, _mm256_set1_ps(-0.0f));
+    x = _mm256_xor_ps(x, sign);
+    y = _mm256_xor_ps(y, sign);
+    z = _mm256_xor_ps(z, sign);
+    w = _mm256_xor_ps(w, sign);
+}
+
+// (x, y, z, w) = a * b
+static inline void multiply_AVX2(__m256 ax, __m256 ay, __m256 az, __m256 aw, __m256 bx, __m256 by, __m256 bz, __m256 bw,
+                                 __m256& x, __m256& y, __m256& z, __m256& w) {
+    x = _mm256_fnmadd_ps(az, by, _mm256_fmadd_ps(ay, bz, _mm256_fmadd_ps(ax, bw, _mm256_mul_ps(aw, bx))));
+    y = _mm256_fnmadd_ps(ax, bz, _mm256_fmadd_ps(az, bx, _mm256_fmadd_ps(ay, bw, _mm256_mul_ps(aw, by))));
+    z = _mm256_fnmadd_ps(ay, bx, _mm256_fmadd_ps(ax, by, _mm256_fmadd_ps(az, bw, _mm256_mul_ps(aw, bz))));
+    w = _mm256_fnmadd_ps(az, bz, _mm256_fnmadd_ps(ay, by, _mm256_fnmadd_ps(ax, bx, _mm256_mul_ps(aw, bw))));
+}
+
+static inline void scatter_AVX2(float* data, const int* indices, __m256 value) {
+    float values[8];
+    _mm256_storeu_ps(values, value);
+    for (int i = 0; i < 8; i++) {
+        data[indices[i]] = values[i];
+    }
+}
+
+void blendPoses_AVX2(const float* const* inputs, const float* alphas, int numInputs, float* result, int numPoses, int stride) {
+
+    static const int LINEAR_COMPONENTS[] = {
+        AnimPoseBuffer::ScaleX, AnimPoseBuffer::ScaleY, AnimPoseBuffer::ScaleZ,
+        AnimPoseBuffer::TransX, AnimPoseBuffer::TransY, AnimPoseBuffer::TransZ
+    };
+    const int rx = AnimPoseBuffer::RotX * stride;
+    const int ry = AnimPoseBuffer::RotY * stride;
+    const int rz = AnimPoseBuffer::RotZ * stride;
+    const int rw = AnimPoseBuffer::RotW * stride;
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    assert(numPoses % 8 == 0);
+
+    for (int i = 0; i < numPoses; i += 8) {
+
+        for (int component : LINEAR_COMPONENTS) {
+            int offset = component * stride + i;
+            __m256 sum = _mm256_mul_ps(_mm256_set1_ps(alphas[0]), _mm256_loadu_ps(&inputs[0][offset]));
+            for (int k = 1; k < numInputs; k++) {
+                sum = _mm256_fmadd_ps(_mm256_set1_ps(alphas[k]), _mm256_loadu_ps(&inputs[k][offset]), sum);
+            }
+            _mm256_storeu_ps(&result[offset], sum);
+        }
+
+        __m256 ax = _mm256_loadu_ps(&inputs[0][rx + i]);
+        __m256 ay = _mm256_loadu_ps(&inputs[0][ry + i]);
+        __m256 az = _mm256_loadu_ps(&inputs[0][rz + i]);
+        __m256 aw = _mm256_loadu_ps(&inputs[0][rw + i]);
+
+        __m256 alpha = _mm256_set1_ps(alphas[0]);
+        __m256 x = _mm256_mul_ps(alpha, ax);
+        __m256 y = _mm256_mul_ps(alpha, ay);
+        __m256 z = _mm256_mul_ps(alpha, az);
+        __m256 w = _mm256_mul_ps(alpha, aw);
+
+        for (int k = 1; k < numInputs; k++) {
+            __m256 bx = _mm256_loadu_ps(&inputs[k][rx + i]);
+            __m256 by = _mm256_loadu_ps(&inputs[k][ry + i]);
+            __m256 bz = _mm256_loadu_ps(&inputs[k][rz + i]);
+            __m256 bw = _mm256_loadu_ps(&inputs[k][rw + i]);
+
+            // negating the alpha negates the rotation
+            __m256 dot = dot4_AVX2(ax, ay, az, aw, bx, by, bz, bw);
+            __m256 isOpposite = _mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ);
+            alpha = _mm256_xor_ps(_mm256_set1_ps(alphas[k]), _mm256_and_ps(isOpposite, signMask));
+
+            x = _mm256_fmadd_ps(alpha, bx, x);
+            y = _mm256_fmadd_ps(alpha, by, y);
+            z = _mm256_fmadd_ps(alpha, bz, z);
+            w = _mm256_fmadd_ps(alpha, bw, w);
+        }
+
+        normalize_AVX2(x, y, z, w);
+        _mm256_storeu_ps(&result[rx + i], x);
+        _mm256_storeu_ps(&result[ry + i], y);
+        _mm256_storeu_ps(&result[rz + i], z);
+        _mm256_storeu_ps(&result[rw + i], w);
+    }
+}
+
+void blendAddPoses_AVX2(const float* a, const float* b, float alpha, float* result, int numPoses, int stride) {
+
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 alpha8 = _mm256_set1_ps(alpha);
+    const __m256 oneMinusAlpha = _mm256_set1_ps(1.0f - alpha);
+    const int rx = AnimPoseBuffer::RotX * stride;
+    const int ry = AnimPoseBuffer::RotY * stride;
+    const int rz = AnimPoseBuffer::RotZ * stride;
+    const int rw = AnimPoseBuffer::RotW * stride;
+
+    assert(numPoses % 8 == 0);
+
+    for (int i = 0; i < numPoses; i += 8) {
+
+        for (int component = AnimPoseBuffer::ScaleX; component <= AnimPoseBuffer::ScaleZ; component++) {
+            int offset = component * stride + i;
+            __m256 scale = _mm256_fmadd_ps(_mm256_loadu_ps(&b[offset]), alpha8, oneMinusAlpha);
+            _mm256_storeu_ps(&result[offset], _mm256_mul_ps(_mm256_loadu_ps(&a[offset]), scale));
+        }
+
+        // the delta is flipped to the side of the identity, then lerped from it
+        __m256 bx = _mm256_loadu_ps(&b[rx + i]);
+        __m256 by = _mm256_loadu_ps(&b[ry + i]);
+        __m256 bz = _mm256_loadu_ps(&b[rz + i]);
+        __m256 bw = _mm256_loadu_ps(&b[rw + i]);
+        __m256 sign = _mm256_and_ps(_mm256_cmp_ps(bw, _mm256_setzero_ps(), _CMP_LT_OQ), signMask);
+        __m256 signedAlpha = _mm256_xor_ps(alpha8, sign);
+        __m256 dx = _mm256_mul_ps(bx, signedAlpha);
+        __m256 dy = _mm256_mul_ps(by, signedAlpha);
+        __m256 dz = _mm256_mul_ps(bz, signedAlpha);
+        __m256 dw = _mm256_fmadd_ps(bw, signedAlpha, oneMinusAlpha);
+
+        __m256 x, y, z, w;
+        multiply_AVX2(_mm256_loadu_ps(&a[rx + i]), _mm256_loadu_ps(&a[ry + i]), _mm256_loadu_ps(&a[rz + i]),
+                      _mm256_loadu_ps(&a[rw + i]), dx, dy, dz, dw, x, y, z, w);
+        normalize_AVX2(x, y, z, w);
+        _mm256_storeu_ps(&result[rx + i], x);
+        _mm256_storeu_ps(&result[ry + i], y);
+        _mm256_storeu_ps(&result[rz + i], z);
+        _mm256_storeu_ps(&result[rw + i], w);
+
+        for (int component = AnimPoseBuffer::TransX; component <= AnimPoseBuffer::TransZ; component++) {
+            int offset = component * stride + i;
+            __m256 trans = _mm256_fmadd_ps(alpha8, _mm256_loadu_ps(&b[offset]), _mm256_loadu_ps(&a[offset]));
+            _mm256_storeu_ps(&result[offset], trans);
+        }
+    }
+}
+
+void normalizeRotations_AVX2(float* poses, int numPoses, int stride) {
+
+    float* rx = poses + AnimPoseBuffer::RotX * stride;
+    float* ry = poses + AnimPoseBuffer::RotY * stride;
+    float* rz = poses + AnimPoseBuffer::RotZ * stride;
+    float* rw = poses + AnimPoseBuffer::RotW * stride;
+
+    assert(numPoses % 8 == 0);
+
+    for (int i = 0; i < numPoses; i += 8) {
+        __m256 x = _mm256_loadu_ps(&rx[i]);
+        __m256 y = _mm256_loadu_ps(&ry[i]);
+        __m256 z = _mm256_loadu_ps(&rz[i]);
+        __m256 w = _mm256_loadu_ps(&rw[i]);
+        normalize_AVX2(x, y, z, w);
+        _mm256_storeu_ps(&rx[i], x);
+        _mm256_storeu_ps(&ry[i], y);
+        _mm256_storeu_ps(&rz[i], z);
+        _mm256_storeu_ps(&rw[i], w);
+    }
+}
+
+void composePoses_AVX2(const float* parents, const float* children, float* result,
+                       const int* parentIndices, const int* childIndices, int numPoses, int stride) {
+
+    const __m256 two = _mm256_set1_ps(2.0f);
+
+    assert(numPoses % 8 == 0);
+
+    for (int i = 0; i < numPoses; i += 8) {
+        const int* childIndex = &childIndices[i];
+        __m256i parentIndex8 = _mm256_loadu_si256((const __m256i*)&parentIndices[i]);
+        __m256i childIndex8 = _mm256_loadu_si256((const __m256i*)childIndex);
+
+        __m256 psx = _mm256_i32gather_ps(parents + AnimPoseBuffer::ScaleX * stride, parentIndex8, 4);
+        __m256 psy = _mm256_i32gather_ps(parents + AnimPoseBuffer::ScaleY * stride, parentIndex8, 4);
+        __m256 psz = _mm256_i32gather_ps(parents + AnimPoseBuffer::ScaleZ * stride, parentIndex8, 4);
+        __m256 prx = _mm256_i32gather_ps(parents + AnimPoseBuffer::RotX * stride, parentIndex8, 4);
+        __m256 pry = _mm256_i32gather_ps(parents + AnimPoseBuffer::RotY * stride, parentIndex8, 4);
+        __m256 prz = _mm256_i32gather_ps(parents + AnimPoseBuffer::RotZ * stride, parentIndex8, 4);
+        __m256 prw = _mm256_i32gather_ps(parents + AnimPoseBuffer::RotW * stride, parentIndex8, 4);
+
+        __m256 csx = _mm256_i32gather_ps(children + AnimPoseBuffer::ScaleX * stride, childIndex8, 4);
+        __m256 csy = _mm256_i32gather_ps(children + AnimPoseBuffer::ScaleY * stride, childIndex8, 4);
+        __m256 csz = _mm256_i32gather_ps(children + AnimPoseBuffer::ScaleZ * stride, childIndex8, 4);
+        __m256 crx = _mm256_i32gather_ps(children + AnimPoseBuffer::RotX * stride, childIndex8, 4);
+        __m256 cry = _mm256_i32gather_ps(children + AnimPoseBuffer::RotY * stride, childIndex8, 4);
+        __m256 crz = _mm256_i32gather_ps(children + AnimPoseBuffer::RotZ * stride, childIndex8, 4);
+        __m256 crw = _mm256_i32gather_ps(children + AnimPoseBuffer::RotW * stride, childIndex8, 4);
+
+        // v = parent.scale * child.trans, rotated by the parent: v + 2w(q x v) + 2q x (q x v)
+        __m256 vx = _mm256_mul_ps(psx, _mm256_i32gather_ps(children + AnimPoseBuffer::TransX * stride, childIndex8, 4));
+        __m256 vy = _mm256_mul_ps(psy, _mm256_i32gather_ps(children + AnimPoseBuffer::TransY * stride, childIndex8, 4));
+        __m256 vz = _mm256_mul_ps(psz, _mm256_i32gather_ps(children + AnimPoseBuffer::TransZ * stride, childIndex8, 4));
+        __m256 tx = _mm256_mul_ps(two, _mm256_fmsub_ps(pry, vz, _mm256_mul_ps(prz, vy)));
+        __m256 ty = _mm256_mul_ps(two, _mm256_fmsub_ps(prz, vx, _mm256_mul_ps(prx, vz)));
+        __m256 tz = _mm256_mul_ps(two, _mm256_fmsub_ps(prx, vy, _mm256_mul_ps(pry, vx)));
+        vx = _mm256_add_ps(_mm256_fmadd_ps(prw, tx, vx), _mm256_fmsub_ps(pry, tz, _mm256_mul_ps(prz, ty)));
+        vy = _mm256_add_ps(_mm256_fmadd_ps(prw, ty, vy), _mm256_fmsub_ps(prz, tx, _mm256_mul_ps(prx, tz)));
+        vz = _mm256_add_ps(_mm256_fmadd_ps(prw, tz, vz), _mm256_fmsub_ps(prx, ty, _mm256_mul_ps(pry, tx)));
+        vx = _mm256_add_ps(vx, _mm256_i32gather_ps(parents + AnimPoseBuffer::TransX * stride, parentIndex8, 4));
+        vy = _mm256_add_ps(vy, _mm256_i32gather_ps(parents + AnimPoseBuffer::TransY * stride, parentIndex8, 4));
+        vz = _mm256_add_ps(vz, _mm256_i32gather_ps(parents + AnimPoseBuffer::TransZ * stride, parentIndex8, 4));
+
+        __m256 x, y, z, w;
+        multiply_AVX2(prx, pry, prz, prw, crx, cry, crz, crw, x, y, z, w);
+        normalize_AVX2(x, y, z, w);
+        canonicalize_AVX2(x, y, z, w);
+
+        scatter_AVX2(result + AnimPoseBuffer::ScaleX * stride, childIndex, _mm256_mul_ps(psx, csx));
+        scatter_AVX2(result + AnimPoseBuffer::ScaleY * stride, childIndex, _mm256_mul_ps(psy, csy));
+        scatter_AVX2(result + AnimPoseBuffer::ScaleZ * stride, childIndex, _mm256_mul_ps(psz, csz));
+        scatter_AVX2(result + AnimPoseBuffer::RotX * stride, childIndex, x);
+        scatter_AVX2(result + AnimPoseBuffer::RotY * stride, childIndex, y);
+        scatter_AVX2(result + AnimPoseBuffer::RotZ * stride, childIndex, z);
+        scatter_AVX2(result + AnimPoseBuffer::RotW * stride, childIndex, w);
+        scatter_AVX2(result + AnimPoseBuffer::TransX * stride, childIndex, vx);
+        scatter_AVX2(result + AnimPoseBuffer::TransY * stride, childIndex, vy);
+        scatter_AVX2(result + AnimPoseBuffer::TransZ * stride, childIndex, vz);
+    }
+}
+
+#endif
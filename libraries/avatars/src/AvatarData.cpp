@@ -269,21 +269,31 @@ void AvatarData::lazyInitHeadData() const {
 }
 
 
-float AvatarData::getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const {
-    auto distance = glm::distance(_globalPosition, viewerPosition);
-    float result = ROTATION_CHANGE_179D; // assume worst
+int AvatarData::getDistanceLevel(float distance) {
     if (distance < AVATAR_DISTANCE_LEVEL_1) {
-        result = AVATAR_MIN_ROTATION_DOT;
+        return 0;
     } else if (distance < AVATAR_DISTANCE_LEVEL_2) {
-        result = ROTATION_CHANGE_2D;
+        return 1;
     } else if (distance < AVATAR_DISTANCE_LEVEL_3) {
-        result = ROTATION_CHANGE_4D;
+        return 2;
     } else if (distance < AVATAR_DISTANCE_LEVEL_4) {
-        result = ROTATION_CHANGE_6D;
+        return 3;
     } else if (distance < AVATAR_DISTANCE_LEVEL_5) {
-        result = ROTATION_CHANGE_15D;
+        return 4;
     }
-    return result;
+    return 5;
+}
+
+float AvatarData::getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const {
+    static const float MIN_ROTATION_DOTS[NUM_AVATAR_DISTANCE_LEVELS] = {
+        AVATAR_MIN_ROTATION_DOT,
+        ROTATION_CHANGE_2D,
+        ROTATION_CHANGE_4D,
+        ROTATION_CHANGE_6D,
+        ROTATION_CHANGE_15D,
+        ROTATION_CHANGE_179D // assume worst
+    };
+    return MIN_ROTATION_DOTS[getDistanceLevel(glm::distance(_globalPosition, viewerPosition))];
 }
 
 float AvatarData::getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const {
@@ -412,6 +412,7 @@ const float AVATAR_DISTANCE_LEVEL_2 = 16.6f; // meters
 const float AVATAR_DISTANCE_LEVEL_3 = 25.0f; // meters
 const float AVATAR_DISTANCE_LEVEL_4 = 50.0f; // meters
 const float AVATAR_DISTANCE_LEVEL_5 = 200.0f; // meters
+const int NUM_AVATAR_DISTANCE_LEVELS = 6; // including the level beyond AVATAR_DISTANCE_LEVEL_5
 
 // Where one's own Avatar begins in the world (will be overwritten if avatar data file is found).
 // This is the start location in the Sandbox (xyz: 6270, 211, 6000).
@@ -630,6 +631,10 @@ public:
 
     virtual void doneEncoding(bool cullSmallChanges);
 
+    // index of the rotation culling distance threshold a viewer at this distance falls under, from 0 (nearest)
+    // to NUM_AVATAR_DISTANCE_LEVELS - 1; viewers at the same level get the same distance adjusted joint data
+    static int getDistanceLevel(float distance);
+
     /// \return true if an error should be logged
     bool shouldLogError(const quint64& now);
 
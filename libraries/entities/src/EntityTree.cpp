@@ -10,6 +10,7 @@
 //
 
 #include "EntityTree.h"
+#include <thread>
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
 #include <openssl/err.h>
@@ -24,9 +25,11 @@
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
+#include <OctreeSnapshot.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
+#include <shared/WorkStealingScheduler.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -307,6 +310,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    trackChangeToPersist(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
@@ -386,6 +390,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                trackChangeToPersist(entity->getEntityItemID());
             }
         }
     } else {
@@ -542,6 +547,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
 
             UpdateEntityOperator theChildOperator(getThisPointer(), childContainingElement, childEntity, queryCube);
             recurseTreeWithOperator(&theChildOperator);
+            trackChangeToPersist(childEntity->getEntityItemID());
             foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
                 if (childChild && childChild->getNestableType() == NestableType::Entity) {
                     toProcess.enqueue(childChild);
@@ -550,6 +556,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        trackChangeToPersist(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -791,6 +798,7 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
             theOperator.addEntityToDeleteList(entity);
             emit deletingEntity(entity->getID());
             emit deletingEntityPointer(entity.get());
+            trackDeletionToPersist(entity->getEntityItemID());
         }
     }
 
@@ -2871,6 +2879,218 @@ bool EntityTree::writeToMap(QVariantMap& entityDescription, OctreeElementPointer
     return true;
 }
 
+bool EntityTree::startTrackingChanges() {
+    {
+        QMutexLocker locker(&_trackedChangesLock);
+        _changedEntityIDsToPersist.clear();
+        _deletedEntityIDsToPersist.clear();
+    }
+    _isTrackingChanges = true;
+    return true;
+}
+
+void EntityTree::trackChangeToPersist(const EntityItemID& entityID) {
+    if (_isTrackingChanges) {
+        QMutexLocker locker(&_trackedChangesLock);
+        _deletedEntityIDsToPersist.remove(entityID);
+        _changedEntityIDsToPersist.insert(entityID);
+    }
+}
+
+void EntityTree::trackDeletionToPersist(const EntityItemID& entityID) {
+    if (_isTrackingChanges) {
+        QMutexLocker locker(&_trackedChangesLock);
+        _changedEntityIDsToPersist.remove(entityID);
+        _deletedEntityIDsToPersist.insert(entityID);
+    }
+}
+
+void EntityTree::takeTrackedChanges(QVariantList& changedItems, QVector<QUuid>& deletedIDs) {
+    QSet<EntityItemID> changedEntityIDs;
+    QSet<EntityItemID> deletedEntityIDs;
+    {
+        QMutexLocker locker(&_trackedChangesLock);
+        changedEntityIDs.swap(_changedEntityIDsToPersist);
+        deletedEntityIDs.swap(_deletedEntityIDsToPersist);
+    }
+
+    // written the way writeToMap() writes them, so that they can replace the entities of a persisted map
+    QScriptEngine scriptEngine;
+    withReadLock([&] {
+        for (const auto& entityID : changedEntityIDs) {
+            EntityItemPointer entity = findEntityByEntityItemID(entityID);
+            if (entity) {
+                EntityItemProperties properties = entity->getProperties();
+                changedItems << EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, properties).toVariant();
+            }
+        }
+    });
+
+    deletedIDs.reserve(deletedEntityIDs.size());
+    for (const auto& entityID : deletedEntityIDs) {
+        deletedIDs << entityID;
+    }
+}
+
+// entities are encoded the way an add edit would send them, in a buffer grown until they fit
+static const int INITIAL_SNAPSHOT_ITEM_BUFFER_SIZE = 64 * 1024;
+static const int MAX_SNAPSHOT_ITEM_BUFFER_SIZE = 64 * 1024 * 1024;
+
+// below this many entities per thread, decoding a snapshot isn't worth starting threads for
+static const int MIN_SNAPSHOT_ITEMS_PER_THREAD = 256;
+
+// each item is the entity's add packet, followed by the properties that are persisted but not sent over the wire
+enum SnapshotItemTrailer {
+    SNAPSHOT_ENTITY_HOST_TYPE = 0,
+    SNAPSHOT_VISIBLE_IN_SECONDARY_CAMERA,
+    SNAPSHOT_ITEM_TRAILER_SIZE
+};
+
+bool EntityTree::writeToSnapshot(QVector<QByteArray>& items) {
+    bool success = true;
+    withReadLock([&] {
+        QReadLocker locker(&_entityMapLock);
+        items.reserve(_entityMap.size());
+        for (const auto& entity : _entityMap) {
+            EntityItemProperties properties = entity->getProperties();
+            properties.markAllChanged();
+
+            QByteArray item;
+            OctreeElement::AppendState appendState = OctreeElement::NONE;
+            for (int bufferSize = INITIAL_SNAPSHOT_ITEM_BUFFER_SIZE;
+                 appendState != OctreeElement::COMPLETED && bufferSize <= MAX_SNAPSHOT_ITEM_BUFFER_SIZE; bufferSize *= 2) {
+                item.resize(bufferSize);
+                EntityPropertyFlags didntFitProperties;
+                appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entity->getEntityItemID(),
+                                                                           properties, item, properties.getChangedProperties(),
+                                                                           didntFitProperties);
+            }
+
+            if (appendState != OctreeElement::COMPLETED) {
+                qCWarning(entities) << "Couldn't encode entity" << entity->getEntityItemID() << "for a snapshot";
+                success = false;
+                return;
+            }
+
+            QByteArray trailer(SNAPSHOT_ITEM_TRAILER_SIZE, 0);
+            trailer[SNAPSHOT_ENTITY_HOST_TYPE] = (char)properties.getEntityHostType();
+            trailer[SNAPSHOT_VISIBLE_IN_SECONDARY_CAMERA] = (char)properties.getIsVisibleInSecondaryCamera();
+            items << item + trailer;
+        }
+    });
+
+    if (!success) {
+        items.clear();
+    }
+    return success;
+}
+
+bool EntityTree::readFromSnapshot(const OctreeSnapshot& snapshot) {
+    const OctreeSnapshot::Info& info = snapshot.getInfo();
+    if (info.dataPacketType != expectedDataPacketType() || info.dataPacketVersion != expectedVersion()) {
+        return false;
+    }
+
+    int numItems = snapshot.getNumItems();
+    if (numItems == 0) {
+        // like an empty JSON file
+        return false;
+    }
+
+    // decoding is independent for each entity, so it is spread over threads; only adding them to the tree is serial
+    std::vector<EntityItemID> entityIDs(numItems);
+    std::vector<EntityItemProperties> properties(numItems);
+    std::vector<uint64_t> costs(numItems);
+    for (int i = 0; i < numItems; ++i) {
+        costs[i] = snapshot.getItemSize(i);
+    }
+
+    int numThreads = std::max(1, std::min((int)std::thread::hardware_concurrency(), numItems / MIN_SNAPSHOT_ITEMS_PER_THREAD));
+    WorkStealingScheduler scheduler;
+    scheduler.reset(numThreads, costs);
+
+    std::atomic<bool> isValid { true };
+    auto decode = [&](int worker) {
+        uint32_t index;
+        while (scheduler.next(worker, index)) {
+            const unsigned char* itemData = snapshot.getItemData(index);
+            int packetSize = snapshot.getItemSize(index) - SNAPSHOT_ITEM_TRAILER_SIZE;
+            int processedBytes = 0;
+            if (packetSize < 0 ||
+                !EntityItemProperties::decodeEntityEditPacket(itemData, packetSize, processedBytes,
+                                                              entityIDs[index], properties[index]) ||
+                processedBytes > packetSize) {
+                isValid = false;
+                continue;
+            }
+
+            const unsigned char* trailer = itemData + packetSize;
+            properties[index].setEntityHostType((entity::HostType)trailer[SNAPSHOT_ENTITY_HOST_TYPE]);
+            properties[index].setIsVisibleInSecondaryCamera(trailer[SNAPSHOT_VISIBLE_IN_SECONDARY_CAMERA] != 0);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int worker = 1; worker < numThreads; ++worker) {
+        threads.emplace_back(decode, worker);
+    }
+    decode(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (!isValid) {
+        qCWarning(entities) << "Couldn't decode entity snapshot";
+        return false;
+    }
+
+    // the rest is what readFromMap() does for content of the current version
+    setOctreeVersionInfo(info.id, info.dataVersion);
+    _namedPaths.clear();
+
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+
+    bool success = true;
+    for (int i = 0; i < numItems; ++i) {
+        if (!addLoadedEntity(entityIDs[i], properties[i], false, cloneIDs)) {
+            success = false;
+        }
+    }
+    setLoadedCloneIDs(cloneIDs);
+
+    return success;
+}
+
+bool EntityTree::addLoadedEntity(const EntityItemID& entityID, EntityItemProperties& properties, bool isImport,
+                                 QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        properties.setOwningAvatarID(myNodeID);
+    }
+
+    EntityItemPointer entity = addEntity(entityID, properties, isImport);
+    if (!entity) {
+        qCDebug(entities) << "adding Entity failed:" << entityID << properties.getType();
+        return false;
+    }
+
+    const QUuid& cloneOriginID = entity->getCloneOriginID();
+    if (!cloneOriginID.isNull()) {
+        cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+    }
+    return true;
+}
+
+void EntityTree::setLoadedCloneIDs(const QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+}
+
 void convertGrabUserDataToProperties(EntityItemProperties& properties) {
     GrabPropertyGroup& grabProperties = properties.getGrab();
     QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
@@ -3048,19 +3268,13 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
         }
 
         // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
+        // (must happen before setOwningAvatarID in addLoadedEntity)
         if (contentVersion < (int)EntityVersion::EntityHostTypes) {
             if (entityMap.contains("clientOnly")) {
                 properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
             }
         }
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
-        }
-
         // Fix for older content not containing mode fields in the zones
         if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
             // The legacy version had no keylight mode - this is set to on
@@ -3155,26 +3369,11 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
             }
         }
 
-        EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+        if (!addLoadedEntity(entityItemID, properties, isImport, cloneIDs)) {
             success = false;
         }
-
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
-            }
-        }
-    }
-
-    for (const auto& entityID : cloneIDs.keys()) {
-        auto entity = findEntityByID(entityID);
-        if (entity) {
-            entity->setCloneIDs(cloneIDs.value(entityID));
-        }
     }
+    setLoadedCloneIDs(cloneIDs);
 
     return success;
 }
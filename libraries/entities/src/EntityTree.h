@@ -12,6 +12,9 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -198,6 +201,11 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
+
+    virtual bool startTrackingChanges() override;
+    virtual void takeTrackedChanges(QVariantList& changedItems, QVector<QUuid>& deletedIDs) override;
+    virtual bool writeToSnapshot(QVector<QByteArray>& items) override;
+    virtual bool readFromSnapshot(const OctreeSnapshot& snapshot) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
 
 
@@ -332,6 +340,14 @@ protected:
     }
 
     mutable QReadWriteLock _entityMapLock;
+
+    // entities changed and deleted since the last takeTrackedChanges(), for incremental persistence
+    void trackChangeToPersist(const EntityItemID& entityID);
+    void trackDeletionToPersist(const EntityItemID& entityID);
+    std::atomic<bool> _isTrackingChanges { false };
+    QMutex _trackedChangesLock;
+    QSet<EntityItemID> _changedEntityIDsToPersist;
+    QSet<EntityItemID> _deletedEntityIDsToPersist;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
     mutable QReadWriteLock _entityCertificateIDMapLock;
@@ -393,6 +409,11 @@ private:
     void sendChallengeOwnershipRequestPacket(const QByteArray& id, const QByteArray& text, const QByteArray& nodeToChallenge, const SharedNodePointer& senderNode);
     void validatePop(const QString& certID, const EntityItemID& entityItemID, const SharedNodePointer& senderNode);
 
+    // shared by readFromMap() and readFromSnapshot(), for the fixups that don't depend on the version of the content
+    bool addLoadedEntity(const EntityItemID& entityID, EntityItemProperties& properties, bool isImport,
+                         QMap<QUuid, QVector<QUuid>>& cloneIDs);
+    void setLoadedCloneIDs(const QMap<QUuid, QVector<QUuid>>& cloneIDs);
+
     std::shared_ptr<AvatarData> _myAvatar{ nullptr };
 
     static std::function<QObject*(const QUuid&)> _getEntityObjectOperator;
@@ -68,14 +68,16 @@ namespace baker {
             indexedTrianglesMeshOut.clear();
             indexedTrianglesMeshOut.resize(meshesIn.size());
 
-            for (size_t i = 0; i < meshesIn.size(); i++) {
-                auto& mesh = meshesIn[i];
-                const auto verticesStd = std::vector<glm::vec3>(
-                    mesh.vertices.begin(),
-                    mesh.vertices.end()
-                );
-                indexedTrianglesMeshOut[i] = hfm::generateTriangleListMesh(verticesStd, mesh.parts);
-            }
+            context->parallelFor(meshesIn.size(), 1, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    auto& mesh = meshesIn[i];
+                    const auto verticesStd = std::vector<glm::vec3>(
+                        mesh.vertices.begin(),
+                        mesh.vertices.end()
+                    );
+                    indexedTrianglesMeshOut[i] = hfm::generateTriangleListMesh(verticesStd, mesh.parts);
+                }
+            });
         }
     };
 
@@ -265,8 +267,11 @@ namespace baker {
         }
     };
 
-    Baker::Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL) :
-        _engine(std::make_shared<Engine>(BakerEngineBuilder::JobModel::create("Baker"), std::make_shared<BakeContext>())) {
+    Baker::Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL,
+                 const task::WorkerPoolPointer& workerPool) {
+        auto context = std::make_shared<BakeContext>();
+        context->workerPool = workerPool;
+        _engine = std::make_shared<Engine>(BakerEngineBuilder::JobModel::create("Baker"), context);
         _engine->feedInput<BakerEngineBuilder::Input>(0, hfmModel);
         _engine->feedInput<BakerEngineBuilder::Input>(1, mapping);
         _engine->feedInput<BakerEngineBuilder::Input>(2, materialMappingBaseURL);
@@ -23,7 +23,9 @@
 namespace baker {
     class Baker {
     public:
-        Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL);
+        // The per mesh tasks are spread over the workerPool's threads, if there is one
+        Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL,
+              const task::WorkerPoolPointer& workerPool = nullptr);
 
         std::shared_ptr<TaskConfig> getConfiguration();
 
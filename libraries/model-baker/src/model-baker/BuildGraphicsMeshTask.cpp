@@ -391,27 +391,31 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
-    int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
-        auto& graphicsMesh = graphicsMeshes[i];
-
-        uint16_t numDeformerControllers = 0;
-        uint32_t skinDeformerIndex = skinDeformerPerMesh[i];
-        if (skinDeformerIndex != hfm::UNDEFINED_KEY) {
-            const hfm::SkinDeformer& skinDeformer = skinDeformers[skinDeformerIndex];
-            numDeformerControllers = (uint16_t)skinDeformer.clusters.size();
-        }
+    const std::string displayNamePrefix = url.toString().toStdString() + "#/mesh/";
+    graphicsMeshes.clear();
+    graphicsMeshes.resize(meshes.size());
+    // Each mesh on its own
+    context->parallelFor(meshes.size(), 1, [&](size_t, size_t begin, size_t end) {
+        for (int i = (int)begin; i < (int)end; i++) {
+            auto& graphicsMesh = graphicsMeshes[i];
+
+            uint16_t numDeformerControllers = 0;
+            uint32_t skinDeformerIndex = skinDeformerPerMesh[i];
+            if (skinDeformerIndex != hfm::UNDEFINED_KEY) {
+                const hfm::SkinDeformer& skinDeformer = skinDeformers[skinDeformerIndex];
+                numDeformerControllers = (uint16_t)skinDeformer.clusters.size();
+            }
 
-        // Try to create the graphics::Mesh
-        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i), numDeformerControllers);
+            // Try to create the graphics::Mesh
+            buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i), numDeformerControllers);
 
-        // Choose a name for the mesh
-        if (graphicsMesh) {
-            graphicsMesh->displayName = url.toString().toStdString() + "#/mesh/" + std::to_string(i);
-            if (meshIndicesToModelNames.find(i) != meshIndicesToModelNames.cend()) {
-                graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
+            // Choose a name for the mesh
+            if (graphicsMesh) {
+                graphicsMesh->displayName = displayNamePrefix + std::to_string(i);
+                if (meshIndicesToModelNames.find(i) != meshIndicesToModelNames.cend()) {
+                    graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
+                }
             }
         }
-    }
+    });
 }
@@ -17,24 +17,27 @@ void CalculateMeshNormalsTask::run(const baker::BakeContextPointer& context, con
     const auto& meshes = input;
     auto& normalsPerMeshOut = output;
 
-    normalsPerMeshOut.reserve(meshes.size());
-    for (int i = 0; i < (int)meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        normalsPerMeshOut.emplace_back();
-        auto& normalsOut = normalsPerMeshOut[normalsPerMeshOut.size()-1];
-        // Only calculate normals if this mesh doesn't already have them
-        if (!mesh.normals.empty()) {
-            normalsOut = std::vector<glm::vec3>(mesh.normals.begin(), mesh.normals.end());
-        } else {
-            normalsOut.resize(mesh.vertices.size());
-            baker::calculateNormals(mesh,
-                [&normalsOut](int normalIndex) /* NormalAccessor */ {
-                    return &normalsOut[normalIndex];
-                },
-                [&mesh](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
-                    outVertex = baker::safeGet(mesh.vertices, vertexIndex);
-                }
-            );
+    normalsPerMeshOut.clear();
+    normalsPerMeshOut.resize(meshes.size());
+    // Each mesh on its own
+    context->parallelFor(meshes.size(), 1, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const auto& mesh = meshes[i];
+            auto& normalsOut = normalsPerMeshOut[i];
+            // Only calculate normals if this mesh doesn't already have them
+            if (!mesh.normals.empty()) {
+                normalsOut = std::vector<glm::vec3>(mesh.normals.begin(), mesh.normals.end());
+            } else {
+                normalsOut.resize(mesh.vertices.size());
+                baker::calculateNormals(mesh,
+                    [&normalsOut](int normalIndex) /* NormalAccessor */ {
+                        return &normalsOut[normalIndex];
+                    },
+                    [&mesh](int vertexIndex, glm::vec3& outVertex) /* VertexSetter */ {
+                        outVertex = baker::safeGet(mesh.vertices, vertexIndex);
+                    }
+                );
+            }
         }
-    }
+    });
 }
@@ -18,29 +18,32 @@ void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, co
     const std::vector<hfm::Mesh>& meshes = input.get1();
     auto& tangentsPerMeshOut = output;
 
-    tangentsPerMeshOut.reserve(meshes.size());
-    for (int i = 0; i < (int)meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& tangentsIn = mesh.tangents;
-        const auto& normals = baker::safeGet(normalsPerMesh, i);
-        tangentsPerMeshOut.emplace_back();
-        auto& tangentsOut = tangentsPerMeshOut[tangentsPerMeshOut.size()-1];
+    tangentsPerMeshOut.clear();
+    tangentsPerMeshOut.resize(meshes.size());
+    // Each mesh on its own
+    context->parallelFor(meshes.size(), 1, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const auto& mesh = meshes[i];
+            const auto& tangentsIn = mesh.tangents;
+            const auto& normals = baker::safeGet(normalsPerMesh, i);
+            auto& tangentsOut = tangentsPerMeshOut[i];
 
-        // Check if we already have tangents and therefore do not need to do any calculation
-        // Otherwise confirm if we have the normals and texcoords needed
-        if (!tangentsIn.empty()) {
-            tangentsOut = std::vector<glm::vec3>(tangentsIn.begin(), tangentsIn.end());
-        } else if (!normals.empty() && mesh.vertices.size() <= mesh.texCoords.size()) {
-            tangentsOut.resize(normals.size());
-            baker::calculateTangents(mesh,
-            [&mesh, &normals, &tangentsOut](int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal) {
-                outVertices[0] = mesh.vertices[firstIndex];
-                outVertices[1] = mesh.vertices[secondIndex];
-                outNormal = normals[firstIndex];
-                outTexCoords[0] = mesh.texCoords[firstIndex];
-                outTexCoords[1] = mesh.texCoords[secondIndex];
-                return &(tangentsOut[firstIndex]);
-            });
+            // Check if we already have tangents and therefore do not need to do any calculation
+            // Otherwise confirm if we have the normals and texcoords needed
+            if (!tangentsIn.empty()) {
+                tangentsOut = std::vector<glm::vec3>(tangentsIn.begin(), tangentsIn.end());
+            } else if (!normals.empty() && mesh.vertices.size() <= mesh.texCoords.size()) {
+                tangentsOut.resize(normals.size());
+                baker::calculateTangents(mesh,
+                [&mesh, &normals, &tangentsOut](int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal) {
+                    outVertices[0] = mesh.vertices[firstIndex];
+                    outVertices[1] = mesh.vertices[secondIndex];
+                    outNormal = normals[firstIndex];
+                    outTexCoords[0] = mesh.texCoords[firstIndex];
+                    outTexCoords[1] = mesh.texCoords[secondIndex];
+                    return &(tangentsOut[firstIndex]);
+                });
+            }
         }
-    }
+    });
 }
@@ -23,11 +23,13 @@
 #include "ModelNetworkingLogging.h"
 #include <Trace.h>
 #include <StatTracker.h>
+#include <ThreadHelpers.h>
 #include <hfm/ModelFormatRegistry.h>
 #include <FBXSerializer.h>
 #include <OBJSerializer.h>
 #include <GLTFSerializer.h>
 #include <model-baker/Baker.h>
+#include <task/WorkerPool.h>
 
 Q_LOGGING_CATEGORY(trace_resource_parse_geometry, "trace.resource.parse.geometry")
 
@@ -88,8 +90,9 @@ namespace std {
 class GeometryReader : public QRunnable {
 public:
     GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
-                   const QByteArray& data, bool combineParts, const QString& webMediaType) :
-        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType) {
+                   const QByteArray& data, bool combineParts, const QString& webMediaType, const task::WorkerPoolPointer& bakerWorkerPool) :
+        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType),
+        _bakerWorkerPool(bakerWorkerPool) {
 
         DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
@@ -104,6 +107,7 @@ private:
     QByteArray _data;
     bool _combineParts;
     QString _webMediaType;
+    task::WorkerPoolPointer _bakerWorkerPool;
 };
 
 void GeometryReader::run() {
@@ -175,7 +179,7 @@ void GeometryReader::run() {
         }
 
         // Do processing on the model
-        baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first);
+        baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first, _bakerWorkerPool);
         modelBaker.run();
 
         auto processedHFMModel = modelBaker.getHFMModel();
@@ -287,7 +291,9 @@ void ModelResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        auto bakerWorkerPool = DependencyManager::get<ModelCache>()->_bakerWorkerPool;
+        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts,
+                                                                _request->getWebMediaType(), bakerWorkerPool));
     }
 }
 
@@ -361,6 +367,8 @@ ModelCache::ModelCache() {
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
 
+    _bakerWorkerPool = std::make_shared<task::WorkerPool>(getWorkerPoolThreadCount());
+
     auto modelFormatRegistry = DependencyManager::get<ModelFormatRegistry>();
     modelFormatRegistry->addFormat(FBXSerializer());
     modelFormatRegistry->addFormat(OBJSerializer());
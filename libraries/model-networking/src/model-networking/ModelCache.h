@@ -22,6 +22,10 @@
 #include <material-networking/TextureCache.h>
 #include "ModelLoader.h"
 
+namespace task {
+    class WorkerPool;
+}
+
 using GeometryMappingPair = std::pair<QUrl, QVariantHash>;
 Q_DECLARE_METATYPE(GeometryMappingPair)
 
@@ -174,6 +178,7 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+    std::shared_ptr<task::WorkerPool> _bakerWorkerPool; // shared by the geometry readers to bake their models' meshes in parallel
 };
 
 #endif // hifi_ModelCache_h
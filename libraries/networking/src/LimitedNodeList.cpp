@@ -515,6 +515,11 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
         NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
         fillPacketHeader(*nlPacket);
     }
+    if (packetList->hasStreamedData()) {
+        packetList->_streamedPacketFinisher = [this](udt::Packet& packet) {
+            fillPacketHeader(static_cast<NLPacket&>(packet));
+        };
+    }
 
     return _nodeSocket.writePacketList(std::move(packetList), sockAddr);
 }
@@ -529,6 +534,19 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
             NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
             fillPacketHeader(*nlPacket, destinationNode.getAuthenticateHash());
         }
+        if (packetList->hasStreamedData()) {
+            // the packets of the streamed data are made later on by the send scheduler, under the connection's packet
+            // lock, where looking the node up would take the node list's lock the other way around.  they're hashed with
+            // a copy of the node's hash, keyed with its secret now, which also outlives the node
+            std::shared_ptr<HMACAuth> hmacAuth;
+            if (destinationNode.getAuthenticateHash()) {
+                hmacAuth = std::make_shared<HMACAuth>();
+                hmacAuth->setKey(destinationNode.getConnectionSecret());
+            }
+            packetList->_streamedPacketFinisher = [this, hmacAuth](udt::Packet& packet) {
+                fillPacketHeader(static_cast<NLPacket&>(packet), hmacAuth.get());
+            };
+        }
 
         return _nodeSocket.writePacketList(std::move(packetList), *activeSocket);
     } else {
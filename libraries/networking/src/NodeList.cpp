@@ -129,12 +129,20 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // we definitely want STUN to update our public socket, so call the LNL to kick that off
     startSTUNPublicSocketUpdate();
 
+    // the domain-server only sends the changes to the list, a node we dropped ourselves is only sent again with the whole list
+    connect(this, &LimitedNodeList::nodeKilled, this, [this] {
+        if (!_isApplyingDomainListRemovals) {
+            _domainListVersion = 0;
+        }
+    });
+
     auto& packetReceiver = getPacketReceiver();
     packetReceiver.registerListener(PacketType::DomainList, this, "processDomainServerList");
     packetReceiver.registerListener(PacketType::Ping, this, "processPingPacket");
     packetReceiver.registerListener(PacketType::PingReply, this, "processPingReplyPacket");
     packetReceiver.registerListener(PacketType::ICEPing, this, "processICEPingPacket");
     packetReceiver.registerListener(PacketType::DomainServerAddedNode, this, "processDomainServerAddedNode");
+    packetReceiver.registerListener(PacketType::DomainServerRemovedNode, this, "processDomainServerRemovedNode");
     packetReceiver.registerListener(PacketType::DomainServerConnectionToken, this, "processDomainServerConnectionTokenPacket");
     packetReceiver.registerListener(PacketType::DomainConnectionDenied, &_domainHandler, "processDomainServerConnectionDeniedPacket");
     packetReceiver.registerListener(PacketType::DomainSettings, &_domainHandler, "processSettingsPacketList");
@@ -142,7 +150,6 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     packetReceiver.registerListener(PacketType::DomainServerRequireDTLS, &_domainHandler, "processDTLSRequirementPacket");
     packetReceiver.registerListener(PacketType::ICEPingReply, &_domainHandler, "processICEPingReplyPacket");
     packetReceiver.registerListener(PacketType::DomainServerPathResponse, this, "processDomainServerPathResponse");
-    packetReceiver.registerListener(PacketType::DomainServerRemovedNode, this, "processDomainServerRemovedNode");
     packetReceiver.registerListener(PacketType::UsernameFromIDReply, this, "processUsernameFromIDReply");
 }
 
@@ -283,6 +290,10 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
         _domainHandler.softReset(reason);
     }
 
+    // we need the whole domain list again
+    _domainListVersion = 0;
+    _pendingDomainList = PendingDomainList();
+
     // refresh the owner UUID to the NULL UUID
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
@@ -465,7 +476,9 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << publicSockAddr << localSockAddr << _nodeTypesOfInterest.values();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
-        if (!domainIsConnected) {
+        if (domainIsConnected) {
+            packetStream << _domainListVersion.load();
+        } else {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
 
@@ -711,6 +724,12 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     bool newConnection;
     packetStream >> newConnection;
 
+    // the whole list if the base version is 0, otherwise what changed since the version we reported
+    quint32 baseVersion;
+    quint32 listVersion;
+    quint32 numEntries;
+    packetStream >> baseVersion >> listVersion >> numEntries;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -791,28 +810,102 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     setAuthenticatePackets(isAuthenticated);
 
     // pull each node in the packet
-    while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
-    }
+    parseDomainListEntries(packetStream, *message, baseVersion, listVersion, numEntries);
 }
 
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
+    if (_domainHandler.getSockAddr().isNull() || !_domainHandler.isConnected()) {
+        // refuse to process this packet if we aren't currently connected to the DS
+        return;
+    }
+
     // setup a QDataStream
     QDataStream packetStream(message->getMessage());
 
-    // use our shared method to pull out the new node
-    parseNodeFromPacketStream(packetStream);
+    // the nodes added, changed or removed since the base version
+    quint32 baseVersion;
+    quint32 listVersion;
+    quint32 numEntries;
+    packetStream >> baseVersion >> listVersion >> numEntries;
+
+    parseDomainListEntries(packetStream, *message, baseVersion, listVersion, numEntries);
 }
 
 void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message) {
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+
+    // the list updates tell of the removal too, the version we have still holds
+    _isApplyingDomainListRemovals = true;
     killNodeWithUUID(nodeUUID);
+    _isApplyingDomainListRemovals = false;
     removeDelayedAdd(nodeUUID);
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+void NodeList::parseDomainListEntries(QDataStream& packetStream, const ReceivedMessage& message,
+                                      quint32 baseVersion, quint32 listVersion, quint32 numEntries) {
+    auto& pending = _pendingDomainList;
+    if (pending.type != message.getType() || pending.baseVersion != baseVersion || pending.listVersion != listVersion) {
+        pending = PendingDomainList();
+        pending.type = message.getType();
+        pending.baseVersion = baseVersion;
+        pending.listVersion = listVersion;
+        pending.numEntries = numEntries;
+    }
+
+    while (packetStream.device()->pos() < message.getSize()) {
+        bool isRemoval;
+        packetStream >> isRemoval;
+
+        if (isRemoval) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            qCDebug(networking) << "Domain-server removed node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+
+            _isApplyingDomainListRemovals = true;
+            killNodeWithUUID(nodeUUID);
+            _isApplyingDomainListRemovals = false;
+            removeDelayedAdd(nodeUUID);
+            pending.receivedEntries.insert(nodeUUID);
+        } else {
+            // use our shared method to pull out the new node
+            QUuid nodeUUID = parseNodeFromPacketStream(packetStream);
+            if (baseVersion == 0) {
+                pending.listedNodes.insert(nodeUUID);
+            }
+            pending.receivedEntries.insert(nodeUUID);
+        }
+    }
+
+    // if a packet of the list was lost, or the changes don't follow on from our version, we keep asking for the changes
+    // since the version we have
+    if ((quint32)pending.receivedEntries.size() >= pending.numEntries) {
+        if (baseVersion == 0) {
+            // the removals we missed while we had no version are only told by the nodes a whole list leaves out.
+            // the upstream nodes that the mixers add for replicated agents were never in the list.
+            std::vector<QUuid> missingNodes;
+            eachNode([&](const SharedNodePointer& node) {
+                if (!node->isUpstream() && !pending.listedNodes.contains(node->getUUID())) {
+                    missingNodes.push_back(node->getUUID());
+                }
+            });
+            _isApplyingDomainListRemovals = true;
+            for (const auto& nodeUUID : missingNodes) {
+                qCDebug(networking) << "Domain list no longer has node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+                killNodeWithUUID(nodeUUID);
+            }
+            _isApplyingDomainListRemovals = false;
+
+            _domainListVersion = listVersion;
+        } else if (baseVersion <= _domainListVersion) {
+            _domainListVersion = std::max(_domainListVersion.load(), listVersion);
+        }
+        pending = PendingDomainList();
+    }
+}
+
+QUuid NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     NewNodeInfo info;
 
     packetStream >> info.type
@@ -831,6 +924,7 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     }
 
     addNewNode(info);
+    return info.uuid;
 }
 
 void NodeList::sendAssignment(Assignment& assignment) {
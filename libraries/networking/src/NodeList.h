@@ -160,7 +160,9 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
-    void parseNodeFromPacketStream(QDataStream& packetStream);
+    QUuid parseNodeFromPacketStream(QDataStream& packetStream);
+    void parseDomainListEntries(QDataStream& packetStream, const ReceivedMessage& message,
+                                quint32 baseVersion, quint32 listVersion, quint32 numEntries);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -176,6 +178,23 @@ private:
 
     bool _sendDomainServerCheckInEnabled { true };
 
+    // the version of the domain list we have, the domain-server only sends what changed since then
+    std::atomic<quint32> _domainListVersion { 0 };
+    bool _isApplyingDomainListRemovals { false };
+
+    // a list can be split over several packets, its version is only taken once all of its entries arrived
+    struct PendingDomainList {
+        PacketType type { PacketType::Unknown };
+        quint32 baseVersion { 0 };
+        quint32 listVersion { 0 };
+        quint32 numEntries { 0 };
+        // the nodes of the entries that arrived, a packet that arrives twice doesn't count twice
+        QSet<QUuid> receivedEntries;
+        // the nodes in a whole list, those we know of that it leaves out are gone
+        QSet<QUuid> listedNodes;
+    };
+    PendingDomainList _pendingDomainList;
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
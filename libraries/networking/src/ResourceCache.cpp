@@ -12,6 +12,7 @@
 #include "ResourceCache.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -28,13 +29,89 @@
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+// the pending priorities are refreshed about once a frame
+static const quint64 PRIORITY_UPDATE_INTERVAL = USECS_PER_SECOND / 60;
+// a remote host starts where browsers do, then adapts its limit to what it delivers
+static const uint32_t DEFAULT_HOST_REQUEST_LIMIT = 6;
+static const uint32_t MIN_HOST_REQUEST_LIMIT = 2;
+static const quint64 THROUGHPUT_WINDOW = USECS_PER_SECOND;
+// changes in throughput smaller than this are taken as noise
+static const float THROUGHPUT_TOLERANCE = 0.1f;
+// the hosts are each held to their own limit, this only keeps a domain of many hosts from opening sockets without end
+static const uint32_t MAX_LOADING_REQUESTS = 64;
+
+void HostRequestLimit::update(float throughput, uint32_t minLimit, uint32_t maxLimit) {
+    if (throughput < _throughput * (1.0f - THROUGHPUT_TOLERANCE)) {
+        _step = -_step;
+    } else if (throughput <= _throughput * (1.0f + THROUGHPUT_TOLERANCE)) {
+        // more requests didn't help, so try with fewer
+        _step = -1;
+    }
+    _limit = (uint32_t)glm::clamp((int)_limit + _step, (int)minLimit, (int)maxLimit);
+    _throughput = throughput;
+}
+
+QString ResourceCacheSharedItems::getHostKey(const QUrl& url) {
+    auto scheme = url.scheme();
+    if (scheme == HIFI_URL_SCHEME_FILE || scheme == URL_SCHEME_QRC || scheme == URL_SCHEME_ATP) {
+        return scheme;
+    }
+    return scheme + "://" + url.authority();
+}
+
+ResourceCacheSharedItems::Host& ResourceCacheSharedItems::getHost(const QString& hostKey) {
+    auto it = _hosts.find(hostKey);
+    if (it == _hosts.end()) {
+        Host host;
+        host.isLocal = hostKey == HIFI_URL_SCHEME_FILE || hostKey == URL_SCHEME_QRC;
+        host.requestLimit.set(getInitialHostRequestLimit(host));
+        host.windowStart = usecTimestampNow();
+        it = _hosts.insert(hostKey, host);
+    }
+    return it.value();
+}
+
+uint32_t ResourceCacheSharedItems::getInitialHostRequestLimit(const Host& host) const {
+    return host.isLocal ? _requestLimit : std::min(DEFAULT_HOST_REQUEST_LIMIT, _requestLimit);
+}
+
+void ResourceCacheSharedItems::updateHostRequestLimit(Host& host, qint64 bytesReceived) {
+    host.bytesReceived += bytesReceived;
+
+    quint64 now = usecTimestampNow();
+    quint64 elapsed = now - host.windowStart;
+    if (host.isLocal || elapsed < THROUGHPUT_WINDOW) {
+        return;
+    }
+
+    // only a host that had more to load than it was allowed to shows how much it can deliver, so climb towards the
+    // limit that gives the most throughput while it's busy
+    if (!host.pendingRequests.empty()) {
+        float throughput = (float)host.bytesReceived / (float)elapsed;
+        host.requestLimit.update(throughput, std::min(MIN_HOST_REQUEST_LIMIT, _requestLimit), _requestLimit);
+    }
+
+    host.bytesReceived = 0;
+    host.windowStart = now;
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
+    auto locked = resource.lock();
+    if (!locked) {
+        return false;
+    }
+
+    auto hostKey = getHostKey(locked->getURL());
+    Host& host = getHost(hostKey);
+    if ((uint32_t)_loadingRequests.size() < MAX_LOADING_REQUESTS && host.numLoadingRequests < host.requestLimit.get()) {
+        _loadingRequests.append({ resource, hostKey });
+        host.numLoadingRequests++;
         return true;
     } else {
-        _pendingRequests.append(resource);
+        host.pendingRequests.push_back({ locked->getLoadPriority(), resource });
+        std::push_heap(host.pendingRequests.begin(), host.pendingRequests.end());
+        _numPendingRequests++;
         return false;
     }
 }
@@ -42,6 +119,9 @@ bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
 void ResourceCacheSharedItems::setRequestLimit(uint32_t limit) {
     Lock lock(_mutex);
     _requestLimit = limit;
+    for (auto& host : _hosts) {
+        host.requestLimit.set(host.isLocal ? _requestLimit : std::min(host.requestLimit.get(), _requestLimit));
+    }
 }
 
 uint32_t ResourceCacheSharedItems::getRequestLimit() const {
@@ -49,14 +129,28 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+uint32_t ResourceCacheSharedItems::getHostRequestLimit(const QUrl& url) const {
+    Lock lock(_mutex);
+    auto hostKey = getHostKey(url);
+    auto it = _hosts.constFind(hostKey);
+    if (it == _hosts.constEnd()) {
+        Host host;
+        host.isLocal = hostKey == HIFI_URL_SCHEME_FILE || hostKey == URL_SCHEME_QRC;
+        return getInitialHostRequestLimit(host);
+    }
+    return it->requestLimit.get();
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
-        if (locked) {
-            result.append(locked);
+    for (const auto& host : _hosts) {
+        for (const auto& request : host.pendingRequests) {
+            auto locked = request.resource.lock();
+            if (locked) {
+                result.append(locked);
+            }
         }
     }
 
@@ -65,15 +159,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return _numPendingRequests;
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -94,9 +188,13 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        const auto& request = _loadingRequests.at(i);
         // Clear our resource and any freed resources
-        if (!request || request.data() == resource.data()) {
+        if (!request.resource || request.resource.data() == resource.data()) {
+            Host& host = getHost(request.hostKey);
+            host.numLoadingRequests--;
+            auto locked = request.resource.lock();
+            updateHostRequestLimit(host, locked ? locked->getBytesReceived() : 0);
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -104,45 +202,86 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
+void ResourceCacheSharedItems::updatePendingPriorities() {
+    Lock lock(_mutex);
+
+    for (auto& host : _hosts) {
+        auto& requests = host.pendingRequests;
+        size_t numRequests = 0;
+        for (size_t i = 0; i < requests.size(); i++) {
+            // Clear any freed resources
+            auto resource = requests[i].resource.lock();
+            if (resource) {
+                requests[numRequests].priority = resource->getLoadPriority();
+                requests[numRequests].resource = requests[i].resource;
+                numRequests++;
+            }
+        }
+        _numPendingRequests -= (uint32_t)(requests.size() - numRequests);
+        requests.resize(numRequests);
+        std::make_heap(requests.begin(), requests.end());
+    }
+
+    _lastPriorityUpdate = usecTimestampNow();
+}
+
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
 
-    bool currentHighestIsFile = false;
+    if ((uint32_t)_loadingRequests.size() >= MAX_LOADING_REQUESTS) {
+        return QSharedPointer<Resource>();
+    }
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
-        if (!resource) {
-            _pendingRequests.removeAt(i);
-            continue;
+    if (usecTimestampNow() - _lastPriorityUpdate > PRIORITY_UPDATE_INTERVAL) {
+        updatePendingPriorities();
+    }
+
+    while (true) {
+        // look for the highest priority pending request among the hosts that have a free request slot,
+        // requests for local files go first
+        Host* highestHost = nullptr;
+        float highestPriority = -FLT_MAX;
+        bool currentHighestIsFile = false;
+
+        for (auto it = _hosts.begin(); it != _hosts.end(); ++it) {
+            Host& host = it.value();
+            if (host.pendingRequests.empty() || host.numLoadingRequests >= host.requestLimit.get()) {
+                continue;
+            }
+
+            float priority = host.pendingRequests.front().priority;
+            bool isFile = it.key() == HIFI_URL_SCHEME_FILE;
+            if ((isFile && !currentHighestIsFile) || (isFile == currentHighestIsFile && priority >= highestPriority)) {
+                highestPriority = priority;
+                highestHost = &host;
+                currentHighestIsFile = isFile;
+            }
         }
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        if (!highestHost) {
+            return QSharedPointer<Resource>();
         }
-        i++;
-    }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
-    }
+        auto& requests = highestHost->pendingRequests;
+        std::pop_heap(requests.begin(), requests.end());
+        auto resource = requests.back().resource.lock();
+        requests.pop_back();
+        _numPendingRequests--;
 
-    return highestResource;
+        // Skip any freed resources
+        if (resource) {
+            return resource;
+        }
+    }
 }
 
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
-    _pendingRequests.clear();
+    for (auto& host : _hosts) {
+        host.pendingRequests.clear();
+        host.numLoadingRequests = 0;
+    }
+    _numPendingRequests = 0;
     _loadingRequests.clear();
 }
 
@@ -343,9 +482,11 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
     sharedItems->setRequestLimit(limit);
 
-    // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+    // Now go fill any new request spots, for as long as a host has room for one
+    while (sharedItems->getPendingRequestsCount() > 0) {
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -545,9 +686,11 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 
     sharedItems->removeRequest(resource);
 
-    // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+    // Now go fill any new request spots, for as long as a host has room for one
+    while (sharedItems->getPendingRequestsCount() > 0) {
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -68,10 +69,32 @@ static const qint64 DEFAULT_UNUSED_MAX_SIZE = 1024 * BYTES_PER_MEGABYTES;
 static const qint64 MIN_UNUSED_MAX_SIZE = 0;
 static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 
+/// The request limit of a remote host, which climbs towards the limit that gets the most throughput out of the host.
+class HostRequestLimit {
+public:
+    HostRequestLimit(uint32_t limit = 0) : _limit(limit) {}
+
+    uint32_t get() const { return _limit; }
+    void set(uint32_t limit) { _limit = limit; }
+
+    /// Takes the throughput, in any unit, of a window in which the host had more to load than the limit let it.
+    void update(float throughput, uint32_t minLimit, uint32_t maxLimit);
+
+private:
+    uint32_t _limit;
+    int _step { 1 };
+    float _throughput { 0.0f }; // of the previous window
+};
+
 // We need to make sure that these items are available for all instances of
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
 // object instead
+/// Schedules the requests of all of the resource caches.
+///
+/// The pending requests are kept per host in heaps ordered by their load priorities, which are refreshed all at once
+/// every frame rather than each time a request is picked.  Each host has its own limit, which remote hosts adapt to
+/// the throughput measured from them, up to the request limit.  The hosts together are only held to a safety ceiling.
 class ResourceCacheSharedItems : public Dependency  {
     SINGLETON_DEPENDENCY
 
@@ -83,21 +106,53 @@ public:
     void removeRequest(QWeakPointer<Resource> doneRequest);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+    uint32_t getHostRequestLimit(const QUrl& url) const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests() const;
     uint32_t getLoadingRequestsCount() const;
+    void updatePendingPriorities();
     void clear();
 
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        float priority;
+        QWeakPointer<Resource> resource;
+
+        bool operator<(const PendingRequest& other) const { return priority < other.priority; }
+    };
+
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        QString hostKey;
+    };
+
+    struct Host {
+        std::vector<PendingRequest> pendingRequests; // a max-heap
+        uint32_t numLoadingRequests { 0 };
+        HostRequestLimit requestLimit;
+        bool isLocal { false };
+
+        // throughput measurement, for the remote hosts
+        qint64 bytesReceived { 0 };
+        quint64 windowStart { 0 };
+    };
+
+    static QString getHostKey(const QUrl& url);
+    Host& getHost(const QString& hostKey);
+    uint32_t getInitialHostRequestLimit(const Host& host) const;
+    void updateHostRequestLimit(Host& host, qint64 bytesReceived);
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    QHash<QString, Host> _hosts;
+    QList<LoadingRequest> _loadingRequests;
+    uint32_t _numPendingRequests { 0 };
+    quint64 _lastPriorityUpdate { 0 };
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
-    uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT }; // the most any one host gets
 };
 
 /// Wrapper to expose resources to JS/QML
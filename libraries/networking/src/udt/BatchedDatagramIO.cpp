@@ -0,0 +1,270 @@
+//
+//  BatchedDatagramIO.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchedDatagramIO.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QProcessEnvironment>
+
+#include "../NetworkLogging.h"
+#include "Constants.h"
+
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+#define HIFI_BATCHED_DATAGRAM_IO
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif
+
+using namespace udt;
+
+// large enough for any datagram a Socket sends, bigger ones are not ours and are dropped
+static const int RECEIVE_BUFFER_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+// the kernel splits a GSO send into at most 64 segments, of at most 64KB in total
+static const int MAX_SEGMENTS_PER_SEND = 64;
+static const int MAX_SEGMENTED_SEND_SIZE = 65000;
+
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+
+struct BatchedDatagramIO::ReceiveBatch {
+    char buffers[MAX_BATCH_SIZE][RECEIVE_BUFFER_SIZE];
+    sockaddr_in senders[MAX_BATCH_SIZE];
+    iovec iovecs[MAX_BATCH_SIZE];
+    mmsghdr messages[MAX_BATCH_SIZE];
+    int sizes[MAX_BATCH_SIZE];
+};
+
+static sockaddr_in toSockAddrIn(const HifiSockAddr& sockAddr) {
+    sockaddr_in destination;
+    memset(&destination, 0, sizeof(destination));
+    destination.sin_family = AF_INET;
+    destination.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+    destination.sin_port = htons(sockAddr.getPort());
+    return destination;
+}
+
+BatchedDatagramIO::BatchedDatagramIO() :
+    _receiveBatch(new ReceiveBatch())
+{
+    auto environment = QProcessEnvironment::systemEnvironment();
+    _isSegmentationOffloadEnabled = environment.contains("HIFI_UDP_GSO") && environment.value("HIFI_UDP_GSO") != "0";
+}
+
+#else
+
+struct BatchedDatagramIO::ReceiveBatch {};
+
+BatchedDatagramIO::BatchedDatagramIO() {}
+
+#endif
+
+BatchedDatagramIO::~BatchedDatagramIO() {}
+
+void BatchedDatagramIO::setSocketDescriptor(qintptr socketDescriptor) {
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+    QWriteLocker locker(&_descriptorLock);
+    _socketDescriptor = socketDescriptor;
+#else
+    Q_UNUSED(socketDescriptor);
+#endif
+}
+
+int BatchedDatagramIO::readDatagrams() {
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+    if (!isEnabled()) {
+        return 0;
+    }
+
+    ReceiveBatch& batch = *_receiveBatch;
+    for (int i = 0; i < MAX_BATCH_SIZE; ++i) {
+        batch.iovecs[i].iov_base = batch.buffers[i];
+        batch.iovecs[i].iov_len = RECEIVE_BUFFER_SIZE;
+
+        msghdr& header = batch.messages[i].msg_hdr;
+        memset(&header, 0, sizeof(header));
+        header.msg_name = &batch.senders[i];
+        header.msg_namelen = sizeof(batch.senders[i]);
+        header.msg_iov = &batch.iovecs[i];
+        header.msg_iovlen = 1;
+    }
+
+    int numRead = recvmmsg((int)_socketDescriptor, batch.messages, MAX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (numRead < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            qCDebug(networking) << "BatchedDatagramIO::readDatagrams error -" << strerror(errno);
+        }
+        return 0;
+    }
+
+    for (int i = 0; i < numRead; ++i) {
+        bool isTruncated = (batch.messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+        bool isIPv4 = batch.messages[i].msg_hdr.msg_namelen >= sizeof(sockaddr_in) && batch.senders[i].sin_family == AF_INET;
+        batch.sizes[i] = (isTruncated || !isIPv4) ? 0 : (int)batch.messages[i].msg_len;
+    }
+    return numRead;
+#else
+    return 0;
+#endif
+}
+
+const char* BatchedDatagramIO::getDatagramData(int index) const {
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+    return _receiveBatch->buffers[index];
+#else
+    Q_UNUSED(index);
+    return nullptr;
+#endif
+}
+
+int BatchedDatagramIO::getDatagramSize(int index) const {
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+    return _receiveBatch->sizes[index];
+#else
+    Q_UNUSED(index);
+    return 0;
+#endif
+}
+
+HifiSockAddr BatchedDatagramIO::getDatagramSender(int index) const {
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+    return HifiSockAddr(reinterpret_cast<const sockaddr*>(&_receiveBatch->senders[index]));
+#else
+    Q_UNUSED(index);
+    return HifiSockAddr();
+#endif
+}
+
+qint64 BatchedDatagramIO::writeDatagrams(const std::vector<Datagram>& datagrams, const HifiSockAddr& sockAddr) {
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+    QReadLocker locker(&_descriptorLock);
+    if (!isEnabled()) {
+        return -1;
+    }
+
+    qint64 bytesWritten = 0;
+    for (const auto& datagram : datagrams) {
+        bytesWritten += datagram.second;
+    }
+
+    if (_isSegmentationOffloadEnabled && writeSegmentedDatagrams(datagrams, sockAddr)) {
+        return bytesWritten;
+    }
+
+    sockaddr_in destination = toSockAddrIn(sockAddr);
+    iovec iovecs[MAX_BATCH_SIZE];
+    mmsghdr messages[MAX_BATCH_SIZE];
+
+    size_t first = 0;
+    while (first < datagrams.size()) {
+        int numInBatch = (int)std::min(datagrams.size() - first, (size_t)MAX_BATCH_SIZE);
+        for (int i = 0; i < numInBatch; ++i) {
+            iovecs[i].iov_base = const_cast<char*>(datagrams[first + i].first);
+            iovecs[i].iov_len = datagrams[first + i].second;
+
+            msghdr& header = messages[i].msg_hdr;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = &destination;
+            header.msg_namelen = sizeof(destination);
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+        }
+
+        int numSent = sendmmsg((int)_socketDescriptor, messages, numInBatch, 0);
+        if (numSent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            qCDebug(networking) << "BatchedDatagramIO::writeDatagrams error to" << sockAddr << "-" << strerror(errno);
+            return -1;
+        }
+
+        // sendmmsg stops at the first datagram it can't send, the rest are tried again in the next batch
+        first += std::max(numSent, 1);
+    }
+
+    return bytesWritten;
+#else
+    Q_UNUSED(datagrams);
+    Q_UNUSED(sockAddr);
+    return -1;
+#endif
+}
+
+bool BatchedDatagramIO::writeSegmentedDatagrams(const std::vector<Datagram>& datagrams, const HifiSockAddr& sockAddr) {
+#ifdef HIFI_BATCHED_DATAGRAM_IO
+    // the kernel cuts a GSO send in segments of one size, so only the last datagram can be smaller
+    if (datagrams.size() < 2 || (int)datagrams.size() > MAX_SEGMENTS_PER_SEND) {
+        return false;
+    }
+    int segmentSize = datagrams.front().second;
+    int totalSize = 0;
+    for (size_t i = 0; i < datagrams.size(); ++i) {
+        int size = datagrams[i].second;
+        if (size == 0 || size > segmentSize || (size != segmentSize && i != datagrams.size() - 1)) {
+            return false;
+        }
+        totalSize += size;
+    }
+    if (totalSize > MAX_SEGMENTED_SEND_SIZE) {
+        return false;
+    }
+
+    // the payload of the send is the datagrams one after the other
+    iovec iovecs[MAX_SEGMENTS_PER_SEND];
+    for (size_t i = 0; i < datagrams.size(); ++i) {
+        iovecs[i].iov_base = const_cast<char*>(datagrams[i].first);
+        iovecs[i].iov_len = datagrams[i].second;
+    }
+
+    sockaddr_in destination = toSockAddrIn(sockAddr);
+
+    char control[CMSG_SPACE(sizeof(uint16_t))];
+    memset(control, 0, sizeof(control));
+
+    msghdr header;
+    memset(&header, 0, sizeof(header));
+    header.msg_name = &destination;
+    header.msg_namelen = sizeof(destination);
+    header.msg_iov = iovecs;
+    header.msg_iovlen = datagrams.size();
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    cmsghdr* controlMessage = CMSG_FIRSTHDR(&header);
+    controlMessage->cmsg_level = SOL_UDP;
+    controlMessage->cmsg_type = UDP_SEGMENT;
+    controlMessage->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t gsoSize = (uint16_t)segmentSize;
+    memcpy(CMSG_DATA(controlMessage), &gsoSize, sizeof(gsoSize));
+
+    if (sendmsg((int)_socketDescriptor, &header, 0) < 0) {
+        if (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT || errno == EOPNOTSUPP) {
+            // the kernel or the device can't segment, so stop trying
+            qCDebug(networking) << "UDP segmentation offload is not supported, disabling it -" << strerror(errno);
+            _isSegmentationOffloadEnabled = false;
+        }
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(datagrams);
+    Q_UNUSED(sockAddr);
+    return false;
+#endif
+}
@@ -0,0 +1,73 @@
+//
+//  BatchedDatagramIO.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BatchedDatagramIO_h
+#define hifi_BatchedDatagramIO_h
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QtGlobal>
+
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// Reads and writes datagrams on the native descriptor of a bound UDP socket with one system call per batch,
+// through recvmmsg and sendmmsg.
+//
+// Only Linux has these calls, everywhere else the batched I/O is never enabled and Socket reads and writes one
+// datagram at a time through its QUdpSocket. Writes of equally sized datagrams can also go out as a single UDP GSO
+// send, when the HIFI_UDP_GSO environment variable is set and the kernel supports it.
+class BatchedDatagramIO {
+public:
+    static const int MAX_BATCH_SIZE = 32;
+
+    using Datagram = std::pair<const char*, int>;
+
+    BatchedDatagramIO();
+    ~BatchedDatagramIO();
+
+    // the descriptor of the bound socket, or -1 while the socket is unbound; waits for the writes in flight on the
+    // previous descriptor, so that it can be closed once this returns
+    void setSocketDescriptor(qintptr socketDescriptor);
+    bool isEnabled() const { return _socketDescriptor != -1; }
+
+    // reads up to MAX_BATCH_SIZE pending datagrams without blocking, into buffers reused by every read; returns how
+    // many were read. They stay valid until the next read, and have a size of 0 if they didn't fit in a buffer.
+    // Must only be called from the socket's thread.
+    int readDatagrams();
+    const char* getDatagramData(int index) const;
+    int getDatagramSize(int index) const;
+    HifiSockAddr getDatagramSender(int index) const;
+
+    // writes all the datagrams to the same address, from any thread; returns the number of bytes written, or -1 if
+    // an error stopped the datagrams from being written
+    qint64 writeDatagrams(const std::vector<Datagram>& datagrams, const HifiSockAddr& sockAddr);
+
+private:
+    struct ReceiveBatch;
+
+    bool writeSegmentedDatagrams(const std::vector<Datagram>& datagrams, const HifiSockAddr& sockAddr);
+
+    std::atomic<qintptr> _socketDescriptor { -1 };
+    QReadWriteLock _descriptorLock; // held for reading by writes, for writing to change the descriptor
+    std::unique_ptr<ReceiveBatch> _receiveBatch;
+    std::atomic<bool> _isSegmentationOffloadEnabled { false };
+};
+
+} // namespace udt
+
+#endif // hifi_BatchedDatagramIO_h
@@ -13,7 +13,6 @@
 
 #include <random>
 
-#include <QtCore/QThread>
 
 #include <NumericalConstants.h>
 
@@ -68,20 +67,13 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
         // tell the send queue to stop and be deleted
-        
+        // once stopped it is never processed again, so its message number can't change anymore
         sendQueue->stop();
 
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
 
         sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
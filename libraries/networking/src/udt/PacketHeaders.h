@@ -375,7 +375,8 @@ enum class DomainConnectionDeniedVersion : PacketVersion {
 
 enum class DomainServerAddedNodeVersion : PacketVersion {
     PrePermissionsGrid = 17,
-    PermissionsGrid
+    PermissionsGrid,
+    DomainListUpdates
 };
 
 enum class DomainListVersion : PacketVersion {
@@ -385,7 +386,13 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasListVersion
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreListVersion = 22,
+    HasListVersion
 };
 
 enum class AudioVersion : PacketVersion {
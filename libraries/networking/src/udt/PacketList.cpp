@@ -141,10 +141,29 @@ QByteArray PacketList::getMessage() const {
     return data;
 }
 
+void PacketList::writeStreamed(const char* data, qint64 size, std::shared_ptr<const void> owner) {
+    Q_ASSERT(_isReliable && _isOrdered && !hasStreamedData());
+
+    // the streamed data starts in a packet of its own
+    closeCurrentPacket(true);
+
+    _streamedData = data;
+    _streamedSize = size;
+    _streamedDataOwner = size > 0 ? owner : nullptr;
+}
+
 void PacketList::preparePackets(MessageNumber messageNumber) {
     Q_ASSERT(_packets.size() > 0);
-    
-    if (_packets.size() == 1) {
+
+    if (hasStreamedData()) {
+        // the last packet is yet to be made
+        _messageNumber = messageNumber;
+        _nextMessagePartNumber = 0;
+        _packets.front()->writeMessageNumber(messageNumber, Packet::PacketPosition::FIRST, _nextMessagePartNumber++);
+        std::for_each(++_packets.begin(), _packets.end(), [&](const PacketPointer& packet) {
+            packet->writeMessageNumber(messageNumber, Packet::PacketPosition::MIDDLE, _nextMessagePartNumber++);
+        });
+    } else if (_packets.size() == 1) {
         _packets.front()->writeMessageNumber(messageNumber, Packet::PacketPosition::ONLY, 0);
     } else {
         const auto second = ++_packets.begin();
@@ -159,6 +178,31 @@ void PacketList::preparePackets(MessageNumber messageNumber) {
     }
 }
 
+bool PacketList::takeStreamedPackets(std::list<PacketPointer>& packets, int maxPackets) {
+    for (int i = 0; i < maxPackets && hasStreamedData(); i++) {
+        auto packet = createPacketWithExtendedHeader();
+        qint64 size = std::min(_streamedSize, packet->bytesAvailableForWrite());
+        packet->write(_streamedData, size);
+        _streamedData += size;
+        _streamedSize -= size;
+
+        auto position = hasStreamedData() ? Packet::PacketPosition::MIDDLE : Packet::PacketPosition::LAST;
+        packet->writeMessageNumber(_messageNumber, position, _nextMessagePartNumber++);
+        if (_streamedPacketFinisher) {
+            _streamedPacketFinisher(*packet);
+        }
+        packets.push_back(std::move(packet));
+    }
+
+    if (!hasStreamedData()) {
+        _streamedData = nullptr;
+        _streamedDataOwner.reset();
+        _streamedPacketFinisher = nullptr;
+        return false;
+    }
+    return true;
+}
+
 const qint64 PACKET_LIST_WRITE_ERROR = -1;
 
 qint64 PacketList::writeString(const QString& string) {
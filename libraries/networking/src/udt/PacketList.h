@@ -12,6 +12,7 @@
 #ifndef hifi_PacketList_h
 #define hifi_PacketList_h
 
+#include <functional>
 #include <memory>
 
 #include "../ExtendedIODevice.h"
@@ -60,6 +61,12 @@ public:
     
     qint64 writeString(const QString& string);
 
+    // Writes data at the end of a reliable ordered list without copying it: the packets for it are only made as the
+    // send queue gets to them, a few at a time, so that a large message is never held as packets all at once.
+    // owner keeps the data alive until the last of them is made.  Nothing can be written after it.
+    void writeStreamed(const char* data, qint64 size, std::shared_ptr<const void> owner);
+    bool hasStreamedData() const { return _streamedSize > 0; }
+
     p_high_resolution_clock::time_point getFirstPacketReceiveTime() const;
     
     
@@ -69,6 +76,9 @@ protected:
     
     void preparePackets(MessageNumber messageNumber);
 
+    // makes the packets for up to maxPackets more of the streamed data, returns false once none is left
+    bool takeStreamedPackets(std::list<std::unique_ptr<Packet>>& packets, int maxPackets);
+
     virtual qint64 writeData(const char* data, qint64 maxSize) override;
     // Not implemented, added an assert so that it doesn't get used by accident
     virtual qint64 readData(char* data, qint64 maxSize) override { Q_ASSERT(false); return 0; }
@@ -96,6 +106,14 @@ private:
     
     Packet::MessageNumber _messageNumber;
     bool _isReliable = false;
+
+    const char* _streamedData { nullptr };
+    qint64 _streamedSize { 0 };
+    std::shared_ptr<const void> _streamedDataOwner;
+    Packet::MessagePartNumber _nextMessagePartNumber { 0 };
+    // fills in what the packets made from the streamed data need from the layers above, it runs under the packet
+    // queue's lock so must not take any of theirs
+    std::function<void(Packet& packet)> _streamedPacketFinisher;
     
     std::unique_ptr<Packet> _currentPacket;
     
@@ -15,8 +15,11 @@
 
 using namespace udt;
 
+// the packets made at once from the streamed data of a list
+static const int STREAMED_PACKETS_PER_WINDOW = 32;
+
 PacketQueue::PacketQueue(MessageNumber messageNumber) : _currentMessageNumber(messageNumber) {
-    _channels.emplace_front(new std::list<PacketPointer>());
+    _channels.emplace_front(new RawChannel());
     _currentChannel = _channels.begin();
 }
 
@@ -53,8 +56,15 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
     Q_ASSERT(!channel->empty());
 
     // Take front packet
-    auto packet = std::move(channel->front());
-    channel->pop_front();
+    auto packet = std::move(channel->packets.front());
+    channel->packets.pop_front();
+
+    // a streamed list makes its next packets once the ones made so far were all taken
+    if (channel->empty() && channel->streamedList) {
+        if (!channel->streamedList->takeStreamedPackets(channel->packets, STREAMED_PACKETS_PER_WINDOW)) {
+            channel->streamedList.reset();
+        }
+    }
 
     // Remove now empty channel (Don't remove the main channel)
     if (channel->empty() && _currentChannel != _channels.begin()) {
@@ -81,7 +91,7 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
 
 void PacketQueue::queuePacket(PacketPointer packet) {
     LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    _channels.front()->packets.push_back(std::move(packet));
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -90,6 +100,9 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
     }
 
     LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    _channels.emplace_back(new RawChannel());
+    _channels.back()->packets.swap(packetList->_packets);
+    if (packetList->hasStreamedData()) {
+        _channels.back()->streamedList = std::move(packetList);
+    }
 }
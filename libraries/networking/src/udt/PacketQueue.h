@@ -30,7 +30,13 @@ class PacketQueue {
     using LockGuard = std::lock_guard<Mutex>;
     using PacketPointer = std::unique_ptr<Packet>;
     using PacketListPointer = std::unique_ptr<PacketList>;
-    using RawChannel = std::list<PacketPointer>;
+    // the packets of a list, and the list itself while it has streamed data left to make packets of
+    struct RawChannel {
+        std::list<PacketPointer> packets;
+        PacketListPointer streamedList;
+
+        bool empty() const { return packets.empty(); }
+    };
     using Channel = std::unique_ptr<RawChannel>;
     using Channels = std::list<Channel>;
     
@@ -12,12 +12,9 @@
 #include "SendQueue.h"
 
 #include <algorithm>
-#include <thread>
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -64,6 +61,12 @@ private:
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
 
+static const auto HANDSHAKE_RESEND_INTERVAL = milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = seconds(5);
+
+// the most packets sent in one go, before the other queues get their turn
+static const int MAX_PACKETS_PER_PROCESS = 32;
+
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
@@ -71,19 +74,8 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
-    // Setup queue private thread
-    QThread* thread = new QThread;
-    thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
-    
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-    
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-    
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-    
-    thread->start();
+    // Start processing the queue on the shared scheduler
+    queue->_schedulerEntry = SendScheduler::getInstance().add(queue.get());
     
     return queue;
 }
@@ -103,37 +95,39 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSe
 }
 
 SendQueue::~SendQueue() {
+    stop();
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // wake the queue up in case it is waiting for packets
+    wakeUp();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // wake the queue up in case it is waiting for packets
+    wakeUp();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
     
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    // Once removed from the scheduler the queue is never processed again
+    if (_schedulerEntry) {
+        SendScheduler::getInstance().remove(_schedulerEntry);
+        _schedulerEntry = nullptr;
+    }
+}
+
+void SendQueue::wakeUp() {
+    // a queue that isn't waiting picks up whatever changed on its next packet
+    if (_isWaiting && _schedulerEntry) {
+        SendScheduler::getInstance().wake(_schedulerEntry);
+    }
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -164,8 +158,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is waiting with a full congestion window
+    wakeUp();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -174,35 +168,27 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is waiting for losses to re-send
+    wakeUp();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
-    }
+    // we haven't received a handshake ACK from the client, send another now
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK() {
-    {
-        std::lock_guard<std::mutex> locker { _handshakeMutex };
-        _hasReceivedHandshakeACK = true;
-    }
+    _hasReceivedHandshakeACK = true;
 
-    // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    // the queue waits for the ACK until the next handshake re-send, wake it up so it starts sending now
+    if (_schedulerEntry) {
+        SendScheduler::getInstance().wake(_schedulerEntry);
+    }
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -246,40 +232,52 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+p_high_resolution_clock::time_point SendQueue::process() {
+    // anything that changes from here on is picked up by this processing, or wakes the queue up again
+    _isWaiting = false;
+
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+        // we've been asked to stop, possibly before we even got a chance to start
+        return p_high_resolution_clock::time_point::max();
     }
-    
     _state = State::Running;
-    
+
+    if (_hasNewDestination) {
+        std::lock_guard<std::mutex> locker(_newDestinationLock);
+        _destination = _newDestination;
+        _hasNewDestination = false;
+    }
+
+    auto now = p_high_resolution_clock::now();
+
     // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeTimestamp) {
+            sendHandshake();
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
+        }
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+        // we wait for the ACK, which wakes us up, or the re-send interval to expire
+        return _nextHandshakeTimestamp;
+    }
+
+    if (!_hasStartedSending) {
+        // Keep an HRC to know when the next packet should have been
+        _hasStartedSending = true;
+        _nextPacketTimestamp = now;
+    } else if (_hasWaitStarted && _nextPacketTimestamp < now) {
+        // we had nothing to send while waiting, there is no need to catch up on it
+        _nextPacketTimestamp = now;
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    for (int i = 0; i < MAX_PACKETS_PER_PROCESS; ++i) {
+        if (_packetSendPeriod > 0 && _nextPacketTimestamp > now) {
+            // come back when the next packet is due
+            return _nextPacketTimestamp;
+        }
 
-    while (_state == State::Running) {
         bool attemptedToSendPacket = maybeResendPacket();
-        
+
         // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
         // (this is according to the current flow window size) then we send out a new packet
         auto newPacketCount = 0;
@@ -287,48 +285,41 @@ void SendQueue::run() {
             newPacketCount = maybeSendNewPacket();
             attemptedToSendPacket = (newPacketCount > 0);
         }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+
+        if (!attemptedToSendPacket) {
+            return waitForActivity(now);
         }
+        _hasWaitStarted = false;
 
         if (_packetSendPeriod > 0) {
             // push the next packet timestamp forwards by the current packet send period
             auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+            _nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
 
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+            now = p_high_resolution_clock::now();
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+            auto timeToWait = duration_cast<microseconds>(_nextPacketTimestamp - now);
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
+            // we use nextPacketTimestamp so that we don't fall behind, not to force long waits
+            // we'll never allow nextPacketTimestamp to force us to wait for more than nextPacketDelta
             // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
+            if (timeToWait > std::chrono::microseconds(nextPacketDelta)) {
                 // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+                _nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
+                timeToWait = std::chrono::microseconds(nextPacketDelta);
             }
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
+            // we're seeing SendQueues wait for a long period of time here,
+            // which holds back everything queued on the connection
+            // for now we guard this by capping the time a queue can wait for its next packet
 
             const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
+            if (timeToWait > MAX_SEND_QUEUE_SLEEP_USECS) {
+                qWarning() << "udt::SendQueue wanted to sleep for" << timeToWait.count() << "microseconds";
                 qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
                 qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
+                << "NPT:" << _nextPacketTimestamp.time_since_epoch().count()
                 << "NOW:" << now.time_since_epoch().count();
 
                 // alright, we're in a weird state
@@ -338,21 +329,22 @@ void SendQueue::run() {
 
                 // setup a json object with the details we want
                 QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+                longSleepObject["timeToSleep"] = qint64(timeToWait.count());
                 longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
                 longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
+                longSleepObject["nextPacketTimestamp"] = qint64(_nextPacketTimestamp.time_since_epoch().count());
                 longSleepObject["then"] = qint64(now.time_since_epoch().count());
 
                 // hopefully send this event using the user activity logger
                 UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+
+                _nextPacketTimestamp = now + MAX_SEND_QUEUE_SLEEP_USECS;
             }
-            
-            std::this_thread::sleep_for(timeToSleep);
         }
     }
+
+    // we still have packets to send, but let the other queues have their turn first
+    return now;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -463,88 +455,96 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
+p_high_resolution_clock::time_point SendQueue::waitForActivity(p_high_resolution_clock::time_point now) {
+    // During our processing we didn't send any packets
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+    // set before looking at the queues, so that anything added to them from here on wakes us up
+    _isWaiting = true;
 
+    // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
+    using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
+    DoubleLock doubleLock(_packets.getLock(), _naksLock);
+    DoubleLock::Lock locker(doubleLock);
+
+    if (!((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        // something changed since we last tried to send, go again
+        return now;
+    }
+
+    // The packets queue and loss list mutexes are now both locked and they're both empty
+    if (_hasWaitStarted) {
+        // we're either done waiting, or were woken up by something that still left us nothing to send
+        bool hasTimedOut = now >= _waitEndTimestamp;
+
+        if (_isWaitingForData) {
+            if (hasTimedOut) {
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+                qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+                    << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+                    << "seconds and receiver has ACKed all packets."
+                    << "The queue is now inactive and will be stopped.";
 #endif
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
+                // we have the lock again - Make sure to unlock it
+                locker.unlock();
 
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-
-                auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
-
-                // Clamp timeout beween 10 ms and 5 s
-                estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
-
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, estimatedTimeout);
-
-                // when we wake-up check if we're "stuck" either if we've slept for the estimated timeout
-                // or it has been that long since the last time we sent a packet
-
-                // we are stuck if all of the following are true
-                // - there are no new packets to send or the flow window is full and we can't send any new packets
-                // - there are no packets to resend
-                // - the client has yet to ACK some sent packets
-                auto now = std::chrono::high_resolution_clock::now();
-
-                if ((cvStatus == std::cv_status::timeout || (now - _lastPacketSentAt > estimatedTimeout))
-                    && (_packets.isEmpty() || isFlowWindowFull())
-                    && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
+                // Deactivate queue
+                deactivate();
+                return p_high_resolution_clock::time_point::max();
+            }
+        } else {
+            // check if we're "stuck" either if we've waited for the estimated timeout
+            // or it has been that long since the last time we sent a packet
+
+            // we are stuck if all of the following are true
+            // - there are no new packets to send or the flow window is full and we can't send any new packets
+            // - there are no packets to resend
+            // - the client has yet to ACK some sent packets
+            auto timeSinceLastPacket = std::chrono::high_resolution_clock::now() - _lastPacketSentAt;
+
+            if ((hasTimedOut || timeSinceLastPacket > _waitTimeout)
+                && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+                // after a timeout if we still have sent packets that the client hasn't ACKed we
+                // add them to the loss list
+
+                // Note that thanks to the DoubleLock we have the _naksLock right now
+                _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+
+                // we have the lock again - time to unlock it
+                locker.unlock();
+
+                _hasWaitStarted = false;
+                emit timeout();
+
+                // go re-send them
+                return now;
             }
         }
     }
-    
-    return false;
+
+    _hasWaitStarted = true;
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        _isWaitingForData = true;
+        _waitEndTimestamp = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+    } else {
+        // We think the client is still waiting for data (based on the sequence number gap)
+        // Let's wait either for a response from the client or until the estimated timeout
+        // (plus the sync interval to allow the client to respond) has elapsed
+
+        auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
+
+        // Clamp timeout beween 10 ms and 5 s
+        estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+        _isWaitingForData = false;
+        _waitTimeout = estimatedTimeout;
+        _waitEndTimestamp = now + estimatedTimeout;
+    }
+
+    return _waitEndTimestamp;
 }
 
 void SendQueue::deactivate() {
@@ -559,5 +559,8 @@ bool SendQueue::isFlowWindowFull() const {
 }
 
 void SendQueue::updateDestinationAddress(HifiSockAddr newAddress) {
-    _destination = newAddress;
+    // switched to the next time the queue is processed, so that it never changes in the middle of a send
+    std::lock_guard<std::mutex> locker(_newDestinationLock);
+    _newDestination = newAddress;
+    _hasNewDestination = true;
 }
@@ -13,7 +13,6 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -29,6 +28,7 @@
 
 #include "Constants.h"
 #include "PacketQueue.h"
+#include "SendScheduler.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
 
@@ -39,7 +39,10 @@ class ControlPacket;
 class Packet;
 class PacketList;
 class Socket;
-    
+
+// Sends the reliable packets of a connection, paced by its congestion control.
+//
+// Queues don't have a thread of their own, the SendScheduler processes them on its workers whenever they are due.
 class SendQueue : public QObject {
     Q_OBJECT
     
@@ -85,15 +88,19 @@ signals:
 
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    friend class SendScheduler;
+
+
     SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
     
+    // sends what can be sent now, and returns when the queue next wants to be processed, or time_point::max()
+    // once it has stopped; called by the scheduler, never by two threads at once
+    p_high_resolution_clock::time_point process();
+
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -102,7 +109,9 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    // called when there is nothing to send, returns when the queue should be processed again
+    p_high_resolution_clock::time_point waitForActivity(p_high_resolution_clock::time_point now);
+    void wakeUp(); // processes the queue as soon as possible if it is waiting for something to send
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -114,6 +123,12 @@ private:
     
     Socket* _socket { nullptr }; // Socket to send packet on
     HifiSockAddr _destination; // Destination addr
+
+    std::mutex _newDestinationLock; // Protects the new destination addr
+    HifiSockAddr _newDestination; // Destination addr to switch to the next time the queue is processed
+    std::atomic<bool> _hasNewDestination { false };
+
+    SendScheduler::Entry* _schedulerEntry { nullptr };
     
     std::atomic<uint32_t> _lastACKSequenceNumber { 0 }; // Last ACKed sequence number
     
@@ -134,11 +149,17 @@ private:
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
     std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
+    p_high_resolution_clock::time_point _nextHandshakeTimestamp; // When to re-send the handshake
+
+    bool _hasStartedSending { false }; // Whether the handshake is done and _nextPacketTimestamp was set
+    p_high_resolution_clock::time_point _nextPacketTimestamp; // When the next packet should be sent, when paced
+
+    std::atomic<bool> _isWaiting { false }; // Set while there is nothing to send, for wakeUp()
+    bool _hasWaitStarted { false }; // Whether the queue is in a wait started by waitForActivity()
+    bool _isWaitingForData { false }; // Whether everything was ACKed when the wait started, or packets are pending
+    std::chrono::microseconds _waitTimeout { 0 }; // Estimated timeout when the wait started
+    p_high_resolution_clock::time_point _waitEndTimestamp; // When the wait times out
 
     std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
 
@@ -0,0 +1,172 @@
+//
+//  SendScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QThread>
+
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+// packets are paced to the tick, a queue due in the middle of one is processed at its end
+static const microseconds TICK_DURATION { 100 };
+
+struct SendScheduler::Entry : public TimerWheel::Timer {
+    enum class State {
+        Idle,
+        Scheduled,
+        Ready,
+        Processing
+    };
+
+    SendQueue* queue { nullptr };
+    State state { State::Idle };
+    bool isWakePending { false };
+    bool isRemoved { false };
+};
+
+SendScheduler& SendScheduler::getInstance() {
+    // sending is mostly spent in system calls, a few workers keep up with any number of connections
+    static SendScheduler instance(std::min(std::max(QThread::idealThreadCount() / 4, 1), 4));
+    return instance;
+}
+
+SendScheduler::SendScheduler(int numThreads) :
+    _epoch(Clock::now())
+{
+    _threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { run(); });
+    }
+}
+
+SendScheduler::~SendScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _scheduleChanged.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+SendScheduler::Entry* SendScheduler::add(SendQueue* queue) {
+    Entry* entry = new Entry();
+    entry->queue = queue;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        makeReady(entry);
+    }
+    _scheduleChanged.notify_one();
+    return entry;
+}
+
+void SendScheduler::wake(Entry* entry) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        switch (entry->state) {
+            case Entry::State::Scheduled:
+                _wheel.cancel(entry);
+                makeReady(entry);
+                break;
+            case Entry::State::Processing:
+                // processed again as soon as it is done, in case it was about to wait
+                entry->isWakePending = true;
+                return;
+            default:
+                return;
+        }
+    }
+    _scheduleChanged.notify_one();
+}
+
+void SendScheduler::remove(Entry* entry) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    entry->isRemoved = true;
+    _processingDone.wait(lock, [&] { return entry->state != Entry::State::Processing; });
+
+    if (entry->state == Entry::State::Scheduled) {
+        _wheel.cancel(entry);
+    } else if (entry->state == Entry::State::Ready) {
+        _ready.erase(std::find(_ready.begin(), _ready.end(), entry));
+    }
+    delete entry;
+}
+
+void SendScheduler::schedule(Entry* entry, p_high_resolution_clock::time_point time) {
+    auto delay = duration_cast<microseconds>(time - p_high_resolution_clock::now());
+    if (delay.count() <= 0) {
+        makeReady(entry);
+        return;
+    }
+
+    // rounded up, so that a queue is never processed before it is due
+    auto expiry = getTick(Clock::now() + delay + TICK_DURATION - microseconds(1));
+    entry->state = Entry::State::Scheduled;
+    _wheel.schedule(entry, expiry);
+}
+
+void SendScheduler::makeReady(Entry* entry) {
+    entry->state = Entry::State::Ready;
+    _ready.push_back(entry);
+}
+
+uint64_t SendScheduler::getTick(Clock::time_point time) const {
+    return (uint64_t)(duration_cast<microseconds>(time - _epoch) / TICK_DURATION);
+}
+
+void SendScheduler::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_isStopping) {
+        auto now = Clock::now();
+        _wheel.advance(getTick(now), _expired);
+        for (auto timer : _expired) {
+            makeReady(static_cast<Entry*>(timer));
+        }
+        _expired.clear();
+
+        if (_ready.empty()) {
+            if (_wheel.isEmpty()) {
+                _scheduleChanged.wait(lock);
+            } else {
+                _scheduleChanged.wait_until(lock, _epoch + TICK_DURATION * (int64_t)_wheel.getNextTick());
+            }
+            continue;
+        }
+
+        Entry* entry = _ready.front();
+        _ready.pop_front();
+        entry->state = Entry::State::Processing;
+        if (!_ready.empty()) {
+            _scheduleChanged.notify_one();
+        }
+        lock.unlock();
+
+        auto nextProcessTime = entry->queue->process();
+
+        lock.lock();
+        entry->state = Entry::State::Idle;
+        if (entry->isRemoved) {
+            _processingDone.notify_all();
+        } else if (entry->isWakePending) {
+            entry->isWakePending = false;
+            makeReady(entry);
+        } else if (nextProcessTime != p_high_resolution_clock::time_point::max()) {
+            // this worker goes back to the wheel next, no other one needs to be told about it
+            schedule(entry, nextProcessTime);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  SendScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendScheduler_h
+#define hifi_SendScheduler_h
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+#include "TimerWheel.h"
+
+namespace udt {
+
+class SendQueue;
+
+// Runs every SendQueue of the process on a small fixed set of workers, instead of one thread per queue.
+//
+// A queue is processed by whichever worker is free first, and never by two workers at once. Processing returns when
+// the queue next wants to be processed - for its next paced packet, a handshake resend or a timeout - and the queue
+// waits in a timer wheel until then, or until it is woken up because it has something new to do.
+class SendScheduler {
+public:
+    struct Entry;
+
+    static SendScheduler& getInstance();
+
+    SendScheduler(int numThreads);
+    ~SendScheduler();
+
+    int getNumThreads() const { return (int)_threads.size(); }
+
+    // the queue is processed right away, and then whenever it asks to be
+    Entry* add(SendQueue* queue);
+
+    // processes the queue as soon as possible, unless it has stopped
+    void wake(Entry* entry);
+
+    // blocks while the queue is being processed, it is never processed again once this returns
+    void remove(Entry* entry);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    void schedule(Entry* entry, p_high_resolution_clock::time_point time);
+    void makeReady(Entry* entry);
+
+    uint64_t getTick(Clock::time_point time) const;
+
+    std::mutex _mutex;
+    std::condition_variable _scheduleChanged;
+    std::condition_variable _processingDone;
+
+    const Clock::time_point _epoch;
+    TimerWheel _wheel;
+    std::deque<Entry*> _ready;
+    std::vector<TimerWheel::Timer*> _expired;
+    bool _isStopping { false };
+
+    std::vector<std::thread> _threads;
+};
+
+} // namespace udt
+
+#endif // hifi_SendScheduler_h
@@ -62,6 +62,10 @@ void Socket::bind(const QHostAddress& address, quint16 port) {
 
     _udpSocket.bind(address, port);
 
+    if (_udpSocket.state() == QAbstractSocket::BoundState) {
+        _batchedIO.setSocketDescriptor(_udpSocket.socketDescriptor());
+    }
+
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes();
 
@@ -85,6 +89,8 @@ void Socket::rebind() {
 }
 
 void Socket::rebind(quint16 localPort) {
+    // stops the batched writes, and waits for those in flight, before their descriptor is closed
+    _batchedIO.setSocketDescriptor(-1);
     _udpSocket.abort();
     bind(QHostAddress::AnyIPv4, localPort);
 }
@@ -198,6 +204,10 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Hif
     }
 
     // Unerliable and Unordered
+    if (_batchedIO.isEnabled() && packetList->_packets.size() > 1) {
+        return writeUnreliablePacketList(*packetList, sockAddr);
+    }
+
     qint64 totalBytesSent = 0;
     while (!packetList->_packets.empty()) {
         totalBytesSent += writePacket(packetList->takeFront<Packet>(), sockAddr);
@@ -205,6 +215,31 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Hif
     return totalBytesSent;
 }
 
+qint64 Socket::writeUnreliablePacketList(const PacketList& packetList, const HifiSockAddr& sockAddr) {
+    auto connection = findOrCreateConnection(sockAddr, true);
+
+    std::vector<BatchedDatagramIO::Datagram> datagrams;
+    datagrams.reserve(packetList._packets.size());
+    {
+        Lock lock(_unreliableSequenceNumbersMutex);
+        SequenceNumber& sequenceNumber = _unreliableSequenceNumbers[sockAddr];
+
+        for (const auto& packet : packetList._packets) {
+            Q_ASSERT_X(!packet->isReliable(), "Socket::writeUnreliablePacketList", "Cannot send a reliable packet unreliably");
+            packet->writeSequenceNumber(++sequenceNumber);
+            datagrams.emplace_back(packet->getData(), (int)packet->getDataSize());
+        }
+    }
+
+    if (connection) {
+        for (const auto& packet : packetList._packets) {
+            connection->recordSentUnreliablePackets(packet->getWireSize(), packet->getPayloadSize());
+        }
+    }
+
+    return _batchedIO.writeDatagrams(datagrams, sockAddr);
+}
+
 void Socket::writeReliablePacket(Packet* packet, const HifiSockAddr& sockAddr) {
     auto connection = findOrCreateConnection(sockAddr);
     if (connection) {
@@ -410,73 +445,112 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+        // the datagrams still pending are read in batches, with one system call for many of them. The first one is
+        // always read through the QUdpSocket, which only keeps emitting readyRead for datagrams it has read itself
+        while (_batchedIO.isEnabled() && system_clock::now() <= abortTime) {
+            int numRead = _batchedIO.readDatagrams();
+            if (numRead == 0) {
+                break;
             }
 
-            continue;
-        }
+            _readyReadBackupTimer->start();
+            auto batchReceiveTime = p_high_resolution_clock::now();
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+            for (int i = 0; i < numRead; ++i) {
+                int size = _batchedIO.getDatagramSize(i);
+                HifiSockAddr batchSenderSockAddr = _batchedIO.getDatagramSender(i);
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+                _lastPacketSizeRead = size;
+                _lastPacketSockAddr = batchSenderSockAddr;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+                if (size <= 0) {
+                    continue;
+                }
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+                // the batch buffers are reused, so each packet gets a buffer of its own
+                auto batchBuffer = std::unique_ptr<char[]>(new char[size]);
+                memcpy(batchBuffer.get(), _batchedIO.getDatagramData(i), size);
+                processDatagram(std::move(batchBuffer), size, batchSenderSockAddr, batchReceiveTime);
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            if (numRead < BatchedDatagramIO::MAX_BATCH_SIZE) {
+                // nothing is left, anything received from here on is picked up through hasPendingDatagrams()
+                break;
+            }
+        }
+    }
+}
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+void Socket::processDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                    qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                        << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
+                    return;
                 }
+            } else if (connection) {
+                connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                            packet->getPayloadSize());
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr, true);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
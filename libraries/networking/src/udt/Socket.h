@@ -24,6 +24,7 @@
 #include <QtNetwork/QUdpSocket>
 
 #include "../HifiSockAddr.h"
+#include "BatchedDatagramIO.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
 
@@ -110,6 +111,8 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void processDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
@@ -120,8 +123,12 @@ private:
     
     Q_INVOKABLE void writeReliablePacket(Packet* packet, const HifiSockAddr& sockAddr);
     Q_INVOKABLE void writeReliablePacketList(PacketList* packetList, const HifiSockAddr& sockAddr);
+
+    // writes all the packets of an unreliable list with one batched write
+    qint64 writeUnreliablePacketList(const PacketList& packetList, const HifiSockAddr& sockAddr);
     
     QUdpSocket _udpSocket { this };
+    BatchedDatagramIO _batchedIO;
     PacketFilterOperator _packetFilterOperator;
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
@@ -0,0 +1,169 @@
+//
+//  TimerWheel.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace udt;
+
+static const uint64_t SLOT_MASK = TimerWheel::SLOTS_PER_LEVEL - 1;
+
+TimerWheel::TimerWheel(uint64_t currentTick) :
+    _currentTick(currentTick)
+{
+    std::fill(&_slots[0][0], &_slots[0][0] + NUM_LEVELS * SLOTS_PER_LEVEL, nullptr);
+    std::fill(_occupiedSlots, _occupiedSlots + NUM_LEVELS, 0);
+}
+
+void TimerWheel::schedule(Timer* timer, uint64_t expiry) {
+    if (timer->isScheduled()) {
+        unlink(timer);
+    }
+
+    if (expiry < _currentTick) {
+        expiry = _currentTick;
+    } else if (expiry - _currentTick > MAX_DELAY) {
+        expiry = _currentTick + MAX_DELAY;
+    }
+    timer->expiry = expiry;
+    insert(timer);
+}
+
+void TimerWheel::cancel(Timer* timer) {
+    if (timer->isScheduled()) {
+        unlink(timer);
+    }
+}
+
+void TimerWheel::advance(uint64_t tick, std::vector<Timer*>& expired) {
+    while (_currentTick <= tick) {
+        // skip straight over the ticks that have nothing to expire or cascade
+        uint64_t nextTick = getNextTick();
+        if (nextTick > tick) {
+            _currentTick = tick + 1;
+            break;
+        }
+
+        _currentTick = nextTick;
+        processCurrentTick(expired);
+    }
+}
+
+uint64_t TimerWheel::getNextTick() const {
+    uint64_t nextTick = std::numeric_limits<uint64_t>::max();
+    if (_numTimers == 0) {
+        return nextTick;
+    }
+
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        if (_occupiedSlots[level] == 0) {
+            continue;
+        }
+
+        // the slots of the upper levels are emptied on the first tick of the span they cover
+        int shift = level * BITS_PER_LEVEL;
+        uint64_t firstSpan = (_currentTick + (uint64_t(1) << shift) - 1) >> shift;
+        for (int i = 0; i < SLOTS_PER_LEVEL; ++i) {
+            uint64_t span = firstSpan + i;
+            if ((_occupiedSlots[level] >> (span & SLOT_MASK)) & 1) {
+                nextTick = std::min(nextTick, span << shift);
+                break;
+            }
+        }
+    }
+    return nextTick;
+}
+
+void TimerWheel::insert(Timer* timer) {
+    assert(timer->expiry >= _currentTick && timer->expiry - _currentTick <= MAX_DELAY);
+
+    uint64_t delay = timer->expiry - _currentTick;
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && delay >= (uint64_t(1) << ((level + 1) * BITS_PER_LEVEL))) {
+        ++level;
+    }
+    int index = (int)((timer->expiry >> (level * BITS_PER_LEVEL)) & SLOT_MASK);
+
+    Timer*& head = _slots[level][index];
+    timer->prev = nullptr;
+    timer->next = head;
+    timer->slot = &head;
+    if (head) {
+        head->prev = timer;
+    }
+    head = timer;
+
+    _occupiedSlots[level] |= uint64_t(1) << index;
+    ++_numTimers;
+}
+
+void TimerWheel::unlink(Timer* timer) {
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        *timer->slot = timer->next;
+    }
+    if (timer->next) {
+        timer->next->prev = timer->prev;
+    }
+
+    if (!*timer->slot) {
+        auto slotIndex = timer->slot - &_slots[0][0];
+        _occupiedSlots[slotIndex / SLOTS_PER_LEVEL] &= ~(uint64_t(1) << (slotIndex % SLOTS_PER_LEVEL));
+    }
+
+    timer->prev = nullptr;
+    timer->next = nullptr;
+    timer->slot = nullptr;
+    --_numTimers;
+}
+
+TimerWheel::Timer* TimerWheel::takeSlot(int level, int index) {
+    Timer* timers = _slots[level][index];
+    _slots[level][index] = nullptr;
+    _occupiedSlots[level] &= ~(uint64_t(1) << index);
+
+    for (Timer* timer = timers; timer; timer = timer->next) {
+        timer->slot = nullptr;
+        --_numTimers;
+    }
+    return timers;
+}
+
+void TimerWheel::processCurrentTick(std::vector<Timer*>& expired) {
+    // move the timers of the spans starting now down, from the top so they end up in the right level
+    for (int level = NUM_LEVELS - 1; level > 0; --level) {
+        int shift = level * BITS_PER_LEVEL;
+        if ((_currentTick & ((uint64_t(1) << shift) - 1)) != 0) {
+            continue;
+        }
+
+        Timer* timer = takeSlot(level, (int)((_currentTick >> shift) & SLOT_MASK));
+        while (timer) {
+            Timer* next = timer->next;
+            insert(timer);
+            timer = next;
+        }
+    }
+
+    Timer* timer = takeSlot(0, (int)(_currentTick & SLOT_MASK));
+    while (timer) {
+        Timer* next = timer->next;
+        timer->prev = nullptr;
+        timer->next = nullptr;
+        expired.push_back(timer);
+        timer = next;
+    }
+
+    ++_currentTick;
+}
@@ -0,0 +1,82 @@
+//
+//  TimerWheel.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <cstdint>
+#include <vector>
+
+namespace udt {
+
+// A hierarchical timer wheel, counting time in ticks.
+//
+// Each level has 64 slots, and each slot of a level spans 64 times as many ticks as a slot of the level below. A timer
+// goes into the lowest level that reaches its expiry, and is moved down a level whenever the wheel turns into the slot
+// holding it, so scheduling and cancelling a timer are constant time however many timers there are.
+//
+// Timers are owned by the caller and linked into the wheel, a timer must be cancelled or expired before it is
+// destroyed. The wheel is not thread safe.
+class TimerWheel {
+public:
+    struct Timer {
+        Timer* prev { nullptr };
+        Timer* next { nullptr };
+        Timer** slot { nullptr };
+        uint64_t expiry { 0 };
+
+        bool isScheduled() const { return slot != nullptr; }
+    };
+
+    static const int BITS_PER_LEVEL = 6;
+    static const int SLOTS_PER_LEVEL = 1 << BITS_PER_LEVEL;
+    static const int NUM_LEVELS = 4;
+
+    // timers expiring further away than this expire this many ticks away
+    static const uint64_t MAX_DELAY = (uint64_t(1) << (BITS_PER_LEVEL * NUM_LEVELS)) - 1;
+
+    TimerWheel(uint64_t currentTick = 0);
+
+    // the next tick to be processed, every timer expiring before it has expired
+    uint64_t getCurrentTick() const { return _currentTick; }
+
+    bool isEmpty() const { return _numTimers == 0; }
+    int getNumTimers() const { return _numTimers; }
+
+    // schedules the timer, or reschedules it if it was already scheduled; timers expiring before the current tick
+    // expire on the current tick
+    void schedule(Timer* timer, uint64_t expiry);
+    void cancel(Timer* timer);
+
+    // processes every tick up to and including the given one, appending the timers that expired to expired
+    void advance(uint64_t tick, std::vector<Timer*>& expired);
+
+    // the earliest tick that advance() has something to do on, which is never after the next expiry; UINT64_MAX when
+    // the wheel is empty
+    uint64_t getNextTick() const;
+
+private:
+    void insert(Timer* timer);
+    void unlink(Timer* timer);
+    Timer* takeSlot(int level, int index);
+    void processCurrentTick(std::vector<Timer*>& expired);
+
+    uint64_t _currentTick;
+    int _numTimers { 0 };
+
+    Timer* _slots[NUM_LEVELS][SLOTS_PER_LEVEL];
+    uint64_t _occupiedSlots[NUM_LEVELS];
+};
+
+} // namespace udt
+
+#endif // hifi_TimerWheel_h
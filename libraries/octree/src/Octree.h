@@ -18,6 +18,9 @@
 
 #include <QHash>
 #include <QObject>
+#include <QUuid>
+#include <QVariant>
+#include <QVector>
 #include <QtCore/QJsonObject>
 
 #include <shared/ReadWriteLockable.h>
@@ -34,6 +37,7 @@ class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
 class OctreePacketData;
+class OctreeSnapshot;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
 
@@ -246,6 +250,19 @@ public:
     virtual void dumpTree() { }
     virtual void pruneTree() { }
 
+    // Incremental persistence, for trees that can tell which of their items changed between two persists.
+    /// start tracking changes, returns false if the tree can't
+    virtual bool startTrackingChanges() { return false; }
+    /// the items changed since the last call, in the form of writeToMap(), and the IDs of those deleted since
+    virtual void takeTrackedChanges(QVariantList& changedItems, QVector<QUuid>& deletedIDs) { }
+
+    // Binary snapshots, for trees that can encode each of their items on its own.
+    /// encode every item of the tree, returns false if the tree has no snapshot encoding
+    virtual bool writeToSnapshot(QVector<QByteArray>& items) { return false; }
+    /// add the items of an open snapshot to the tree, called with the write lock held
+    virtual bool readFromSnapshot(const OctreeSnapshot& snapshot) { return false; }
+
+    QUuid getPersistID() const { return _persistID; }
     void setOctreeVersionInfo(QUuid id, int64_t dataVersion) {
         _persistID = id;
         _persistDataVersion = dataVersion;
@@ -260,6 +277,7 @@ public:
     virtual quint64 getAverageFilterTime() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
+    int getPersistDataVersion() const { return _persistDataVersion; }
 
 
 protected:
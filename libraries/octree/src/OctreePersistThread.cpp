@@ -43,8 +43,13 @@ constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
+// the journal is plain JSON while the persist file is usually gzipped, so it is let grow to a few times its size
+constexpr qint64 MIN_JOURNAL_SIZE_BYTES_TO_COMPACT { 4 * 1000 * 1000 };
+constexpr qint64 JOURNAL_TO_PERSIST_FILE_SIZE_RATIO_TO_COMPACT { 4 };
+
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
-                                         bool debugTimestampNow, QString persistAsFileType) :
+                                         bool debugTimestampNow, QString persistAsFileType, bool wantJournal,
+                                         bool wantSnapshot) :
     _tree(tree),
     _filename(filename),
     _persistInterval(persistInterval),
@@ -53,7 +58,9 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _loadTimeUSecs(0),
     _debugTimestampNow(debugTimestampNow),
     _lastTimeDebug(0),
-    _persistAsFileType(persistAsFileType)
+    _persistAsFileType(persistAsFileType),
+    _wantJournal(wantJournal),
+    _wantSnapshot(wantSnapshot)
 {
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
@@ -72,9 +79,17 @@ void OctreePersistThread::start() {
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
     QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
+    if (_wantSnapshot && openSnapshot()) {
+        // the persist file is only read if the snapshot fails to load
+        const OctreeSnapshot::Info& info = _snapshot->getInfo();
+        qCDebug(octree) << "Current octree snapshot: ID(" << info.id << ") DataVersion(" << info.dataVersion << ")";
+        packet->writePrimitive(true);
+        auto id = info.id.toRfc4122();
+        packet->write(id);
+        packet->writePrimitive(info.dataVersion);
+    } else if (file.open(QIODevice::ReadOnly)) {
+        qCDebug(octree) << "Reading octree data from" << _filename;
         QByteArray jsonData(file.readAll());
         file.close();
         if (!gunzip(jsonData, _cachedJSONData)) {
@@ -114,10 +129,16 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     bool hasValidOctreeData { false };
     if (includesNewData) {
         _cachedJSONData.clear();
+        _snapshot.reset();
         replacementData = message->readAll();
         replaceData(replacementData);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
+    } else if (_snapshot) {
+        qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
+        hasValidOctreeData = true;
+        data.id = _snapshot->getInfo().id;
+        data.dataVersion = _snapshot->getInfo().dataVersion;
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
@@ -139,6 +160,10 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
                 }
             }
         }
+
+        if (_wantJournal && !_cachedJSONData.isEmpty() && replayJournal(_cachedJSONData)) {
+            qCDebug(octree) << "Replayed octree journal" << getJournalFilename();
+        }
     }
 
     quint64 loadStarted = usecTimestampNow();
@@ -153,21 +178,48 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        if (_cachedJSONData.isEmpty()) {
-            persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
-        } else {
-            QDataStream jsonStream(_cachedJSONData);
-            persistentFileRead = _tree->readFromStream(-1, jsonStream);
+        persistentFileRead = false;
+        if (_snapshot) {
+            qCDebug(octree) << "Loading octree snapshot" << getSnapshotFilename();
+            persistentFileRead = _tree->readFromSnapshot(*_snapshot);
+            if (!persistentFileRead) {
+                qCWarning(octree) << "Failed to load octree snapshot, reading octree data from" << _filename;
+                _tree->eraseAllOctreeElements();
+            }
+        }
+
+        if (!persistentFileRead) {
+            if (_cachedJSONData.isEmpty()) {
+                persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
+            } else {
+                QDataStream jsonStream(_cachedJSONData);
+                persistentFileRead = _tree->readFromStream(-1, jsonStream);
+            }
         }
         _tree->pruneTree();
     });
 
     _cachedJSONData.clear();
+    _snapshot.reset();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
+    if (_wantJournal) {
+        _isJournaling = _tree->startTrackingChanges();
+        if (_isJournaling) {
+            // replayed records are kept until the next compaction, new ones are appended after them
+            _journalSize = QFileInfo(getJournalFilename()).size();
+            _persistFileSize = QFileInfo(_filename).size();
+
+            // records are only replayed onto a persist file, so the first persist has to write one
+            _needsFullPersist = !QFile::exists(_filename);
+        } else {
+            qCWarning(octree) << "Octree can't track its changes, persisting without a journal";
+        }
+    }
+
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
     unsigned long leafNodeCount = OctreeElement::getLeafNodeCount();
@@ -213,6 +265,10 @@ QString OctreePersistThread::getPersistFileMimeType() const {
 void OctreePersistThread::replaceData(QByteArray data) {
     backupCurrentFile();
 
+    // the journal holds changes to the data being replaced, and the snapshot is a copy of it
+    QFile::remove(getJournalFilename());
+    QFile::remove(getSnapshotFilename());
+
     QFile currentFile { _filename };
     if (currentFile.open(QIODevice::WriteOnly)) {
         currentFile.write(data);
@@ -258,6 +314,11 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    if (_wantSnapshot && _isJournaling && _journalSize > 0) {
+        // a snapshot is never loaded over a journal, so the journal is compacted for the next start to load it
+        _needsFullPersist = true;
+        _tree->setDirtyBit();
+    }
     persist();
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
@@ -303,6 +364,19 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        if (_isJournaling) {
+            bool shouldCompact = _needsFullPersist || _journalSize >
+                std::max(MIN_JOURNAL_SIZE_BYTES_TO_COMPACT, JOURNAL_TO_PERSIST_FILE_SIZE_RATIO_TO_COMPACT * _persistFileSize);
+            if (!shouldCompact && appendToJournal()) {
+                return;
+            }
+
+            // everything changed so far is written below, the journal starts over once it has been
+            QVariantList changedItems;
+            QVector<QUuid> deletedIDs;
+            _tree->takeTrackedChanges(changedItems, deletedIDs);
+            qCDebug(octree) << "Compacting octree journal" << getJournalFilename() << "of" << _journalSize << "bytes";
+        }
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
@@ -316,6 +390,18 @@ void OctreePersistThread::persist() {
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+
+            if (_isJournaling) {
+                // if we stop before this, the records are skipped on replay as they are older than the persist file
+                QFile::remove(getJournalFilename());
+                _journalSize = 0;
+                _persistFileSize = QFileInfo(_filename).size();
+                _needsFullPersist = false;
+            }
+
+            if (_wantSnapshot) {
+                writeSnapshot();
+            }
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
@@ -324,6 +410,164 @@ void OctreePersistThread::persist() {
     }
 }
 
+bool OctreePersistThread::appendToJournal() {
+    // cleared first, so that changes made while the record is being written mark the tree dirty again
+    _tree->clearDirtyBit();
+
+    QVariantList changedItems;
+    QVector<QUuid> deletedIDs;
+    _tree->takeTrackedChanges(changedItems, deletedIDs);
+    if (changedItems.isEmpty() && deletedIDs.isEmpty()) {
+        return true;
+    }
+
+    _tree->incrementPersistDataVersion();
+
+    QVariantList deletedItems;
+    for (const auto& deletedID : deletedIDs) {
+        deletedItems << deletedID.toString();
+    }
+
+    QVariantMap record;
+    record["DataVersion"] = _tree->getPersistDataVersion();
+    record["Entities"] = changedItems;
+    record["Deleted"] = deletedItems;
+
+    // one record per line, compact JSON has no line breaks of its own
+    QByteArray recordData = QJsonDocument::fromVariant(record).toJson(QJsonDocument::Compact) + '\n';
+
+    QFile journal(getJournalFilename());
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Append) || journal.write(recordData) != recordData.size() ||
+        !journal.flush()) {
+        // the changes taken above are in no record, so only a full persist can save them now
+        qCWarning(octree) << "Failed to append to octree journal" << journal.fileName() << journal.errorString();
+        _needsFullPersist = true;
+        _tree->setDirtyBit();
+        return false;
+    }
+
+    _journalSize += recordData.size();
+    return true;
+}
+
+bool OctreePersistThread::replayJournal(QByteArray& jsonData) {
+    QFile journal(getJournalFilename());
+    if (!journal.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QVariantMap map = QJsonDocument::fromJson(jsonData).toVariant().toMap();
+    int dataVersion = map["DataVersion"].toInt();
+    QVariantList entities = map["Entities"].toList();
+
+    QHash<QUuid, int> entityIndices;
+    for (int i = 0; i < entities.size(); ++i) {
+        entityIndices[QUuid(entities[i].toMap()["id"].toString())] = i;
+    }
+
+    int numRecordsReplayed = 0;
+    while (!journal.atEnd()) {
+        QByteArray recordData = journal.readLine();
+        QJsonParseError parseError;
+        QJsonDocument recordDocument = QJsonDocument::fromJson(recordData, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !recordDocument.isObject()) {
+            // the last record is cut short if we stopped while appending it
+            qCWarning(octree) << "Ignoring the end of octree journal" << journal.fileName() << "-"
+                              << parseError.errorString();
+            break;
+        }
+
+        QVariantMap record = recordDocument.toVariant().toMap();
+        int recordDataVersion = record["DataVersion"].toInt();
+        if (recordDataVersion <= dataVersion) {
+            continue; // left by a compaction that stopped after writing the persist file
+        }
+
+        for (const auto& entity : record["Entities"].toList()) {
+            QUuid entityID(entity.toMap()["id"].toString());
+            auto it = entityIndices.find(entityID);
+            if (it != entityIndices.end()) {
+                entities[it.value()] = entity;
+            } else {
+                entityIndices[entityID] = entities.size();
+                entities << entity;
+            }
+        }
+
+        for (const auto& deletedID : record["Deleted"].toList()) {
+            auto it = entityIndices.find(QUuid(deletedID.toString()));
+            if (it != entityIndices.end()) {
+                entities[it.value()] = QVariant();
+                entityIndices.erase(it);
+            }
+        }
+
+        dataVersion = recordDataVersion;
+        ++numRecordsReplayed;
+    }
+
+    if (numRecordsReplayed == 0) {
+        return false;
+    }
+
+    entities.removeAll(QVariant());
+    map["Entities"] = entities;
+    map["DataVersion"] = dataVersion;
+    jsonData = QJsonDocument::fromVariant(map).toJson(QJsonDocument::Compact);
+    return true;
+}
+
+bool OctreePersistThread::openSnapshot() {
+    // journal records are replayed onto the persist file, which the snapshot would skip
+    if (_wantJournal && QFile::exists(getJournalFilename())) {
+        return false;
+    }
+
+    _snapshot.reset(new OctreeSnapshot());
+    if (!_snapshot->open(getSnapshotFilename())) {
+        _snapshot.reset();
+        return false;
+    }
+
+    const OctreeSnapshot::Info& info = _snapshot->getInfo();
+    QFileInfo persistFile(_filename);
+    if (info.id.isNull() || info.dataPacketType != _tree->expectedDataPacketType() ||
+        info.dataPacketVersion != _tree->expectedVersion() || !persistFile.exists() ||
+        info.persistFileSize != persistFile.size() ||
+        info.persistFileModified != persistFile.lastModified().toMSecsSinceEpoch()) {
+        qCDebug(octree) << "Octree snapshot" << getSnapshotFilename() << "is out of date";
+        _snapshot.reset();
+        return false;
+    }
+
+    return true;
+}
+
+void OctreePersistThread::writeSnapshot() {
+    // encoded after the persist file is written, so that the snapshot holds at least everything the file does
+    QVector<QByteArray> items;
+    if (!_tree->writeToSnapshot(items)) {
+        QFile::remove(getSnapshotFilename());
+        return;
+    }
+
+    QFileInfo persistFile(_filename);
+    OctreeSnapshot::Info info;
+    info.dataPacketType = _tree->expectedDataPacketType();
+    info.dataPacketVersion = _tree->expectedVersion();
+    info.id = _tree->getPersistID();
+    info.dataVersion = _tree->getPersistDataVersion();
+    info.persistFileSize = persistFile.size();
+    info.persistFileModified = persistFile.lastModified().toMSecsSinceEpoch();
+
+    if (OctreeSnapshot::write(getSnapshotFilename(), info, items)) {
+        qCDebug(octree) << "DONE writing octree snapshot" << getSnapshotFilename();
+    } else {
+        // a stale snapshot would still match the persist file if it was rewritten with the same size and time
+        QFile::remove(getSnapshotFilename());
+    }
+}
+
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
     auto nodeList = DependencyManager::get<NodeList>();
@@ -14,9 +14,12 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <memory>
+
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeSnapshot.h"
 
 class OctreePersistThread : public QObject {
     Q_OBJECT
@@ -36,7 +39,9 @@ public:
                         const QString& filename,
                         std::chrono::milliseconds persistInterval = DEFAULT_PERSIST_INTERVAL,
                         bool debugTimestampNow = false,
-                        QString persistAsFileType = "json.gz");
+                        QString persistAsFileType = "json.gz",
+                        bool wantJournal = false,
+                        bool wantSnapshot = false);
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
@@ -59,6 +64,12 @@ protected slots:
 
 protected:
     void persist();
+    bool appendToJournal();
+    bool replayJournal(QByteArray& jsonData);
+    QString getJournalFilename() const { return _filename + ".journal"; }
+    bool openSnapshot();
+    void writeSnapshot();
+    QString getSnapshotFilename() const { return _filename + ".snapshot"; }
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
@@ -79,6 +90,18 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    // in journal mode, persists append the entities changed since the previous persist to a journal next to the
+    // persist file, and the persist file is only rewritten once the journal has grown large compared to it
+    bool _wantJournal;
+    bool _isJournaling { false };
+    bool _needsFullPersist { false };
+    qint64 _journalSize { 0 };
+    qint64 _persistFileSize { 0 };
+
+    // with snapshots, full persists also write a binary copy of the tree, loaded instead of the persist file on start
+    bool _wantSnapshot;
+    std::unique_ptr<OctreeSnapshot> _snapshot;
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -0,0 +1,165 @@
+//
+//  OctreeSnapshot.cpp
+//  libraries/octree/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSnapshot.h"
+
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QSaveFile>
+
+#include "OctreeLogging.h"
+
+static const char SNAPSHOT_MAGIC[4] = { 'H', 'F', 'O', 'S' };
+static const quint32 SNAPSHOT_FORMAT_VERSION = 2;
+
+// 64 bytes, so that the index entries that follow are aligned
+struct SnapshotHeader {
+    char magic[4];
+    quint32 formatVersion;
+    quint32 dataPacketType;
+    quint32 dataPacketVersion;
+    char id[16];
+    qint64 dataVersion;
+    qint64 persistFileSize;
+    qint64 persistFileModified;
+    quint64 numItems;
+};
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader must not be padded");
+
+struct SnapshotIndexEntry {
+    quint64 offset;
+    quint64 size;
+};
+
+bool OctreeSnapshot::write(const QString& filename, const Info& info, const QVector<QByteArray>& items) {
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.formatVersion = SNAPSHOT_FORMAT_VERSION;
+    header.dataPacketType = (quint32)info.dataPacketType;
+    header.dataPacketVersion = (quint32)info.dataPacketVersion;
+    QByteArray id = info.id.toRfc4122();
+    memcpy(header.id, id.constData(), sizeof(header.id));
+    header.dataVersion = info.dataVersion;
+    header.persistFileSize = info.persistFileSize;
+    header.persistFileModified = info.persistFileModified;
+    header.numItems = items.size();
+
+    QVector<SnapshotIndexEntry> index(items.size());
+    quint64 offset = sizeof(SnapshotHeader) + items.size() * sizeof(SnapshotIndexEntry);
+    for (int i = 0; i < items.size(); ++i) {
+        index[i].offset = offset;
+        index[i].size = items[i].size();
+        offset += items[i].size();
+    }
+
+    // written to a temporary file first, so that a snapshot is never left half written
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(octree) << "Couldn't write octree snapshot" << filename << file.errorString();
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(index.constData()), index.size() * sizeof(SnapshotIndexEntry));
+    for (const auto& item : items) {
+        file.write(item);
+    }
+
+    if (!file.commit()) {
+        qCWarning(octree) << "Couldn't write octree snapshot" << filename << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool OctreeSnapshot::open(const QString& filename) {
+    close();
+
+    _file.setFileName(filename);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    _size = _file.size();
+    if (_size < (qint64)sizeof(SnapshotHeader)) {
+        qCWarning(octree) << "Octree snapshot" << filename << "is truncated";
+        close();
+        return false;
+    }
+
+    _data = _file.map(0, _size);
+    if (!_data) {
+        qCWarning(octree) << "Couldn't map octree snapshot" << filename << _file.errorString();
+        close();
+        return false;
+    }
+
+    SnapshotHeader header;
+    memcpy(&header, _data, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.formatVersion != SNAPSHOT_FORMAT_VERSION) {
+        qCWarning(octree) << "Octree snapshot" << filename << "has an unknown format";
+        close();
+        return false;
+    }
+
+    quint64 indexSize = header.numItems * sizeof(SnapshotIndexEntry);
+    if (header.numItems > (quint64)std::numeric_limits<int>::max() || sizeof(SnapshotHeader) + indexSize > (quint64)_size) {
+        qCWarning(octree) << "Octree snapshot" << filename << "is truncated";
+        close();
+        return false;
+    }
+
+    _numItems = (int)header.numItems;
+    _index = _data + sizeof(SnapshotHeader);
+    for (int i = 0; i < _numItems; ++i) {
+        SnapshotIndexEntry entry;
+        memcpy(&entry, _index + i * sizeof(SnapshotIndexEntry), sizeof(entry));
+        if (entry.offset > (quint64)_size || entry.size > (quint64)_size - entry.offset ||
+            entry.size > (quint64)std::numeric_limits<int>::max()) {
+            qCWarning(octree) << "Octree snapshot" << filename << "is truncated";
+            close();
+            return false;
+        }
+    }
+
+    _info.dataPacketType = (PacketType)header.dataPacketType;
+    _info.dataPacketVersion = (PacketVersion)header.dataPacketVersion;
+    _info.id = QUuid::fromRfc4122(QByteArray::fromRawData(header.id, sizeof(header.id)));
+    _info.dataVersion = header.dataVersion;
+    _info.persistFileSize = header.persistFileSize;
+    _info.persistFileModified = header.persistFileModified;
+    return true;
+}
+
+void OctreeSnapshot::close() {
+    if (_data) {
+        _file.unmap(const_cast<unsigned char*>(_data));
+    }
+    _file.close();
+
+    _data = nullptr;
+    _size = 0;
+    _info = Info();
+    _numItems = 0;
+    _index = nullptr;
+}
+
+const unsigned char* OctreeSnapshot::getItemData(int index) const {
+    SnapshotIndexEntry entry;
+    memcpy(&entry, _index + index * sizeof(SnapshotIndexEntry), sizeof(entry));
+    return _data + entry.offset;
+}
+
+int OctreeSnapshot::getItemSize(int index) const {
+    SnapshotIndexEntry entry;
+    memcpy(&entry, _index + index * sizeof(SnapshotIndexEntry), sizeof(entry));
+    return (int)entry.size;
+}
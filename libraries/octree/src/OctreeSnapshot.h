@@ -0,0 +1,66 @@
+//
+//  OctreeSnapshot.h
+//  libraries/octree/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSnapshot_h
+#define hifi_OctreeSnapshot_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+#include <QtCore/QVector>
+
+#include <udt/PacketHeaders.h>
+
+// A binary copy of a persisted octree, which loads much faster than the JSON it is made from.
+//
+// The file is a header, an index of (offset, size) pairs, and one blob per item of the tree, in whatever encoding
+// the tree gives it. It is written next to the persist file after each full persist and read through a memory map,
+// so that the tree can decode its items in parallel straight from the mapped file.
+//
+// A snapshot is only a cache of the persist file: it records the size and modification time of the file it was
+// written along with, and is ignored once they no longer match. Integers are in the byte order of the machine that
+// wrote it, a snapshot moved to another machine is rejected and rebuilt on the next persist.
+class OctreeSnapshot {
+public:
+    struct Info {
+        PacketType dataPacketType { PacketType::Unknown };
+        PacketVersion dataPacketVersion { 0 };
+        QUuid id;
+        int64_t dataVersion { 0 };
+
+        // of the persist file the snapshot was written along with
+        qint64 persistFileSize { 0 };
+        qint64 persistFileModified { 0 };
+    };
+
+    static bool write(const QString& filename, const Info& info, const QVector<QByteArray>& items);
+
+    ~OctreeSnapshot() { close(); }
+
+    // maps the file and checks its header and index
+    bool open(const QString& filename);
+    void close();
+
+    const Info& getInfo() const { return _info; }
+    int getNumItems() const { return _numItems; }
+    const unsigned char* getItemData(int index) const;
+    int getItemSize(int index) const;
+
+private:
+    QFile _file;
+    const unsigned char* _data { nullptr };
+    qint64 _size { 0 };
+
+    Info _info;
+    int _numItems { 0 };
+    const unsigned char* _index { nullptr };
+};
+
+#endif // hifi_OctreeSnapshot_h
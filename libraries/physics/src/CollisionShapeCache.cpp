@@ -0,0 +1,215 @@
+//
+//  CollisionShapeCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CollisionShapeCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+
+#include <SettingHandle.h>
+
+#include "ShapeFactory.h"
+
+using File = cache::File;
+using FilePointer = cache::FilePointer;
+
+// Whenever a change is made to the serialized format for the shape cache that isn't backward compatible,
+// this value should be incremented.  This will force the shape cache to be wiped
+const int CollisionShapeCache::CURRENT_VERSION = 0x02;
+const int CollisionShapeCache::INVALID_VERSION = 0x00;
+const char* CollisionShapeCache::SETTING_VERSION_NAME = "hifi.shape.cache_version";
+
+static const quint32 SHAPE_FILE_SIGNATURE = 0x48535048; // "HPSH"
+
+enum class CachedShapeType : quint8 {
+    ConvexHull,
+    Compound
+};
+
+static std::string keyForHash(uint64_t hash) {
+    return QString::number(hash, 16).toStdString();
+}
+
+CollisionShapeCache::CollisionShapeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+void CollisionShapeCache::initialize() {
+    FileCache::initialize();
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != CURRENT_VERSION) {
+        wipe();
+        cacheVersionHandle.set(CURRENT_VERSION);
+    }
+}
+
+std::unique_ptr<File> CollisionShapeCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCInfo(file_cache) << "Wrote collision shape" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
+
+QByteArray CollisionShapeCache::getContentDigest(const ShapeInfo& info) {
+    QCryptographicHash digest(QCryptographicHash::Md5);
+    for (const auto& points : info.getPointCollection()) {
+        quint32 numPoints = (quint32)points.size();
+        digest.addData(reinterpret_cast<const char*>(&numPoints), sizeof(numPoints));
+        digest.addData(reinterpret_cast<const char*>(points.data()), (int)(points.size() * sizeof(glm::vec3)));
+    }
+    const auto& triangleIndices = info.getTriangleIndices();
+    digest.addData(reinterpret_cast<const char*>(triangleIndices.data()), (int)(triangleIndices.size() * sizeof(int32_t)));
+    return digest.result();
+}
+
+const btCollisionShape* CollisionShapeCache::loadShape(uint64_t hash, const QByteArray& digest) {
+    FilePointer file = getFile(keyForHash(hash));
+    if (!file) {
+        return nullptr;
+    }
+
+    QFile shapeFile(file->getFilepath().c_str());
+    if (!shapeFile.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    return deserializeShape(hash, digest, shapeFile.readAll());
+}
+
+void CollisionShapeCache::saveShape(uint64_t hash, const QByteArray& digest, const btCollisionShape* shape) {
+    if (!isCacheable(shape)) {
+        return;
+    }
+    QByteArray data = serializeShape(hash, digest, shape);
+    writeFile(data.constData(), Metadata(keyForHash(hash), data.size()), true);
+}
+
+bool CollisionShapeCache::isCacheable(const btCollisionShape* shape) {
+    if (!shape) {
+        return false;
+    }
+    if (shape->getShapeType() == (int)CONVEX_HULL_SHAPE_PROXYTYPE) {
+        return true;
+    }
+    if (shape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE) {
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+        for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+            if (compound->getChildShape(i)->getShapeType() != (int)CONVEX_HULL_SHAPE_PROXYTYPE) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+static void writeHull(QDataStream& stream, const btConvexHullShape* hull) {
+    stream << hull->getMargin();
+    int numPoints = hull->getNumPoints();
+    stream << (quint32)numPoints;
+    const btVector3* points = hull->getUnscaledPoints();
+    for (int i = 0; i < numPoints; ++i) {
+        stream << points[i].getX() << points[i].getY() << points[i].getZ();
+    }
+}
+
+static btConvexHullShape* readHull(QDataStream& stream) {
+    float margin;
+    quint32 numPoints;
+    stream >> margin >> numPoints;
+    if (stream.status() != QDataStream::Ok || numPoints == 0 || numPoints > (quint32)MAX_HULL_POINTS) {
+        return nullptr;
+    }
+
+    btConvexHullShape* hull = new btConvexHullShape();
+    hull->setMargin(margin);
+    for (quint32 i = 0; i < numPoints; ++i) {
+        float x, y, z;
+        stream >> x >> y >> z;
+        hull->addPoint(btVector3(x, y, z), false);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        delete hull;
+        return nullptr;
+    }
+    hull->recalcLocalAabb();
+    return hull;
+}
+
+QByteArray CollisionShapeCache::serializeShape(uint64_t hash, const QByteArray& digest, const btCollisionShape* shape) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << SHAPE_FILE_SIGNATURE << (quint64)hash << digest;
+
+    if (shape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE) {
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+        int numChildren = compound->getNumChildShapes();
+        stream << (quint8)CachedShapeType::Compound << (quint32)numChildren;
+        for (int i = 0; i < numChildren; ++i) {
+            const btTransform& transform = compound->getChildTransform(i);
+            const btVector3& origin = transform.getOrigin();
+            btQuaternion rotation = transform.getRotation();
+            stream << origin.getX() << origin.getY() << origin.getZ();
+            stream << rotation.getX() << rotation.getY() << rotation.getZ() << rotation.getW();
+            writeHull(stream, static_cast<const btConvexHullShape*>(compound->getChildShape(i)));
+        }
+    } else {
+        stream << (quint8)CachedShapeType::ConvexHull;
+        writeHull(stream, static_cast<const btConvexHullShape*>(shape));
+    }
+    return data;
+}
+
+const btCollisionShape* CollisionShapeCache::deserializeShape(uint64_t hash, const QByteArray& digest, const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 signature;
+    quint64 fileHash;
+    QByteArray fileDigest;
+    quint8 type;
+    stream >> signature >> fileHash >> fileDigest >> type;
+    if (stream.status() != QDataStream::Ok || signature != SHAPE_FILE_SIGNATURE || fileHash != hash ||
+        fileDigest != digest) {
+        return nullptr;
+    }
+
+    if (type == (quint8)CachedShapeType::ConvexHull) {
+        return readHull(stream);
+    }
+    if (type != (quint8)CachedShapeType::Compound) {
+        return nullptr;
+    }
+
+    quint32 numChildren;
+    stream >> numChildren;
+    if (stream.status() != QDataStream::Ok || numChildren == 0) {
+        return nullptr;
+    }
+
+    btCompoundShape* compound = new btCompoundShape();
+    for (quint32 i = 0; i < numChildren; ++i) {
+        float x, y, z, w;
+        btTransform transform;
+        stream >> x >> y >> z;
+        transform.setOrigin(btVector3(x, y, z));
+        stream >> x >> y >> z >> w;
+        transform.setRotation(btQuaternion(x, y, z, w));
+
+        btConvexHullShape* hull = readHull(stream);
+        if (!hull) {
+            // the file is truncated or corrupt
+            ShapeFactory::deleteShape(compound);
+            return nullptr;
+        }
+        compound->addChildShape(transform, hull);
+    }
+    compound->recalculateLocalAabb();
+    return compound;
+}
@@ -0,0 +1,58 @@
+//
+//  CollisionShapeCache.h
+//  libraries/physics/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CollisionShapeCache_h
+#define hifi_CollisionShapeCache_h
+
+#include <QtCore/QByteArray>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <ShapeInfo.h>
+#include <shared/FileCache.h>
+
+// Keeps the convex hulls and compounds of hulls built by the ShapeFactory on disk, keyed by ShapeInfo::getHash(),
+// so that a model seen before doesn't need its hulls computed again.  The hash of a compound only covers its URL and
+// bounds, so each file also holds a digest of the points and triangles the shape was built from, and a model that
+// changed behind the same URL misses the cache.
+//
+// Loading and saving are thread-safe, they are done by the ShapeFactory workers.
+class CollisionShapeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format for the shape cache that isn't backward compatible,
+    // this value should be incremented.  This will force the shape cache to be wiped
+    static const int CURRENT_VERSION;
+    static const int INVALID_VERSION;
+    static const char* SETTING_VERSION_NAME;
+
+    CollisionShapeCache(const std::string& dir, const std::string& ext);
+
+    void initialize() override;
+
+    /// \return a digest of the points and triangle indices of the shape
+    static QByteArray getContentDigest(const ShapeInfo& info);
+
+    /// \return the cached shape for the hash and digest or nullptr, the shape is owned by the caller
+    const btCollisionShape* loadShape(uint64_t hash, const QByteArray& digest);
+    void saveShape(uint64_t hash, const QByteArray& digest, const btCollisionShape* shape);
+
+    /// \return true for convex hulls and compounds of convex hulls, the only shapes that are cached
+    static bool isCacheable(const btCollisionShape* shape);
+
+    static QByteArray serializeShape(uint64_t hash, const QByteArray& digest, const btCollisionShape* shape);
+    static const btCollisionShape* deserializeShape(uint64_t hash, const QByteArray& digest, const QByteArray& data);
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+};
+
+#endif // hifi_CollisionShapeCache_h
@@ -380,6 +380,19 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                     // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
                     shapeRequest.shapeHash = shapeInfo.getHash();
                     _shapeRequests.insert(shapeRequest);
+
+                    if (entity->getDynamic()) {
+                        // a dynamic entity would hang in the air until its shape arrives, so it starts with a box
+                        // around it instead and is given the real shape as a CHANGE when it is ready
+                        ShapeInfo placeholderInfo;
+                        placeholderInfo.setParams(SHAPE_TYPE_BOX, 0.5f * entity->getScaledDimensions());
+                        entity->adjustShapeInfoByRegistration(placeholderInfo);
+                        btCollisionShape* placeholder =
+                            const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(placeholderInfo));
+                        if (placeholder) {
+                            buildMotionState(placeholder, entity);
+                        }
+                    }
                 } else {
                     // failed to build shape --> will not be added
                 }
@@ -428,41 +441,31 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
 
         bool needsNewShape = object->needsNewShape();
         if (needsNewShape) {
-            ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
-                ShapeRequest shapeRequest(object->_entity);
-                ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
-                if (requestItr == _shapeRequests.end()) {
-                    ShapeInfo shapeInfo;
-                    object->_entity->computeShapeInfo(shapeInfo);
-                    uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
-                    if (shape) {
-                        object->setShape(shape);
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                        needsNewShape = false;
-                    } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
-                        // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
-                        shapeRequest.shapeHash = shapeInfo.getHash();
-                        _shapeRequests.insert(shapeRequest);
-                    } else {
-                        // failed to build shape --> will not be added/updated
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                    }
-                } else {
-                    // continue waiting for shape request
-                }
-            } else {
+            ShapeRequest shapeRequest(object->_entity);
+            ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
+            if (requestItr == _shapeRequests.end()) {
                 ShapeInfo shapeInfo;
                 object->_entity->computeShapeInfo(shapeInfo);
+                uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
                 btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
                 if (shape) {
                     object->setShape(shape);
                     handledFlags |= Simulation::DIRTY_SHAPE;
                     needsNewShape = false;
+                } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
+                    // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
+                    shapeRequest.shapeHash = shapeInfo.getHash();
+                    _shapeRequests.insert(shapeRequest);
                 } else {
-                    // failed to build shape --> will not be added
+                    // failed to build shape --> will not be added/updated
+                    handledFlags |= Simulation::DIRTY_SHAPE;
                 }
+            } else {
+                // continue waiting for shape request
+            }
+            if (needsNewShape && object->getShape() && _shapeRequests.find(shapeRequest) != _shapeRequests.end()) {
+                // the object keeps its current (or placeholder) shape until the new one arrives
+                needsNewShape = false;
             }
         }
         if (!isInPhysicsSimulation) {
@@ -12,6 +12,7 @@
 #include "PhysicsEngine.h"
 
 #include <functional>
+#include <memory>
 
 #include <QFile>
 
@@ -27,6 +28,13 @@
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+// Bullet's own thread pool, shared by all engines since the task scheduler is global to Bullet.
+// It is null when Bullet was built without BT_THREADSAFE.
+static btITaskScheduler* getMultithreadedTaskScheduler() {
+    static std::unique_ptr<btITaskScheduler> scheduler { btCreateDefaultTaskScheduler() };
+    return scheduler.get();
+}
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
@@ -34,6 +42,7 @@ PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
 
 PhysicsEngine::~PhysicsEngine() {
     _myAvatarController = nullptr;
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
     delete _collisionConfig;
     delete _collisionDispatcher;
     delete _broadphaseFilter;
@@ -44,10 +53,14 @@ PhysicsEngine::~PhysicsEngine() {
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
+        setNumThreads(_numThreads);
+
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+        // the Mt dispatcher and solver pool only split the work across threads when a multithreaded
+        // task scheduler is set, see setNumThreads()
+        _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
+        _constraintSolver = new btConstraintSolverPoolMt(MAX_PHYSICS_THREADS);
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
@@ -70,6 +83,27 @@ void PhysicsEngine::init() {
     }
 }
 
+void PhysicsEngine::setNumThreads(int numThreads) {
+    numThreads = glm::clamp(numThreads, 1, MAX_PHYSICS_THREADS);
+
+    btITaskScheduler* scheduler = btGetSequentialTaskScheduler();
+    if (numThreads > 1) {
+        btITaskScheduler* multithreadedScheduler = getMultithreadedTaskScheduler();
+        if (multithreadedScheduler) {
+            numThreads = std::min(numThreads, multithreadedScheduler->getMaxNumThreads());
+            multithreadedScheduler->setNumThreads(numThreads);
+            scheduler = multithreadedScheduler;
+        } else {
+            qCWarning(physics) << "Bullet was built without BT_THREADSAFE, physics will step on a single thread";
+            numThreads = 1;
+        }
+    }
+
+    // the scheduler is only swapped between steps, since the simulation steps on the thread that calls this
+    btSetTaskScheduler(scheduler);
+    _numThreads = numThreads;
+}
+
 uint32_t PhysicsEngine::getNumSubsteps() const {
     return _dynamicsWorld->getNumSubsteps();
 }
@@ -415,6 +449,11 @@ void PhysicsEngine::harvestPerformanceStats() {
             itr->Next();
         }
     }
+
+    // one record per substep, so that the timer shows the average substep
+    for (auto substepTime : _dynamicsWorld->getSubstepTimes()) {
+        PerformanceTimer::addTimerRecord("physics/substep", substepTime);
+    }
 }
 
 void PhysicsEngine::printPerformanceStatsToFile(const QString& filename) {
@@ -848,7 +887,9 @@ struct AllContactsCallback : public btCollisionWorld::ContactResultCallback {
     }
 
     ~AllContactsCallback() {
-        ObjectMotionState::getShapeManager()->releaseShape(collisionObject.getCollisionShape());
+        if (collisionObject.getCollisionShape()) {
+            ObjectMotionState::getShapeManager()->releaseShape(collisionObject.getCollisionShape());
+        }
     }
 
     btCollisionObject collisionObject;
@@ -914,6 +955,11 @@ std::vector<ContactTestResult> PhysicsEngine::contactTest(uint16_t mask, const S
     }
 
     auto contactCallback = AllContactsCallback((int32_t)mask, (int32_t)group, regionShapeInfo, regionTransform, myAvatarCollisionObject, threshold);
+    if (!contactCallback.collisionObject.getCollisionShape()) {
+        // hulls and compounds are built on the ShapeManager's workers, and there's nothing to test against until the
+        // region's shape is ready, which a later test of the same region will find
+        return std::vector<ContactTestResult>();
+    }
     _dynamicsWorld->contactTest(&contactCallback.collisionObject, contactCallback);
 
     return contactCallback.contacts;
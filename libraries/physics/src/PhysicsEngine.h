@@ -18,6 +18,7 @@
 
 #include <QUuid>
 #include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #include "BulletUtil.h"
@@ -28,6 +29,7 @@
 #include "ObjectConstraint.h"
 
 const float HALF_SIMULATION_EXTENT = 512.0f; // meters
+const int MAX_PHYSICS_THREADS = 8;
 
 class CharacterController;
 class PhysicsDebugDraw;
@@ -96,6 +98,11 @@ public:
     ~PhysicsEngine();
     void init();
 
+    /// \brief sets the number of threads the simulation steps on, 1 steps it on the calling thread only.
+    /// Needs Bullet to be built with BT_THREADSAFE, otherwise the simulation stays single threaded.
+    void setNumThreads(int numThreads);
+    int getNumThreads() const { return _numThreads; }
+
     uint32_t getNumSubsteps() const;
     int32_t getNumCollisionObjects() const;
 
@@ -170,9 +177,9 @@ private:
 
     btClock _clock;
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
-    btCollisionDispatcher* _collisionDispatcher = NULL;
+    btCollisionDispatcherMt* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _constraintSolver = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
@@ -189,6 +196,7 @@ private:
     CharacterController* _myAvatarController;
 
     uint32_t _numContactFrames { 0 };
+    int _numThreads { 1 };
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
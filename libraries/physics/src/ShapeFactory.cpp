@@ -16,6 +16,7 @@
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "CollisionShapeCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -488,7 +489,23 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+bool ShapeFactory::isBuiltByWorker(ShapeType type) {
+    return type == SHAPE_TYPE_STATIC_MESH || type == SHAPE_TYPE_COMPOUND ||
+        type == SHAPE_TYPE_SIMPLE_HULL || type == SHAPE_TYPE_SIMPLE_COMPOUND;
+}
+
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    uint64_t hash = shapeInfo.getHash();
+    QByteArray digest;
+    if (diskCache) {
+        digest = CollisionShapeCache::getContentDigest(shapeInfo);
+        shape = diskCache->loadShape(hash, digest);
+    }
+    if (!shape) {
+        shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+        if (diskCache && shape) {
+            diskCache->saveShape(hash, digest, shape);
+        }
+    }
     emit submitWork(this);
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_ShapeFactory_h
 #define hifi_ShapeFactory_h
 
+#include <memory>
+
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 #include <QObject>
@@ -19,12 +21,17 @@
 
 #include <ShapeInfo.h>
 
+class CollisionShapeCache;
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // meshes, hulls and compounds are too expensive to build on the simulation thread
+    bool isBuiltByWorker(ShapeType type);
+
     class Worker : public QObject, public QRunnable {
         Q_OBJECT
     public:
@@ -32,6 +39,8 @@ namespace ShapeFactory {
         void run() override;
         ShapeInfo shapeInfo;
         const btCollisionShape* shape;
+        // when set, the shape is loaded from the cache if it was built before, and saved to it otherwise
+        std::shared_ptr<CollisionShapeCache> diskCache;
     signals:
         void submitWork(Worker*);
     };
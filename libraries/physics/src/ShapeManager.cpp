@@ -11,16 +11,26 @@
 
 #include "ShapeManager.h"
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
-#include <QThreadPool>
 
 #include <NumericalConstants.h>
+#include <ThreadHelpers.h>
 
 const int MAX_RING_SIZE = 256;
 
+static const std::string SHAPE_CACHE_DIRNAME { "shape_cache" };
+static const std::string SHAPE_CACHE_EXT { "shape" };
+static const size_t MAX_SHAPE_CACHE_SIZE { MB_TO_BYTES(512) };
+
 ShapeManager::ShapeManager() {
     _garbageRing.reserve(MAX_RING_SIZE);
     _nextOrphanExpiry = std::chrono::steady_clock::now();
+
+    // a teleport into a model heavy area asks for many hulls at once, build them on a few threads
+    // without holding up the global pool
+    _workerPool.setMaxThreadCount(getWorkerPoolThreadCount());
 }
 
 ShapeManager::~ShapeManager() {
@@ -36,6 +46,15 @@ ShapeManager::~ShapeManager() {
     }
 }
 
+void ShapeManager::initializeDiskCache() {
+    if (_diskCache) {
+        return;
+    }
+    _diskCache = std::make_shared<CollisionShapeCache>(SHAPE_CACHE_DIRNAME, SHAPE_CACHE_EXT);
+    _diskCache->initialize();
+    _diskCache->setMaxSize(MAX_SHAPE_CACHE_SIZE);
+}
+
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
@@ -47,7 +66,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (ShapeFactory::isBuiltByWorker(info.getType())) {
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
@@ -66,10 +85,12 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
                 worker->shapeInfo = info;
                 _deadWorker = nullptr;
             }
+            // only hulls and compounds are kept on disk
+            worker->diskCache = info.getType() != SHAPE_TYPE_STATIC_MESH ? _diskCache : nullptr;
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-            QThreadPool::globalInstance()->start(worker);
+            _workerPool.start(worker);
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
@@ -277,6 +298,7 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
     // save this dead worker for later
     worker->shapeInfo.clear();
     worker->shape = nullptr;
+    worker->diskCache.reset();
     _deadWorker = worker;
     ++_workDeliveryCount;
 }
@@ -17,11 +17,13 @@
 #include <vector>
 
 #include <QObject>
+#include <QThreadPool>
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
 #include <ShapeInfo.h>
 
+#include "CollisionShapeCache.h"
 #include "ShapeFactory.h"
 #include "HashKey.h"
 
@@ -41,6 +43,11 @@
 // and returns the pointer.  If not it asks the ShapeFactory to create it, adds an
 // entry in the map with a ref-count of 1, and returns the pointer.
 //
+// Meshes, hulls and compounds are built on the ShapeManager's worker threads instead:
+// getShape() returns nullptr and bumps the work request count, and the shape can be
+// had by key once the work delivery count changes.  When the disk cache is initialized
+// the workers load hulls and compounds built on an earlier run from it.
+//
 // When a body stops using a shape the ShapeManager must be informed so it can
 // decrement its ref-count.  When a ref-count drops to zero the ShapeManager
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
@@ -55,6 +62,9 @@ public:
     ShapeManager();
     ~ShapeManager();
 
+    /// start keeping the hulls and compounds built by the workers on disk
+    void initializeDiskCache();
+
     /// \return pointer to shape
     const btCollisionShape* getShape(const ShapeInfo& info);
     const btCollisionShape* getShapeByKey(uint64_t key);
@@ -103,10 +113,14 @@ private:
     std::vector<uint64_t> _pendingMeshShapes;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
+    std::shared_ptr<CollisionShapeCache> _diskCache;
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
     std::atomic_uint _workDeliveryCount { 0 };
+
+    // last, so that it is destroyed first and waits for the workers to finish
+    QThreadPool _workerPool;
 };
 
 #endif // hifi_ShapeManager_h
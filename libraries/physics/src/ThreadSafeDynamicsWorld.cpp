@@ -19,14 +19,16 @@
 
 #include <LinearMath/btQuickprof.h>
 
+#include <SharedUtil.h>
+
 #include "Profile.h"
 
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
-        btConstraintSolver* constraintSolver,
+        btConstraintSolverPoolMt* solverPool,
         btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, solverPool, nullptr, collisionConfiguration) {
 }
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
@@ -34,6 +36,7 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
     DETAILED_PROFILE_RANGE(simulation_physics, "stepWithCB");
     BT_PROFILE("stepSimulationWithSubstepCallback");
     int subSteps = 0;
+    _substepTimes.clear();
     if (maxSubSteps) {
         //fixed timestep with interpolation
         m_fixedTimeStep = fixedTimeStep;
@@ -75,8 +78,15 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
 
         for (int i=0;i<clampedSimulationSteps;i++) {
             DETAILED_PROFILE_RANGE(simulation_physics, "substep");
+            uint64_t substepStart = usecTimestampNow();
             internalSingleStepSimulation(fixedTimeStep);
             onSubStep();
+            _substepTimes.push_back(usecTimestampNow() - substepStart);
+        }
+
+        // let the task scheduler's workers sleep until the next step, as btDiscreteDynamicsWorldMt::stepSimulation() does
+        if (btITaskScheduler* scheduler = btGetTaskScheduler()) {
+            scheduler->sleepWorkerThreadsHint();
         }
     }
 
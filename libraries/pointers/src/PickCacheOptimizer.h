@@ -10,6 +10,9 @@
 
 #include <unordered_map>
 
+#include <QtCore/QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
 #include "Pick.h"
 
 typedef struct PickCacheKey {
@@ -33,18 +36,45 @@ namespace std {
 
 // T is a mathematical representation of a Pick (a MathPick)
 // For example: RayPicks use T = PickRay
+//
+// The picks are updated in batches.  When given a worker pool, the entity intersections of a batch, one for each distinct
+// pick and filter, run on the workers while the avatar and HUD intersections, which have to be on the calling thread,
+// run alongside them.
 template<typename T>
 class PickCacheOptimizer {
 
 public:
-    QVector3D update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD);
+    QVector3D update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD,
+                     QThreadPool* workerPool = nullptr);
 
 protected:
     typedef std::unordered_map<T, std::unordered_map<PickCacheKey, PickResultPointer>> PickCache;
 
+    static const size_t PICKS_PER_WORKER { 4 };
+
+    struct BatchedPick {
+        std::shared_ptr<Pick<T>> pick;
+        T mathPick;
+        PickResultPointer res;
+        int entityQuery { -1 };
+        int avatarQuery { -1 };
+        int hudQuery { -1 };
+    };
+
+    struct Query {
+        std::shared_ptr<Pick<T>> pick;
+        T mathPick;
+        PickResultPointer result;
+    };
+    typedef std::unordered_map<T, std::unordered_map<PickCacheKey, int>> QueryIndices;
+
     // Returns true if this pick exists in the cache, and if it does, update res if the cached result is closer
     bool checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key);
     void cacheResult(const bool intersects, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick);
+
+    // Returns the index of the query for this pick and key, or -1 if its result is already in the cache
+    int addQuery(BatchedPick& batchedPick, const PickCacheKey& key, PickCache& cache, std::vector<Query>& queries, QueryIndices& queryIndices);
+    void updateBatch(std::vector<BatchedPick>& batch, PickCache& cache, bool shouldPickHUD, QThreadPool* workerPool, QVector3D& numIntersectionsComputed);
 };
 
 template<typename T>
@@ -66,9 +96,126 @@ void PickCacheOptimizer<T>::cacheResult(const bool needToCompareResults, const P
     }
 }
 
+template<typename T>
+int PickCacheOptimizer<T>::addQuery(BatchedPick& batchedPick, const PickCacheKey& key, PickCache& cache,
+        std::vector<Query>& queries, QueryIndices& queryIndices) {
+    auto cached = cache.find(batchedPick.mathPick);
+    if (cached != cache.end() && cached->second.find(key) != cached->second.end()) {
+        return -1;
+    }
+    auto& indices = queryIndices[batchedPick.mathPick];
+    auto index = indices.find(key);
+    if (index != indices.end()) {
+        return index->second;
+    }
+    int queryIndex = (int)queries.size();
+    indices[key] = queryIndex;
+    queries.push_back({ batchedPick.pick, batchedPick.mathPick, PickResultPointer() });
+    return queryIndex;
+}
+
+template<typename T>
+void PickCacheOptimizer<T>::updateBatch(std::vector<BatchedPick>& batch, PickCache& cache, bool shouldPickHUD,
+        QThreadPool* workerPool, QVector3D& numIntersectionsComputed) {
+    std::vector<Query> entityQueries;
+    std::vector<Query> avatarQueries;
+    std::vector<Query> hudQueries;
+    QueryIndices entityQueryIndices;
+    QueryIndices avatarQueryIndices;
+    QueryIndices hudQueryIndices;
+
+    for (auto& batchedPick : batch) {
+        const auto& filter = batchedPick.pick->getFilter();
+        if (filter.doesPickDomainEntities() || filter.doesPickAvatarEntities() || filter.doesPickLocalEntities()) {
+            PickCacheKey entityKey = { filter.getEntityFlags(), batchedPick.pick->getIncludeItems(), batchedPick.pick->getIgnoreItems() };
+            batchedPick.entityQuery = addQuery(batchedPick, entityKey, cache, entityQueries, entityQueryIndices);
+        }
+        if (filter.doesPickAvatars()) {
+            PickCacheKey avatarKey = { filter.getAvatarFlags(), batchedPick.pick->getIncludeItems(), batchedPick.pick->getIgnoreItems() };
+            batchedPick.avatarQuery = addQuery(batchedPick, avatarKey, cache, avatarQueries, avatarQueryIndices);
+        }
+        // Can't intersect with HUD in desktop mode
+        if (filter.doesPickHUD() && shouldPickHUD) {
+            PickCacheKey hudKey = { filter.getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
+            batchedPick.hudQuery = addQuery(batchedPick, hudKey, cache, hudQueries, hudQueryIndices);
+        }
+    }
+
+    std::vector<QFuture<void>> entityFutures;
+    if (workerPool && entityQueries.size() > 1) {
+        entityFutures.reserve(entityQueries.size());
+        for (auto& query : entityQueries) {
+            entityFutures.push_back(QtConcurrent::run(workerPool, [&query] {
+                query.result = query.pick->getEntityIntersection(query.mathPick);
+            }));
+        }
+    } else {
+        for (auto& query : entityQueries) {
+            query.result = query.pick->getEntityIntersection(query.mathPick);
+        }
+    }
+    for (auto& query : avatarQueries) {
+        query.result = query.pick->getAvatarIntersection(query.mathPick);
+    }
+    for (auto& query : hudQueries) {
+        query.result = query.pick->getHUDIntersection(query.mathPick);
+    }
+    for (auto& future : entityFutures) {
+        future.waitForFinished();
+    }
+
+    numIntersectionsComputed[0] += (float)entityQueries.size();
+    numIntersectionsComputed[1] += (float)avatarQueries.size();
+    numIntersectionsComputed[2] += (float)hudQueries.size();
+
+    // combine the results in the same order as the picks would have computed them one by one
+    for (auto& batchedPick : batch) {
+        const auto& pick = batchedPick.pick;
+        auto& mathematicalPick = batchedPick.mathPick;
+        auto& res = batchedPick.res;
+        const auto& filter = pick->getFilter();
+
+        if (filter.doesPickDomainEntities() || filter.doesPickAvatarEntities() || filter.doesPickLocalEntities()) {
+            PickCacheKey entityKey = { filter.getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+            if (!checkAndCompareCachedResults(mathematicalPick, cache, res, entityKey) && batchedPick.entityQuery != -1) {
+                PickResultPointer entityRes = entityQueries[batchedPick.entityQuery].result;
+                if (entityRes) {
+                    cacheResult(entityRes->doesIntersect(), entityRes, entityKey, res, mathematicalPick, cache, pick);
+                }
+            }
+        }
+
+        if (filter.doesPickAvatars()) {
+            PickCacheKey avatarKey = { filter.getAvatarFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+            if (!checkAndCompareCachedResults(mathematicalPick, cache, res, avatarKey) && batchedPick.avatarQuery != -1) {
+                PickResultPointer avatarRes = avatarQueries[batchedPick.avatarQuery].result;
+                if (avatarRes) {
+                    cacheResult(avatarRes->doesIntersect(), avatarRes, avatarKey, res, mathematicalPick, cache, pick);
+                }
+            }
+        }
+
+        if (filter.doesPickHUD() && shouldPickHUD) {
+            PickCacheKey hudKey = { filter.getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
+            if (!checkAndCompareCachedResults(mathematicalPick, cache, res, hudKey) && batchedPick.hudQuery != -1) {
+                PickResultPointer hudRes = hudQueries[batchedPick.hudQuery].result;
+                if (hudRes) {
+                    cacheResult(true, hudRes, hudKey, res, mathematicalPick, cache, pick);
+                }
+            }
+        }
+
+        if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
+            pick->setPickResult(res);
+        } else {
+            pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
+        }
+    }
+}
+
 template<typename T>
 QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
-        uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD) {
+        uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD, QThreadPool* workerPool) {
     QVector3D numIntersectionsComputed;
     PickCache results;
     const uint32_t INVALID_PICK_ID = 0;
@@ -79,62 +226,33 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
             itr = picks.begin();
         }
     }
+    const size_t batchSize = workerPool ? PICKS_PER_WORKER * workerPool->maxThreadCount() : 1;
+    std::vector<BatchedPick> batch;
+    batch.reserve(batchSize);
     uint32_t numUpdates = 0;
     while(numUpdates < picks.size()) {
-        std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
-        T mathematicalPick = pick->getMathematicalPick();
-        PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
-
-        if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick) {
-            pick->setPickResult(res);
-        } else {
-            if (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities()) {
-                PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, entityKey)) {
-                    PickResultPointer entityRes = pick->getEntityIntersection(mathematicalPick);
-                    numIntersectionsComputed[0]++;
-                    if (entityRes) {
-                        cacheResult(entityRes->doesIntersect(), entityRes, entityKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
-            if (pick->getFilter().doesPickAvatars()) {
-                PickCacheKey avatarKey = { pick->getFilter().getAvatarFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, avatarKey)) {
-                    PickResultPointer avatarRes = pick->getAvatarIntersection(mathematicalPick);
-                    numIntersectionsComputed[1]++;
-                    if (avatarRes) {
-                        cacheResult(avatarRes->doesIntersect(), avatarRes, avatarKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
-            // Can't intersect with HUD in desktop mode
-            if (pick->getFilter().doesPickHUD() && shouldPickHUD) {
-                PickCacheKey hudKey = { pick->getFilter().getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, hudKey)) {
-                    PickResultPointer hudRes = pick->getHUDIntersection(mathematicalPick);
-                    numIntersectionsComputed[2]++;
-                    if (hudRes) {
-                        cacheResult(true, hudRes, hudKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
+        batch.clear();
+        while (numUpdates < picks.size() && batch.size() < batchSize) {
+            std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
+            T mathematicalPick = pick->getMathematicalPick();
+            PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
 
-            if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
+            if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick) {
                 pick->setPickResult(res);
             } else {
-                pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
+                batch.push_back({ pick, mathematicalPick, res });
             }
-        }
 
-        ++itr;
-        if (itr == picks.end()) {
-            itr = picks.begin();
+            ++itr;
+            if (itr == picks.end()) {
+                itr = picks.begin();
+            }
+            nextToUpdate = itr->first;
+            ++numUpdates;
         }
-        nextToUpdate = itr->first;
-        ++numUpdates;
+
+        updateBatch(batch, results, shouldPickHUD, workerPool, numIntersectionsComputed);
+
         if (usecTimestampNow() > expiry) {
             break;
         }
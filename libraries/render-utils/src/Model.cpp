@@ -25,6 +25,8 @@
 #include <ViewFrustum.h>
 #include <GLMHelpers.h>
 #include <TBBHelpers.h>
+#include <PrioritySortUtil.h>
+#include <ThreadHelpers.h>
 
 #include <model-networking/SimpleMeshProxy.h>
 #include <graphics-scripting/Forward.h>
@@ -1777,7 +1779,8 @@ static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
 class Blender : public QRunnable {
 public:
 
-    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
+    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients,
+            quint64 requestTime);
 
     virtual void run() override;
 
@@ -1786,13 +1789,16 @@ private:
     HFMModel::ConstPointer _hfmModel;
     int _blendNumber;
     QVector<float> _blendshapeCoefficients;
+    quint64 _requestTime;
 };
 
-Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients) :
+Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients,
+                 quint64 requestTime) :
     _model(model),
     _hfmModel(hfmModel),
     _blendNumber(blendNumber),
-    _blendshapeCoefficients(blendshapeCoefficients) {
+    _blendshapeCoefficients(blendshapeCoefficients),
+    _requestTime(requestTime) {
 }
 
 void Blender::run() {
@@ -1868,20 +1874,62 @@ void Blender::run() {
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
                               Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
                               Q_ARG(QVector<BlendshapeOffset>, packedBlendshapeOffsets),
-                              Q_ARG(QVector<int>, blendedMeshSizes));
+                              Q_ARG(QVector<int>, blendedMeshSizes), Q_ARG(quint64, _requestTime));
 }
 
-bool Model::maybeStartBlender() {
+bool Model::maybeStartBlender(QThreadPool& pool, quint64 requestTime) {
     if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getNetworkModel()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
+        pool.start(new Blender(getThisPointer(), getNetworkModel()->getConstHFMModelPointer(),
+                               ++_blendNumber, _blendshapeCoefficients, requestTime));
         return true;
     }
     return false;
 }
 
-ModelBlender::ModelBlender() :
-    _pendingBlenders(0) {
+namespace {
+
+// the smallest a face can look in a view, as its radius over its distance, for its blendshapes to be worth computing
+const float MIN_BLEND_ANGULAR_SIZE = 0.005f;
+
+// the updates a model out of the views or too small in them waits before its blend is started anyway, last in the frame,
+// so that it isn't left stale in shadows or when it comes into view
+const int MAX_SKIPPED_BLEND_UPDATES = 30;
+
+class SortableModel : public PrioritySortUtil::Sortable {
+public:
+    SortableModel(const ModelPointer& model, quint64 requestTime) : _model(model), _requestTime(requestTime) {
+        Extents extents = model->getMeshExtents();
+        _position = model->getTranslation() + model->getRotation() * (0.5f * (extents.minimum + extents.maximum));
+        _radius = 0.5f * glm::length(extents.maximum - extents.minimum);
+    }
+
+    glm::vec3 getPosition() const override { return _position; }
+    float getRadius() const override { return _radius; }
+    uint64_t getTimestamp() const override { return _requestTime; }
+
+    const ModelPointer& getModel() const { return _model; }
+
+    bool isTooSmall(const ConicalViewFrustums& views) const {
+        for (const auto& view : views) {
+            float distance = glm::distance(_position, view.getPosition());
+            if (_radius >= MIN_BLEND_ANGULAR_SIZE * distance) {
+                return false;
+            }
+        }
+        return !views.empty();
+    }
+
+private:
+    ModelPointer _model;
+    quint64 _requestTime;
+    glm::vec3 _position;
+    float _radius;
+};
+
+}
+
+ModelBlender::ModelBlender() {
+    _blenderPool.setMaxThreadCount(getWorkerPoolThreadCount());
 }
 
 ModelBlender::~ModelBlender() {
@@ -1889,26 +1937,90 @@ ModelBlender::~ModelBlender() {
 
 void ModelBlender::noteRequiresBlend(ModelPointer model) {
     Lock lock(_mutex);
-    if (_modelsRequiringBlendsSet.find(model) == _modelsRequiringBlendsSet.end()) {
-        _modelsRequiringBlendsQueue.push(model);
-        _modelsRequiringBlendsSet.insert(model);
-    }
-
-    if (_pendingBlenders < QThread::idealThreadCount()) {
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                return;
+    // the blend is started by the next update, the request time of a model that already requires one stands
+    _modelsRequiringBlends.emplace(model, BlendRequest { usecTimestampNow() });
+}
+
+void ModelBlender::update(const ConicalViewFrustums& views) {
+    PROFILE_RANGE(simulation_animation, __FUNCTION__);
+    Lock lock(_mutex);
+    _sortedModelsRequiringBlends.clear();
+    if (_modelsRequiringBlends.empty()) {
+        return;
+    }
+
+    PrioritySortUtil::PriorityQueue<SortableModel> sortedModels(views);
+    sortedModels.reserve(_modelsRequiringBlends.size());
+    std::vector<ModelPointer> skippedModels;
+    for (auto iter = _modelsRequiringBlends.begin(); iter != _modelsRequiringBlends.end();) {
+        ModelPointer model = iter->first.lock();
+        if (!model) {
+            iter = _modelsRequiringBlends.erase(iter);
+            continue;
+        }
+        if (model->isVisible()) {
+            SortableModel sortable(model, iter->second.requestTime);
+            if (sortable.isTooSmall(views)) {
+                skippedModels.push_back(model);
+            } else {
+                sortedModels.push(sortable);
             }
         }
+        ++iter;
+    }
+
+    for (const auto& sortable : sortedModels.getSortedVector()) {
+        if (sortable.getPriority() < OUT_OF_VIEW_THRESHOLD) {
+            skippedModels.push_back(sortable.getModel());
+        } else {
+            _sortedModelsRequiringBlends.push_back(sortable.getModel());
+        }
+    }
+
+    for (const auto& model : skippedModels) {
+        auto iter = _modelsRequiringBlends.find(model);
+        if (++iter->second.numSkippedUpdates >= MAX_SKIPPED_BLEND_UPDATES) {
+            _sortedModelsRequiringBlends.push_back(model);
+        }
+    }
+
+    startBlenders();
+}
+
+void ModelBlender::startBlenders() {
+    while (_pendingBlenders < _blenderPool.maxThreadCount() && !_sortedModelsRequiringBlends.empty()) {
+        auto weakPtr = _sortedModelsRequiringBlends.front();
+        _sortedModelsRequiringBlends.pop_front();
+        auto iter = _modelsRequiringBlends.find(weakPtr);
+        if (iter == _modelsRequiringBlends.end()) {
+            continue;
+        }
+        quint64 requestTime = iter->second.requestTime;
+        _modelsRequiringBlends.erase(iter);
+        ModelPointer nextModel = weakPtr.lock();
+        if (nextModel && nextModel->maybeStartBlender(_blenderPool, requestTime)) {
+            _pendingBlenders++;
+        }
     }
 }
 
-void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes) {
+int ModelBlender::getQueueDepth() const {
+    Lock lock(_mutex);
+    return (int)_modelsRequiringBlends.size();
+}
+
+int ModelBlender::getNumBlendsInFlight() const {
+    Lock lock(_mutex);
+    return _pendingBlenders;
+}
+
+float ModelBlender::getAverageLatency() const {
+    Lock lock(_mutex);
+    return _averageLatency;
+}
+
+void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets,
+                                      QVector<int> blendedMeshSizes, quint64 requestTime) {
     if (model) {
         auto blendshapeOperator = model->getModelBlendshapeOperator();
         if (blendshapeOperator) {
@@ -1918,16 +2030,11 @@ void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVect
 
     {
         Lock lock(_mutex);
+        const float LATENCY_TIMESCALE = 0.1f;
+        float latency = (float)(usecTimestampNow() - requestTime) / (float)USECS_PER_MSEC;
+        _averageLatency += LATENCY_TIMESCALE * (latency - _averageLatency);
+
         _pendingBlenders--;
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                break;
-            }
-        }
+        startBlenders();
     }
 }
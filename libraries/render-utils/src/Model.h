@@ -11,7 +11,10 @@
 #include <QObject>
 #include <QUrl>
 #include <QMutex>
+#include <QThreadPool>
 
+#include <deque>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -27,6 +30,7 @@
 #include <SpatiallyNestable.h>
 #include <TriangleSet.h>
 #include <DualQuaternion.h>
+#include <shared/ConicalViewFrustum.h>
 
 #include "RenderHifi.h"
 #include "GeometryCache.h"
@@ -150,7 +154,7 @@ public:
     AABox getRenderableMeshBound() const;
     const render::ItemIDs& fetchRenderItemIDs() const;
 
-    bool maybeStartBlender();
+    bool maybeStartBlender(QThreadPool& pool, quint64 requestTime);
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
     bool isAddedToScene() const { return _addedToScene; }
@@ -522,6 +526,7 @@ Q_DECLARE_METATYPE(NetworkModel::WeakPointer)
 Q_DECLARE_METATYPE(BlendshapeOffset)
 
 /// Handle management of pending models that need blending
+/// The blends are run on a pool of their own, a frame's worth at a time, in order of the models' priority in the views.
 class ModelBlender : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
@@ -531,10 +536,20 @@ public:
     /// Adds the specified model to the list requiring vertex blends.
     void noteRequiresBlend(ModelPointer model);
 
+    /// Starts the blends of the models requiring them, most visible first, skipping those that are out of the views or
+    /// too small in them to tell, which stay in the list for a number of updates before they are started last.
+    /// Called once a frame.
+    void update(const ConicalViewFrustums& views);
+
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
 
+    int getQueueDepth() const;
+    int getNumBlendsInFlight() const;
+    float getAverageLatency() const; // ms, from the blend being required to its vertices being set
+
 public slots:
-    void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
+    void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets,
+                            QVector<int> blendedMeshSizes, quint64 requestTime);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
 
 private:
@@ -544,10 +559,20 @@ private:
     ModelBlender();
     virtual ~ModelBlender();
 
-    std::queue<ModelWeakPointer> _modelsRequiringBlendsQueue;
-    std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlendsSet;
-    int _pendingBlenders;
-    Mutex _mutex;
+    void startBlenders(); // with _mutex locked
+
+    // the models requiring blends, when they first did, and the updates that have skipped them since
+    struct BlendRequest {
+        quint64 requestTime;
+        int numSkippedUpdates { 0 };
+    };
+    std::map<ModelWeakPointer, BlendRequest, std::owner_less<ModelWeakPointer>> _modelsRequiringBlends;
+    // the models of the last update that are to be started as blenders finish, in order
+    std::deque<ModelWeakPointer> _sortedModelsRequiringBlends;
+    int _pendingBlenders { 0 };
+    float _averageLatency { 0.0f };
+    mutable Mutex _mutex;
+    QThreadPool _blenderPool;
 
     bool _computeBlendshapes { true };
 };
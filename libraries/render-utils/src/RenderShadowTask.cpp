@@ -531,6 +531,9 @@ void RenderShadowTeardown::run(const render::RenderContextPointer& renderContext
     args->_renderMode = input.get0();
 }
 
+// The number of items culled at a time on a worker thread
+static const size_t SHADOW_CULL_GRAIN_SIZE = 256;
+
 static AABox& merge(AABox& box, const AABox& otherBox, const glm::vec3& dir) {
     if (!otherBox.isInvalid()) {
         int vertexIndex = 0;
@@ -552,6 +555,7 @@ static AABox& merge(AABox& box, const AABox& otherBox, const glm::vec3& dir) {
 void CullShadowBounds::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
+    render::CPUJobTimer cpuJobTimer(renderContext, render::RenderContext::CULL_JOB);
     RenderArgs* args = renderContext->args;
 
     const auto& inShapes = inputs.get0();
@@ -575,55 +579,72 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
 
     if (!filter.selectsNothing() && currentKeyLight) {
         auto& details = args->_details.edit(RenderDetails::SHADOW);
-        render::CullTest test(shadowCullFunctor, args, details, antiFrustum);
         auto scene = args->_scene;
         auto lightStage = renderContext->_scene->getStage<LightStage>();
         assert(lightStage);
         const auto globalLightDir = currentKeyLight->getDirection();
         auto castersFilter = render::ItemFilter::Builder(filter).withShadowCaster().build();
 
+        // The buckets are cut into ranges culled on the worker pool.  Each range keeps the items it let through in order,
+        // as the receivers' contribution to the bounds depends on what came before them.
+        struct CullRange {
+            const render::ItemBounds* inItems;
+            render::ItemBounds* outItems;
+            size_t begin;
+            size_t end;
+            std::vector<std::pair<render::ItemBound, bool>> culledItems; // and whether they're casters
+            RenderDetails::Item details;
+        };
+        std::vector<CullRange> ranges;
         for (auto& inItems : inShapes) {
             auto key = inItems.first;
             auto outItems = outShapes.find(key);
             if (outItems == outShapes.end()) {
-                outItems = outShapes.insert(std::make_pair(key, ItemBounds{})).first;
+                outItems = outShapes.insert(std::make_pair(key, render::ItemBounds{})).first;
                 outItems->second.reserve(inItems.second.size());
             }
 
             details._considered += (int)inItems.second.size();
 
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
+            size_t numItems = inItems.second.size();
+            for (size_t begin = 0; begin < numItems; begin += SHADOW_CULL_GRAIN_SIZE) {
+                ranges.push_back({ &inItems.second, &outItems->second, begin, std::min(begin + SHADOW_CULL_GRAIN_SIZE, numItems) });
+            }
+        }
+
+        renderContext->parallelFor(ranges.size(), 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                auto& range = ranges[i];
+                render::CullTest test(shadowCullFunctor, args, range.details, antiFrustum);
+                for (size_t j = range.begin; j < range.end; j++) {
+                    const auto& item = (*range.inItems)[j];
+                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) &&
+                        (antiFrustum == nullptr || test.antiFrustumTest(item.bound))) {
                         const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
+                        range.culledItems.emplace_back(item, castersFilter.test(shapeKey));
                     }
                 }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
-                    }
+            }
+        });
+
+        for (const auto& range : ranges) {
+            for (const auto& culledItem : range.culledItems) {
+                const auto& item = culledItem.first;
+                if (culledItem.second) {
+                    range.outItems->emplace_back(item);
+                    outBounds += item.bound;
+                } else {
+                    // Receivers are not rendered but they still increase the bounds of the shadow scene
+                    // although only in the direction of the light direction so as to have a correct far
+                    // distance without decreasing the near distance.
+                    merge(outBounds, item.bound, globalLightDir);
                 }
             }
-            details._rendered += (int)outItems->second.size();
+            details._outOfView += range.details._outOfView;
+            details._tooSmall += range.details._tooSmall;
+        }
+        for (auto& items : outShapes) {
+            details._rendered += (int)items.second.size();
         }
 
         for (auto& items : outShapes) {
@@ -19,6 +19,43 @@
 
 using namespace render;
 
+// The number of items culled at a time on a worker thread
+static const size_t CULL_GRAIN_SIZE = 256;
+
+namespace {
+
+struct CullSelectionList {
+    const ItemIDs* items;
+    bool frustumTest;
+    bool solidAngleTest;
+};
+
+struct CullSelectionRange {
+    CullSelectionRange(const CullSelectionList& list, size_t begin, size_t end) : list(list), begin(begin), end(end) {}
+
+    CullSelectionList list;
+    size_t begin;
+    size_t end;
+    ItemBounds outItems;
+    RenderDetails::Item details;
+};
+
+// A range of the items of a shape bucket
+struct CullShapeRange {
+    CullShapeRange(const ItemBounds* inItems, ItemBounds* outItems, size_t begin, size_t end) :
+        inItems(inItems), outItems(outItems), begin(begin), end(end) {}
+
+    const ItemBounds* inItems;
+    ItemBounds* outItems;
+    size_t begin;
+    size_t end;
+    ItemBounds culledItems;
+    AABox bounds;
+    RenderDetails::Item details;
+};
+
+}
+
 CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum) :
     _functor(functor),
     _args(pargs),
@@ -118,6 +155,7 @@ void render::cullItems(const RenderContextPointer& renderContext, const CullFunc
 void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const ItemFilter& filter, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::FETCH_JOB);
     auto& scene = renderContext->_scene;
 
     outItems.clear();
@@ -142,7 +180,8 @@ void FetchSpatialTree::run(const RenderContextPointer& renderContext, const Inpu
     if (!renderContext){
         return;
     }
-    
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::FETCH_JOB);
+
     // start fresh
     outSelection.clear();
 
@@ -197,6 +236,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                                const Inputs& inputs, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::CULL_JOB);
     RenderArgs* args = renderContext->args;
     auto& scene = renderContext->_scene;
     auto& inSelection = inputs.get0();
@@ -213,8 +253,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -227,136 +265,54 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-        } else {
-            // CPM investigate
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
+        // inside & fit items: easy, just filter
+        // inside & subcell items: filter & distance cull
+        // partial & fit items: filter & frustum cull
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        // With culling disabled, all of them are only filtered.
+        const bool doCull = !(_skipCulling || _overrideSkipCulling);
+        const CullSelectionList lists[] = {
+            { &inSelection.insideItems, false, false },
+            { &inSelection.insideSubcellItems, false, doCull },
+            { &inSelection.partialItems, doCull, false },
+            { &inSelection.partialSubcellItems, doCull, doCull }
+        };
+
+        // The lists are cut into ranges culled on the worker pool, each into its own output so the items keep their order
+        std::vector<CullSelectionRange> ranges;
+        for (const auto& list : lists) {
+            size_t numItems = list.items->size();
+            for (size_t begin = 0; begin < numItems; begin += CULL_GRAIN_SIZE) {
+                ranges.emplace_back(list, begin, std::min(begin + CULL_GRAIN_SIZE, numItems));
             }
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
+        renderContext->parallelFor(ranges.size(), 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                auto& range = ranges[i];
+                CullTest test(_cullFunctor, args, range.details);
+                const auto& items = *range.list.items;
+                for (size_t j = range.begin; j < range.end; j++) {
+                    auto id = items[j];
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
                         ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
+                        if ((!range.list.frustumTest || test.frustumTest(itemBound.bound)) &&
+                            (!range.list.solidAngleTest || test.solidAngleTest(itemBound.bound))) {
+                            range.outItems.emplace_back(itemBound);
                             if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
+                                item.fetchMetaSubItemBounds(range.outItems, (*scene));
                             }
                         }
                     }
                 }
             }
+        });
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+        for (const auto& range : ranges) {
+            outItems.insert(outItems.end(), range.outItems.begin(), range.outItems.end());
+            details._outOfView += range.details._outOfView;
+            details._tooSmall += range.details._tooSmall;
         }
     }
 
@@ -373,6 +329,7 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
 void CullShapeBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::CULL_JOB);
     RenderArgs* args = renderContext->args;
 
     const auto& inShapes = inputs.get0();
@@ -390,9 +347,10 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
 
     if (!cullFilter.selectsNothing() || !boundsFilter.selectsNothing()) {
         auto& details = args->_details.edit(_detailType);
-        CullTest test(_cullFunctor, args, details, antiFrustum);
         auto scene = args->_scene;
 
+        // The buckets are cut into ranges culled on the worker pool, each into its own output so the items keep their order
+        std::vector<CullShapeRange> ranges;
         for (auto& inItems : inShapes) {
             auto key = inItems.first;
             auto outItems = outShapes.find(key);
@@ -403,32 +361,38 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
 
             details._considered += (int)inItems.second.size();
 
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (cullFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                        }
-                        if (boundsFilter.test(shapeKey)) {
-                            outBounds += item.bound;
-                        }
-                    }
-                }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
+            size_t numItems = inItems.second.size();
+            for (size_t begin = 0; begin < numItems; begin += CULL_GRAIN_SIZE) {
+                ranges.emplace_back(&inItems.second, &outItems->second, begin, std::min(begin + CULL_GRAIN_SIZE, numItems));
+            }
+        }
+
+        renderContext->parallelFor(ranges.size(), 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                auto& range = ranges[i];
+                CullTest test(_cullFunctor, args, range.details, antiFrustum);
+                for (size_t j = range.begin; j < range.end; j++) {
+                    const auto& item = (*range.inItems)[j];
+                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) &&
+                        (antiFrustum == nullptr || test.antiFrustumTest(item.bound))) {
                         const auto shapeKey = scene->getItem(item.id).getKey();
                         if (cullFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
+                            range.culledItems.emplace_back(item);
                         }
                         if (boundsFilter.test(shapeKey)) {
-                            outBounds += item.bound;
+                            range.bounds += item.bound;
                         }
                     }
                 }
             }
-            details._rendered += (int)outItems->second.size();
+        });
+
+        for (const auto& range : ranges) {
+            range.outItems->insert(range.outItems->end(), range.culledItems.begin(), range.culledItems.end());
+            outBounds += range.bounds;
+            details._outOfView += range.details._outOfView;
+            details._tooSmall += range.details._tooSmall;
+            details._rendered += (int)range.culledItems.size();
         }
 
         for (auto& items : outShapes) {
@@ -441,6 +405,7 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
 void ApplyCullFunctorOnItemBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::CULL_JOB);
     RenderArgs* args = renderContext->args;
     auto& inItems = inputs.get0();
     auto& outItems = outputs;
@@ -453,10 +418,18 @@ void ApplyCullFunctorOnItemBounds::run(const RenderContextPointer& renderContext
     outItems.clear();
     outItems.reserve(inItems.size());
 
-    for (auto& item : inItems) {
-        if (_cullFunctor(args, item.bound)) {
-            outItems.emplace_back(item); // cpm - add to render?
+    // Culled in ranges on the worker pool, each into its own output so the items keep their order
+    std::vector<ItemBounds> rangeItems(task::WorkerPool::getNumRanges(inItems.size(), CULL_GRAIN_SIZE));
+    renderContext->parallelFor(inItems.size(), CULL_GRAIN_SIZE, [&](size_t rangeIndex, size_t begin, size_t end) {
+        auto& culledItems = rangeItems[rangeIndex];
+        for (size_t i = begin; i < end; i++) {
+            if (_cullFunctor(args, inItems[i].bound)) {
+                culledItems.emplace_back(inItems[i]); // cpm - add to render?
+            }
         }
+    });
+    for (const auto& culledItems : rangeItems) {
+        outItems.insert(outItems.end(), culledItems.begin(), culledItems.end());
     }
 
     if (inputFrustum != nullptr) {
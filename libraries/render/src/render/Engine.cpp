@@ -14,6 +14,7 @@
 #include <QtCore/QFile>
 
 #include <PathUtils.h>
+#include <ThreadHelpers.h>
 
 #include <gpu/Context.h>
 
@@ -38,6 +39,8 @@ public:
 
 RenderEngine::RenderEngine() : Engine(EngineTask::JobModel::create("Engine"), std::make_shared<RenderContext>())
 {
+    // The render thread runs its share of the culling and sorting too
+    _context->workerPool = std::make_shared<task::WorkerPool>(getWorkerPoolThreadCount());
 }
 
 void RenderEngine::load() {
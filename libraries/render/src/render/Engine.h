@@ -12,6 +12,9 @@
 #ifndef hifi_render_Engine_h
 #define hifi_render_Engine_h
 
+#include <array>
+#include <chrono>
+
 #include <SettingHandle.h>
 
 #include <gpu/Batch.h>
@@ -25,14 +28,39 @@ namespace render {
 
     class RenderContext : public task::JobContext {
     public:
+        enum CPUJobType {
+            FETCH_JOB = 0,
+            CULL_JOB,
+            SORT_JOB,
+            NUM_CPU_JOB_TYPES
+        };
+
         RenderContext() : task::JobContext() {}
         virtual ~RenderContext() {}
 
         RenderArgs* args;
         ScenePointer _scene;
+
+        // The time taken by the fetch, cull and sort jobs of all of the views since EngineStats last ran, in ms
+        std::array<double, NUM_CPU_JOB_TYPES> _cpuJobRunTimes {{ 0.0, 0.0, 0.0 }};
     };
     using RenderContextPointer = std::shared_ptr<RenderContext>;
 
+    // Adds the time between its construction and destruction to the run time of a type of job
+    class CPUJobTimer {
+    public:
+        CPUJobTimer(const RenderContextPointer& renderContext, RenderContext::CPUJobType type) :
+            _runTime(renderContext->_cpuJobRunTimes[type]),
+            _startTime(std::chrono::high_resolution_clock::now()) {}
+        ~CPUJobTimer() {
+            _runTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - _startTime).count();
+        }
+
+    private:
+        double& _runTime;
+        std::chrono::high_resolution_clock::time_point _startTime;
+    };
+
     Task_DeclareCategoryTimeProfilerClass(RenderTimeProfiler, trace_render);
 
     Task_DeclareTypeAliases(RenderContext, RenderTimeProfiler)
@@ -64,5 +64,13 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    // The other jobs of the engine run after this one, so these are the times of the previous frame
+    auto& cpuJobRunTimes = renderContext->_cpuJobRunTimes;
+    config->frameFetchCPURunTime = cpuJobRunTimes[RenderContext::FETCH_JOB];
+    config->frameCullCPURunTime = cpuJobRunTimes[RenderContext::CULL_JOB];
+    config->frameSortCPURunTime = cpuJobRunTimes[RenderContext::SORT_JOB];
+    cpuJobRunTimes.fill(0.0);
+    config->workerThreadCount = renderContext->workerPool ? renderContext->workerPool->getNumThreads() : 1;
+
     // These new stat values are notified with the "newStats" signal triggered by the timer
 }
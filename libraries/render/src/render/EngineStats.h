@@ -61,6 +61,11 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY newStats)
 
+        Q_PROPERTY(double frameFetchCPURunTime MEMBER frameFetchCPURunTime NOTIFY newStats)
+        Q_PROPERTY(double frameCullCPURunTime MEMBER frameCullCPURunTime NOTIFY newStats)
+        Q_PROPERTY(double frameSortCPURunTime MEMBER frameSortCPURunTime NOTIFY newStats)
+        Q_PROPERTY(quint32 workerThreadCount MEMBER workerThreadCount NOTIFY newStats)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -101,6 +106,12 @@ namespace render {
         quint32 frameSetPipelineCount{ 0 };
 
         quint32 frameSetInputFormatCount{ 0 };
+
+        // ms, summed over all of the views of the last frame
+        double frameFetchCPURunTime { 0.0 };
+        double frameCullCPURunTime { 0.0 };
+        double frameSortCPURunTime { 0.0 };
+        quint32 workerThreadCount { 1 };
     };
 
     class EngineStats {
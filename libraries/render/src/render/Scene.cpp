@@ -10,14 +10,22 @@
 //
 #include "Scene.h"
 
+#include <iterator>
+#include <limits>
 #include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
 
 using namespace render;
 
+// The number of item changes applied between checks of the time budget
+static const size_t ITEM_CHANGES_PER_BUDGET_CHECK = 64;
+
 void Transaction::resetItem(ItemID id, const PayloadPointer& payload) {
     if (payload) {
         _resetItems.emplace_back(Reset{ id, payload });
@@ -166,6 +174,79 @@ void Transaction::merge(const Transaction& transaction) {
     copyElements(_highlightQueries, transaction._highlightQueries);
 }
 
+size_t Transaction::coalesce() {
+    size_t numChanges = getNumItemChanges();
+
+    // Each remove once
+    std::unordered_set<ItemID> removedIDs;
+    removedIDs.reserve(_removedItems.size());
+    size_t numRemoves = 0;
+    for (auto removedID : _removedItems) {
+        if (removedIDs.insert(removedID).second) {
+            _removedItems[numRemoves++] = removedID;
+        }
+    }
+    _removedItems.erase(_removedItems.begin() + numRemoves, _removedItems.end());
+
+    // The last reset of each item that isn't removed
+    std::unordered_map<ItemID, size_t> lastResets;
+    lastResets.reserve(_resetItems.size());
+    for (size_t i = 0; i < _resetItems.size(); i++) {
+        lastResets[std::get<0>(_resetItems[i])] = i;
+    }
+    size_t numResets = 0;
+    for (size_t i = 0; i < _resetItems.size(); i++) {
+        auto itemID = std::get<0>(_resetItems[i]);
+        if (lastResets[itemID] == i && removedIDs.count(itemID) == 0) {
+            if (numResets != i) {
+                _resetItems[numResets] = std::move(_resetItems[i]);
+            }
+            numResets++;
+        }
+    }
+    _resetItems.erase(_resetItems.begin() + numResets, _resetItems.end());
+
+    // The updates of each item that isn't removed, grouped in the order the items were first updated
+    struct UpdateGroup {
+        size_t numFunctors { 0 };
+        size_t begin { 0 };
+        size_t end { 0 };
+    };
+    std::unordered_map<ItemID, size_t> updateGroupIndices;
+    std::vector<UpdateGroup> updateGroups;
+    for (const auto& update : _updatedItems) {
+        auto itemID = std::get<0>(update);
+        if (removedIDs.count(itemID) == 0) {
+            auto found = updateGroupIndices.emplace(itemID, updateGroups.size());
+            if (found.second) {
+                updateGroups.emplace_back();
+            }
+            if (std::get<1>(update)) {
+                updateGroups[found.first->second].numFunctors++;
+            }
+        }
+    }
+    size_t numUpdates = 0;
+    for (auto& group : updateGroups) {
+        group.begin = group.end = numUpdates;
+        numUpdates += std::max(group.numFunctors, (size_t)1);
+    }
+    Updates updates(numUpdates);
+    for (auto& update : _updatedItems) {
+        auto found = updateGroupIndices.find(std::get<0>(update));
+        if (found != updateGroupIndices.end()) {
+            auto& group = updateGroups[found->second];
+            // The updates without a functor are only kept, once, for an item without any others
+            if (std::get<1>(update) || (group.numFunctors == 0 && group.end == group.begin)) {
+                updates[group.end++] = std::move(update);
+            }
+        }
+    }
+    _updatedItems.swap(updates);
+
+    return numChanges - getNumItemChanges();
+}
+
 void Transaction::clear() {
     _resetItems.clear();
     _removedItems.clear();
@@ -189,6 +270,13 @@ Scene::Scene(glm::vec3 origin, float size) :
 
 Scene::~Scene() {
     qCDebug(renderlogging) << "Scene::~Scene()";
+
+    auto queuedTransaction = _queuedTransactions.exchange(nullptr);
+    while (queuedTransaction) {
+        auto next = queuedTransaction->next;
+        delete queuedTransaction;
+        queuedTransaction = next;
+    }
 }
 
 ItemID Scene::allocateID() {
@@ -202,54 +290,99 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    pushTransaction(new QueuedTransaction { transaction });
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    pushTransaction(new QueuedTransaction { std::move(transaction) });
+}
+
+void Scene::pushTransaction(QueuedTransaction* queuedTransaction) {
+    // counted before it can be taken, so that enqueueFrame never takes away more than has been counted
+    _numQueuedTransactions++;
+    queuedTransaction->next = _queuedTransactions.load(std::memory_order_relaxed);
+    while (!_queuedTransactions.compare_exchange_weak(queuedTransaction->next, queuedTransaction,
+                                                     std::memory_order_release, std::memory_order_relaxed)) {
+    }
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
-    TransactionQueue localTransactionQueue;
-    {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
+
+    // Take the whole stack, and put it back in the order the transactions were queued in
+    auto queuedTransaction = _queuedTransactions.exchange(nullptr, std::memory_order_acquire);
+    size_t numTransactions = 0;
+    for (auto node = queuedTransaction; node; node = node->next) {
+        numTransactions++;
+    }
+    _numQueuedTransactions -= numTransactions;
+
+    TransactionQueue localTransactionQueue(numTransactions);
+    for (size_t i = numTransactions; i > 0; i--) {
+        localTransactionQueue[i - 1] = std::move(queuedTransaction->transaction);
+        auto next = queuedTransaction->next;
+        delete queuedTransaction;
+        queuedTransaction = next;
     }
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
+    _numCoalescedChanges += (uint32_t)consolidatedTransaction.coalesce();
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(consolidatedTransaction));
     }
 
     return ++_transactionFrameNumber;
 }
 
  
-void Scene::processTransactionQueue() {
+void Scene::processTransactionQueue(std::chrono::microseconds budget) {
     PROFILE_RANGE(render, __FUNCTION__);
+    uint64_t startTime = usecTimestampNow();
+    uint64_t deadline = budget.count() > 0 ? startTime + budget.count() : std::numeric_limits<uint64_t>::max();
 
-    static TransactionFrames queuedFrames;
     {
         // capture the queued frames and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        queuedFrames.swap(_transactionFrames);
+        std::move(_transactionFrames.begin(), _transactionFrames.end(), std::back_inserter(_pendingFrames));
+        _transactionFrames.clear();
     }
 
-    // go through the queue of frames and process them
-    for (auto& frame : queuedFrames) {
-        processTransactionFrame(frame);
+    // go through the queue of frames and process them, in order
+    size_t numAppliedChanges = 0;
+    while (!_pendingFrames.empty()) {
+        const auto& frame = _pendingFrames.front();
+        size_t numChanges = processTransactionFrame(frame, _numFrontFrameChangesApplied, deadline);
+        numAppliedChanges += numChanges;
+        _numFrontFrameChangesApplied += numChanges;
+        if (_numFrontFrameChangesApplied < frame.getNumItemChanges()) {
+            break;
+        }
+
+        _pendingFrames.pop_front();
+        _numFrontFrameChangesApplied = 0;
+        if (usecTimestampNow() >= deadline) {
+            break;
+        }
     }
 
-    queuedFrames.clear();
+    size_t numPendingChanges = 0;
+    for (const auto& frame : _pendingFrames) {
+        numPendingChanges += frame.getNumItemChanges();
+    }
+    _transactionStats.numAppliedChanges = (uint32_t)numAppliedChanges;
+    _transactionStats.numPendingChanges = (uint32_t)(numPendingChanges - _numFrontFrameChangesApplied);
+    _transactionStats.numCoalescedChanges = _numCoalescedChanges.exchange(0);
+    _transactionStats.applyTime = usecTimestampNow() - startTime;
 }
 
-void Scene::processTransactionFrame(const Transaction& transaction) {
+size_t Scene::processTransactionFrame(const Transaction& transaction, size_t firstChange, uint64_t deadline) {
     PROFILE_RANGE(render, __FUNCTION__);
+    const size_t numResets = transaction._resetItems.size();
+    const size_t numUpdates = transaction._updatedItems.size();
+    const size_t numChanges = transaction.getNumItemChanges();
+    size_t change = firstChange;
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
         // Here we should be able to check the value of last ItemID allocated 
@@ -261,37 +394,51 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the transaction
 
-        // resets and potential NEW items
-        resetItems(transaction._resetItems);
+        // resets and potential NEW items, then updates, then removes, a chunk at a time until the deadline
+        while (change < numChanges) {
+            size_t chunkEnd = std::min(change + ITEM_CHANGES_PER_BUDGET_CHECK, numChanges);
+            if (change < numResets) {
+                chunkEnd = std::min(chunkEnd, numResets);
+                resetItems(transaction._resetItems, change, chunkEnd);
+            } else if (change < numResets + numUpdates) {
+                chunkEnd = std::min(chunkEnd, numResets + numUpdates);
+                updateItems(transaction._updatedItems, change - numResets, chunkEnd - numResets);
+            } else {
+                removeItems(transaction._removedItems, change - numResets - numUpdates, chunkEnd - numResets - numUpdates);
+            }
+            change = chunkEnd;
 
-        // Update the numItemsAtomic counter AFTER the reset changes went through
-        _numAllocatedItems.exchange(maxID);
+            if (usecTimestampNow() >= deadline) {
+                break;
+            }
+        }
 
-        // updates
-        updateItems(transaction._updatedItems);
+        if (change == numChanges) {
+            // Update the numItemsAtomic counter AFTER all the reset changes of the frame went through
+            _numAllocatedItems.exchange(maxID);
 
-        // removes
-        removeItems(transaction._removedItems);
+            // add transitions
+            resetTransitionItems(transaction._resetTransitions);
+            removeTransitionItems(transaction._removeTransitions);
+            queryTransitionItems(transaction._queriedTransitions);
+            resetTransitionFinishedOperator(transaction._transitionFinishedOperators);
+        }
+    }
 
-        // add transitions
-        resetTransitionItems(transaction._resetTransitions);
-        removeTransitionItems(transaction._removeTransitions);
-        queryTransitionItems(transaction._queriedTransitions);
-        resetTransitionFinishedOperator(transaction._transitionFinishedOperators);
+    if (change == numChanges) {
+        resetSelections(transaction._resetSelections);
 
-        // Update the numItemsAtomic counter AFTER the pending changes went through
-        _numAllocatedItems.exchange(maxID);
+        resetHighlights(transaction._highlightResets);
+        removeHighlights(transaction._highlightRemoves);
+        queryHighlights(transaction._highlightQueries);
     }
 
-    resetSelections(transaction._resetSelections);
-
-    resetHighlights(transaction._highlightResets);
-    removeHighlights(transaction._highlightRemoves);
-    queryHighlights(transaction._highlightQueries);
+    return change - firstChange;
 }
 
-void Scene::resetItems(const Transaction::Resets& transactions) {
-    for (auto& reset : transactions) {
+void Scene::resetItems(const Transaction::Resets& transactions, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const auto& reset = transactions[i];
         // Access the true item
         auto itemId = std::get<0>(reset);
         auto& item = _items[itemId];
@@ -313,8 +460,9 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
     }
 }
 
-void Scene::removeItems(const Transaction::Removes& transactions) {
-    for (auto removedID : transactions) {
+void Scene::removeItems(const Transaction::Removes& transactions, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        auto removedID = transactions[i];
         // Access the true item
         auto& item = _items[removedID];
         auto oldCell = item.getCell();
@@ -335,9 +483,14 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
     }
 }
 
-void Scene::updateItems(const Transaction::Updates& transactions) {
-    for (auto& update : transactions) {
-        auto updateID = std::get<0>(update);
+void Scene::updateItems(const Transaction::Updates& transactions, size_t begin, size_t end) {
+    for (size_t i = begin; i < end;) {
+        // The updates of an item are next to each other once coalesced, its container is updated once for all of them
+        auto updateID = std::get<0>(transactions[i]);
+        size_t firstUpdate = i;
+        for (i++; i < end && std::get<0>(transactions[i]) == updateID; i++) {
+        }
+
         if (updateID == Item::INVALID_ITEM_ID) {
             continue;
         }
@@ -355,7 +508,9 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
         auto oldKey = item.getKey();
 
         // Update the item
-        item.update(std::get<1>(update));
+        for (size_t j = firstUpdate; j < i; j++) {
+            item.update(std::get<1>(transactions[j]));
+        }
         auto newKey = item.getKey();
 
         // Update the item's container
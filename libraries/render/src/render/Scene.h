@@ -12,6 +12,9 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <chrono>
+#include <deque>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -76,6 +79,14 @@ public:
     void merge(Transaction&& transaction);
     void clear();
 
+    // Drops the item resets, updates and removes made redundant by others in the transaction, and groups the updates
+    // of an item together, returns the number of changes dropped.
+    // Only the last reset of an item counts, and none of the resets and updates of an item that is removed,
+    // since removes are applied after them.  Updates without a functor only refresh an item, which its other updates do too.
+    size_t coalesce();
+
+    size_t getNumItemChanges() const { return _resetItems.size() + _updatedItems.size() + _removedItems.size(); }
+
 protected:
 
     using Reset = std::tuple<ItemID, PayloadPointer>;
@@ -147,16 +158,28 @@ public:
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
     // Enqueue transaction to the scene
+    // These calls are lock free, and can be made from any number of threads
     void enqueueTransaction(const Transaction& transaction);
 
     // Enqueue transaction to the scene
     void enqueueTransaction(Transaction&& transaction);
 
     // Enqueue end of frame transactions boundary
+    // The transactions of the frame are merged and coalesced here, rather than on the thread that applies them
     uint32_t enqueueFrame();
 
     // Process the pending transactions queued
-    void processTransactionQueue();
+    // With a budget, stops applying item changes once the budget is spent and carries on from there on the next call,
+    // so that a flood of changes is spread over several frames.  The frames are still applied in order.
+    void processTransactionQueue(std::chrono::microseconds budget = std::chrono::microseconds(0));
+
+    struct TransactionStats {
+        uint32_t numAppliedChanges { 0 }; // item changes applied by the last processTransactionQueue
+        uint32_t numPendingChanges { 0 }; // item changes it left for the next one
+        uint32_t numCoalescedChanges { 0 }; // item changes dropped as redundant from the frames it took in
+        uint64_t applyTime { 0 }; // usecs
+    };
+    const TransactionStats& getTransactionStats() const { return _transactionStats; }
 
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
@@ -194,24 +217,37 @@ public:
     void setItemTransition(ItemID id, Index transitionId);
     void removeItemTransition(ItemID id);
 
-    size_t getTransactionQueueSize() { return _transactionQueue.size(); }
+    size_t getTransactionQueueSize() { return _numQueuedTransactions.load(); }
 
 protected:
 
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
 
-    
+    // The transactions queued since the last frame, as a stack that the producers push onto and enqueueFrame takes whole
+    struct QueuedTransaction {
+        Transaction transaction;
+        QueuedTransaction* next { nullptr };
+    };
+    std::atomic<QueuedTransaction*> _queuedTransactions { nullptr };
+    std::atomic<size_t> _numQueuedTransactions { 0 };
+    void pushTransaction(QueuedTransaction* queuedTransaction);
+
     std::mutex _transactionFramesMutex;
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
     uint32_t _transactionFrameNumber{ 0 };
+    std::atomic<uint32_t> _numCoalescedChanges { 0 };
+
+    // The frames taken in by processTransactionQueue, the first of which may have been partly applied
+    std::deque<Transaction> _pendingFrames;
+    size_t _numFrontFrameChangesApplied { 0 };
+    TransactionStats _transactionStats;
 
-    // Process one transaction frame 
-    void processTransactionFrame(const Transaction& transaction);
+    // Process one transaction frame, starting at its firstChange-th item change, returns the number of its item changes
+    // applied, which is less than all of them if the deadline has passed
+    size_t processTransactionFrame(const Transaction& transaction, size_t firstChange, uint64_t deadline);
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -220,10 +256,10 @@ protected:
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
-    void resetItems(const Transaction::Resets& transactions);
+    void resetItems(const Transaction::Resets& transactions, size_t begin, size_t end);
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
-    void removeItems(const Transaction::Removes& transactions);
-    void updateItems(const Transaction::Updates& transactions);
+    void removeItems(const Transaction::Removes& transactions, size_t begin, size_t end);
+    void updateItems(const Transaction::Updates& transactions, size_t begin, size_t end);
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
@@ -10,12 +10,23 @@
 //
 #include "SceneTask.h"
 
+#include <NumericalConstants.h>
+
 
 using namespace render;
 
 void PerformSceneTransaction::configure(const Config& config) {
+    _budget = std::chrono::microseconds((int64_t)(std::max(config.maxApplyTime, 0.0f) * USECS_PER_MSEC));
 }
 
 void PerformSceneTransaction::run(const RenderContextPointer& renderContext) {
-    renderContext->_scene->processTransactionQueue();
+    auto& scene = renderContext->_scene;
+    scene->processTransactionQueue(_budget);
+
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    const auto& stats = scene->getTransactionStats();
+    config->numAppliedChanges = stats.numAppliedChanges;
+    config->numPendingChanges = stats.numPendingChanges;
+    config->numCoalescedChanges = stats.numCoalescedChanges;
+    config->applyTime = (double)stats.applyTime / USECS_PER_MSEC;
 }
@@ -18,7 +18,22 @@ namespace render {
 
     class PerformSceneTransactionConfig : public Job::Config {
         Q_OBJECT
+        Q_PROPERTY(float maxApplyTime MEMBER maxApplyTime NOTIFY dirty)
+
+        Q_PROPERTY(quint32 numAppliedChanges MEMBER numAppliedChanges NOTIFY newStats)
+        Q_PROPERTY(quint32 numPendingChanges MEMBER numPendingChanges NOTIFY newStats)
+        Q_PROPERTY(quint32 numCoalescedChanges MEMBER numCoalescedChanges NOTIFY newStats)
+        Q_PROPERTY(double applyTime MEMBER applyTime NOTIFY newStats)
     public:
+        // ms the item changes of the scene transactions may take per frame, the rest are applied on the next frames,
+        // no limit if 0
+        float maxApplyTime { 4.0f };
+
+        quint32 numAppliedChanges { 0 };
+        quint32 numPendingChanges { 0 };
+        quint32 numCoalescedChanges { 0 };
+        double applyTime { 0.0 }; // ms
+
     signals:
         void dirty();
 
@@ -33,6 +48,7 @@ namespace render {
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext);
     protected:
+        std::chrono::microseconds _budget { 0 };
     };
 
 
@@ -12,11 +12,15 @@
 #include "SortTask.h"
 #include "ShapePipeline.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
+// The number of items sorted at a time on a worker thread
+static const size_t SORT_GRAIN_SIZE = 1024;
+
 struct ItemBoundSort {
     float _centerDepth = 0.0f;
     float _nearDepth = 0.0f;
@@ -29,23 +33,45 @@ struct ItemBoundSort {
 };
 
 struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
         return (left._centerDepth < right._centerDepth);
     }
 };
 
 struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
         return (left._centerDepth > right._centerDepth);
     }
 };
 
+// Sorts the ranges of the items on the worker pool, then merges them pairwise a level at a time
+template <class Compare>
+static void parallelSort(const RenderContextPointer& renderContext, std::vector<ItemBoundSort>& items, Compare compare) {
+    size_t numItems = items.size();
+    renderContext->parallelFor(numItems, SORT_GRAIN_SIZE, [&](size_t, size_t begin, size_t end) {
+        std::sort(items.begin() + begin, items.begin() + end, compare);
+    });
+
+    for (size_t width = SORT_GRAIN_SIZE; width < numItems; width *= 2) {
+        size_t numMerges = (numItems + 2 * width - 1) / (2 * width);
+        renderContext->parallelFor(numMerges, 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                size_t first = i * 2 * width;
+                size_t middle = std::min(first + width, numItems);
+                size_t last = std::min(first + 2 * width, numItems);
+                if (middle < last) {
+                    std::inplace_merge(items.begin() + first, items.begin() + middle, items.begin() + last, compare);
+                }
+            }
+        });
+    }
+}
+
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
 
@@ -55,24 +81,21 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
 
 
     // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
-    }
+    const auto& frustum = args->getViewFrustum();
+    std::vector<ItemBoundSort> itemBoundSorts(inItems.size());
+    renderContext->parallelFor(inItems.size(), SORT_GRAIN_SIZE, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const auto& bound = inItems[i].bound;
+            float distanceSquared = frustum.distanceToCameraSquared(bound.calcCenter());
+            itemBoundSorts[i] = ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, inItems[i].id, bound);
+        }
+    });
 
     // sort against Z
     if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
+        parallelSort(renderContext, itemBoundSorts, FrontToBackSort());
     } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+        parallelSort(renderContext, itemBoundSorts, BackToFrontSort());
     }
 
     // Finally once sorted result to a list of itemID and keep uniques
@@ -99,6 +122,7 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
 }
 
 void PipelineSortShapes::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes) {
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::SORT_JOB);
     auto& scene = renderContext->_scene;
     outShapes.clear();
 
@@ -120,6 +144,7 @@ void PipelineSortShapes::run(const RenderContextPointer& renderContext, const It
 }
 
 void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::SORT_JOB);
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
@@ -135,6 +160,7 @@ void DepthSortShapes::run(const RenderContextPointer& renderContext, const Shape
 }
 
 void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, Outputs& outputs) {
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::SORT_JOB);
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
@@ -156,5 +182,6 @@ void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderCont
 }
 
 void DepthSortItems::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
+    CPUJobTimer cpuJobTimer(renderContext, RenderContext::SORT_JOB);
     depthSortItems(renderContext, _frontToBack, inItems, outItems);
 }
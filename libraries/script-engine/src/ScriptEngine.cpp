@@ -2264,6 +2264,13 @@ QFuture<QVariant> ScriptEngine::getLocalEntityScriptDetails(const EntityItemID&
     return QtConcurrent::run(this, &ScriptEngine::cloneEntityScriptDetails, entityID);
 }
 
+QHash<EntityItemID, quint64> ScriptEngine::takeEntityScriptRunTimes() {
+    QHash<EntityItemID, quint64> runTimes;
+    QMutexLocker locker(&_entityScriptRunTimesLock);
+    runTimes.swap(_entityScriptRunTimes);
+    return runTimes;
+}
+
 bool ScriptEngine::getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const {
     QReadLocker locker { &_entityScriptsLock };
     auto it = _entityScripts.constFind(entityID);
@@ -2690,6 +2697,9 @@ void ScriptEngine::refreshFileScript(const EntityItemID& entityID) {
 // global values for different entity scripts).
 void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, std::function<void()> operation) {
     EntityItemID oldIdentifier = currentEntityIdentifier;
+    // the entity script server accounts the time of each outermost call to the entity script that made it
+    bool isTimed = _context == ENTITY_SERVER_SCRIPT && !entityID.isNull() && oldIdentifier.isNull();
+    quint64 startTime = isTimed ? usecTimestampNow() : 0;
     QUrl oldSandboxURL;
     if (currentSandboxURL.isValid()) oldSandboxURL = currentSandboxURL;
     currentEntityIdentifier = entityID;
@@ -2706,6 +2716,12 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+
+    if (isTimed) {
+        quint64 runTime = usecTimestampNow() - startTime;
+        QMutexLocker locker(&_entityScriptRunTimesLock);
+        _entityScriptRunTimes[entityID] += runTime;
+    }
 }
 
 void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
@@ -15,6 +15,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -678,6 +679,9 @@ public:
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
+    // the time, in usecs, that each entity script of an entity server script engine has spent running since the last call
+    QHash<EntityItemID, quint64> takeEntityScriptRunTimes();
+
     void setScriptEngines(QSharedPointer<ScriptEngines>& scriptEngines) { _scriptEngines = scriptEngines; }
 
 public slots:
@@ -946,6 +950,8 @@ protected:
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
+    QMutex _entityScriptRunTimesLock;
+    QHash<EntityItemID, quint64> _entityScriptRunTimes;
     EntityScriptContentAvailableMap _contentAvailableQueue;
 
     bool _isThreaded { false };
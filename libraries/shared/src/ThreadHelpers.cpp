@@ -8,7 +8,10 @@
 
 #include "ThreadHelpers.h"
 
+#include <algorithm>
+
 #include <QtCore/QDebug>
+#include <QtCore/QThreadPool>
 
 // Support for viewing the thread name in the debugger.  
 // Note, Qt actually does this for you but only in debug builds
@@ -78,3 +81,17 @@ void moveToNewNamedThread(QObject* object, const QString& name, std::function<vo
 void moveToNewNamedThread(QObject* object, const QString& name, QThread::Priority priority) {
     moveToNewNamedThread(object, name, [](QThread*){}, []{}, priority);
 }
+
+int getWorkerPoolThreadCount() {
+    return std::min(std::max(QThread::idealThreadCount() / 2, 1), MAX_WORKER_POOL_THREADS);
+}
+
+QThreadPool* getMainThreadWorkerPool() {
+    // kept to the end of the process, like the global pool
+    static QThreadPool* pool = [] {
+        auto pool = new QThreadPool();
+        pool->setMaxThreadCount(getWorkerPoolThreadCount());
+        return pool;
+    }();
+    return pool;
+}
@@ -21,6 +21,8 @@
 #include <QtCore/QString>
 #include <QtCore/QThread>
 
+class QThreadPool;
+
 template <typename L, typename F>
 void withLock(L lock, F function) {
     throw std::exception();
@@ -44,6 +46,14 @@ void moveToNewNamedThread(QObject* object, const QString& name,
 void moveToNewNamedThread(QObject* object, const QString& name, 
     QThread::Priority priority = QThread::InheritPriority);
 
+// The pools of worker threads that systems spread their work over get half the cores, leaving the rest to the main,
+// render and network threads, and no more than MAX_WORKER_POOL_THREADS each, as several of them are busy at once.
+const int MAX_WORKER_POOL_THREADS = 4;
+int getWorkerPoolThreadCount();
+
+// The worker pool of the main thread's per frame work, which it waits for one system after the other
+QThreadPool* getMainThreadWorkerPool();
+
 class ConditionalGuard {
 public:
     void trigger() {
@@ -0,0 +1,98 @@
+//
+//  FrameBarrier.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Shared_FrameBarrier_h
+#define hifi_Shared_FrameBarrier_h
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Start/finish barrier between a pool thread and its workers, run once per frame.
+//
+// Both sides spin on atomics for a short while before falling back to a condition variable, so a busy pool
+// never touches the mutex, while an idle pool does not burn CPU between frames.
+// The sleeping counters and the frame/finished counters are all sequentially consistent, which guarantees
+// that a waker either sees a sleeper and notifies it, or the sleeper sees the new state before waiting.
+class FrameBarrier {
+public:
+    static const int SPIN_ITERATIONS = 1000;
+
+    // pool side: release the workers into a new frame
+    void start(int numWorkers) {
+        _numWorkers = numWorkers;
+        _numFinished = 0;
+        ++_frame;
+
+        if (_numSleepingWorkers > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _workerCondition.notify_all();
+        }
+    }
+
+    // pool side: block until every worker released by start has called finish
+    void wait() {
+        for (int i = 0; i < SPIN_ITERATIONS; ++i) {
+            if (_numFinished == _numWorkers) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _isPoolSleeping = true;
+        _poolCondition.wait(lock, [&] { return _numFinished == _numWorkers; });
+        _isPoolSleeping = false;
+    }
+
+    // worker side: block until a frame other than lastFrame starts, and return it
+    uint32_t waitForFrame(uint32_t lastFrame) {
+        for (int i = 0; i < SPIN_ITERATIONS; ++i) {
+            uint32_t frame = _frame;
+            if (frame != lastFrame) {
+                return frame;
+            }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        ++_numSleepingWorkers;
+        _workerCondition.wait(lock, [&] { return _frame != lastFrame; });
+        --_numSleepingWorkers;
+        return _frame;
+    }
+
+    // worker side: signal that this worker is done with the current frame
+    void finish() {
+        if (++_numFinished == _numWorkers && _isPoolSleeping) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _poolCondition.notify_one();
+        }
+    }
+
+    uint32_t getFrame() const { return _frame; }
+
+private:
+    std::atomic<uint32_t> _frame { 0 };
+    std::atomic<int> _numWorkers { 0 };
+    std::atomic<int> _numFinished { 0 };
+
+    std::atomic<int> _numSleepingWorkers { 0 };
+    std::atomic<bool> _isPoolSleeping { false };
+
+    std::mutex _mutex;
+    std::condition_variable _workerCondition;
+    std::condition_variable _poolCondition;
+};
+
+#endif // hifi_Shared_FrameBarrier_h
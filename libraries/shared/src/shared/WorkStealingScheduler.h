@@ -0,0 +1,130 @@
+//
+//  WorkStealingScheduler.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Shared_WorkStealingScheduler_h
+#define hifi_Shared_WorkStealingScheduler_h
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Lock-free distribution of a frame's work items, given as indices, over a fixed set of workers.
+//
+// reset() splits [0, numItems) into one contiguous chunk per worker so that every chunk has roughly the same
+// estimated cost. Workers take items from the front of their own chunk, and once it is empty they steal half
+// of the remaining items from the back of another worker's chunk.
+//
+// reset() must not run concurrently with next(); next() is thread-safe.
+class WorkStealingScheduler {
+public:
+    void reset(int numWorkers, const std::vector<uint64_t>& costs) {
+        if (numWorkers != _numWorkers) {
+            _ranges.reset(new Range[std::max(numWorkers, 1)]);
+            _numWorkers = numWorkers;
+        }
+        _numSteals = 0;
+
+        uint64_t totalCost = 0;
+        for (auto cost : costs) {
+            totalCost += cost;
+        }
+
+        // worker w takes the items whose cumulative cost falls in its share of the total
+        uint32_t numItems = (uint32_t)costs.size();
+        uint32_t first = 0;
+        uint64_t cumulativeCost = 0;
+        for (int worker = 0; worker < _numWorkers; ++worker) {
+            uint32_t last = first;
+            if (worker == _numWorkers - 1) {
+                last = numItems;
+            } else {
+                uint64_t targetCost = (totalCost * (worker + 1)) / _numWorkers;
+                // an item belongs to this worker if its midpoint falls within the worker's share
+                while (last < numItems && 2 * cumulativeCost + costs[last] <= 2 * targetCost) {
+                    cumulativeCost += costs[last];
+                    ++last;
+                }
+            }
+            _ranges[worker].bounds = pack(first, last);
+            first = last;
+        }
+    }
+
+    // get the next item for this worker, returns false once no work is left for the frame
+    bool next(int worker, uint32_t& index) {
+        if (popFront(_ranges[worker], index)) {
+            return true;
+        }
+
+        // start with the neighbour, so that thieves spread over the victims
+        for (int i = 1; i < _numWorkers; ++i) {
+            Range& victim = _ranges[(worker + i) % _numWorkers];
+            uint32_t stolenFirst, stolenLast;
+            if (stealBack(victim, stolenFirst, stolenLast)) {
+                ++_numSteals;
+
+                // the first stolen item is returned, the rest become our own chunk (which others may steal in turn)
+                index = stolenFirst;
+                _ranges[worker].bounds = pack(stolenFirst + 1, stolenLast);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    int getNumSteals() const { return _numSteals; }
+
+private:
+    // padded so that workers popping from their own ranges do not share cache lines
+    static const int CACHE_LINE_SIZE = 64;
+    struct Range {
+        std::atomic<uint64_t> bounds { 0 };
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+    };
+
+    static uint64_t pack(uint32_t first, uint32_t last) { return ((uint64_t)first << 32) | last; }
+    static uint32_t getFirst(uint64_t bounds) { return (uint32_t)(bounds >> 32); }
+    static uint32_t getLast(uint64_t bounds) { return (uint32_t)bounds; }
+
+    static bool popFront(Range& range, uint32_t& index) {
+        uint64_t bounds = range.bounds;
+        while (getFirst(bounds) < getLast(bounds)) {
+            if (range.bounds.compare_exchange_weak(bounds, pack(getFirst(bounds) + 1, getLast(bounds)))) {
+                index = getFirst(bounds);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool stealBack(Range& range, uint32_t& stolenFirst, uint32_t& stolenLast) {
+        uint64_t bounds = range.bounds;
+        while (getFirst(bounds) < getLast(bounds)) {
+            uint32_t remaining = getLast(bounds) - getFirst(bounds);
+            uint32_t split = getLast(bounds) - std::max(remaining / 2, 1u);
+            if (range.bounds.compare_exchange_weak(bounds, pack(getFirst(bounds), split))) {
+                stolenFirst = split;
+                stolenLast = getLast(bounds);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::unique_ptr<Range[]> _ranges;
+    int _numWorkers { 0 };
+    std::atomic<int> _numSteals { 0 };
+};
+
+#endif // hifi_Shared_WorkStealingScheduler_h
@@ -10,6 +10,8 @@
 //
 #include "Task.h"
 
+#include <algorithm>
+
 using namespace task;
 
 JobContext::JobContext() {
@@ -18,6 +20,20 @@ JobContext::JobContext() {
 JobContext::~JobContext() {
 }
 
+void JobContext::parallelFor(size_t count, size_t grainSize, const WorkerPool::RangeFunction& function) const {
+    if (workerPool) {
+        workerPool->parallelFor(count, grainSize, function);
+        return;
+    }
+
+    grainSize = std::max(grainSize, (size_t)1);
+    size_t numRanges = WorkerPool::getNumRanges(count, grainSize);
+    for (size_t range = 0; range < numRanges; range++) {
+        size_t begin = range * grainSize;
+        function(range, begin, std::min(begin + grainSize, count));
+    }
+}
+
 void TaskFlow::reset() {
     _doAbortTask = false;
 }
@@ -14,6 +14,7 @@
 
 #include "Config.h"
 #include "Varying.h"
+#include "WorkerPool.h"
 
 #include <unordered_map>
 
@@ -49,6 +50,7 @@ protected:
 // It specifically provide access to:
 // - The taskFlow object allowing for messaging control flow commands from within a Job::run
 // - The current Config object attached to the Job::run currently called.
+// - The worker pool a Job::run can spread its data-parallel work over.
 // The JobContext can be derived to add more global state to it that Jobs can access
 class JobContext {
 public:
@@ -60,6 +62,12 @@ public:
     // Task flow control
     TaskFlow taskFlow{};
 
+    // Worker threads for data-parallel jobs, the loops run on the calling thread alone without it
+    WorkerPoolPointer workerPool { nullptr };
+
+    // Runs function over [0, count) in ranges of grainSize, see WorkerPool::parallelFor
+    void parallelFor(size_t count, size_t grainSize, const WorkerPool::RangeFunction& function) const;
+
 protected:
 };
 using JobContextPointer = std::shared_ptr<JobContext>;
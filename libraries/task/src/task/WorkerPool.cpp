@@ -0,0 +1,121 @@
+//
+//  WorkerPool.cpp
+//  task/src/task
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <QtCore/QRunnable>
+
+#include <shared/WorkStealingScheduler.h>
+
+using namespace task;
+
+namespace {
+
+// The state of a loop shared by the threads running it, worker 0 being the thread that called parallelFor.
+// The threads that start after all of the ranges were taken only look at the scheduler, so the function is no longer
+// needed once parallelFor returns.
+class Loop {
+public:
+    Loop(size_t count, size_t grainSize, int numWorkers, const WorkerPool::RangeFunction& function) :
+        _count(count),
+        _grainSize(grainSize),
+        _numRanges(WorkerPool::getNumRanges(count, grainSize)),
+        _function(function) {
+        // the ranges are all the same size, but the last
+        _scheduler.reset(numWorkers, std::vector<uint64_t>(_numRanges, 1));
+    }
+
+    void runRanges(int worker) {
+        size_t numRangesRun = 0;
+        uint32_t range;
+        while (_scheduler.next(worker, range)) {
+            size_t begin = range * _grainSize;
+            _function(range, begin, std::min(begin + _grainSize, _count));
+            numRangesRun++;
+        }
+
+        if (numRangesRun > 0 && (_numRangesDone += numRangesRun) == _numRanges) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done.notify_all();
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _numRangesDone == _numRanges; });
+    }
+
+    size_t getNumRanges() const { return _numRanges; }
+
+private:
+    const size_t _count;
+    const size_t _grainSize;
+    const size_t _numRanges;
+    const WorkerPool::RangeFunction& _function;
+
+    WorkStealingScheduler _scheduler;
+    std::atomic<size_t> _numRangesDone { 0 };
+    std::mutex _mutex;
+    std::condition_variable _done;
+};
+
+class LoopRunner : public QRunnable {
+public:
+    LoopRunner(const std::shared_ptr<Loop>& loop, int worker) : _loop(loop), _worker(worker) {}
+
+    void run() override { _loop->runRanges(_worker); }
+
+private:
+    std::shared_ptr<Loop> _loop;
+    int _worker;
+};
+
+}
+
+WorkerPool::WorkerPool(int numThreads) {
+    _pool.setMaxThreadCount(std::max(numThreads, 1));
+}
+
+WorkerPool::~WorkerPool() {
+    _pool.waitForDone();
+}
+
+size_t WorkerPool::getNumRanges(size_t count, size_t grainSize) {
+    grainSize = std::max(grainSize, (size_t)1);
+    return (count + grainSize - 1) / grainSize;
+}
+
+void WorkerPool::parallelFor(size_t count, size_t grainSize, const RangeFunction& function) {
+    grainSize = std::max(grainSize, (size_t)1);
+    size_t numRanges = getNumRanges(count, grainSize);
+    if (numRanges == 0) {
+        return;
+    }
+    if (numRanges == 1) {
+        function(0, 0, count);
+        return;
+    }
+
+    int numRunners = (int)std::min(numRanges - 1, (size_t)_pool.maxThreadCount());
+    auto loop = std::make_shared<Loop>(count, grainSize, numRunners + 1, function);
+    for (int i = 0; i < numRunners; i++) {
+        _pool.start(new LoopRunner(loop, i + 1));
+    }
+
+    // the calling thread takes its share too, and steals the shares of runners that haven't started, so the loop
+    // gets done even if the pool's threads are busy
+    loop->runRanges(0);
+    loop->wait();
+}
@@ -0,0 +1,50 @@
+//
+//  WorkerPool.h
+//  task/src/task
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_task_WorkerPool_h
+#define hifi_task_WorkerPool_h
+
+#include <functional>
+#include <memory>
+
+#include <QtCore/QThreadPool>
+
+namespace task {
+
+// A pool of threads the jobs of a task graph can spread their data-parallel loops over.
+// A loop is cut into ranges which are dealt out to the pool's threads and the thread running the job by a
+// WorkStealingScheduler: each thread runs its own contiguous share, then steals from the others, so that a thread
+// that is done with cheap ranges, or one that started late, goes on to help with the rest.
+class WorkerPool {
+public:
+    // called with the index of the range, and the [begin, end) of the loop it covers
+    using RangeFunction = std::function<void(size_t rangeIndex, size_t begin, size_t end)>;
+
+    WorkerPool(int numThreads);
+    ~WorkerPool();
+
+    // the number of threads a loop runs on, counting the one running the job
+    int getNumThreads() const { return _pool.maxThreadCount() + 1; }
+
+    // the number of ranges a loop over count items is cut into, for jobs to size their per-range outputs
+    static size_t getNumRanges(size_t count, size_t grainSize);
+
+    // runs function over [0, count) in ranges of grainSize, returns once all of the ranges are done
+    void parallelFor(size_t count, size_t grainSize, const RangeFunction& function);
+
+private:
+    QThreadPool _pool;
+};
+
+using WorkerPoolPointer = std::shared_ptr<WorkerPool>;
+
+}
+
+#endif // hifi_task_WorkerPool_h
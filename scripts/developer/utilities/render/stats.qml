@@ -97,6 +97,32 @@ Item {
             ]
         }
 
+        PlotPerf {
+            title: "Fetch / Cull / Sort"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            valueUnit: "ms"
+            valueScale: 1
+            valueNumDigits: "2"
+            plots: [
+                {
+                    prop: "frameFetchCPURunTime",
+                    label: "Fetch",
+                    color: "#00B4EF"
+                },
+                {
+                    prop: "frameCullCPURunTime",
+                    label: "Cull",
+                    color: "#1AC567"
+                },
+                {
+                    prop: "frameSortCPURunTime",
+                    label: "Sort",
+                    color: "#FED959"
+                }
+            ]
+        }
+
         property var drawOpaqueConfig: Render.getConfig("RenderMainView.DrawOpaqueDeferred")
         property var drawTransparentConfig: Render.getConfig("RenderMainView.DrawTransparentDeferred")
         property var drawLightConfig: Render.getConfig("RenderMainView.DrawLight")
@@ -793,6 +793,8 @@ private:
             if (_cullingEnabled) {
                 _viewFrustum.calculate();
             }
+            _view.clear();
+            _view.push_back(_viewFrustum);
         }
 
         EntityUpdateOperator updateOperator(now);
@@ -808,6 +810,9 @@ private:
 
         getEntities()->update(false);
 
+        // the models' blendshapes are only started by the blender's update
+        DependencyManager::get<ModelBlender>()->update(_view);
+
         {
             PerformanceTimer perfTimer("SceneProcessTransaction");
             _main3DScene->processTransactionQueue();
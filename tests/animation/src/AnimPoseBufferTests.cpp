@@ -0,0 +1,358 @@
+//
+//  AnimPoseBufferTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <random>
+
+#include <AnimPoseBuffer.h>
+#include <AnimUtil.h>
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float TEST_EPSILON = 0.001f;
+const int NUM_BENCHMARK_JOINTS = 100;
+
+// a tree of short chains, like the limbs and fingers of an avatar, with the parents before their children
+static std::vector<int> makeParentIndices(int numJoints) {
+    std::vector<int> parentIndices(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        parentIndices[i] = (i == 0) ? -1 : ((i % 5 == 0) ? i / 5 : i - 1);
+    }
+    return parentIndices;
+}
+
+static AnimPoseVec makePoses(int numPoses, unsigned int seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    AnimPoseVec poses;
+    for (int i = 0; i < numPoses; i++) {
+        float scale = 1.0f + 0.2f * unit(random);
+        glm::quat rot = glm::normalize(glm::quat(unit(random), unit(random), unit(random), unit(random)));
+        glm::vec3 trans = 0.5f * glm::vec3(unit(random), unit(random), unit(random));
+        poses.push_back(AnimPose(glm::vec3(scale), rot, trans));
+    }
+    return poses;
+}
+
+// the absolute poses by AnimPose::operator*, in any order of the joints
+static AnimPoseVec buildAbsolutePoses(const std::vector<int>& parentIndices, const AnimPoseVec& relativePoses,
+                                      const AnimPose& rootPose) {
+    AnimPoseVec absolutePoses(relativePoses.size());
+    std::vector<bool> isBuilt(relativePoses.size(), false);
+    size_t numBuilt = 0;
+    while (numBuilt < relativePoses.size()) {
+        for (size_t i = 0; i < relativePoses.size(); i++) {
+            int parentIndex = parentIndices[i];
+            if (isBuilt[i] || (parentIndex >= 0 && !isBuilt[parentIndex])) {
+                continue;
+            }
+            const AnimPose& parentPose = parentIndex >= 0 ? absolutePoses[parentIndex] : rootPose;
+            absolutePoses[i] = parentPose * relativePoses[i];
+            isBuilt[i] = true;
+            numBuilt++;
+        }
+    }
+    return absolutePoses;
+}
+
+static void verifyPoses(const AnimPoseVec& actual, const AnimPoseVec& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        QVERIFY(glm::distance(actual[i].scale(), expected[i].scale()) < TEST_EPSILON);
+        QVERIFY(glm::dot(actual[i].rot(), expected[i].rot()) > 1.0f - TEST_EPSILON);
+        QVERIFY(glm::distance(actual[i].trans(), expected[i].trans()) < TEST_EPSILON);
+    }
+}
+
+void AnimPoseBufferTests::testLoadStore() {
+    // sizes around the padding
+    for (int numPoses : { 0, 1, 7, 8, 9, 100 }) {
+        AnimPoseVec poses = makePoses(numPoses, numPoses);
+        AnimPoseBuffer buffer;
+        buffer.load(poses);
+        QCOMPARE(buffer.size(), numPoses);
+        QVERIFY(buffer.getStride() > numPoses);
+        QCOMPARE(buffer.getStride() % AnimPoseBuffer::POSES_PER_BLOCK, 0);
+
+        AnimPoseVec stored;
+        buffer.store(stored);
+        verifyPoses(stored, poses);
+    }
+}
+
+void AnimPoseBufferTests::testBlend() {
+    const int NUM_POSES = 13;
+    AnimPoseVec a = makePoses(NUM_POSES, 1);
+    AnimPoseVec b = makePoses(NUM_POSES, 2);
+
+    for (float alpha : { 0.0f, 0.3f, 1.0f }) {
+        // AnimUtil blends a single pose without the buffers
+        AnimPoseVec expected(NUM_POSES);
+        for (int i = 0; i < NUM_POSES; i++) {
+            ::blend(1, &a[i], &b[i], alpha, &expected[i]);
+        }
+
+        AnimPoseBuffer aBuffer, bBuffer, result;
+        aBuffer.load(a);
+        bBuffer.load(b);
+        AnimPoseBuffer::blend(aBuffer, bBuffer, alpha, result);
+        AnimPoseVec actual;
+        result.store(actual);
+        verifyPoses(actual, expected);
+
+        // in place
+        AnimPoseBuffer::blend(aBuffer, bBuffer, alpha, aBuffer);
+        aBuffer.store(actual);
+        verifyPoses(actual, expected);
+
+        // through AnimUtil, in place
+        actual = a;
+        ::blend(NUM_POSES, actual.data(), b.data(), alpha, actual.data());
+        verifyPoses(actual, expected);
+    }
+}
+
+void AnimPoseBufferTests::testBlend3() {
+    const int NUM_POSES = 21;
+    AnimPoseVec a = makePoses(NUM_POSES, 1);
+    AnimPoseVec b = makePoses(NUM_POSES, 2);
+    AnimPoseVec c = makePoses(NUM_POSES, 3);
+    float alphas[] = { 0.2f, 0.5f, 0.3f };
+
+    AnimPoseVec expected(NUM_POSES);
+    for (int i = 0; i < NUM_POSES; i++) {
+        ::blend3(1, &a[i], &b[i], &c[i], alphas, &expected[i]);
+    }
+
+    AnimPoseBuffer aBuffer, bBuffer, cBuffer, result;
+    aBuffer.load(a);
+    bBuffer.load(b);
+    cBuffer.load(c);
+    AnimPoseBuffer::blend3(aBuffer, bBuffer, cBuffer, alphas, result);
+    AnimPoseVec actual;
+    result.store(actual);
+    verifyPoses(actual, expected);
+
+    actual.resize(NUM_POSES);
+    ::blend3(NUM_POSES, a.data(), b.data(), c.data(), alphas, actual.data());
+    verifyPoses(actual, expected);
+}
+
+void AnimPoseBufferTests::testBlend4() {
+    const int NUM_POSES = 21;
+    AnimPoseVec a = makePoses(NUM_POSES, 1);
+    AnimPoseVec b = makePoses(NUM_POSES, 2);
+    AnimPoseVec c = makePoses(NUM_POSES, 3);
+    AnimPoseVec d = makePoses(NUM_POSES, 4);
+    float alphas[] = { 0.1f, 0.4f, 0.3f, 0.2f };
+
+    AnimPoseVec expected(NUM_POSES);
+    for (int i = 0; i < NUM_POSES; i++) {
+        ::blend4(1, &a[i], &b[i], &c[i], &d[i], alphas, &expected[i]);
+    }
+
+    AnimPoseBuffer aBuffer, bBuffer, cBuffer, dBuffer, result;
+    aBuffer.load(a);
+    bBuffer.load(b);
+    cBuffer.load(c);
+    dBuffer.load(d);
+    AnimPoseBuffer::blend4(aBuffer, bBuffer, cBuffer, dBuffer, alphas, result);
+    AnimPoseVec actual;
+    result.store(actual);
+    verifyPoses(actual, expected);
+
+    actual.resize(NUM_POSES);
+    ::blend4(NUM_POSES, a.data(), b.data(), c.data(), d.data(), alphas, actual.data());
+    verifyPoses(actual, expected);
+}
+
+void AnimPoseBufferTests::testBlendAdd() {
+    const int NUM_POSES = 13;
+    AnimPoseVec a = makePoses(NUM_POSES, 1);
+    AnimPoseVec b = makePoses(NUM_POSES, 2);
+    const float ALPHA = 0.6f;
+
+    AnimPoseVec expected(NUM_POSES);
+    for (int i = 0; i < NUM_POSES; i++) {
+        ::blendAdd(1, &a[i], &b[i], ALPHA, &expected[i]);
+    }
+
+    AnimPoseBuffer aBuffer, bBuffer, result;
+    aBuffer.load(a);
+    bBuffer.load(b);
+    AnimPoseBuffer::blendAdd(aBuffer, bBuffer, ALPHA, result);
+    AnimPoseVec actual;
+    result.store(actual);
+    verifyPoses(actual, expected);
+
+    actual.resize(NUM_POSES);
+    ::blendAdd(NUM_POSES, a.data(), b.data(), ALPHA, actual.data());
+    verifyPoses(actual, expected);
+}
+
+void AnimPoseBufferTests::testNormalizeRotations() {
+    AnimPoseVec poses = makePoses(10, 1);
+    AnimPoseBuffer buffer;
+    buffer.load(poses);
+
+    buffer.setPose(0, AnimPose(glm::vec3(1.0f), glm::quat(0.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.0f)));
+    buffer.setPose(1, AnimPose(glm::vec3(1.0f), 3.0f * poses[1].rot(), glm::vec3(0.0f)));
+    buffer.normalizeRotations();
+
+    // like glm::normalize, a zero length rotation becomes the identity
+    QVERIFY(buffer.getPose(0).rot() == glm::quat());
+    QVERIFY(glm::dot(buffer.getPose(1).rot(), poses[1].rot()) > 1.0f - TEST_EPSILON);
+    QVERIFY(fabsf(glm::length(buffer.getPose(1).rot()) - 1.0f) < TEST_EPSILON);
+}
+
+void AnimPoseBufferTests::testBuildAbsolutePoses() {
+    std::vector<int> parentIndices = makeParentIndices(NUM_BENCHMARK_JOINTS);
+    AnimPoseVec relativePoses = makePoses(NUM_BENCHMARK_JOINTS, 1);
+    AnimPose rootPose(glm::vec3(2.0f), glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f, 2.0f, 3.0f));
+
+    AnimPoseBuffer relativeBuffer, absoluteBuffer;
+    relativeBuffer.load(relativePoses);
+    QVERIFY(relativeBuffer.hasUniformScales());
+    AnimPoseBuffer::buildAbsolutePoses(relativeBuffer, AnimPoseHierarchy(parentIndices), rootPose, absoluteBuffer);
+
+    AnimPoseVec actual;
+    absoluteBuffer.store(actual);
+    verifyPoses(actual, buildAbsolutePoses(parentIndices, relativePoses, rootPose));
+
+    relativeBuffer.setPose(3, AnimPose(glm::vec3(1.0f, 2.0f, 1.0f), glm::quat(), glm::vec3(0.0f)));
+    QVERIFY(!relativeBuffer.hasUniformScales());
+}
+
+void AnimPoseBufferTests::testBuildAbsolutePosesOutOfOrder() {
+    // several roots, and children before their parents
+    const int NUM_JOINTS = 30;
+    std::vector<int> parentIndices(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        parentIndices[i] = (i >= NUM_JOINTS - 3) ? -1 : i + 1 + (i % 3);
+    }
+    AnimPoseVec relativePoses = makePoses(NUM_JOINTS, 2);
+    AnimPose rootPose(glm::vec3(0.5f), glm::quat(), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    AnimPoseBuffer relativeBuffer, absoluteBuffer;
+    relativeBuffer.load(relativePoses);
+    AnimPoseBuffer::buildAbsolutePoses(relativeBuffer, AnimPoseHierarchy(parentIndices), rootPose, absoluteBuffer);
+
+    AnimPoseVec actual;
+    absoluteBuffer.store(actual);
+    verifyPoses(actual, buildAbsolutePoses(parentIndices, relativePoses, rootPose));
+}
+
+void AnimPoseBufferTests::benchmarkBlend() {
+    AnimPoseVec a = makePoses(NUM_BENCHMARK_JOINTS, 1);
+    AnimPoseVec b = makePoses(NUM_BENCHMARK_JOINTS, 2);
+    AnimPoseVec result(NUM_BENCHMARK_JOINTS);
+    // one pose at a time, as AnimUtil blended them
+    QBENCHMARK {
+        for (int i = 0; i < NUM_BENCHMARK_JOINTS; i++) {
+            ::blend(1, &a[i], &b[i], 0.3f, &result[i]);
+        }
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBlendAnimPoseVec() {
+    AnimPoseVec a = makePoses(NUM_BENCHMARK_JOINTS, 1);
+    AnimPoseVec b = makePoses(NUM_BENCHMARK_JOINTS, 2);
+    AnimPoseVec result(NUM_BENCHMARK_JOINTS);
+    // as AnimUtil blends them now, including the conversions to and from AnimPoseVecs
+    QBENCHMARK {
+        ::blend(NUM_BENCHMARK_JOINTS, a.data(), b.data(), 0.3f, result.data());
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBlendBuffer() {
+    AnimPoseBuffer a, b, result;
+    a.load(makePoses(NUM_BENCHMARK_JOINTS, 1));
+    b.load(makePoses(NUM_BENCHMARK_JOINTS, 2));
+    QBENCHMARK {
+        AnimPoseBuffer::blend(a, b, 0.3f, result);
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBlend4() {
+    AnimPoseVec a = makePoses(NUM_BENCHMARK_JOINTS, 1);
+    AnimPoseVec b = makePoses(NUM_BENCHMARK_JOINTS, 2);
+    AnimPoseVec c = makePoses(NUM_BENCHMARK_JOINTS, 3);
+    AnimPoseVec d = makePoses(NUM_BENCHMARK_JOINTS, 4);
+    AnimPoseVec result(NUM_BENCHMARK_JOINTS);
+    float alphas[] = { 0.1f, 0.4f, 0.3f, 0.2f };
+    // one pose at a time, as AnimUtil blended them
+    QBENCHMARK {
+        for (int i = 0; i < NUM_BENCHMARK_JOINTS; i++) {
+            ::blend4(1, &a[i], &b[i], &c[i], &d[i], alphas, &result[i]);
+        }
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBlend4AnimPoseVec() {
+    AnimPoseVec a = makePoses(NUM_BENCHMARK_JOINTS, 1);
+    AnimPoseVec b = makePoses(NUM_BENCHMARK_JOINTS, 2);
+    AnimPoseVec c = makePoses(NUM_BENCHMARK_JOINTS, 3);
+    AnimPoseVec d = makePoses(NUM_BENCHMARK_JOINTS, 4);
+    AnimPoseVec result(NUM_BENCHMARK_JOINTS);
+    float alphas[] = { 0.1f, 0.4f, 0.3f, 0.2f };
+    // as AnimUtil blends them now, including the conversions to and from AnimPoseVecs
+    QBENCHMARK {
+        ::blend4(NUM_BENCHMARK_JOINTS, a.data(), b.data(), c.data(), d.data(), alphas, result.data());
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBlend4Buffer() {
+    AnimPoseBuffer a, b, c, d, result;
+    a.load(makePoses(NUM_BENCHMARK_JOINTS, 1));
+    b.load(makePoses(NUM_BENCHMARK_JOINTS, 2));
+    c.load(makePoses(NUM_BENCHMARK_JOINTS, 3));
+    d.load(makePoses(NUM_BENCHMARK_JOINTS, 4));
+    float alphas[] = { 0.1f, 0.4f, 0.3f, 0.2f };
+    QBENCHMARK {
+        AnimPoseBuffer::blend4(a, b, c, d, alphas, result);
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBuildAbsolutePoses() {
+    std::vector<int> parentIndices = makeParentIndices(NUM_BENCHMARK_JOINTS);
+    AnimPoseVec relativePoses = makePoses(NUM_BENCHMARK_JOINTS, 1);
+    AnimPoseVec absolutePoses(NUM_BENCHMARK_JOINTS);
+    AnimPose rootPose(glm::vec3(2.0f), glm::quat(), glm::vec3(0.0f));
+
+    // as Rig::buildAbsoluteRigPoses did
+    QBENCHMARK {
+        for (int i = 0; i < NUM_BENCHMARK_JOINTS; i++) {
+            int parentIndex = parentIndices[i];
+            if (parentIndex == -1) {
+                absolutePoses[i] = rootPose * relativePoses[i];
+            } else {
+                absolutePoses[i] = absolutePoses[parentIndex] * relativePoses[i];
+            }
+        }
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBuildAbsolutePoseBuffer() {
+    AnimPoseHierarchy hierarchy(makeParentIndices(NUM_BENCHMARK_JOINTS));
+    AnimPoseVec relativePoses = makePoses(NUM_BENCHMARK_JOINTS, 1);
+    AnimPoseVec absolutePoses(NUM_BENCHMARK_JOINTS);
+    AnimPose rootPose(glm::vec3(2.0f), glm::quat(), glm::vec3(0.0f));
+    AnimPoseBuffer relativeBuffer, absoluteBuffer;
+
+    // as Rig::buildAbsoluteRigPoses does now, including the conversions to and from AnimPoseVecs
+    QBENCHMARK {
+        relativeBuffer.load(relativePoses);
+        if (relativeBuffer.hasUniformScales()) {
+            AnimPoseBuffer::buildAbsolutePoses(relativeBuffer, hierarchy, rootPose, absoluteBuffer);
+        }
+        absoluteBuffer.store(absolutePoses.data());
+    }
+}
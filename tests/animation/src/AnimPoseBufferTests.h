@@ -0,0 +1,40 @@
+//
+//  AnimPoseBufferTests.h
+//  tests/animation/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBufferTests_h
+#define hifi_AnimPoseBufferTests_h
+
+#include <QtTest/QtTest>
+
+class AnimPoseBufferTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testLoadStore();
+    void testBlend();
+    void testBlend3();
+    void testBlend4();
+    void testBlendAdd();
+    void testNormalizeRotations();
+    void testBuildAbsolutePoses();
+    void testBuildAbsolutePosesOutOfOrder();
+
+    // one AnimPose at a time, AnimUtil on AnimPoseVecs and AnimPoseBuffers alone, on a 100 joint skeleton
+    void benchmarkBlend();
+    void benchmarkBlendAnimPoseVec();
+    void benchmarkBlendBuffer();
+    void benchmarkBlend4();
+    void benchmarkBlend4AnimPoseVec();
+    void benchmarkBlend4Buffer();
+    void benchmarkBuildAbsolutePoses();
+    void benchmarkBuildAbsolutePoseBuffer();
+};
+
+#endif // hifi_AnimPoseBufferTests_h
@@ -0,0 +1,188 @@
+//
+//  RigTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RigTests.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <NumericalConstants.h>
+#include <Rig.h>
+
+QTEST_MAIN(RigTests)
+
+const float TEST_EPSILON = 0.0001f;
+
+// the animation LODs of OtherAvatar
+const int NUM_LODS = 3;
+const float MIN_SCREEN_SIZES[NUM_LODS] = { 0.05f, 0.015f, 0.0f };
+const float HYSTERESIS = 0.9f;
+
+// Hips---->Spine---->Head---->HeadTop_End
+//            |
+//            +------>LeftHand---->LeftHandIndex1
+//            |
+//            +------>RightHand--->RightHandIndex1
+static void makeTestFBXJoints(HFMModel& hfmModel) {
+    HFMJoint joint;
+    joint.isFree = false;
+    joint.distanceToParent = 1.0f;
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.isSkeletonJoint = true;
+
+    const std::vector<std::pair<QString, int>> JOINTS = {
+        { "Hips", -1 },
+        { "Spine", 0 },
+        { "Head", 1 },
+        { "HeadTop_End", 2 },
+        { "LeftHand", 1 },
+        { "LeftHandIndex1", 4 },
+        { "RightHand", 1 },
+        { "RightHandIndex1", 6 }
+    };
+    for (const auto& nameAndParent : JOINTS) {
+        joint.name = nameAndParent.first;
+        joint.parentIndex = nameAndParent.second;
+        joint.translation = nameAndParent.second == -1 ? glm::vec3() : glm::vec3(0.0f, 1.0f, 0.0f);
+        joint.transform = glm::translate(joint.translation);
+        if (joint.parentIndex != -1) {
+            joint.transform = hfmModel.joints[joint.parentIndex].transform * joint.transform;
+        }
+        joint.bindTransform = joint.transform;
+        hfmModel.joints.push_back(joint);
+    }
+}
+
+static void verifyRotation(const glm::quat& actual, const glm::quat& expected) {
+    QVERIFY(fabsf(glm::dot(actual, expected)) > 1.0f - TEST_EPSILON);
+}
+
+// joint data that moves every joint away from its default pose
+static QVector<JointData> makeJointData(int numJoints) {
+    QVector<JointData> jointData(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        jointData[i].rotation = glm::angleAxis(0.5f * (float)(i + 1), glm::vec3(0.0f, 0.0f, 1.0f));
+        jointData[i].rotationIsDefaultPose = false;
+        jointData[i].translation = glm::vec3((float)(i + 1), 0.0f, 0.0f);
+        jointData[i].translationIsDefaultPose = false;
+    }
+    return jointData;
+}
+
+void RigTests::testLevelOfDetailHysteresis() {
+    // from the finest LOD an avatar has to shrink past the hysteresis before it drops one
+    QCOMPARE(computeLevelOfDetail(0.05f, 0, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 0);
+    QCOMPARE(computeLevelOfDetail(0.046f, 0, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 0);
+    QCOMPARE(computeLevelOfDetail(0.044f, 0, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 1);
+    QCOMPARE(computeLevelOfDetail(0.01f, 0, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 2);
+
+    // but it has to grow all the way to a threshold to take a finer one
+    QCOMPARE(computeLevelOfDetail(0.049f, 1, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 1);
+    QCOMPARE(computeLevelOfDetail(0.05f, 1, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 0);
+    QCOMPARE(computeLevelOfDetail(0.014f, 1, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 1);
+    QCOMPARE(computeLevelOfDetail(0.013f, 1, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 2);
+
+    QCOMPARE(computeLevelOfDetail(0.014f, 2, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 2);
+    QCOMPARE(computeLevelOfDetail(0.015f, 2, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 1);
+    QCOMPARE(computeLevelOfDetail(0.0f, 2, MIN_SCREEN_SIZES, NUM_LODS, HYSTERESIS), 2);
+}
+
+void RigTests::testCoreJoints() {
+    HFMModel hfmModel;
+    makeTestFBXJoints(hfmModel);
+    AnimSkeleton skeleton(hfmModel);
+
+    QVERIFY(skeleton.isCoreJoint(skeleton.nameToJointIndex("Hips")));
+    QVERIFY(skeleton.isCoreJoint(skeleton.nameToJointIndex("Spine")));
+    QVERIFY(skeleton.isCoreJoint(skeleton.nameToJointIndex("Head")));
+    QVERIFY(skeleton.isCoreJoint(skeleton.nameToJointIndex("LeftHand")));
+    QVERIFY(skeleton.isCoreJoint(skeleton.nameToJointIndex("RightHand")));
+    QVERIFY(!skeleton.isCoreJoint(skeleton.nameToJointIndex("HeadTop_End")));
+    QVERIFY(!skeleton.isCoreJoint(skeleton.nameToJointIndex("LeftHandIndex1")));
+    QVERIFY(!skeleton.isCoreJoint(skeleton.nameToJointIndex("RightHandIndex1")));
+}
+
+void RigTests::testCopyCoreJointsFromJointData() {
+    HFMModel hfmModel;
+    makeTestFBXJoints(hfmModel);
+    Rig rig;
+    rig.initJointStates(hfmModel, glm::mat4());
+    AnimSkeleton::ConstPointer skeleton = rig.getAnimSkeleton();
+    int numJoints = skeleton->getNumJoints();
+    QVector<JointData> jointData = makeJointData(numJoints);
+
+    // the joints below the hands and the head keep their default poses
+    rig.copyJointsFromJointData(jointData, true);
+    for (int i = 0; i < numJoints; i++) {
+        glm::quat rotation;
+        QVERIFY(rig.getJointRotation(i, rotation));
+        glm::quat expectedRotation = skeleton->getRelativeDefaultPose(i).rot();
+        if (skeleton->isCoreJoint(i)) {
+            int parentIndex = skeleton->getParentIndex(i);
+            expectedRotation = parentIndex == -1 ? jointData[i].rotation :
+                glm::inverse(jointData[parentIndex].rotation) * jointData[i].rotation;
+        }
+        verifyRotation(rotation, expectedRotation);
+    }
+
+    // until all the joints are copied
+    rig.copyJointsFromJointData(jointData);
+    for (int i = 0; i < numJoints; i++) {
+        glm::quat rotation;
+        QVERIFY(rig.getJointRotation(i, rotation));
+        int parentIndex = skeleton->getParentIndex(i);
+        glm::quat expectedRotation = parentIndex == -1 ? jointData[i].rotation :
+            glm::inverse(jointData[parentIndex].rotation) * jointData[i].rotation;
+        verifyRotation(rotation, expectedRotation);
+    }
+}
+
+void RigTests::testJointInterpolation() {
+    HFMModel hfmModel;
+    makeTestFBXJoints(hfmModel);
+    Rig rig;
+    rig.initJointStates(hfmModel, glm::mat4());
+    AnimSkeleton::ConstPointer skeleton = rig.getAnimSkeleton();
+    int numJoints = skeleton->getNumJoints();
+    QVector<JointData> jointData = makeJointData(numJoints);
+
+    // the joints take a quarter of the way to the joint data now, and another quarter each frame after
+    const int NUM_FRAMES = 4;
+    rig.copyJointsFromJointData(jointData, false, NUM_FRAMES);
+    for (int frame = 1; frame <= NUM_FRAMES; frame++) {
+        QCOMPARE(rig.isInterpolatingJoints(), frame < NUM_FRAMES);
+        float alpha = (float)frame / (float)NUM_FRAMES;
+        for (int i = 0; i < numJoints; i++) {
+            glm::quat rotation;
+            QVERIFY(rig.getJointRotation(i, rotation));
+            int parentIndex = skeleton->getParentIndex(i);
+            glm::quat targetRotation = parentIndex == -1 ? jointData[i].rotation :
+                glm::inverse(jointData[parentIndex].rotation) * jointData[i].rotation;
+            verifyRotation(rotation, safeLerp(skeleton->getRelativeDefaultPose(i).rot(), targetRotation, alpha));
+        }
+        rig.stepJointInterpolation();
+    }
+    QVERIFY(!rig.isInterpolatingJoints());
+
+    // without interpolation the joints take the joint data straight away, and stop any interpolation under way
+    rig.copyJointsFromJointData(makeJointData(numJoints), false, NUM_FRAMES);
+    QVERIFY(rig.isInterpolatingJoints());
+    rig.copyJointsFromJointData(jointData);
+    QVERIFY(!rig.isInterpolatingJoints());
+}
@@ -0,0 +1,127 @@
+//
+// AudioMixerSourceBucketsTests.cpp
+// tests/assignment-client/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerSourceBucketsTests.h"
+
+#include <AudioMixerSourceBuckets.h>
+#include <GLMHelpers.h>
+
+QTEST_MAIN(AudioMixerSourceBucketsTests)
+
+static const float CELL_SIZE = 4.0f;
+
+// a stream placed directly, rather than by parsing the audio packets of a node
+class PlacedAudioStream : public PositionalAudioStream {
+public:
+    PlacedAudioStream(Type type, const glm::vec3& position, const glm::quat& orientation = glm::quat(),
+                      bool isStereo = false) :
+        PositionalAudioStream(type, isStereo)
+    {
+        _position = position;
+        _orientation = orientation;
+    }
+};
+
+static void setupBuckets(AudioMixerSourceBuckets& buckets) {
+    buckets.setEnabled(true);
+    buckets.setCellSize(CELL_SIZE);
+}
+
+static glm::quat yawRotation(float degrees) {
+    return glm::angleAxis(glm::radians(degrees), Vectors::UNIT_Y);
+}
+
+void AudioMixerSourceBucketsTests::cellKeyTest() {
+    AudioMixerSourceBuckets buckets;
+    setupBuckets(buckets);
+
+    // sources in the same cell share a bucket, on either side of the origin
+    PlacedAudioStream a(PositionalAudioStream::Injector, glm::vec3(0.5f, 1.0f, 3.5f));
+    PlacedAudioStream b(PositionalAudioStream::Injector, glm::vec3(3.5f, 3.9f, 0.1f));
+    QCOMPARE(buckets.computeKey(a), buckets.computeKey(b));
+
+    PlacedAudioStream negativeA(PositionalAudioStream::Injector, glm::vec3(-0.5f, -1.0f, -3.5f));
+    PlacedAudioStream negativeB(PositionalAudioStream::Injector, glm::vec3(-3.5f, -3.9f, -0.1f));
+    QCOMPARE(buckets.computeKey(negativeA), buckets.computeKey(negativeB));
+    QVERIFY(buckets.computeKey(a) != buckets.computeKey(negativeA));
+
+    // a neighbouring cell along each axis gets a bucket of its own
+    for (int i = 0; i < 3; i++) {
+        glm::vec3 position = a.getPosition();
+        position[i] += CELL_SIZE;
+        PlacedAudioStream neighbour(PositionalAudioStream::Injector, position);
+        QVERIFY(buckets.computeKey(a) != buckets.computeKey(neighbour));
+    }
+
+    // the same position falls in another cell once the cells are smaller
+    AudioMixerSourceBuckets smallerBuckets;
+    setupBuckets(smallerBuckets);
+    smallerBuckets.setCellSize(CELL_SIZE / 4.0f);
+    QVERIFY(smallerBuckets.computeKey(a) != smallerBuckets.computeKey(b));
+}
+
+void AudioMixerSourceBucketsTests::facingKeyTest() {
+    AudioMixerSourceBuckets buckets;
+    setupBuckets(buckets);
+    const glm::vec3 POSITION(1.0f, 1.0f, 1.0f);
+
+    // avatars facing within the same sector share a bucket, and are split from those facing another way
+    PlacedAudioStream facing(PositionalAudioStream::Microphone, POSITION, yawRotation(10.0f));
+    PlacedAudioStream nearlyFacing(PositionalAudioStream::Microphone, POSITION, yawRotation(30.0f));
+    QCOMPARE(buckets.computeKey(facing), buckets.computeKey(nearlyFacing));
+
+    const float SECTOR_DEGREES = 360.0f / AudioMixerSourceBuckets::NUM_FACING_SECTORS;
+    for (int i = 1; i < AudioMixerSourceBuckets::NUM_FACING_SECTORS; i++) {
+        PlacedAudioStream turned(PositionalAudioStream::Microphone, POSITION, yawRotation(10.0f + i * SECTOR_DEGREES));
+        QVERIFY(buckets.computeKey(facing) != buckets.computeKey(turned));
+    }
+
+    // only the yaw of an avatar picks its sector
+    glm::quat pitched = yawRotation(10.0f) * glm::angleAxis(glm::radians(20.0f), Vectors::UNIT_X);
+    PlacedAudioStream lookingUp(PositionalAudioStream::Microphone, POSITION, pitched);
+    QCOMPARE(buckets.computeKey(facing), buckets.computeKey(lookingUp));
+
+    // injectors are omni-directional, so their facing is ignored
+    PlacedAudioStream injector(PositionalAudioStream::Injector, POSITION, yawRotation(10.0f));
+    PlacedAudioStream turnedInjector(PositionalAudioStream::Injector, POSITION, yawRotation(190.0f));
+    QCOMPARE(buckets.computeKey(injector), buckets.computeKey(turnedInjector));
+}
+
+void AudioMixerSourceBucketsTests::typeKeyTest() {
+    AudioMixerSourceBuckets buckets;
+    setupBuckets(buckets);
+
+    // avatars and injectors in the same cell are never summed together
+    for (int i = 0; i < AudioMixerSourceBuckets::NUM_FACING_SECTORS; i++) {
+        glm::quat orientation = yawRotation(i * 360.0f / AudioMixerSourceBuckets::NUM_FACING_SECTORS);
+        PlacedAudioStream avatar(PositionalAudioStream::Microphone, glm::vec3(1.0f), orientation);
+        PlacedAudioStream injector(PositionalAudioStream::Injector, glm::vec3(1.0f), orientation);
+        QVERIFY(buckets.computeKey(avatar) != buckets.computeKey(injector));
+    }
+}
+
+void AudioMixerSourceBucketsTests::bucketableTest() {
+    AudioMixerSourceBuckets buckets;
+    PlacedAudioStream mono(PositionalAudioStream::Microphone, glm::vec3(1.0f));
+    PlacedAudioStream stereo(PositionalAudioStream::Injector, glm::vec3(1.0f), glm::quat(), true);
+
+    // nothing is bucketed until the buckets are enabled
+    QVERIFY(!buckets.isEnabled());
+    QVERIFY(!buckets.isBucketable(mono));
+
+    // a stream that has not popped any audio this frame has nothing to add to a bucket
+    setupBuckets(buckets);
+    QVERIFY(!buckets.isBucketable(mono));
+    QVERIFY(!buckets.isBucketable(stereo));
+
+    // and no bucket exists before the first frame is prepared
+    QCOMPARE(buckets.numBuckets(), 0);
+    QVERIFY(buckets.find(buckets.computeKey(mono)) == nullptr);
+}
@@ -0,0 +1,25 @@
+//
+// AudioMixerSourceBucketsTests.h
+// tests/assignment-client/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerSourceBucketsTests_h
+#define hifi_AudioMixerSourceBucketsTests_h
+
+#include <QtTest/QtTest>
+
+class AudioMixerSourceBucketsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void cellKeyTest();
+    void facingKeyTest();
+    void typeKeyTest();
+    void bucketableTest();
+};
+
+#endif // hifi_AudioMixerSourceBucketsTests_h
@@ -0,0 +1,137 @@
+//
+// AvatarEncodingCacheTests.cpp
+// tests/assignment-client/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEncodingCacheTests.h"
+
+#include <AvatarEncodingCache.h>
+#include <GLMHelpers.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+QTEST_MAIN(AvatarEncodingCacheTests)
+
+static const int NUM_JOINTS = 20;
+static const int NUM_FRAMES = 50;
+
+// a listener in the middle of distance level 2, where rotations of less than 4 degrees are culled
+static const glm::vec3 VIEWER_POSITION = 20.0f * Vectors::UNIT_X;
+
+// the joint rotations can lose a little more to compression than the culling allows
+static const float MIN_RECEIVED_ROTATION_DOT = ROTATION_CHANGE_4D - 0.0001f;
+
+// some joints turn quickly and go out every frame, the others turn slowly and go out every few frames
+static void poseAvatar(AvatarData& avatar, int frame) {
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        float angularSpeed = (i % 2 == 0) ? 0.2f : 0.01f;
+        glm::quat rotation = glm::angleAxis(frame * angularSpeed + i, Vectors::UNIT_Y);
+        avatar.setJointData(i, rotation, glm::vec3(0.0f, 0.1f * i, 0.0f));
+    }
+}
+
+// applies avatar data the way an interface does, which receives it without the UUID of the avatar
+static void receive(AvatarData& receiver, const QByteArray& bytes) {
+    receiver.parseDataFromBuffer(bytes.mid(NUM_BYTES_RFC4122_UUID));
+}
+
+static void verifyJoints(const AvatarData& received, const AvatarData& source) {
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        QVERIFY(fabsf(glm::dot(received.getJointRotation(i), source.getJointRotation(i))) > MIN_RECEIVED_ROTATION_DOT);
+        QVERIFY(glm::distance(received.getJointTranslation(i), source.getJointTranslation(i)) < 0.001f);
+    }
+}
+
+static void verifySameJoints(const AvatarData& a, const AvatarData& b) {
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        QVERIFY(fabsf(glm::dot(a.getJointRotation(i), b.getJointRotation(i))) > AVATAR_MIN_ROTATION_DOT);
+        QVERIFY(glm::distance(a.getJointTranslation(i), b.getJointTranslation(i)) < 0.0001f);
+    }
+}
+
+void AvatarEncodingCacheTests::keyframeMatchesPerListenerTest() {
+    AvatarData source;
+    poseAvatar(source, 0);
+
+    AvatarEncodingCache cache;
+    QByteArray keyframe = cache.getKeyframe(source, 1);
+
+    // the same frame gives the same keyframe, without encoding it again
+    QCOMPARE(cache.getKeyframe(source, 1), keyframe);
+
+    QVector<JointData> lastSentJoints;
+    AvatarDataPacket::SendStatus sendStatus;
+    sendStatus.sendUUID = true;
+    QByteArray perListener = source.toByteArray(AvatarData::SendAllData, 0, lastSentJoints, sendStatus,
+        false, true, VIEWER_POSITION, &lastSentJoints);
+
+    AvatarData sharedReceiver;
+    receive(sharedReceiver, keyframe);
+    AvatarData perListenerReceiver;
+    receive(perListenerReceiver, perListener);
+
+    QCOMPARE(sharedReceiver.getJointData().size(), NUM_JOINTS);
+    verifyJoints(sharedReceiver, source);
+    verifySameJoints(sharedReceiver, perListenerReceiver);
+}
+
+void AvatarEncodingCacheTests::deltasMatchPerListenerTest() {
+    const int SKIPPED_FRAME = NUM_FRAMES / 2;
+
+    AvatarData source;
+    AvatarEncodingCache cache;
+    int distanceLevel = AvatarData::getDistanceLevel(glm::length(VIEWER_POSITION));
+    QCOMPARE(distanceLevel, 2);
+
+    AvatarData sharedReceiver;
+    uint32_t sharedGeneration = 0;
+    int numKeyframes = 0;
+
+    AvatarData perListenerReceiver;
+    QVector<JointData> lastSentJoints;
+    quint64 lastSentTime = 0;
+
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        poseAvatar(source, frame);
+        uint16_t sequenceNumber = (uint16_t)(frame + 1);
+
+        // follow the mixer: the shared delta only goes to a listener that holds the generation it was made against,
+        // and is still made for the other listeners in the frame this listener misses
+        AvatarEncodingCache::Delta delta = cache.getDelta(source, sequenceNumber, distanceLevel);
+        if (frame != SKIPPED_FRAME) {
+            bool followsChain = (sharedGeneration != 0 && delta.baseGeneration == sharedGeneration);
+            if (followsChain) {
+                receive(sharedReceiver, delta.bytes);
+            } else {
+                receive(sharedReceiver, cache.getKeyframe(source, sequenceNumber));
+                numKeyframes++;
+            }
+            sharedGeneration = delta.generation;
+        }
+
+        quint64 sendTime = usecTimestampNow();
+        AvatarDataPacket::SendStatus sendStatus;
+        sendStatus.sendUUID = true;
+        AvatarData::AvatarDataDetail detail = (frame == 0) ? AvatarData::SendAllData : AvatarData::CullSmallData;
+        receive(perListenerReceiver, source.toByteArray(detail, lastSentTime, lastSentJoints, sendStatus,
+            false, true, VIEWER_POSITION, &lastSentJoints));
+        lastSentTime = sendTime;
+
+        verifyJoints(perListenerReceiver, source);
+        if (frame != SKIPPED_FRAME) {
+            verifyJoints(sharedReceiver, source);
+        }
+        if (frame < SKIPPED_FRAME) {
+            // until the shared listener misses a frame, both are sent the same joints
+            verifySameJoints(sharedReceiver, perListenerReceiver);
+        }
+    }
+
+    // one keyframe to start with, and one after the skipped frame broke the chain
+    QCOMPARE(numKeyframes, 2);
+}
@@ -0,0 +1,23 @@
+//
+// AvatarEncodingCacheTests.h
+// tests/assignment-client/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarEncodingCacheTests_h
+#define hifi_AvatarEncodingCacheTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarEncodingCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void keyframeMatchesPerListenerTest();
+    void deltasMatchPerListenerTest();
+};
+
+#endif // hifi_AvatarEncodingCacheTests_h
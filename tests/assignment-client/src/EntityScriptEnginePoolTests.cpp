@@ -0,0 +1,148 @@
+//
+// EntityScriptEnginePoolTests.cpp
+// tests/assignment-client/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEnginePoolTests.h"
+
+#include <EntityScriptEnginePool.h>
+
+QTEST_MAIN(EntityScriptEnginePoolTests)
+
+static const int NUM_ENGINES = 2;
+static const quint64 INTERVAL = 1000000;
+// enough updates for the smoothed loads to settle on the run times given
+static const int NUM_LOAD_UPDATES = 100;
+
+// the pool only hands the engines out, so the placement tests don't need real ones
+static void setupPool(EntityScriptEnginePool& pool, EntityScriptEnginePool::Placement placement, int numEngines = NUM_ENGINES) {
+    pool.setEngines(std::vector<ScriptEnginePointer>(numEngines));
+    pool.setPlacement(placement);
+}
+
+// settles each script's load on the given fraction of a thread
+static void setLoads(EntityScriptEnginePool& pool, const QHash<EntityItemID, float>& loads) {
+    std::vector<QHash<EntityItemID, quint64>> runTimes(pool.getNumEngines());
+    for (auto it = loads.constBegin(); it != loads.constEnd(); ++it) {
+        runTimes[pool.getEngineIndex(it.key())][it.key()] = (quint64)(it.value() * INTERVAL);
+    }
+    for (int i = 0; i < NUM_LOAD_UPDATES; i++) {
+        pool.addRunTimes(runTimes, INTERVAL);
+    }
+}
+
+void EntityScriptEnginePoolTests::hashPlacementTest() {
+    const int NUM_HASHED_ENGINES = 4;
+    const int NUM_ENTITIES = 1000;
+
+    EntityScriptEnginePool pool;
+    setupPool(pool, EntityScriptEnginePool::Placement::Hash, NUM_HASHED_ENGINES);
+
+    std::vector<int> numScripts(NUM_HASHED_ENGINES, 0);
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        EntityItemID entityID(QUuid::createUuid());
+        pool.assignEngine(entityID);
+        int engineIndex = pool.getEngineIndex(entityID);
+        QCOMPARE(engineIndex, (int)(qHash(entityID) % NUM_HASHED_ENGINES));
+
+        // the same entity always lands on the same engine, loaded or not
+        pool.unassignEngine(entityID);
+        QCOMPARE(pool.getEngineIndex(entityID), -1);
+        pool.assignEngine(entityID);
+        QCOMPARE(pool.getEngineIndex(entityID), engineIndex);
+        numScripts[engineIndex]++;
+    }
+    for (int i = 0; i < NUM_HASHED_ENGINES; i++) {
+        QVERIFY(numScripts[i] > 0);
+    }
+
+    EntityItemID entityID(QUuid::createUuid());
+    pool.assignEngine(entityID);
+    EntityItemID fromEntityID;
+    ScriptEnginePointer fromEngine;
+    QVERIFY(!pool.rebalance(fromEntityID, fromEngine));
+}
+
+void EntityScriptEnginePoolTests::loadPlacementTest() {
+    EntityScriptEnginePool pool;
+    setupPool(pool, EntityScriptEnginePool::Placement::Load);
+
+    // with no loads to go by the scripts are spread evenly
+    EntityItemID first(QUuid::createUuid());
+    EntityItemID second(QUuid::createUuid());
+    pool.assignEngine(first);
+    pool.assignEngine(second);
+    QCOMPARE(pool.getEngineIndex(first), 0);
+    QCOMPARE(pool.getEngineIndex(second), 1);
+
+    // then they go to the least busy engine, even when it has more scripts
+    setLoads(pool, { { first, 0.0f }, { second, 0.5f } });
+    EntityItemID third(QUuid::createUuid());
+    EntityItemID fourth(QUuid::createUuid());
+    pool.assignEngine(third);
+    pool.assignEngine(fourth);
+    QCOMPARE(pool.getEngineIndex(third), 0);
+    QCOMPARE(pool.getEngineIndex(fourth), 0);
+}
+
+void EntityScriptEnginePoolTests::rebalanceThresholdTest() {
+    EntityScriptEnginePool pool;
+    setupPool(pool, EntityScriptEnginePool::Placement::Load);
+
+    EntityItemID first(QUuid::createUuid());
+    EntityItemID second(QUuid::createUuid());
+    EntityItemID third(QUuid::createUuid());
+    pool.assignEngine(first);
+    pool.assignEngine(second);
+    pool.assignEngine(third);
+    QCOMPARE(pool.getEngineIndex(third), 0);
+
+    // engines 0.08 of a thread apart are close enough
+    setLoads(pool, { { first, 0.04f }, { second, 0.0f }, { third, 0.04f } });
+    EntityItemID entityID;
+    ScriptEnginePointer fromEngine;
+    QVERIFY(!pool.rebalance(entityID, fromEngine));
+
+    // 0.22 apart are not
+    setLoads(pool, { { first, 0.1f }, { second, 0.0f }, { third, 0.12f } });
+    QVERIFY(pool.rebalance(entityID, fromEngine));
+    QVERIFY(entityID == first);
+    QCOMPARE(pool.getEngineIndex(first), 1);
+
+    // which leaves them balanced
+    QVERIFY(!pool.rebalance(entityID, fromEngine));
+}
+
+void EntityScriptEnginePoolTests::rebalanceKeepsOrderTest() {
+    EntityScriptEnginePool pool;
+    setupPool(pool, EntityScriptEnginePool::Placement::Load);
+
+    EntityItemID heavy(QUuid::createUuid());
+    EntityItemID idle(QUuid::createUuid());
+    EntityItemID light(QUuid::createUuid());
+    pool.assignEngine(heavy);
+    pool.assignEngine(idle);
+    pool.assignEngine(light);
+    QCOMPARE(pool.getEngineIndex(heavy), 0);
+    QCOMPARE(pool.getEngineIndex(light), 0);
+
+    // moving the heavy script would leave engine 1 the busier one, so the light one goes
+    setLoads(pool, { { heavy, 0.3f }, { idle, 0.0f }, { light, 0.2f } });
+    EntityItemID entityID;
+    ScriptEnginePointer fromEngine;
+    QVERIFY(pool.rebalance(entityID, fromEngine));
+    QVERIFY(entityID == light);
+    QCOMPARE(pool.getEngineIndex(light), 1);
+
+    auto loads = pool.getEngineLoads();
+    QVERIFY(loads[0] >= loads[1]);
+
+    // no script on engine 0 is small enough to move without flipping them
+    QVERIFY(!pool.rebalance(entityID, fromEngine));
+    QCOMPARE(pool.getEngineIndex(heavy), 0);
+}
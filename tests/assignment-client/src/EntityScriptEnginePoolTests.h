@@ -0,0 +1,25 @@
+//
+// EntityScriptEnginePoolTests.h
+// tests/assignment-client/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEnginePoolTests_h
+#define hifi_EntityScriptEnginePoolTests_h
+
+#include <QtTest/QtTest>
+
+class EntityScriptEnginePoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void hashPlacementTest();
+    void loadPlacementTest();
+    void rebalanceThresholdTest();
+    void rebalanceKeepsOrderTest();
+};
+
+#endif // hifi_EntityScriptEnginePoolTests_h
@@ -0,0 +1,114 @@
+//
+// DomainListHistoryTests.cpp
+// tests/domain-server/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListHistoryTests.h"
+
+#include <DomainListHistory.h>
+
+QTEST_MAIN(DomainListHistoryTests)
+
+void DomainListHistoryTests::commitTest() {
+    DomainListHistory history;
+    DomainListHistory::Version firstVersion = history.getVersion();
+    QVERIFY(firstVersion != 0);
+    QVERIFY(!history.hasPendingChanges());
+
+    // nothing to commit keeps the version
+    QCOMPARE(history.commitPendingChanges(), firstVersion);
+
+    QUuid node = QUuid::createUuid();
+    history.nodeChanged(node);
+    QVERIFY(history.hasPendingChanges());
+    // pending changes aren't in any version yet
+    QVERIFY(history.getChangesSince(firstVersion).changedNodes.isEmpty());
+
+    DomainListHistory::Version secondVersion = history.commitPendingChanges();
+    QCOMPARE(secondVersion, firstVersion + 1);
+    QCOMPARE(history.getVersion(), secondVersion);
+    QVERIFY(!history.hasPendingChanges());
+
+    // a node without a list, or with a version we haven't made, gets the whole list
+    QVERIFY(!history.hasChangesSince(0));
+    QVERIFY(!history.hasChangesSince(secondVersion + 1));
+    QVERIFY(history.hasChangesSince(firstVersion));
+    QVERIFY(history.hasChangesSince(secondVersion));
+
+    auto changes = history.getChangesSince(firstVersion);
+    QCOMPARE(changes.changedNodes, QSet<QUuid>({ node }));
+    QVERIFY(changes.removedNodes.isEmpty());
+
+    // a node that is up to date has nothing to be sent
+    changes = history.getChangesSince(secondVersion);
+    QVERIFY(changes.changedNodes.isEmpty());
+    QVERIFY(changes.removedNodes.isEmpty());
+}
+
+void DomainListHistoryTests::coalesceTest() {
+    DomainListHistory history;
+    DomainListHistory::Version firstVersion = history.getVersion();
+
+    QUuid agent = QUuid::createUuid();
+    QUuid mixer = QUuid::createUuid();
+    QUuid rejoiner = QUuid::createUuid();
+
+    history.nodeChanged(agent);
+    history.nodeChanged(mixer);
+    history.nodeChanged(rejoiner);
+    DomainListHistory::Version addedVersion = history.commitPendingChanges();
+
+    history.nodeChanged(agent);
+    history.nodeRemoved(mixer, NodeType::AudioMixer);
+    history.nodeRemoved(rejoiner, NodeType::Agent);
+    DomainListHistory::Version removedVersion = history.commitPendingChanges();
+
+    history.nodeChanged(rejoiner);
+    history.commitPendingChanges();
+
+    // each node is in the changes once, as its last change left it
+    auto changes = history.getChangesSince(firstVersion);
+    QCOMPARE(changes.changedNodes, QSet<QUuid>({ agent, rejoiner }));
+    QCOMPARE(changes.removedNodes.size(), 1);
+    QCOMPARE(changes.removedNodes.value(mixer), (NodeType_t)NodeType::AudioMixer);
+
+    // only the changes after the version are sent
+    changes = history.getChangesSince(addedVersion);
+    QCOMPARE(changes.changedNodes, QSet<QUuid>({ agent, rejoiner }));
+    QCOMPARE(changes.removedNodes.size(), 1);
+
+    changes = history.getChangesSince(removedVersion);
+    QCOMPARE(changes.changedNodes, QSet<QUuid>({ rejoiner }));
+    QVERIFY(changes.removedNodes.isEmpty());
+}
+
+void DomainListHistoryTests::overflowTest() {
+    // more single change versions than the history keeps
+    const int NUM_VERSIONS = 10000;
+
+    DomainListHistory history;
+    DomainListHistory::Version firstVersion = history.getVersion();
+    QUuid firstNode = QUuid::createUuid();
+    history.nodeChanged(firstNode);
+    history.commitPendingChanges();
+    for (int i = 1; i < NUM_VERSIONS; i++) {
+        history.nodeChanged(QUuid::createUuid());
+        history.commitPendingChanges();
+    }
+    QCOMPARE(history.getVersion(), firstVersion + NUM_VERSIONS);
+
+    // a node that has fallen too far behind is sent the whole list
+    QVERIFY(!history.hasChangesSince(firstVersion));
+
+    // while one that is close gets the changes
+    DomainListHistory::Version recentVersion = history.getVersion() - 10;
+    QVERIFY(history.hasChangesSince(recentVersion));
+    auto changes = history.getChangesSince(recentVersion);
+    QCOMPARE(changes.changedNodes.size(), 10);
+    QVERIFY(!changes.changedNodes.contains(firstNode));
+}
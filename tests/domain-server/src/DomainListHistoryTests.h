@@ -0,0 +1,24 @@
+//
+// DomainListHistoryTests.h
+// tests/domain-server/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListHistoryTests_h
+#define hifi_DomainListHistoryTests_h
+
+#include <QtTest/QtTest>
+
+class DomainListHistoryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void commitTest();
+    void coalesceTest();
+    void overflowTest();
+};
+
+#endif // hifi_DomainListHistoryTests_h
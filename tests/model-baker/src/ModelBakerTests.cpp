@@ -0,0 +1,135 @@
+//
+//  ModelBakerTests.cpp
+//  tests/model-baker/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelBakerTests.h"
+
+#include <gpu/Stream.h>
+#include <model-baker/Baker.h>
+#include <task/WorkerPool.h>
+
+QTEST_MAIN(ModelBakerTests)
+
+const int NUM_MESHES = 12;
+const int GRID_SIZE = 16;
+const int NUM_BLENDSHAPE_VERTICES = 20;
+const int NUM_WORKER_THREADS = 4;
+
+// a bumpy grid of triangles per mesh, each with a blendshape, and neither normals nor tangents for the baker to compute
+static hfm::Model::Pointer makeTestModel() {
+    auto hfmModel = std::make_shared<hfm::Model>();
+    hfmModel->originalURL = "file:///test.fbx";
+
+    hfm::Joint joint;
+    joint.parentIndex = -1;
+    joint.distanceToParent = 0.0f;
+    joint.isSkeletonJoint = false;
+    joint.bindTransformFoundInCluster = false;
+    joint.name = "root";
+    hfmModel->joints.push_back(joint);
+    hfmModel->jointIndices["root"] = 1;
+
+    hfmModel->materials.emplace_back();
+
+    for (int i = 0; i < NUM_MESHES; i++) {
+        hfm::Mesh mesh;
+        mesh.meshIndex = i;
+        for (int y = 0; y < GRID_SIZE; y++) {
+            for (int x = 0; x < GRID_SIZE; x++) {
+                float height = sinf(0.3f * (float)(x * (i + 1)) + 0.7f * (float)y);
+                mesh.vertices.push_back(glm::vec3((float)x, height, (float)y));
+                mesh.texCoords.push_back(glm::vec2((float)x, (float)y) / (float)GRID_SIZE);
+                mesh.meshExtents.addPoint(mesh.vertices.back());
+            }
+        }
+
+        hfm::MeshPart part;
+        for (int y = 0; y < GRID_SIZE - 1; y++) {
+            for (int x = 0; x < GRID_SIZE - 1; x++) {
+                int corner = y * GRID_SIZE + x;
+                part.triangleIndices << corner << corner + GRID_SIZE << corner + 1;
+                part.triangleIndices << corner + 1 << corner + GRID_SIZE << corner + GRID_SIZE + 1;
+            }
+        }
+        mesh.parts.push_back(part);
+
+        hfm::Blendshape blendshape;
+        for (int j = 0; j < NUM_BLENDSHAPE_VERTICES; j++) {
+            int vertexIndex = (j * 7 + i) % mesh.vertices.size();
+            blendshape.indices << vertexIndex;
+            blendshape.vertices << mesh.vertices[vertexIndex] + glm::vec3(0.0f, 0.5f, 0.0f);
+        }
+        mesh.blendshapes << blendshape;
+
+        hfmModel->meshExtents.addExtents(mesh.meshExtents);
+        hfmModel->meshes.push_back(mesh);
+
+        hfm::Shape shape;
+        shape.mesh = i;
+        shape.meshPart = 0;
+        shape.material = 0;
+        shape.joint = 0;
+        hfmModel->shapes.push_back(shape);
+    }
+
+    return hfmModel;
+}
+
+static void verifyBuffersEqual(const gpu::BufferView& a, const gpu::BufferView& b) {
+    QCOMPARE((bool)a._buffer, (bool)b._buffer);
+    if (!a._buffer) {
+        return;
+    }
+    QCOMPARE(a._size, b._size);
+    QCOMPARE(memcmp(a._buffer->getData() + a._offset, b._buffer->getData() + b._offset, a._size), 0);
+}
+
+void ModelBakerTests::parallelBakeMatchesSerial() {
+    // the baker writes its outputs into the model it's given, so each bake gets its own copy
+    baker::Baker serialBaker(makeTestModel(), hifi::VariantHash(), hifi::URL());
+    serialBaker.run();
+    auto serialModel = serialBaker.getHFMModel();
+
+    auto workerPool = std::make_shared<task::WorkerPool>(NUM_WORKER_THREADS);
+    baker::Baker parallelBaker(makeTestModel(), hifi::VariantHash(), hifi::URL(), workerPool);
+    parallelBaker.run();
+    auto parallelModel = parallelBaker.getHFMModel();
+
+    QCOMPARE((int)serialModel->meshes.size(), NUM_MESHES);
+    QCOMPARE(parallelModel->meshes.size(), serialModel->meshes.size());
+    for (int i = 0; i < NUM_MESHES; i++) {
+        const hfm::Mesh& serialMesh = serialModel->meshes[i];
+        const hfm::Mesh& parallelMesh = parallelModel->meshes[i];
+
+        QCOMPARE(serialMesh.normals.size(), serialMesh.vertices.size());
+        QCOMPARE(serialMesh.tangents.size(), serialMesh.vertices.size());
+        QVERIFY(parallelMesh.normals == serialMesh.normals);
+        QVERIFY(parallelMesh.tangents == serialMesh.tangents);
+
+        QCOMPARE(parallelMesh.blendshapes.size(), serialMesh.blendshapes.size());
+        for (int j = 0; j < serialMesh.blendshapes.size(); j++) {
+            QVERIFY(!serialMesh.blendshapes[j].normals.empty());
+            QVERIFY(parallelMesh.blendshapes[j].normals == serialMesh.blendshapes[j].normals);
+            QVERIFY(parallelMesh.blendshapes[j].tangents == serialMesh.blendshapes[j].tangents);
+        }
+
+        QVERIFY(parallelMesh.triangleListMesh.vertices == serialMesh.triangleListMesh.vertices);
+        QVERIFY(parallelMesh.triangleListMesh.indices == serialMesh.triangleListMesh.indices);
+
+        QVERIFY(serialMesh._mesh);
+        QVERIFY(parallelMesh._mesh);
+        QCOMPARE(parallelMesh._mesh->displayName, serialMesh._mesh->displayName);
+        QCOMPARE(parallelMesh._mesh->getNumVertices(), serialMesh._mesh->getNumVertices());
+        QCOMPARE(parallelMesh._mesh->getNumIndices(), serialMesh._mesh->getNumIndices());
+        verifyBuffersEqual(parallelMesh._mesh->getVertexBuffer(), serialMesh._mesh->getVertexBuffer());
+        verifyBuffersEqual(parallelMesh._mesh->getIndexBuffer(), serialMesh._mesh->getIndexBuffer());
+        verifyBuffersEqual(parallelMesh._mesh->getAttributeBuffer(gpu::Stream::NORMAL),
+                           serialMesh._mesh->getAttributeBuffer(gpu::Stream::NORMAL));
+    }
+}
@@ -0,0 +1,23 @@
+//
+//  ModelBakerTests.h
+//  tests/model-baker/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelBakerTests_h
+#define hifi_ModelBakerTests_h
+
+#include <QtTest/QtTest>
+
+class ModelBakerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void parallelBakeMatchesSerial();
+};
+
+#endif // hifi_ModelBakerTests_h
@@ -13,6 +13,8 @@
 #include <test-utils/QTestExtensions.h>
 
 #include <NLPacket.h>
+#include <NLPacketList.h>
+#include <udt/PacketQueue.h>
 
 QTEST_MAIN(PacketTests)
 
@@ -180,3 +182,58 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::streamedPacketListTest() {
+    // enough for several windows of packets
+    const int STREAMED_SIZE = 200 * 1024;
+    auto streamedData = std::make_shared<QByteArray>(STREAMED_SIZE, 0);
+    for (int i = 0; i < STREAMED_SIZE; i++) {
+        (*streamedData)[i] = (char)(i * 7);
+    }
+    std::weak_ptr<QByteArray> weakStreamedData = streamedData;
+
+    auto packetList = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
+    packetList->write("header");
+    packetList->writeStreamed(streamedData->constData(), STREAMED_SIZE, streamedData);
+    QVERIFY(packetList->hasStreamedData());
+    // only the header has been made into a packet
+    QCOMPARE((int)packetList->getNumPackets(), 1);
+    streamedData.reset();
+
+    udt::PacketQueue queue;
+    queue.queuePacketList(std::move(packetList));
+
+    QByteArray message;
+    int numPackets = 0;
+    while (!queue.isEmpty()) {
+        auto packet = queue.takePacket();
+        QVERIFY(packet->isPartOfMessage());
+        QCOMPARE((int)packet->getMessagePartNumber(), numPackets);
+
+        auto expectedPosition = udt::Packet::PacketPosition::MIDDLE;
+        if (numPackets == 0) {
+            expectedPosition = udt::Packet::PacketPosition::FIRST;
+        } else if (queue.isEmpty()) {
+            expectedPosition = udt::Packet::PacketPosition::LAST;
+        }
+        QCOMPARE(packet->getPacketPosition(), expectedPosition);
+
+        // the rest of the data is only made into packets later on
+        if (numPackets == 0) {
+            QVERIFY(!weakStreamedData.expired());
+        }
+
+        auto nlPacket = static_cast<NLPacket*>(packet.get());
+        message.append(nlPacket->getPayload(), (int)nlPacket->getPayloadSize());
+        numPackets++;
+    }
+
+    // and is let go of once it was
+    QVERIFY(weakStreamedData.expired());
+    QVERIFY(numPackets > 2);
+    QCOMPARE(message.size(), 6 + STREAMED_SIZE);
+    QVERIFY(message.startsWith("header"));
+    for (int i = 0; i < STREAMED_SIZE; i++) {
+        QCOMPARE(message[6 + i], (char)(i * 7));
+    }
+}
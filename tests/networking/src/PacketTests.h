@@ -36,6 +36,9 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test a reliable packet list whose data is only made into packets as the queue gets to them
+    void streamedPacketListTest();
 };
 
 #endif // hifi_PacketTests_h
@@ -93,3 +93,113 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+void ResourceTests::requestScheduling() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->clear();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(1);
+
+    QObject owner;
+    auto createResource = [&](const QString& url, float priority) {
+        auto resource = QSharedPointer<Resource>::create(QUrl(url));
+        resource->setSelf(resource);
+        resource->setLoadPriority(&owner, priority);
+        return resource;
+    };
+    auto loading = createResource("http://example.com/loading.fst", 0.0f);
+    auto loadingFile = createResource("file:///models/loading.fst", 0.0f);
+    auto low = createResource("http://example.com/low.fst", 1.0f);
+    auto high = createResource("http://example.com/high.fst", 3.0f);
+    auto middle = createResource("http://example.com/middle.fst", 2.0f);
+    auto file = createResource("file:///models/file.fst", 0.5f);
+
+    // each host gets as many requests as its limit
+    QVERIFY(sharedItems->appendRequest(loading));
+    QVERIFY(sharedItems->appendRequest(loadingFile));
+    QVERIFY(!sharedItems->appendRequest(low));
+    QVERIFY(!sharedItems->appendRequest(high));
+    QVERIFY(!sharedItems->appendRequest(middle));
+    QVERIFY(!sharedItems->appendRequest(file));
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)4);
+
+    // nothing is handed out while all of the request slots are taken
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+
+    sharedItems->removeRequest(loading);
+    sharedItems->removeRequest(loadingFile);
+    QCOMPARE(sharedItems->getLoadingRequestsCount(), (uint32_t)0);
+
+    // local files go first, then the highest priorities
+    QVERIFY(sharedItems->getHighestPendingRequest() == file);
+    QVERIFY(sharedItems->getHighestPendingRequest() == high);
+
+    // changed priorities are picked up once they're refreshed
+    low->setLoadPriority(&owner, 10.0f);
+    sharedItems->updatePendingPriorities();
+    QVERIFY(sharedItems->getHighestPendingRequest() == low);
+
+    // freed resources are skipped
+    middle.reset();
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+// the throughput of a host that gives each request its share of the bandwidth up to the peak number of requests, past
+// which they get in each other's way
+static float getHostThroughput(uint32_t numRequests, uint32_t peakRequests) {
+    const float REQUEST_THROUGHPUT = 100.0f;
+    if (numRequests <= peakRequests) {
+        return REQUEST_THROUGHPUT * numRequests;
+    }
+    return REQUEST_THROUGHPUT * peakRequests * peakRequests / numRequests;
+}
+
+void ResourceTests::hostRequestLimit() {
+    const uint32_t MIN_LIMIT = 2;
+    const uint32_t MAX_LIMIT = 32;
+    const int NUM_SETTLED_WINDOWS = 20;
+
+    // climbs a request at a time to the peak
+    const uint32_t PEAK = 8;
+    HostRequestLimit limit(6);
+    for (uint32_t expected = 7; expected <= PEAK; expected++) {
+        limit.update(getHostThroughput(limit.get(), PEAK), MIN_LIMIT, MAX_LIMIT);
+        QCOMPARE(limit.get(), expected);
+    }
+
+    // then only looks a request either side of it
+    for (int i = 0; i < NUM_SETTLED_WINDOWS; i++) {
+        limit.update(getHostThroughput(limit.get(), PEAK), MIN_LIMIT, MAX_LIMIT);
+        QVERIFY(limit.get() >= PEAK - 1 && limit.get() <= PEAK + 1);
+    }
+
+    // comes back down when the host slows down
+    const uint32_t SLOWER_PEAK = 4;
+    const int MAX_WINDOWS_TO_SLOWER_PEAK = 8;
+    int numWindows = 0;
+    while (limit.get() > SLOWER_PEAK) {
+        limit.update(getHostThroughput(limit.get(), SLOWER_PEAK), MIN_LIMIT, MAX_LIMIT);
+        QVERIFY(++numWindows <= MAX_WINDOWS_TO_SLOWER_PEAK);
+    }
+    for (int i = 0; i < NUM_SETTLED_WINDOWS; i++) {
+        limit.update(getHostThroughput(limit.get(), SLOWER_PEAK), MIN_LIMIT, MAX_LIMIT);
+        QVERIFY(limit.get() >= SLOWER_PEAK - 1 && limit.get() <= SLOWER_PEAK + 1);
+    }
+
+    // and stays within its bounds however the host does
+    HostRequestLimit fastLimit(6);
+    const uint32_t FAST_MAX_LIMIT = 10;
+    for (int i = 0; i < NUM_SETTLED_WINDOWS; i++) {
+        fastLimit.update(getHostThroughput(fastLimit.get(), 100), MIN_LIMIT, FAST_MAX_LIMIT);
+        QVERIFY(fastLimit.get() <= FAST_MAX_LIMIT);
+    }
+    HostRequestLimit stalledLimit(6);
+    for (int i = 0; i < NUM_SETTLED_WINDOWS; i++) {
+        stalledLimit.update(0.0f, MIN_LIMIT, MAX_LIMIT);
+        QVERIFY(stalledLimit.get() >= MIN_LIMIT);
+    }
+    QCOMPARE(stalledLimit.get(), MIN_LIMIT);
+}
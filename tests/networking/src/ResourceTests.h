@@ -18,6 +18,8 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void requestScheduling();
+    void hostRequestLimit();
     void cleanupTestCase();
 };
 
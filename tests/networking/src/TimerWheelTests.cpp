@@ -0,0 +1,155 @@
+//
+//  TimerWheelTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <map>
+#include <random>
+
+#include <udt/TimerWheel.h>
+
+using namespace udt;
+
+QTEST_MAIN(TimerWheelTests)
+
+void TimerWheelTests::expiryTest() {
+    TimerWheel wheel(100);
+    TimerWheel::Timer early, late, past;
+    wheel.schedule(&late, 110);
+    wheel.schedule(&early, 105);
+    wheel.schedule(&past, 50);
+    QCOMPARE(wheel.getNumTimers(), 3);
+
+    // timers scheduled in the past expire right away
+    QCOMPARE(wheel.getNextTick(), (uint64_t)100);
+
+    std::vector<TimerWheel::Timer*> expired;
+    wheel.advance(104, expired);
+    QCOMPARE(expired.size(), (size_t)1);
+    QCOMPARE(expired[0], &past);
+    QVERIFY(!past.isScheduled());
+    QCOMPARE(wheel.getNextTick(), (uint64_t)105);
+
+    expired.clear();
+    wheel.advance(109, expired);
+    QCOMPARE(expired.size(), (size_t)1);
+    QCOMPARE(expired[0], &early);
+
+    expired.clear();
+    wheel.advance(110, expired);
+    QCOMPARE(expired.size(), (size_t)1);
+    QCOMPARE(expired[0], &late);
+    QVERIFY(wheel.isEmpty());
+    QCOMPARE(wheel.getCurrentTick(), (uint64_t)111);
+}
+
+void TimerWheelTests::cascadeTest() {
+    TimerWheel wheel(7);
+    const uint64_t expiries[] = { 70, 4100, 300000, 10000000 };
+    TimerWheel::Timer timers[4];
+    for (int i = 0; i < 4; ++i) {
+        wheel.schedule(&timers[i], expiries[i]);
+    }
+
+    // every timer expires on its tick, however many levels it went down
+    std::vector<TimerWheel::Timer*> expired;
+    for (int i = 0; i < 4; ++i) {
+        wheel.advance(expiries[i] - 1, expired);
+        QVERIFY(expired.empty());
+        QVERIFY(wheel.getNextTick() <= expiries[i]);
+
+        wheel.advance(expiries[i], expired);
+        QCOMPARE(expired.size(), (size_t)1);
+        QCOMPARE(expired[0], &timers[i]);
+        expired.clear();
+    }
+
+    // further than the wheel reaches is clamped
+    TimerWheel::Timer far;
+    wheel.schedule(&far, wheel.getCurrentTick() + TimerWheel::MAX_DELAY * 2);
+    QCOMPARE(far.expiry, wheel.getCurrentTick() + TimerWheel::MAX_DELAY);
+    wheel.cancel(&far);
+}
+
+void TimerWheelTests::cancelTest() {
+    TimerWheel wheel;
+    TimerWheel::Timer first, second;
+    wheel.schedule(&first, 10);
+    wheel.schedule(&second, 10);
+    wheel.cancel(&first);
+    QVERIFY(!first.isScheduled());
+
+    // rescheduling moves the timer
+    wheel.schedule(&second, 5000);
+    QCOMPARE(wheel.getNextTick(), (uint64_t)4096);
+
+    std::vector<TimerWheel::Timer*> expired;
+    wheel.advance(4999, expired);
+    QVERIFY(expired.empty());
+    wheel.advance(5000, expired);
+    QCOMPARE(expired.size(), (size_t)1);
+    QCOMPARE(expired[0], &second);
+}
+
+void TimerWheelTests::randomTest() {
+    // checks the wheel against a plain map of expiries
+    std::mt19937_64 generator(1);
+    const int NUM_TIMERS = 500;
+    const int NUM_STEPS = 5000;
+
+    uint64_t now = generator() % (uint64_t(1) << 30);
+    TimerWheel wheel(now);
+    std::vector<TimerWheel::Timer> timers(NUM_TIMERS);
+    std::map<TimerWheel::Timer*, uint64_t> expected;
+    std::vector<TimerWheel::Timer*> expired;
+
+    for (int step = 0; step < NUM_STEPS; ++step) {
+        TimerWheel::Timer* timer = &timers[generator() % NUM_TIMERS];
+        switch (generator() % 4) {
+            case 0:
+            case 1: {
+                const uint64_t MAX_DELAYS[] = { 70, 5000, 300000, uint64_t(1) << 25 };
+                uint64_t expiry = now + generator() % MAX_DELAYS[generator() % 4];
+                wheel.schedule(timer, expiry);
+                expected[timer] = std::min(expiry, now + TimerWheel::MAX_DELAY);
+                break;
+            }
+            case 2:
+                wheel.cancel(timer);
+                expected.erase(timer);
+                break;
+            default: {
+                uint64_t nextExpiry = std::numeric_limits<uint64_t>::max();
+                for (const auto& entry : expected) {
+                    nextExpiry = std::min(nextExpiry, entry.second);
+                }
+                QVERIFY(wheel.getNextTick() <= nextExpiry);
+
+                uint64_t tick = now + (generator() % 3 == 0 ? generator() % 100000 : generator() % 100);
+                expired.clear();
+                wheel.advance(tick, expired);
+                for (auto expiredTimer : expired) {
+                    auto it = expected.find(expiredTimer);
+                    QVERIFY(it != expected.end());
+                    QVERIFY(it->second >= now && it->second <= tick);
+                    expected.erase(it);
+                }
+                for (const auto& entry : expected) {
+                    QVERIFY(entry.second > tick);
+                }
+
+                now = tick + 1;
+                QCOMPARE(wheel.getCurrentTick(), now);
+                QCOMPARE(wheel.getNumTimers(), (int)expected.size());
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,339 @@
+//
+//  EntitySnapshotTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshotTests.h"
+
+#include <QtCore/QTemporaryDir>
+#include <QtScript/QScriptEngine>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreeSnapshot.h>
+
+QTEST_MAIN(EntitySnapshotTests)
+
+static const int NUM_TEST_ENTITIES = 1000;
+static const int NUM_BENCHMARK_ENTITIES = 20000;
+
+static EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+static QVector<EntityItemID> addTestEntities(EntityTreePointer tree, int numEntities) {
+    QVector<EntityItemID> entityIDs;
+    for (int i = 0; i < numEntities; ++i) {
+        EntityItemProperties properties;
+        properties.setType(i % 2 ? EntityTypes::Box : EntityTypes::Text);
+        properties.setName(QString("Entity %1").arg(i));
+        properties.setPosition(glm::vec3(i % 100, (i / 100) % 100, i / 10000));
+        properties.setDimensions(glm::vec3(0.5f + (i % 7)));
+        properties.setUserData(QString("{\"index\":%1}").arg(i));
+
+        EntityItemID entityID(QUuid::createUuid());
+        if (tree->addEntity(entityID, properties)) {
+            entityIDs << entityID;
+        }
+    }
+    return entityIDs;
+}
+
+// entities of several types, with properties from every group set away from their defaults, and one avatar entity
+static QVector<EntityItemID> addEntitiesOfEveryKind(EntityTreePointer tree) {
+    QVector<EntityItemProperties> entities;
+
+    EntityItemProperties avatarShape;
+    avatarShape.setType(EntityTypes::Shape);
+    avatarShape.setEntityHostType(entity::HostType::AVATAR);
+    avatarShape.setOwningAvatarID(QUuid::createUuid());
+    avatarShape.setShape("Cylinder");
+    avatarShape.setColor(u8vec3Color(10, 20, 30));
+    avatarShape.setAlpha(0.5f);
+    avatarShape.setRotation(glm::angleAxis(1.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))));
+    avatarShape.setRegistrationPoint(glm::vec3(0.25f, 0.5f, 0.75f));
+    avatarShape.setCollisionless(true);
+    avatarShape.setDynamic(true);
+    avatarShape.setGravity(glm::vec3(0.0f, -1.0f, 0.0f));
+    avatarShape.setDamping(0.5f);
+    avatarShape.setScript("http://example.com/script.js");
+    avatarShape.setDescription("An avatar entity");
+    avatarShape.setHref("hifi://example");
+    avatarShape.setCanCastShadow(false);
+    avatarShape.setIsVisibleInSecondaryCamera(false);
+    avatarShape.setRenderLayer(RenderLayer::FRONT);
+    avatarShape.setPrimitiveMode(PrimitiveMode::LINES);
+    avatarShape.setIgnorePickIntersection(true);
+    entities << avatarShape;
+
+    EntityItemProperties text;
+    text.setType(EntityTypes::Text);
+    text.setText("Snapshot");
+    text.setLineHeight(0.25f);
+    text.setTextColor(u8vec3Color(200, 100, 50));
+    text.setBackgroundColor(u8vec3Color(1, 2, 3));
+    text.setLeftMargin(0.1f);
+    text.setTopMargin(0.2f);
+    text.setUnlit(true);
+    text.setBillboardMode(BillboardMode::YAW);
+    entities << text;
+
+    EntityItemProperties model;
+    model.setType(EntityTypes::Model);
+    model.setModelURL("http://example.com/model.fbx");
+    model.setShapeType(SHAPE_TYPE_COMPOUND);
+    model.setCompoundShapeURL("http://example.com/hull.obj");
+    model.setTextures("{\"tex\":\"http://example.com/tex.png\"}");
+    model.setLocked(true);
+    entities << model;
+
+    EntityItemProperties light;
+    light.setType(EntityTypes::Light);
+    light.setIsSpotlight(true);
+    light.setIntensity(2.0f);
+    light.setFalloffRadius(3.0f);
+    light.setCutoff(45.0f);
+    light.setExponent(2.0f);
+    entities << light;
+
+    EntityItemProperties zone;
+    zone.setType(EntityTypes::Zone);
+    zone.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    zone.setSkyboxMode(COMPONENT_MODE_DISABLED);
+    zone.setFlyingAllowed(false);
+    zone.setGhostingAllowed(false);
+    entities << zone;
+
+    EntityItemProperties material;
+    material.setType(EntityTypes::Material);
+    material.setMaterialURL("materialData");
+    material.setMaterialData("{\"materials\":{\"albedo\":[1,0,0]}}");
+    material.setPriority(2);
+    material.setParentMaterialName("0");
+    material.setMaterialMappingMode(PROJECTED);
+    entities << material;
+
+    EntityItemProperties web;
+    web.setType(EntityTypes::Web);
+    web.setSourceUrl("http://example.com/");
+    web.setDPI(60);
+    web.setMaxFPS(30);
+    entities << web;
+
+    EntityItemProperties image;
+    image.setType(EntityTypes::Image);
+    image.setImageURL("http://example.com/image.png");
+    image.setEmissive(true);
+    image.setKeepAspectRatio(false);
+    image.setSubImage(QRect(1, 2, 3, 4));
+    entities << image;
+
+    QVector<EntityItemID> entityIDs;
+    for (int i = 0; i < entities.size(); ++i) {
+        EntityItemProperties& properties = entities[i];
+        properties.setName(QString("Entity %1").arg(i));
+        properties.setPosition(glm::vec3(i, 2.0f * i, 3.0f * i));
+        properties.setDimensions(glm::vec3(1.0f + i));
+        properties.setUserData(QString("{\"index\":%1}").arg(i));
+
+        EntityItemID entityID(QUuid::createUuid());
+        if (tree->addEntity(entityID, properties)) {
+            entityIDs << entityID;
+        }
+    }
+    return entityIDs;
+}
+
+// rotations are packed into 16 bits per component, so numbers only have to come back nearly the same
+static bool fuzzyCompare(const QVariant& a, const QVariant& b) {
+    const double NUMBER_TOLERANCE = 0.0001;
+
+    if (a.type() == QVariant::Map && b.type() == QVariant::Map) {
+        QVariantMap mapA = a.toMap();
+        QVariantMap mapB = b.toMap();
+        if (mapA.keys() != mapB.keys()) {
+            return false;
+        }
+        for (auto it = mapA.constBegin(); it != mapA.constEnd(); ++it) {
+            if (!fuzzyCompare(it.value(), mapB.value(it.key()))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (a.type() == QVariant::List && b.type() == QVariant::List) {
+        QVariantList listA = a.toList();
+        QVariantList listB = b.toList();
+        if (listA.size() != listB.size()) {
+            return false;
+        }
+        for (int i = 0; i < listA.size(); ++i) {
+            if (!fuzzyCompare(listA[i], listB[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (a.type() == QVariant::Double && b.type() == QVariant::Double) {
+        return fabs(a.toDouble() - b.toDouble()) <= NUMBER_TOLERANCE;
+    }
+    return a == b;
+}
+
+static QVariantMap getAllProperties(EntityItemPointer entity, QScriptEngine& engine) {
+    return entity->getProperties().copyToScriptValue(&engine, false, true, true).toVariant().toMap();
+}
+
+static bool writeSnapshot(EntityTreePointer tree, const QString& filename, PacketVersion version) {
+    QVector<QByteArray> items;
+    if (!tree->writeToSnapshot(items)) {
+        return false;
+    }
+
+    OctreeSnapshot::Info info;
+    info.dataPacketType = tree->expectedDataPacketType();
+    info.dataPacketVersion = version;
+    info.id = tree->getPersistID();
+    info.dataVersion = tree->getPersistDataVersion();
+    return OctreeSnapshot::write(filename, info, items);
+}
+
+void EntitySnapshotTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+void EntitySnapshotTests::snapshotRoundTrip() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.json.gz.snapshot");
+
+    EntityTreePointer tree = createTree();
+    QVector<EntityItemID> entityIDs = addTestEntities(tree, NUM_TEST_ENTITIES);
+    QCOMPARE(entityIDs.size(), NUM_TEST_ENTITIES);
+    tree->incrementPersistDataVersion();
+    QVERIFY(writeSnapshot(tree, filename, tree->expectedVersion()));
+
+    OctreeSnapshot snapshot;
+    QVERIFY(snapshot.open(filename));
+    QCOMPARE(snapshot.getNumItems(), NUM_TEST_ENTITIES);
+    QCOMPARE(snapshot.getInfo().id, tree->getPersistID());
+    QCOMPARE(snapshot.getInfo().dataVersion, (int64_t)tree->getPersistDataVersion());
+
+    EntityTreePointer loadedTree = createTree();
+    QVERIFY(loadedTree->readFromSnapshot(snapshot));
+    QCOMPARE(loadedTree->getPersistID(), tree->getPersistID());
+
+    for (const auto& entityID : entityIDs) {
+        EntityItemPointer entity = tree->findEntityByEntityItemID(entityID);
+        EntityItemPointer loadedEntity = loadedTree->findEntityByEntityItemID(entityID);
+        QVERIFY(loadedEntity);
+        QCOMPARE(loadedEntity->getType(), entity->getType());
+        QCOMPARE(loadedEntity->getName(), entity->getName());
+        QCOMPARE(loadedEntity->getWorldPosition(), entity->getWorldPosition());
+        QCOMPARE(loadedEntity->getScaledDimensions(), entity->getScaledDimensions());
+        QCOMPARE(loadedEntity->getUserData(), entity->getUserData());
+        QCOMPARE(loadedEntity->getCreated(), entity->getCreated());
+    }
+}
+
+void EntitySnapshotTests::allPropertiesRoundTrip() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.json.gz.snapshot");
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->setSessionUUID(QUuid::createUuid());
+
+    EntityTreePointer tree = createTree();
+    QVector<EntityItemID> entityIDs = addEntitiesOfEveryKind(tree);
+    QVERIFY(writeSnapshot(tree, filename, tree->expectedVersion()));
+
+    OctreeSnapshot snapshot;
+    QVERIFY(snapshot.open(filename));
+    QCOMPARE(snapshot.getNumItems(), entityIDs.size());
+
+    EntityTreePointer loadedTree = createTree();
+    QVERIFY(loadedTree->readFromSnapshot(snapshot));
+
+    QScriptEngine engine;
+    for (const auto& entityID : entityIDs) {
+        EntityItemPointer entity = tree->findEntityByEntityItemID(entityID);
+        EntityItemPointer loadedEntity = loadedTree->findEntityByEntityItemID(entityID);
+        QVERIFY(loadedEntity);
+
+        // like content loaded from JSON, avatar entities belong to this session's avatar
+        QCOMPARE(loadedEntity->getEntityHostType(), entity->getEntityHostType());
+        if (entity->getEntityHostType() == entity::HostType::AVATAR) {
+            QCOMPARE(loadedEntity->getOwningAvatarID(), nodeList->getSessionUUID());
+        }
+
+        // everything else comes back as it was, apart from when the entity was last edited
+        QVariantMap properties = getAllProperties(entity, engine);
+        QVariantMap loadedProperties = getAllProperties(loadedEntity, engine);
+        for (const auto& key : { "lastEdited", "owningAvatarID" }) {
+            properties.remove(key);
+            loadedProperties.remove(key);
+        }
+        QCOMPARE(loadedProperties.keys(), properties.keys());
+        for (auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+            QVERIFY2(fuzzyCompare(loadedProperties.value(it.key()), it.value()), qPrintable(it.key()));
+        }
+    }
+}
+
+void EntitySnapshotTests::outOfDateSnapshot() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.json.gz.snapshot");
+
+    EntityTreePointer tree = createTree();
+    addTestEntities(tree, NUM_TEST_ENTITIES);
+    QVERIFY(writeSnapshot(tree, filename, tree->expectedVersion() - 1));
+
+    // entities encoded by another version are never decoded
+    OctreeSnapshot snapshot;
+    QVERIFY(snapshot.open(filename));
+    EntityTreePointer loadedTree = createTree();
+    QVERIFY(!loadedTree->readFromSnapshot(snapshot));
+    QVERIFY(loadedTree->getRoot()->isLeaf());
+}
+
+void EntitySnapshotTests::benchmarkJSONLoad() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.json.gz");
+
+    EntityTreePointer tree = createTree();
+    addTestEntities(tree, NUM_BENCHMARK_ENTITIES);
+    QVERIFY(tree->writeToFile(filename.toLocal8Bit().constData()));
+
+    QBENCHMARK {
+        EntityTreePointer loadedTree = createTree();
+        QVERIFY(loadedTree->readFromFile(filename.toLocal8Bit().constData()));
+    }
+}
+
+void EntitySnapshotTests::benchmarkSnapshotLoad() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.json.gz.snapshot");
+
+    EntityTreePointer tree = createTree();
+    addTestEntities(tree, NUM_BENCHMARK_ENTITIES);
+    QVERIFY(writeSnapshot(tree, filename, tree->expectedVersion()));
+
+    QBENCHMARK {
+        EntityTreePointer loadedTree = createTree();
+        OctreeSnapshot snapshot;
+        QVERIFY(snapshot.open(filename));
+        QVERIFY(loadedTree->readFromSnapshot(snapshot));
+    }
+}
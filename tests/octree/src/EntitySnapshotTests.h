@@ -0,0 +1,31 @@
+//
+//  EntitySnapshotTests.h
+//  tests/octree/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySnapshotTests_h
+#define hifi_EntitySnapshotTests_h
+
+#include <QtTest/QtTest>
+
+class EntitySnapshotTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void snapshotRoundTrip();
+    void allPropertiesRoundTrip();
+    void outOfDateSnapshot();
+
+    // load times of the same entities from the JSON persist file and from a snapshot
+    void benchmarkJSONLoad();
+    void benchmarkSnapshotLoad();
+};
+
+#endif // hifi_EntitySnapshotTests_h
@@ -13,6 +13,7 @@
 
 #include <iostream>
 
+#include <CollisionShapeCache.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -218,9 +219,14 @@ void ShapeManagerTests::addCompoundShape() {
     info.setParams(SHAPE_TYPE_COMPOUND, halfExtents);
     info.setPointCollection(pointCollection);
 
-    // create the shape
+    // compounds are built on a worker, the shape isn't available right away
     ShapeManager shapeManager;
-    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(shapeManager.getShape(info) == nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)1);
+    QTRY_COMPARE(shapeManager.getWorkDeliveryCount(), (uint32_t)1);
+
+    // take the shape once it's delivered
+    const btCollisionShape* shape = shapeManager.getShapeByKey(info.getHash());
     QVERIFY(shape != nullptr);
 
     // verify the shape is correct type
@@ -244,3 +250,94 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::serializeCompoundShape() {
+    // a compound of two offset boxes' worth of hull points
+    ShapeInfo::PointCollection pointCollection;
+    for (int i = 0; i < 2; ++i) {
+        glm::vec3 offset((float)(2 * i), 0.0f, 0.0f);
+        ShapeInfo::PointList pointList;
+        for (int j = 0; j < 8; ++j) {
+            glm::vec3 corner((j & 1) ? 0.5f : -0.5f, (j & 2) ? 0.5f : -0.5f, (j & 4) ? 0.5f : -0.5f);
+            pointList.push_back(corner + offset);
+        }
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(1.5f, 0.5f, 0.5f));
+    info.setPointCollection(pointCollection);
+
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape != nullptr);
+    QVERIFY(CollisionShapeCache::isCacheable(shape));
+
+    uint64_t hash = info.getHash();
+    QByteArray digest = CollisionShapeCache::getContentDigest(info);
+    QByteArray data = CollisionShapeCache::serializeShape(hash, digest, shape);
+
+    // the hash is checked, so a file for a different shape is never used
+    QVERIFY(CollisionShapeCache::deserializeShape(hash + 1, digest, data) == nullptr);
+    // and so is truncation
+    QVERIFY(CollisionShapeCache::deserializeShape(hash, digest, data.left(data.size() - 1)) == nullptr);
+
+    const btCollisionShape* loadedShape = CollisionShapeCache::deserializeShape(hash, digest, data);
+    QVERIFY(loadedShape != nullptr);
+    QCOMPARE(loadedShape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    const btCompoundShape* loadedCompound = static_cast<const btCompoundShape*>(loadedShape);
+    QCOMPARE(loadedCompound->getNumChildShapes(), compound->getNumChildShapes());
+    for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+        auto hull = static_cast<const btConvexHullShape*>(compound->getChildShape(i));
+        auto loadedHull = static_cast<const btConvexHullShape*>(loadedCompound->getChildShape(i));
+        QCOMPARE(loadedHull->getMargin(), hull->getMargin());
+        QCOMPARE(loadedHull->getNumPoints(), hull->getNumPoints());
+        for (int j = 0; j < hull->getNumPoints(); ++j) {
+            QVERIFY(loadedHull->getUnscaledPoints()[j] == hull->getUnscaledPoints()[j]);
+        }
+        QVERIFY(loadedCompound->getChildTransform(i).getOrigin() == compound->getChildTransform(i).getOrigin());
+    }
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(loadedShape);
+}
+
+void ShapeManagerTests::changedShapeMissesCache() {
+    ShapeInfo::PointCollection pointCollection;
+    ShapeInfo::PointList pointList;
+    for (int j = 0; j < 8; ++j) {
+        pointList.push_back(glm::vec3((j & 1) ? 0.5f : -0.5f, (j & 2) ? 0.5f : -0.5f, (j & 4) ? 0.5f : -0.5f));
+    }
+    pointCollection.push_back(pointList);
+
+    const QString url("http://example.com/model.fbx");
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(0.5f), url);
+    info.setPointCollection(pointCollection);
+
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape != nullptr);
+    uint64_t hash = info.getHash();
+    QByteArray digest = CollisionShapeCache::getContentDigest(info);
+    QByteArray data = CollisionShapeCache::serializeShape(hash, digest, shape);
+
+    // the model behind the url changes within the same bounds
+    pointCollection[0][0] = glm::vec3(-0.4f, -0.5f, -0.5f);
+    ShapeInfo changedInfo;
+    changedInfo.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(0.5f), url);
+    changedInfo.setPointCollection(pointCollection);
+
+    // which its hash doesn't tell, but its digest does
+    QCOMPARE(changedInfo.getHash(), hash);
+    QByteArray changedDigest = CollisionShapeCache::getContentDigest(changedInfo);
+    QVERIFY(changedDigest != digest);
+    QVERIFY(CollisionShapeCache::deserializeShape(hash, changedDigest, data) == nullptr);
+
+    // while the same points still hit
+    QCOMPARE(CollisionShapeCache::getContentDigest(info), digest);
+    const btCollisionShape* loadedShape = CollisionShapeCache::deserializeShape(hash, digest, data);
+    QVERIFY(loadedShape != nullptr);
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(loadedShape);
+}
@@ -0,0 +1,193 @@
+//
+//  CullSortTests.cpp
+//  tests/render/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullSortTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+
+#include <QtCore/QThread>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <render/CullTask.h>
+#include <render/SortTask.h>
+
+QTEST_MAIN(CullSortTests)
+
+using namespace render;
+
+namespace {
+
+struct TestItem {
+    using Pointer = std::shared_ptr<TestItem>;
+    AABox bound;
+};
+
+}
+
+namespace render {
+template <> const ItemKey payloadGetKey(const TestItem::Pointer& item) {
+    return ItemKey::Builder::opaqueShape();
+}
+template <> const Item::Bound payloadGetBound(const TestItem::Pointer& item) {
+    return item->bound;
+}
+}
+
+namespace {
+
+const size_t NUM_BENCHMARK_ITEMS = 100000;
+
+// the render context of a view looking into a cube of randomly sized and placed items, without a gpu context
+class TestView {
+public:
+    TestView(size_t numItems) {
+        const float TREE_SCALE = 32768.0f;
+        _scene = std::make_shared<Scene>(glm::vec3(-0.5f * TREE_SCALE), TREE_SCALE);
+
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> size(0.05f, 2.0f);
+        Transaction transaction;
+        for (size_t i = 0; i < numItems; i++) {
+            auto item = std::make_shared<TestItem>();
+            glm::vec3 corner(position(generator), position(generator), position(generator));
+            item->bound = AABox(corner, glm::vec3(size(generator), size(generator), size(generator)));
+            transaction.resetItem(_scene->allocateID(), std::make_shared<Payload<TestItem>>(item));
+        }
+        _scene->enqueueTransaction(transaction);
+        _scene->enqueueFrame();
+        _scene->processTransactionQueue();
+
+        ViewFrustum frustum;
+        frustum.setPosition(glm::vec3(0.0f, 0.0f, 50.0f));
+        frustum.setOrientation(glm::quat());
+        frustum.setProjection(glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 500.0f));
+        frustum.calculate();
+        _args.setViewFrustum(frustum);
+        _args._scene = _scene;
+
+        _renderContext = std::make_shared<RenderContext>();
+        _renderContext->args = &_args;
+        _renderContext->_scene = _scene;
+        _renderContext->jobConfig = std::make_shared<CullSpatialSelection::Config>();
+    }
+
+    void setWorkerPool(const task::WorkerPoolPointer& workerPool) { _renderContext->workerPool = workerPool; }
+
+    // fetches, culls and sorts the opaques front to back, returns the sorted items
+    ItemBounds run() {
+        const auto filter = ItemFilter::Builder::visibleWorldItems().withoutLayered().build();
+        ItemSpatialTree::ItemSelection selection;
+        _fetch.run(_renderContext, FetchSpatialTree::Inputs(filter, glm::ivec2(0, 0)), selection);
+
+        ItemBounds culledItems;
+        _cull.run(_renderContext, CullSpatialSelection::Inputs(selection, filter), culledItems);
+
+        ItemBounds sortedItems;
+        _sort.run(_renderContext, culledItems, sortedItems);
+        return sortedItems;
+    }
+
+private:
+    static bool cullFunctor(const RenderArgs* args, const AABox& bounds) {
+        auto eyeToBound = args->getViewFrustum().getPosition() - bounds.calcCenter();
+        auto dimensions = bounds.getDimensions();
+        return 0.25f * glm::dot(dimensions, dimensions) >= args->_lodAngleHalfTanSq * glm::dot(eyeToBound, eyeToBound);
+    }
+
+    ScenePointer _scene;
+    RenderArgs _args;
+    RenderContextPointer _renderContext;
+    FetchSpatialTree _fetch;
+    CullSpatialSelection _cull { cullFunctor, false, RenderDetails::ITEM };
+    DepthSortItems _sort;
+};
+
+}
+
+void CullSortTests::testParallelFor() {
+    task::WorkerPool workerPool(3);
+    QCOMPARE(workerPool.getNumThreads(), 4);
+    QCOMPARE(task::WorkerPool::getNumRanges(0, 10), (size_t)0);
+    QCOMPARE(task::WorkerPool::getNumRanges(10, 10), (size_t)1);
+    QCOMPARE(task::WorkerPool::getNumRanges(11, 10), (size_t)2);
+
+    for (size_t count : { (size_t)0, (size_t)1, (size_t)7, (size_t)1000, (size_t)10007 }) {
+        std::vector<std::atomic<int>> visits(count);
+        for (auto& visit : visits) {
+            visit = 0;
+        }
+        std::vector<std::atomic<int>> rangeVisits(task::WorkerPool::getNumRanges(count, 16));
+        for (auto& visit : rangeVisits) {
+            visit = 0;
+        }
+
+        std::atomic<int> numBadRanges { 0 };
+        workerPool.parallelFor(count, 16, [&](size_t rangeIndex, size_t begin, size_t end) {
+            if (begin != rangeIndex * 16 || end > count) {
+                numBadRanges++;
+                return;
+            }
+            rangeVisits[rangeIndex]++;
+            for (size_t i = begin; i < end; i++) {
+                visits[i]++;
+            }
+        });
+
+        QCOMPARE((int)numBadRanges, 0);
+        for (const auto& visit : visits) {
+            QCOMPARE((int)visit, 1);
+        }
+        for (const auto& visit : rangeVisits) {
+            QCOMPARE((int)visit, 1);
+        }
+    }
+
+    // loops started from within a loop still get done
+    std::atomic<int> numVisits { 0 };
+    workerPool.parallelFor(8, 1, [&](size_t, size_t, size_t) {
+        workerPool.parallelFor(100, 10, [&](size_t, size_t begin, size_t end) {
+            numVisits += (int)(end - begin);
+        });
+    });
+    QCOMPARE((int)numVisits, 800);
+}
+
+void CullSortTests::testCullSortMatchesSerial() {
+    TestView view(20000);
+    auto serialItems = view.run();
+    QVERIFY(!serialItems.empty());
+
+    view.setWorkerPool(std::make_shared<task::WorkerPool>(3));
+    auto parallelItems = view.run();
+
+    QCOMPARE(parallelItems.size(), serialItems.size());
+    for (size_t i = 0; i < serialItems.size(); i++) {
+        QCOMPARE(parallelItems[i].id, serialItems[i].id);
+    }
+}
+
+void CullSortTests::benchmarkCullSortSerial() {
+    TestView view(NUM_BENCHMARK_ITEMS);
+    QBENCHMARK {
+        view.run();
+    }
+}
+
+void CullSortTests::benchmarkCullSortParallel() {
+    TestView view(NUM_BENCHMARK_ITEMS);
+    view.setWorkerPool(std::make_shared<task::WorkerPool>(std::max(QThread::idealThreadCount() - 1, 1)));
+    QBENCHMARK {
+        view.run();
+    }
+}
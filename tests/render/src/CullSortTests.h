@@ -0,0 +1,28 @@
+//
+//  CullSortTests.h
+//  tests/render/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CullSortTests_h
+#define hifi_CullSortTests_h
+
+#include <QtTest/QtTest>
+
+class CullSortTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testParallelFor();
+    void testCullSortMatchesSerial();
+
+    // the fetch, cull and sort jobs of a view over a 100k item scene, with no gpu context
+    void benchmarkCullSortSerial();
+    void benchmarkCullSortParallel();
+};
+
+#endif // hifi_CullSortTests_h
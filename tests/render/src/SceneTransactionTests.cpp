@@ -0,0 +1,224 @@
+//
+//  SceneTransactionTests.cpp
+//  tests/render/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTransactionTests.h"
+
+#include <chrono>
+#include <thread>
+
+#include <render/Scene.h>
+
+QTEST_MAIN(SceneTransactionTests)
+
+using namespace render;
+
+namespace {
+
+struct TestItem {
+    using Pointer = std::shared_ptr<TestItem>;
+    std::vector<int> updates;
+};
+
+}
+
+namespace render {
+template <> const ItemKey payloadGetKey(const TestItem::Pointer& item) {
+    return ItemKey::Builder::opaqueShape();
+}
+template <> const Item::Bound payloadGetBound(const TestItem::Pointer& item) {
+    return Item::Bound(glm::vec3(0.0f), 1.0f);
+}
+}
+
+namespace {
+
+const size_t NUM_BENCHMARK_ITEMS = 100000;
+
+ScenePointer makeScene() {
+    const float TREE_SCALE = 32768.0f;
+    return std::make_shared<Scene>(glm::vec3(-0.5f * TREE_SCALE), TREE_SCALE);
+}
+
+PayloadPointer makePayload(const TestItem::Pointer& item) {
+    return std::make_shared<Payload<TestItem>>(item);
+}
+
+void appendUpdate(Transaction& transaction, ItemID id, int update) {
+    transaction.updateItem<TestItem>(id, [update](TestItem& item) {
+        item.updates.push_back(update);
+    });
+}
+
+}
+
+void SceneTransactionTests::testCoalesce() {
+    auto scene = makeScene();
+    auto firstA = std::make_shared<TestItem>();
+    auto lastA = std::make_shared<TestItem>();
+    auto b = std::make_shared<TestItem>();
+    ItemID idA = scene->allocateID();
+    ItemID idB = scene->allocateID();
+    ItemID idC = scene->allocateID();
+
+    Transaction transaction;
+    transaction.resetItem(idA, makePayload(firstA));
+    transaction.resetItem(idB, makePayload(b));
+    transaction.resetItem(idC, makePayload(std::make_shared<TestItem>()));
+    transaction.resetItem(idA, makePayload(lastA));
+    appendUpdate(transaction, idA, 1);
+    transaction.updateItem(idA);
+    appendUpdate(transaction, idB, 2);
+    transaction.updateItem(idC);
+    transaction.updateItem(idC);
+    appendUpdate(transaction, idA, 3);
+    transaction.removeItem(idB);
+    transaction.removeItem(idB);
+
+    // the first reset of A, B's reset, update and second remove, A's and one of C's functor-less updates
+    QCOMPARE(transaction.getNumItemChanges(), (size_t)12);
+    QCOMPARE(transaction.coalesce(), (size_t)6);
+    QCOMPARE(transaction.getNumItemChanges(), (size_t)6);
+    QCOMPARE(transaction.coalesce(), (size_t)0);
+
+    scene->enqueueTransaction(transaction);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    QVERIFY(scene->getItem(idA).exist());
+    QVERIFY(!scene->getItem(idB).exist());
+    QVERIFY(scene->getItem(idC).exist());
+    QVERIFY(firstA->updates.empty());
+    QCOMPARE(lastA->updates, std::vector<int>({ 1, 3 }));
+    QVERIFY(b->updates.empty());
+
+    // the changes of different transactions of a frame are coalesced together
+    scene->enqueueTransaction(Transaction());
+    for (int i = 0; i < 3; i++) {
+        Transaction update;
+        update.updateItem(idC);
+        scene->enqueueTransaction(update);
+    }
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+    QCOMPARE(scene->getTransactionStats().numCoalescedChanges, (uint32_t)2);
+    QCOMPARE(scene->getTransactionStats().numAppliedChanges, (uint32_t)1);
+}
+
+void SceneTransactionTests::testBudgetCarriesOver() {
+    const size_t NUM_ITEMS = 10000;
+    auto scene = makeScene();
+
+    std::vector<ItemID> ids;
+    std::vector<TestItem::Pointer> items;
+    Transaction resets;
+    for (size_t i = 0; i < NUM_ITEMS; i++) {
+        ids.push_back(scene->allocateID());
+        items.push_back(std::make_shared<TestItem>());
+        resets.resetItem(ids.back(), makePayload(items.back()));
+    }
+    scene->enqueueTransaction(resets);
+    scene->enqueueFrame();
+
+    // the next frame's updates only get applied once the resets they follow are
+    Transaction updates;
+    for (size_t i = 0; i < NUM_ITEMS; i++) {
+        appendUpdate(updates, ids[i], (int)i);
+    }
+    Selection selection("test", ItemIDs({ ids.front(), ids.back() }));
+    updates.resetSelection(selection);
+    scene->enqueueTransaction(updates);
+    scene->enqueueFrame();
+
+    const auto BUDGET = std::chrono::microseconds(1);
+    scene->processTransactionQueue(BUDGET);
+    const auto& stats = scene->getTransactionStats();
+    QVERIFY(stats.numAppliedChanges > 0);
+    QCOMPARE((size_t)(stats.numAppliedChanges + stats.numPendingChanges), 2 * NUM_ITEMS);
+
+    size_t numCalls = 1;
+    size_t numAppliedChanges = stats.numAppliedChanges;
+    while (stats.numPendingChanges > 0) {
+        QVERIFY(scene->getSelection("test").isEmpty());
+        scene->processTransactionQueue(BUDGET);
+        QVERIFY(stats.numAppliedChanges > 0);
+        numAppliedChanges += stats.numAppliedChanges;
+        numCalls++;
+    }
+    QCOMPARE(numAppliedChanges, 2 * NUM_ITEMS);
+    QVERIFY(numCalls > 1);
+
+    for (size_t i = 0; i < NUM_ITEMS; i++) {
+        QVERIFY(scene->getItem(ids[i]).exist());
+        QCOMPARE(items[i]->updates, std::vector<int>({ (int)i }));
+    }
+    QCOMPARE(scene->getSelection("test").getItems().size(), (size_t)2);
+
+    // with nothing left, the next call has nothing to do
+    scene->processTransactionQueue(BUDGET);
+    QCOMPARE(stats.numAppliedChanges, (uint32_t)0);
+    QCOMPARE(stats.numPendingChanges, (uint32_t)0);
+}
+
+void SceneTransactionTests::testConcurrentEnqueue() {
+    const int NUM_THREADS = 4;
+    const int NUM_TRANSACTIONS_PER_THREAD = 2000;
+    auto scene = makeScene();
+
+    std::vector<std::vector<ItemID>> ids(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < NUM_TRANSACTIONS_PER_THREAD; i++) {
+                Transaction transaction;
+                ItemID id = scene->allocateID();
+                ids[t].push_back(id);
+                transaction.resetItem(id, makePayload(std::make_shared<TestItem>()));
+                scene->enqueueTransaction(std::move(transaction));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    QCOMPARE(scene->getTransactionQueueSize(), (size_t)(NUM_THREADS * NUM_TRANSACTIONS_PER_THREAD));
+    scene->enqueueFrame();
+    QCOMPARE(scene->getTransactionQueueSize(), (size_t)0);
+    scene->processTransactionQueue();
+
+    for (const auto& threadIDs : ids) {
+        for (auto id : threadIDs) {
+            QVERIFY(scene->getItem(id).exist());
+        }
+    }
+}
+
+void SceneTransactionTests::benchmarkApplyChanges() {
+    auto scene = makeScene();
+    std::vector<ItemID> ids;
+    Transaction resets;
+    for (size_t i = 0; i < NUM_BENCHMARK_ITEMS; i++) {
+        ids.push_back(scene->allocateID());
+        resets.resetItem(ids.back(), makePayload(std::make_shared<TestItem>()));
+    }
+    scene->enqueueTransaction(resets);
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    QBENCHMARK {
+        Transaction updates;
+        for (auto id : ids) {
+            updates.updateItem(id);
+        }
+        scene->enqueueTransaction(std::move(updates));
+        scene->enqueueFrame();
+        scene->processTransactionQueue();
+    }
+}
@@ -0,0 +1,28 @@
+//
+//  SceneTransactionTests.h
+//  tests/render/src
+//
+//  Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SceneTransactionTests_h
+#define hifi_SceneTransactionTests_h
+
+#include <QtTest/QtTest>
+
+class SceneTransactionTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCoalesce();
+    void testBudgetCarriesOver();
+    void testConcurrentEnqueue();
+
+    // enqueuing and applying the updates of 100k items
+    void benchmarkApplyChanges();
+};
+
+#endif // hifi_SceneTransactionTests_h
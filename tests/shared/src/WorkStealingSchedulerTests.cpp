@@ -0,0 +1,115 @@
+//
+// WorkStealingSchedulerTests.cpp
+// tests/shared/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingSchedulerTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <shared/FrameBarrier.h>
+#include <shared/WorkStealingScheduler.h>
+
+QTEST_MAIN(WorkStealingSchedulerTests)
+
+void WorkStealingSchedulerTests::balanceTest() {
+    // one expensive item followed by many cheap ones should leave the expensive item alone in the first chunk
+    std::vector<uint64_t> costs(101, 1);
+    costs[0] = 100;
+
+    WorkStealingScheduler scheduler;
+    scheduler.reset(2, costs);
+
+    uint32_t index;
+    QVERIFY(scheduler.next(0, index));
+    QCOMPARE(index, (uint32_t)0);
+    QVERIFY(scheduler.next(1, index));
+    QCOMPARE(index, (uint32_t)1);
+
+    // worker 0 is now out of its own work, and steals from the back of worker 1
+    QVERIFY(scheduler.next(0, index));
+    QVERIFY(index > 1);
+    QCOMPARE(scheduler.getNumSteals(), 1);
+}
+
+void WorkStealingSchedulerTests::singleWorkerTest() {
+    const uint32_t NUM_ITEMS = 10;
+    WorkStealingScheduler scheduler;
+    scheduler.reset(1, std::vector<uint64_t>(NUM_ITEMS, 1));
+
+    uint32_t index;
+    for (uint32_t i = 0; i < NUM_ITEMS; ++i) {
+        QVERIFY(scheduler.next(0, index));
+        QCOMPARE(index, i);
+    }
+    QVERIFY(!scheduler.next(0, index));
+
+    scheduler.reset(1, {});
+    QVERIFY(!scheduler.next(0, index));
+}
+
+void WorkStealingSchedulerTests::concurrentFramesTest() {
+    const int NUM_WORKERS = 4;
+    const int NUM_FRAMES = 200;
+    const int NUM_ITEMS = 1000;
+
+    WorkStealingScheduler scheduler;
+    FrameBarrier barrier;
+    std::vector<std::atomic<int>> visits(NUM_ITEMS);
+    for (auto& count : visits) {
+        count = 0;
+    }
+    std::atomic<bool> stop { false };
+
+    std::vector<std::thread> workers;
+    for (int worker = 0; worker < NUM_WORKERS; ++worker) {
+        workers.emplace_back([&, worker] {
+            uint32_t frame = 0;
+            while (true) {
+                frame = barrier.waitForFrame(frame);
+                bool stopping = stop;
+
+                uint32_t index;
+                while (scheduler.next(worker, index)) {
+                    ++visits[index];
+                }
+
+                barrier.finish();
+                if (stopping) {
+                    return;
+                }
+            }
+        });
+    }
+
+    // uneven costs so that the initial split differs from frame to frame
+    std::vector<uint64_t> costs(NUM_ITEMS);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            costs[i] = 1 + (i * (frame + 1)) % 17;
+        }
+        scheduler.reset(NUM_WORKERS, costs);
+        barrier.start(NUM_WORKERS);
+        barrier.wait();
+    }
+
+    stop = true;
+    scheduler.reset(NUM_WORKERS, {});
+    barrier.start(NUM_WORKERS);
+    barrier.wait();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // every item was processed exactly once per frame
+    for (auto& count : visits) {
+        QCOMPARE((int)count, NUM_FRAMES);
+    }
+}
@@ -0,0 +1,24 @@
+//
+// WorkStealingSchedulerTests.h
+// tests/shared/src
+//
+// Copyright 2020, Tivoli Cloud VR
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_WorkStealingSchedulerTests_h
+#define hifi_WorkStealingSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class WorkStealingSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void balanceTest();
+    void singleWorkerTest();
+    void concurrentFramesTest();
+};
+
+#endif // hifi_WorkStealingSchedulerTests_h